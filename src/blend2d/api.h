@@ -717,6 +717,7 @@ BL_FORWARD_DECLARE_STRUCT(BLGlyphRun);
 BL_FORWARD_DECLARE_STRUCT(BLFontUnicodeCoverage);
 BL_FORWARD_DECLARE_STRUCT(BLFontFaceInfo);
 BL_FORWARD_DECLARE_STRUCT(BLFontQueryProperties);
+BL_FORWARD_DECLARE_STRUCT(BLFontShapingCacheInfo);
 BL_FORWARD_DECLARE_STRUCT(BLFontFeatureItem);
 BL_FORWARD_DECLARE_STRUCT(BLFontFeatureSettingsCore);
 BL_FORWARD_DECLARE_STRUCT(BLFontFeatureSettingsImpl);
@@ -730,6 +731,7 @@ BL_FORWARD_DECLARE_STRUCT(BLFontVariationItem);
 BL_FORWARD_DECLARE_STRUCT(BLFontVariationSettingsCore);
 BL_FORWARD_DECLARE_STRUCT(BLFontVariationSettingsImpl);
 BL_FORWARD_DECLARE_STRUCT(BLFontVariationSettingsView);
+BL_FORWARD_DECLARE_STRUCT(BLTextBatchItem);
 BL_FORWARD_DECLARE_STRUCT(BLTextMetrics);
 
 BL_FORWARD_DECLARE_STRUCT(BLFontCore);
@@ -7,6 +7,7 @@
 #include "context_p.h"
 #include "gradient_p.h"
 #include "image_p.h"
+#include "imageblur_p.h"
 #include "pattern_p.h"
 #include "runtime_p.h"
 #include "raster/rastercontext_p.h"
@@ -41,6 +42,8 @@ static BLResult BL_CDECL setFillRuleImpl(BLContextImpl* impl, BLFillRule) noexce
 
 static BLResult BL_CDECL saveImpl(BLContextImpl* impl, BLContextCookie*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 static BLResult BL_CDECL restoreImpl(BLContextImpl* impl, const BLContextCookie*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
+static BLResult BL_CDECL beginGroupImpl(BLContextImpl* impl, double, BLCompOp, const BLRect*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
+static BLResult BL_CDECL endGroupImpl(BLContextImpl* impl) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 
 static BLResult BL_CDECL getStyleImpl(const BLContextImpl* impl, BLContextStyleSlot, bool, BLVarCore*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 static BLResult BL_CDECL setStyleImpl(BLContextImpl* impl, BLContextStyleSlot, const BLObjectCore*, BLContextStyleTransformMode) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
@@ -84,6 +87,10 @@ static BLResult BL_CDECL doGeometryImpl(BLContextImpl* impl, BLGeometryType, con
 static BLResult BL_CDECL doGeometryRgba32Impl(BLContextImpl* impl, BLGeometryType, const void*, uint32_t) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 static BLResult BL_CDECL doGeometryExtImpl(BLContextImpl* impl, BLGeometryType, const void*, const BLObjectCore*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 
+static BLResult BL_CDECL doPathInstancesDImpl(BLContextImpl* impl, const BLPathCore*, const BLPoint*, size_t) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
+static BLResult BL_CDECL doPathInstancesDRgba32Impl(BLContextImpl* impl, const BLPathCore*, const BLPoint*, const BLRgba32*, size_t) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
+static BLResult BL_CDECL preparePathDImpl(BLContextImpl* impl, const BLPoint*, const BLPathCore*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
+
 static BLResult BL_CDECL doTextOpIImpl(BLContextImpl* impl, const BLPointI*, const BLFontCore*, BLContextRenderTextOp, const void*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 static BLResult BL_CDECL doTextOpIRgba32Impl(BLContextImpl* impl, const BLPointI*, const BLFontCore*, BLContextRenderTextOp, const void*, uint32_t) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
 static BLResult BL_CDECL doTextOpIExtImpl(BLContextImpl* impl, const BLPointI*, const BLFontCore*, BLContextRenderTextOp, const void*, const BLObjectCore*) noexcept { return blTraceError(BL_ERROR_INVALID_STATE); }
@@ -117,6 +124,8 @@ static void initNullContextVirt(BLContextVirt* virt) noexcept {
 
   virt->save                     = NullContext::saveImpl;
   virt->restore                  = NullContext::restoreImpl;
+  virt->beginGroup               = NullContext::beginGroupImpl;
+  virt->endGroup                 = NullContext::endGroupImpl;
 
   virt->userToMeta               = NullContext::noArgsImpl;
   virt->applyTransformOp         = NullContext::applyTransformOpImpl;
@@ -180,6 +189,10 @@ static void initNullContextVirt(BLContextVirt* virt) noexcept {
   virt->fillGeometryRgba32       = NullContext::doGeometryRgba32Impl;
   virt->fillGeometryExt          = NullContext::doGeometryExtImpl;
 
+  virt->fillPathInstancesD       = NullContext::doPathInstancesDImpl;
+  virt->fillPathInstancesDRgba32 = NullContext::doPathInstancesDRgba32Impl;
+  virt->preparePathD             = NullContext::preparePathDImpl;
+
   virt->fillTextOpI              = NullContext::doTextOpIImpl;
   virt->fillTextOpIRgba32        = NullContext::doTextOpIRgba32Impl;
   virt->fillTextOpIExt           = NullContext::doTextOpIExtImpl;
@@ -361,6 +374,20 @@ BL_API_IMPL BLResult blContextRestore(BLContextCore* self, const BLContextCookie
   return impl->virt->restore(impl, cookie);
 }
 
+BL_API_IMPL BLResult blContextBeginGroup(BLContextCore* self, double opacity, BLCompOp compOp, const BLRect* bounds) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  return impl->virt->beginGroup(impl, opacity, compOp, bounds);
+}
+
+BL_API_IMPL BLResult blContextEndGroup(BLContextCore* self) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  return impl->virt->endGroup(impl);
+}
+
 // bl::Context - API - Transformations
 // ===================================
 
@@ -960,6 +987,27 @@ BL_API_IMPL BLResult blContextFillPathDExt(BLContextCore* self, const BLPoint* o
   return impl->virt->fillPathDExt(impl, origin, path, static_cast<const BLObjectCore*>(style));
 }
 
+BL_API_IMPL BLResult blContextFillPathInstancesD(BLContextCore* self, const BLPathCore* path, const BLPoint* origins, size_t n) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  return impl->virt->fillPathInstancesD(impl, path, origins, n);
+}
+
+BL_API_IMPL BLResult blContextFillPathInstancesDRgba32(BLContextCore* self, const BLPathCore* path, const BLPoint* origins, const BLRgba32* colors, size_t n) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  return impl->virt->fillPathInstancesDRgba32(impl, path, origins, colors, n);
+}
+
+BL_API_IMPL BLResult blContextPreparePathD(BLContextCore* self, const BLPoint* origin, const BLPathCore* path) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  return impl->virt->preparePathD(impl, origin, path);
+}
+
 // bl::Context - API - Fill Geometry Operations
 // ============================================
 
@@ -1321,6 +1369,75 @@ BL_API_IMPL BLResult blContextFillMaskDExt(BLContextCore* self, const BLPoint* o
   return impl->virt->fillMaskDExt(impl, origin, mask, maskArea, static_cast<const BLObjectCore*>(style));
 }
 
+// bl::Context - API - Fill Shadow Operations
+// ==========================================
+
+// Shadows are rendered as blurred A8 masks, which are larger than the image so they contain the whole blur.
+static BLResult blContextMakeShadowMask(BLImage* mask, BLPoint* maskOrigin, const BLPoint* origin, const BLImageCore* image, double sigma) noexcept {
+  BLPointI offset;
+  BL_PROPAGATE(bl::ImageBlurInternal::makeShadowMask(mask, image, sigma, &offset));
+
+  *maskOrigin = BLPoint(origin->x - double(offset.x), origin->y - double(offset.y));
+  return BL_SUCCESS;
+}
+
+BL_API_IMPL BLResult blContextFillShadowD(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  BLImage mask;
+  BLPoint maskOrigin;
+  BL_PROPAGATE(blContextMakeShadowMask(&mask, &maskOrigin, origin, image, sigma));
+
+  if (mask.empty())
+    return BL_SUCCESS;
+
+  return impl->virt->fillMaskD(impl, &maskOrigin, &mask, nullptr);
+}
+
+BL_API_IMPL BLResult blContextFillShadowDRgba32(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma, uint32_t rgba32) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  BLImage mask;
+  BLPoint maskOrigin;
+  BL_PROPAGATE(blContextMakeShadowMask(&mask, &maskOrigin, origin, image, sigma));
+
+  if (mask.empty())
+    return BL_SUCCESS;
+
+  return impl->virt->fillMaskDRgba32(impl, &maskOrigin, &mask, nullptr, rgba32);
+}
+
+BL_API_IMPL BLResult blContextFillShadowDRgba64(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma, uint64_t rgba64) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  BLImage mask;
+  BLPoint maskOrigin;
+  BL_PROPAGATE(blContextMakeShadowMask(&mask, &maskOrigin, origin, image, sigma));
+
+  if (mask.empty())
+    return BL_SUCCESS;
+
+  BLVarCore style = BLInternal::makeInlineStyle(BLRgba64(rgba64));
+  return impl->virt->fillMaskDExt(impl, &maskOrigin, &mask, nullptr, &style);
+}
+
+BL_API_IMPL BLResult blContextFillShadowDExt(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma, const BLUnknown* style) noexcept {
+  BL_ASSERT(self->_d.isContext());
+  BLContextImpl* impl = self->_impl();
+
+  BLImage mask;
+  BLPoint maskOrigin;
+  BL_PROPAGATE(blContextMakeShadowMask(&mask, &maskOrigin, origin, image, sigma));
+
+  if (mask.empty())
+    return BL_SUCCESS;
+
+  return impl->virt->fillMaskDExt(impl, &maskOrigin, &mask, nullptr, static_cast<const BLObjectCore*>(style));
+}
+
 // bl::Context - API - Stroke Rect Operations
 // ==========================================
 
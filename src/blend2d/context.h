@@ -53,6 +53,8 @@ BL_DEFINE_ENUM(BLContextHint) {
   BL_CONTEXT_HINT_GRADIENT_QUALITY = 1,
   //! Pattern quality.
   BL_CONTEXT_HINT_PATTERN_QUALITY = 2,
+  //! Glyph positioning, see \ref BLGlyphPositioning.
+  BL_CONTEXT_HINT_GLYPH_POSITIONING = 3,
 
   //! Maximum value of `BLContextHint`.
   BL_CONTEXT_HINT_MAX_VALUE = 7
@@ -126,6 +128,14 @@ BL_DEFINE_ENUM(BLContextCreateFlags) {
   //! rendering. It's only practical to use this flag with 2 or more requested threads.
   BL_CONTEXT_CREATE_FLAG_FALLBACK_TO_SYNC = 0x00100000u,
 
+  //! Enables occlusion culling of asynchronous rendering. Before a band is rendered, box fills that are fully hidden
+  //! by a later opaque box fill are skipped in that band. Opaque box fills are aligned rectangles filled either by an
+  //! opaque style with \ref BL_COMP_OP_SRC_OVER or by any style with \ref BL_COMP_OP_SRC_COPY, both at full alpha.
+  //!
+  //! This flag only makes sense when the asynchronous mode was specified by having `threadCount` greater than 0. It
+  //! helps scenes that repaint backgrounds and then cover them with opaque panels.
+  BL_CONTEXT_CREATE_FLAG_OCCLUSION_CULLING = 0x00200000u,
+
   //! If this flag is specified and asynchronous rendering is enabled then the context would create its own isolated
   //! thread-pool, which is useful for debugging purposes.
   //!
@@ -316,6 +326,28 @@ BL_DEFINE_ENUM(BLRenderingQuality) {
   BL_FORCE_ENUM_UINT32(BL_RENDERING_QUALITY)
 };
 
+//! Glyph positioning - specifies how origins of filled glyphs are snapped to the pixel grid.
+//!
+//! Quantized positioning means that each glyph is rendered at one of a few subpixel positions, so the same glyph
+//! always looks the same at the same subpixel phase and small text gets crisper baselines. Glyph origins are
+//! rounded to the nearest position in device space, the outline itself is not modified. Stroked text is not
+//! affected by this hint.
+BL_DEFINE_ENUM(BLGlyphPositioning) {
+  //! Glyphs are rendered at their exact positions (default).
+  BL_GLYPH_POSITIONING_EXACT = 0,
+  //! Glyph origins are quantized to 4 horizontal and 4 vertical subpixel positions.
+  BL_GLYPH_POSITIONING_SUBPIXEL_4X4 = 1,
+  //! Glyph origins are quantized to 4 horizontal subpixel positions and snapped vertically to whole pixels.
+  BL_GLYPH_POSITIONING_SUBPIXEL_4X1 = 2,
+  //! Glyph origins are snapped to whole pixels.
+  BL_GLYPH_POSITIONING_PIXEL = 3,
+
+  //! Maximum value of `BLGlyphPositioning`.
+  BL_GLYPH_POSITIONING_MAX_VALUE = 3
+
+  BL_FORCE_ENUM_UINT32(BL_GLYPH_POSITIONING)
+};
+
 //! \}
 
 //! \name BLContext - Structs
@@ -411,6 +443,7 @@ struct BLContextHints {
       uint8_t renderingQuality;
       uint8_t gradientQuality;
       uint8_t patternQuality;
+      uint8_t glyphPositioning;
     };
 
     uint8_t hints[BL_CONTEXT_HINT_MAX_VALUE + 1];
@@ -467,6 +500,8 @@ BL_API BLResult BL_CDECL blContextFlush(BLContextCore* self, BLContextFlushFlags
 
 BL_API BLResult BL_CDECL blContextSave(BLContextCore* self, BLContextCookie* cookie) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextRestore(BLContextCore* self, const BLContextCookie* cookie) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextBeginGroup(BLContextCore* self, double opacity, BLCompOp compOp, const BLRect* bounds) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextEndGroup(BLContextCore* self) BL_NOEXCEPT_C;
 
 BL_API BLResult BL_CDECL blContextGetMetaTransform(const BLContextCore* self, BLMatrix2D* transformOut) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextGetUserTransform(const BLContextCore* self, BLMatrix2D* transformOut) BL_NOEXCEPT_C;
@@ -569,6 +604,10 @@ BL_API BLResult BL_CDECL blContextFillPathDRgba32(BLContextCore* self, const BLP
 BL_API BLResult BL_CDECL blContextFillPathDRgba64(BLContextCore* self, const BLPoint* origin, const BLPathCore* path, uint64_t rgba64) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextFillPathDExt(BLContextCore* self, const BLPoint* origin, const BLPathCore* path, const BLUnknown* style) BL_NOEXCEPT_C;
 
+BL_API BLResult BL_CDECL blContextFillPathInstancesD(BLContextCore* self, const BLPathCore* path, const BLPoint* origins, size_t n) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextFillPathInstancesDRgba32(BLContextCore* self, const BLPathCore* path, const BLPoint* origins, const BLRgba32* colors, size_t n) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextPreparePathD(BLContextCore* self, const BLPoint* origin, const BLPathCore* path) BL_NOEXCEPT_C;
+
 BL_API BLResult BL_CDECL blContextFillGeometry(BLContextCore* self, BLGeometryType type, const void* data) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextFillGeometryRgba32(BLContextCore* self, BLGeometryType type, const void* data, uint32_t rgba32) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextFillGeometryRgba64(BLContextCore* self, BLGeometryType type, const void* data, uint64_t rgba64) BL_NOEXCEPT_C;
@@ -624,6 +663,11 @@ BL_API BLResult BL_CDECL blContextFillMaskDRgba32(BLContextCore* self, const BLP
 BL_API BLResult BL_CDECL blContextFillMaskDRgba64(BLContextCore* self, const BLPoint* origin, const BLImageCore* mask, const BLRectI* maskArea, uint64_t rgba64) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextFillMaskDExt(BLContextCore* self, const BLPoint* origin, const BLImageCore* mask, const BLRectI* maskArea, const BLUnknown* style) BL_NOEXCEPT_C;
 
+BL_API BLResult BL_CDECL blContextFillShadowD(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextFillShadowDRgba32(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma, uint32_t rgba32) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextFillShadowDRgba64(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma, uint64_t rgba64) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blContextFillShadowDExt(BLContextCore* self, const BLPoint* origin, const BLImageCore* image, double sigma, const BLUnknown* style) BL_NOEXCEPT_C;
+
 BL_API BLResult BL_CDECL blContextStrokeRectI(BLContextCore* self, const BLRectI* rect) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextStrokeRectIRgba32(BLContextCore* self, const BLRectI* rect, uint32_t rgba32) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blContextStrokeRectIRgba64(BLContextCore* self, const BLRectI* rect, uint64_t rgba64) BL_NOEXCEPT_C;
@@ -775,6 +819,8 @@ struct BLContextVirt BL_CLASS_INHERITS(BLObjectVirt) {
 
   BLResult (BL_CDECL* save                    )(BLContextImpl* impl, BLContextCookie* cookie) BL_NOEXCEPT;
   BLResult (BL_CDECL* restore                 )(BLContextImpl* impl, const BLContextCookie* cookie) BL_NOEXCEPT;
+  BLResult (BL_CDECL* beginGroup              )(BLContextImpl* impl, double opacity, BLCompOp compOp, const BLRect* bounds) BL_NOEXCEPT;
+  BLResult (BL_CDECL* endGroup                )(BLContextImpl* impl) BL_NOEXCEPT;
 
   BLResult (BL_CDECL* userToMeta              )(BLContextImpl* impl) BL_NOEXCEPT;
 
@@ -824,6 +870,10 @@ struct BLContextVirt BL_CLASS_INHERITS(BLObjectVirt) {
   BLResult (BL_CDECL* fillGeometryRgba32      )(BLContextImpl* impl, BLGeometryType type, const void* data, uint32_t rgba32) BL_NOEXCEPT;
   BLResult (BL_CDECL* fillGeometryExt         )(BLContextImpl* impl, BLGeometryType type, const void* data, const BLObjectCore* style) BL_NOEXCEPT;
 
+  BLResult (BL_CDECL* fillPathInstancesD      )(BLContextImpl* impl, const BLPathCore* path, const BLPoint* origins, size_t n) BL_NOEXCEPT;
+  BLResult (BL_CDECL* fillPathInstancesDRgba32)(BLContextImpl* impl, const BLPathCore* path, const BLPoint* origins, const BLRgba32* colors, size_t n) BL_NOEXCEPT;
+  BLResult (BL_CDECL* preparePathD            )(BLContextImpl* impl, const BLPoint* origin, const BLPathCore* path) BL_NOEXCEPT;
+
   BLResult (BL_CDECL* fillTextOpI             )(BLContextImpl* self, const BLPointI* origin, const BLFontCore* font, BLContextRenderTextOp op, const void* data) BL_NOEXCEPT_C;
   BLResult (BL_CDECL* fillTextOpIRgba32       )(BLContextImpl* self, const BLPointI* origin, const BLFontCore* font, BLContextRenderTextOp op, const void* data, uint32_t rgba32) BL_NOEXCEPT_C;
   BLResult (BL_CDECL* fillTextOpIExt          )(BLContextImpl* self, const BLPointI* origin, const BLFontCore* font, BLContextRenderTextOp op, const void* data, const BLObjectCore* style) BL_NOEXCEPT_C;
@@ -1235,6 +1285,50 @@ public:
 
   //! \}
 
+  //! \name Group Management
+  //! \{
+
+  //! Begins a group - all rendering that follows goes into a temporary layer, which is composited to the previous
+  //! destination by `endGroup()` with the given `opacity` and `compOp`.
+  //!
+  //! This is much cheaper than rendering into a separate image and blitting it, because the layer only covers the
+  //! current clip box, which is intersected with the bounds of the group passed to the other overload of this
+  //! function. The current state is saved by `beginGroup()` and restored by `endGroup()`, and it's not possible to
+  //! `restore()` a state that was saved before the group has started.
+  //!
+  //! Rendering within the group starts with global alpha set to 1 and with `BL_COMP_OP_SRC_OVER` composition operator.
+  //! The layer is composited by `compOp` and the global alpha used before the group started multiplied by `opacity`.
+  //!
+  //! \note When the rendering context is multi-threaded, both `beginGroup()` and `endGroup()` have to wait until all
+  //! previously issued rendering commands finish (like `flush(BL_CONTEXT_FLUSH_SYNC)`), because the destination of
+  //! worker threads can only change between batches. Each group thus costs two synchronization points, which makes
+  //! many small groups rendered by a multi-threaded context considerably slower than the same content without groups.
+  //! Groups that are empty after clipping don't synchronize at all.
+  BL_INLINE_NODEBUG BLResult beginGroup(double opacity = 1.0, BLCompOp compOp = BL_COMP_OP_SRC_OVER) noexcept {
+    BL_CONTEXT_CALL_RETURN(beginGroup, impl, opacity, compOp, nullptr);
+  }
+
+  //! Begins a group that is bounded by `bounds` rectangle specified in user coordinates, see `beginGroup()`.
+  //!
+  //! Rendering outside of `bounds` (transformed by the current transformation matrix) is clipped.
+  BL_INLINE_NODEBUG BLResult beginGroup(double opacity, BLCompOp compOp, const BLRect& bounds) noexcept {
+    BL_CONTEXT_CALL_RETURN(beginGroup, impl, opacity, compOp, &bounds);
+  }
+
+  //! Ends a group started by `beginGroup()` and composites its content to the previous destination.
+  //!
+  //! The opacity of the group is multiplied by the global alpha of the state that was active when the group began.
+  //!
+  //! Possible return conditions:
+  //!
+  //!   - `BL_SUCCESS` - The group was composited successfully.
+  //!   - `BL_ERROR_INVALID_STATE` - There is no group to end.
+  BL_INLINE_NODEBUG BLResult endGroup() noexcept {
+    BL_CONTEXT_CALL_RETURN(endGroup, impl);
+  }
+
+  //! \}
+
   //! \cond INTERNAL
   //! \name Transformations (Internal)
   //! \{
@@ -1390,6 +1484,17 @@ public:
     return setHint(BL_CONTEXT_HINT_PATTERN_QUALITY, uint32_t(value));
   }
 
+  //! Returns the glyph positioning hint.
+  BL_NODISCARD
+  BL_INLINE_NODEBUG BLGlyphPositioning glyphPositioning() const noexcept {
+    return BLGlyphPositioning(hints().glyphPositioning);
+  }
+
+  //! Sets glyph positioning hint to `value`.
+  BL_INLINE_NODEBUG BLResult setGlyphPositioning(BLGlyphPositioning value) noexcept {
+    return setHint(BL_CONTEXT_HINT_GLYPH_POSITIONING, uint32_t(value));
+  }
+
   //! \}
 
   //! \name Approximation Options
@@ -2113,6 +2218,31 @@ private:
     BL_CONTEXT_CALL_RETURN(fillMaskDExt, impl, &origin, &mask, maskArea, &style);
   }
 
+  BL_INLINE_NODEBUG BLResult _fillShadowD(const BLPoint& origin, const BLImage& image, double sigma, const BLRgba& rgba) noexcept {
+    BLVarCore style = BLInternal::makeInlineStyle(rgba);
+    return blContextFillShadowDExt(this, &origin, &image, sigma, &style);
+  }
+
+  BL_INLINE_NODEBUG BLResult _fillShadowD(const BLPoint& origin, const BLImage& image, double sigma, const BLRgba32& rgba32) noexcept {
+    return blContextFillShadowDRgba32(this, &origin, &image, sigma, rgba32.value);
+  }
+
+  BL_INLINE_NODEBUG BLResult _fillShadowD(const BLPoint& origin, const BLImage& image, double sigma, const BLRgba64& rgba64) noexcept {
+    return blContextFillShadowDRgba64(this, &origin, &image, sigma, rgba64.value);
+  }
+
+  BL_INLINE_NODEBUG BLResult _fillShadowD(const BLPoint& origin, const BLImage& image, double sigma, const BLVarCore& style) noexcept {
+    return blContextFillShadowDExt(this, &origin, &image, sigma, &style);
+  }
+
+  BL_INLINE_NODEBUG BLResult _fillShadowD(const BLPoint& origin, const BLImage& image, double sigma, const BLPatternCore& style) noexcept {
+    return blContextFillShadowDExt(this, &origin, &image, sigma, &style);
+  }
+
+  BL_INLINE_NODEBUG BLResult _fillShadowD(const BLPoint& origin, const BLImage& image, double sigma, const BLGradientCore& style) noexcept {
+    return blContextFillShadowDExt(this, &origin, &image, sigma, &style);
+  }
+
 public:
 
   //! \}
@@ -2497,6 +2627,42 @@ public:
     return _fillPathD(origin, path, style);
   }
 
+  //! Fills the given `path` translated by each of `n` points passed in `origins`.
+  //!
+  //! Each instance is composited separately like `fillPath(origins[i], path)` would, however, the path is flattened
+  //! only once and its edges are translated to each instance, which makes this function much faster when the same
+  //! path (like a marker) is rendered many times. Origins are rounded to the fixed-point precision of the rasterizer
+  //! (1/256 of a device pixel), thus the result can slightly differ from calling `fillPath()` for each origin.
+  BL_INLINE_NODEBUG BLResult fillPathInstances(const BLPathCore& path, const BLPoint* origins, size_t n) noexcept {
+    BL_CONTEXT_CALL_RETURN(fillPathInstancesD, impl, &path, origins, n);
+  }
+
+  //! Fills the given `path` translated by each of `n` points passed in `origins` by using the corresponding color
+  //! passed in `colors` as a fill style of each instance.
+  BL_INLINE_NODEBUG BLResult fillPathInstances(const BLPathCore& path, const BLPoint* origins, const BLRgba32* colors, size_t n) noexcept {
+    BL_CONTEXT_CALL_RETURN(fillPathInstancesDRgba32, impl, &path, origins, colors, n);
+  }
+
+  //! Prepares the given `path` for repeated filling.
+  //!
+  //! Edges of the path are built for the current transform, clip box, and flatten tolerance and cached by the path,
+  //! thus subsequent `fillPath()` calls that use the same state only rasterize the cached edges instead of flattening,
+  //! clipping, and converting the path again. The cache is immutable and can be used by multiple rendering contexts
+  //! (including multithreaded ones) that share the same state. It's dropped when the path is modified and it's replaced
+  //! when the path is prepared again for a different state. Fills that don't match the prepared state are not affected.
+  //! A path can be prepared while it's being rendered by other threads or contexts - each fill uses either the previous
+  //! or the new edge cache, which stays alive until all commands that use it are finalized.
+  BL_INLINE_NODEBUG BLResult preparePath(const BLPathCore& path) noexcept {
+    BLPoint origin {};
+    BL_CONTEXT_CALL_RETURN(preparePathD, impl, &origin, &path);
+  }
+
+  //! Prepares the given `path` translated by `origin` for repeated filling by `fillPath(origin, path)`, see
+  //! `preparePath(path)` for more details.
+  BL_INLINE_NODEBUG BLResult preparePath(const BLPoint& origin, const BLPathCore& path) noexcept {
+    BL_CONTEXT_CALL_RETURN(preparePathD, impl, &origin, &path);
+  }
+
   //! Fills the passed geometry specified by geometry `type` and `data`.
   //!
   //! \note This function provides a low-level interface that can be used in cases that geometry `type` and `data`
@@ -2676,6 +2842,25 @@ public:
 
   //! \}
 
+  //! \name Fill Shadow Operations
+  //! \{
+
+  //! Fills a shadow of `image` placed at `origin`, which is its alpha channel blurred by a gaussian blur of `sigma`.
+  //!
+  //! The shadow is not clipped to the image - it extends by `3 * sigma` pixels in all directions. Drop shadows are
+  //! usually rendered by offsetting `origin` before rendering the image itself. XRGB32 images cast a shadow of their
+  //! whole area.
+  BL_INLINE_NODEBUG BLResult fillShadow(const BLPoint& origin, const BLImage& image, double sigma) noexcept {
+    return blContextFillShadowD(this, &origin, &image, sigma);
+  }
+  //! \overload
+  template<typename StyleT>
+  BL_INLINE_NODEBUG BLResult fillShadow(const BLPoint& origin, const BLImage& image, double sigma, const StyleT& style) noexcept {
+    return _fillShadowD(origin, image, sigma, style);
+  }
+
+  //! \}
+
   //! \cond INTERNAL
   //! \name Stroke Wrappers (Internal)
   //! \{
@@ -3252,6 +3437,10 @@ public:
   }
 
   //! Strokes the given `path`.
+  //!
+  //! \note Paths that only contain lines and that are stroked by butt or square caps with a transformed width of at
+  //! most 1.5 pixels are outlined directly in device space. The result matches a fill of `BLPath::addStrokedPath()`
+  //! output, except for round joins, which are approximated by lines, so their tips can be slightly lighter.
   BL_INLINE_NODEBUG BLResult strokePath(const BLPathCore& path) noexcept {
     return _strokeGeometryOp(BL_GEOMETRY_TYPE_PATH, &path);
   }
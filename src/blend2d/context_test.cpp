@@ -7,9 +7,18 @@
 #if defined(BL_TEST)
 
 #include "context_p.h"
+#include "font.h"
 #include "gradient_p.h"
 #include "image_p.h"
+#include "path_p.h"
 #include "pattern_p.h"
+#include "pixelops/scalar_p.h"
+#include "random.h"
+#include "raster/rastercontext_p.h"
+
+#include "../test/resources/abeezee_regular_ttf.h"
+
+#include <thread>
 
 // bl::Context - Tests
 // ===================
@@ -587,12 +596,1018 @@ static void test_context_blit_fill_clip(BLContext& ctx) {
   }
 }
 
+// Thin strokes of paths that only contain lines are rendered by a hairline stroker, which bypasses the general
+// stroker. The result must match a fill of an outline produced by the general stroker, including strokes that cross,
+// retrace, or overlap themselves. Round joins are approximated by line segments, which makes the tips of sharp round
+// joins a few percent lighter, thus they are compared with a higher tolerance.
+static void test_context_hairline_stroke() {
+  const double kNaN = Math::nan<double>();
+  const double kInf = Math::inf<double>();
+
+  BLPath polyline;
+  polyline.moveTo(10.5, 100.5);
+  for (uint32_t i = 1; i < 60; i++)
+    polyline.lineTo(10.5 + i * 4.0, 100.5 + Math::sin(double(i) * 0.2) * 60.0);
+
+  BLPath polygon;
+  polygon.moveTo(20.3, 20.7);
+  polygon.lineTo(200.2, 20.7);
+  polygon.lineTo(200.2, 180.1);
+  polygon.lineTo(120.0, 230.0);
+  polygon.lineTo(20.3, 180.1);
+  polygon.close();
+
+  BLPath star;
+  star.moveTo(128.3, 20.6);
+  for (uint32_t i = 1; i < 5; i++) {
+    double angle = double(i) * Math::kPI * 0.8;
+    star.lineTo(128.3 + Math::sin(angle) * 100.0, 120.6 - Math::cos(angle) * 100.0);
+  }
+  star.close();
+
+  BLPath overlapping;
+  overlapping.moveTo(20.5, 30.5);
+  overlapping.lineTo(230.5, 40.5);
+  overlapping.lineTo(20.5, 30.5);
+  overlapping.lineTo(230.5, 40.5);
+  overlapping.moveTo(20.2, 240.7);
+  overlapping.lineTo(230.6, 150.1);
+  overlapping.lineTo(230.6, 240.7);
+  overlapping.lineTo(20.2, 150.1);
+  overlapping.close();
+
+  BLPath spikes;
+  spikes.moveTo(10.5, 128.5);
+  for (uint32_t i = 0; i < 30; i++)
+    spikes.lineTo(10.5 + i * 7.7, (i & 1) ? 60.3 : 200.8);
+
+  const BLPath* paths[] = { &polyline, &polygon, &star, &overlapping, &spikes };
+  const double widths[] = { 0.25, 1.0, 1.5 };
+
+  BLImage actual(256, 256, BL_FORMAT_A8);
+  BLImage expected(256, 256, BL_FORMAT_A8);
+
+  INFO("Testing hairline strokes against the general stroker");
+  for (uint32_t pathIndex = 0; pathIndex < BL_ARRAY_SIZE(paths); pathIndex++) {
+    const BLPath* path = paths[pathIndex];
+    for (double width : widths) {
+      for (uint32_t join = 0; join <= BL_STROKE_JOIN_MAX_VALUE; join++) {
+        for (uint32_t cap = 0; cap <= BL_STROKE_CAP_SQUARE; cap++) {
+          BLStrokeOptions strokeOptions;
+          strokeOptions.width = width;
+          strokeOptions.join = uint8_t(join);
+          strokeOptions.startCap = uint8_t(cap);
+          strokeOptions.endCap = uint8_t(cap);
+
+          BLPath outline;
+          EXPECT_SUCCESS(outline.addStrokedPath(*path, strokeOptions, blDefaultApproximationOptions));
+
+          {
+            BLContext ctx(actual);
+            ctx.clearAll();
+            ctx.setStrokeOptions(strokeOptions);
+            ctx.strokePath(*path, BLRgba32(0xFFFFFFFFu));
+          }
+
+          {
+            BLContext ctx(expected);
+            ctx.clearAll();
+            ctx.fillPath(outline, BLRgba32(0xFFFFFFFFu));
+          }
+
+          BLImageData actualData;
+          BLImageData expectedData;
+
+          EXPECT_SUCCESS(actual.getData(&actualData));
+          EXPECT_SUCCESS(expected.getData(&expectedData));
+
+          uint32_t maxDiff = 0;
+          for (int y = 0; y < 256; y++) {
+            const uint8_t* a = static_cast<const uint8_t*>(actualData.pixelData) + y * actualData.stride;
+            const uint8_t* e = static_cast<const uint8_t*>(expectedData.pixelData) + y * expectedData.stride;
+
+            for (int x = 0; x < 256; x++)
+              maxDiff = blMax<uint32_t>(maxDiff, uint32_t(blAbs(int(a[x]) - int(e[x]))));
+          }
+
+          uint32_t tolerance = (join == BL_STROKE_JOIN_ROUND || join == BL_STROKE_JOIN_MITER_ROUND) ? 8u : 2u;
+          EXPECT_LE(maxDiff, tolerance)
+            .message("Hairline stroke doesn't match the general stroker (path=%u width=%g join=%u cap=%u)",
+                     pathIndex, width, join, cap);
+        }
+      }
+    }
+  }
+
+  INFO("Testing hairline strokes of degenerate paths");
+  {
+    BLPath degenerate;
+    degenerate.moveTo(10, 10);
+    degenerate.lineTo(10, 10);
+    degenerate.close();
+    degenerate.moveTo(20, 20);
+    degenerate.lineTo(30, 20);
+    degenerate.lineTo(20, 20);
+    degenerate.close();
+    degenerate.moveTo(kNaN, 10);
+    degenerate.lineTo(20, kNaN);
+    degenerate.moveTo(-kInf, 10);
+    degenerate.lineTo(kInf, 20);
+    degenerate.moveTo(-1e200, 10);
+    degenerate.lineTo(1e200, 20);
+
+    BLContext ctx(actual);
+    ctx.clearAll();
+    EXPECT_SUCCESS(ctx.strokePath(degenerate, BLRgba32(0xFFFFFFFFu)));
+  }
+}
+
+static uint32_t test_context_max_pixel_diff(const BLImage& a, const BLImage& b) {
+  BLImageData aData;
+  BLImageData bData;
+
+  EXPECT_SUCCESS(a.getData(&aData));
+  EXPECT_SUCCESS(b.getData(&bData));
+
+  uint32_t maxDiff = 0;
+  size_t rowSize = size_t(aData.size.w) * (blFormatInfo[aData.format].depth / 8u);
+
+  for (int y = 0; y < aData.size.h; y++) {
+    const uint8_t* aLine = static_cast<const uint8_t*>(aData.pixelData) + y * aData.stride;
+    const uint8_t* bLine = static_cast<const uint8_t*>(bData.pixelData) + y * bData.stride;
+
+    for (size_t x = 0; x < rowSize; x++)
+      maxDiff = blMax<uint32_t>(maxDiff, uint32_t(blAbs(int(aLine[x]) - int(bLine[x]))));
+  }
+
+  return maxDiff;
+}
+
+static void test_context_fill_path_instances() {
+  BLPath marker;
+  marker.addCircle(BLCircle(0, 0, 6.5));
+  marker.moveTo(-4, -9);
+  marker.cubicTo(10, -14, 12, 9, 3, 11);
+  marker.quadTo(-8, 6, -4, -9);
+  marker.close();
+
+  // A path larger than the image - all its instances are clipped, thus they are not translated.
+  BLPath largeMarker;
+  largeMarker.addCircle(BLCircle(0, 0, 150));
+
+  constexpr size_t kInstanceCount = 300;
+
+  BLPoint origins[kInstanceCount];
+  BLRgba32 colors[kInstanceCount];
+
+  BLRandom rnd(0x1234);
+  for (size_t i = 0; i < kInstanceCount; i++) {
+    // Some instances are partially or fully outside of the image. Origins are multiples of 1/64, which are exact in
+    // fixed point at all tested scales, thus instanced fills must match fillPath() at the same origins.
+    origins[i].reset(Math::floor(rnd.nextDouble() * 300.0 * 64.0) / 64.0 - 20.0,
+                     Math::floor(rnd.nextDouble() * 300.0 * 64.0) / 64.0 - 20.0);
+    colors[i].reset(rnd.nextUInt32() | 0x20000000u);
+  }
+
+  // The last context uses a command queue limit that is lower than the instance count, thus the instances are split
+  // across multiple batches (and jobs).
+  BLContextCreateInfo createInfos[3] {};
+  createInfos[1].threadCount = 2;
+  createInfos[2].threadCount = 2;
+  createInfos[2].commandQueueLimit = 256;
+
+  const double scales[] = { 1.0, 2.25 };
+  const BLPath* paths[] = { &marker, &largeMarker };
+
+  BLImage actual(256, 256, BL_FORMAT_PRGB32);
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+
+  INFO("Testing fillPathInstances() against fillPath() called per instance");
+  for (const BLContextCreateInfo& createInfo : createInfos) {
+    for (const BLPath* path : paths) {
+      for (double scale : scales) {
+        for (uint32_t perInstanceColors = 0; perInstanceColors < 2; perInstanceColors++) {
+          {
+            BLContext ctx(actual, createInfo);
+            ctx.clearAll();
+            ctx.scale(scale);
+            ctx.setFillStyle(BLRgba32(0x8000FF40u));
+
+            if (perInstanceColors)
+              EXPECT_SUCCESS(ctx.fillPathInstances(*path, origins, colors, kInstanceCount));
+            else
+              EXPECT_SUCCESS(ctx.fillPathInstances(*path, origins, kInstanceCount));
+          }
+
+          {
+            BLContext ctx(expected, createInfo);
+            ctx.clearAll();
+            ctx.scale(scale);
+            ctx.setFillStyle(BLRgba32(0x8000FF40u));
+
+            for (size_t i = 0; i < kInstanceCount; i++) {
+              if (perInstanceColors)
+                ctx.fillPath(origins[i], *path, colors[i]);
+              else
+                ctx.fillPath(origins[i], *path);
+            }
+          }
+
+          // Curves are flattened at a different translation, which can only cause rounding differences.
+          uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+          EXPECT_LE(maxDiff, 1u)
+            .message("Instanced fill doesn't match fillPath() (threadCount=%u commandQueueLimit=%u path=%s scale=%g perInstanceColors=%u)",
+                     createInfo.threadCount, createInfo.commandQueueLimit, path == &marker ? "marker" : "largeMarker", scale, perInstanceColors);
+        }
+      }
+    }
+  }
+
+  INFO("Testing fillPathInstances() with origins that are not exact in fixed point");
+  for (size_t i = 0; i < kInstanceCount; i++)
+    origins[i] += BLPoint(rnd.nextDouble() / 64.0, rnd.nextDouble() / 64.0);
+
+  for (const BLContextCreateInfo& createInfo : createInfos) {
+    {
+      BLContext ctx(actual, createInfo);
+      ctx.clearAll();
+      EXPECT_SUCCESS(ctx.fillPathInstances(marker, origins, colors, kInstanceCount));
+    }
+
+    {
+      BLContext ctx(expected, createInfo);
+      ctx.clearAll();
+      for (size_t i = 0; i < kInstanceCount; i++)
+        ctx.fillPath(origins[i], marker, colors[i]);
+    }
+
+    // Origins are rounded to 1/256 of a pixel, which can only cause tiny differences.
+    uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+    EXPECT_LE(maxDiff, 4u)
+      .message("Instanced fill differs too much from fillPath() (threadCount=%u commandQueueLimit=%u)",
+               createInfo.threadCount, createInfo.commandQueueLimit);
+  }
+}
+
+static void test_context_render_box_fills(BLContext& ctx) {
+  BLRandom rnd(0x5678);
+
+  // Rows of adjacent cells, which are merged into larger boxes.
+  ctx.setFillStyle(BLRgba32(0x80FF4020u));
+  for (int y = 0; y < 8; y++)
+    for (int x = 0; x < 16; x++)
+      ctx.fillRect(BLRectI(4 + x * 12, 4 + y * 6, 12, 6));
+
+  // Overlapping semi-transparent boxes of the same style, which must be composited in order.
+  for (int i = 0; i < 100; i++) {
+    int x = int(rnd.nextUInt32() % 230u);
+    int y = int(rnd.nextUInt32() % 230u);
+    ctx.fillRect(BLRectI(x, y, 1 + int(rnd.nextUInt32() % 40u), 1 + int(rnd.nextUInt32() % 40u)));
+  }
+
+  // Style, alpha, and comp-op changes, and unaligned boxes interleaved with aligned ones.
+  for (int i = 0; i < 60; i++) {
+    double x = double(rnd.nextUInt32() % 200u);
+    double y = double(rnd.nextUInt32() % 200u);
+
+    switch (i % 6) {
+      case 0: ctx.fillRect(BLRect(x, y, 20, 20), BLRgba32(0xFF2040F0u)); break;
+      case 1: ctx.fillRect(BLRect(x, y, 20, 20), BLRgba32(0xFF2040F0u)); break;
+      case 2: ctx.fillRect(BLRect(x + 0.5, y + 0.25, 20, 20), BLRgba32(0xFF2040F0u)); break;
+      case 3: ctx.setGlobalAlpha(0.5); ctx.fillRect(BLRect(x, y, 30, 10)); ctx.setGlobalAlpha(1.0); break;
+      case 4: ctx.setCompOp(BL_COMP_OP_PLUS); ctx.fillRect(BLRect(x, y, 10, 30)); ctx.setCompOp(BL_COMP_OP_SRC_OVER); break;
+      case 5: ctx.fillRect(BLRect(x, y, 10, 10), BLRgba32(0x40000000u)); break;
+    }
+  }
+}
+
+static void test_context_box_fill_coalescing() {
+  BLContextCreateInfo createInfo {};
+  createInfo.threadCount = 2;
+
+  BLImage actual(256, 256, BL_FORMAT_PRGB32);
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+
+  INFO("Testing coalesced box fills against synchronous rendering");
+  {
+    BLContext ctx(actual, createInfo);
+    ctx.clearAll();
+    test_context_render_box_fills(ctx);
+  }
+
+  {
+    BLContext ctx(expected);
+    ctx.clearAll();
+    test_context_render_box_fills(ctx);
+  }
+
+  uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+  EXPECT_EQ(maxDiff, 0u).message("Coalesced box fills don't match synchronous rendering");
+
+  INFO("Testing that box fills of the same style are coalesced into a single command");
+  {
+    BLContext ctx(actual, createInfo);
+    ctx.setFillStyle(BLRgba32(0x80FF4020u));
+
+    // Adjacent boxes are merged into a single box, the remaining boxes are appended to a box list.
+    for (int x = 0; x < 16; x++)
+      ctx.fillRect(BLRectI(4 + x * 12, 4, 12, 6));
+
+    for (int i = 0; i < 8; i++)
+      ctx.fillRect(BLRectI(4 + i * 20, 20 + i * 10, 15, 5));
+
+    // Inspect the commands before the batch is flushed.
+    BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(ctx._d.impl);
+    bl::RasterEngine::RenderCommandAppender& appender = ctxI->workerMgr().commandAppender();
+
+    EXPECT_EQ(appender.index(), 1u);
+    EXPECT_TRUE(appender.command(0)->isFillBoxListA());
+    EXPECT_EQ(appender.command(0)->boxListSize(), 9u);
+    EXPECT_EQ(appender.command(0)->boxListData()[0], BLBoxI(4, 4, 196, 10));
+  }
+}
+
+static void test_context_render_occluded_fills(BLContext& ctx) {
+  BLRandom rnd(0x9ABC);
+
+  // Content that is completely hidden by the opaque background painted below.
+  for (int i = 0; i < 200; i++) {
+    int x = int(rnd.nextUInt32() % 220u);
+    int y = int(rnd.nextUInt32() % 220u);
+    ctx.fillRect(BLRectI(x, y, 1 + int(rnd.nextUInt32() % 30u), 1 + int(rnd.nextUInt32() % 30u)), BLRgba32(0x8020F040u));
+    ctx.fillRect(BLRect(x + 0.5, y + 0.25, 10, 10), BLRgba32(0xFFF02040u));
+  }
+
+  ctx.fillAll(BLRgba32(0xFF102030u));
+
+  // Panels - every panel occludes the content drawn before it, but only where it covers it.
+  for (int i = 0; i < 40; i++) {
+    int x = int(rnd.nextUInt32() % 200u);
+    int y = int(rnd.nextUInt32() % 200u);
+
+    ctx.fillRect(BLRectI(x + 5, y + 5, 20, 20), BLRgba32(0x80FFFFFFu));
+    ctx.fillCircle(x + 15, y + 15, 10, BLRgba32(0xFF4080C0u));
+    ctx.fillRect(BLRect(x + 2.5, y + 2.5, 8, 8), BLRgba32(0xC0000000u));
+    ctx.fillRect(BLRectI(x, y, 40, 30), BLRgba32(0xFF000000u | rnd.nextUInt32()));
+  }
+
+  // Boxes that are not occluders - semi-transparent and non-SrcCopy fills must never hide anything.
+  for (int i = 0; i < 40; i++) {
+    int x = int(rnd.nextUInt32() % 200u);
+    int y = int(rnd.nextUInt32() % 200u);
+
+    ctx.fillRect(BLRectI(x, y, 30, 30), BLRgba32(0xFF00FF00u));
+    ctx.fillRect(BLRectI(x, y, 50, 50), BLRgba32(0x80FF0000u));
+    ctx.setCompOp(BL_COMP_OP_PLUS);
+    ctx.fillRect(BLRectI(x, y, 50, 50), BLRgba32(0xFF202020u));
+    ctx.setCompOp(BL_COMP_OP_SRC_OVER);
+  }
+}
+
+static void test_context_occlusion_culling() {
+  BLContextCreateInfo createInfo {};
+  createInfo.threadCount = 2;
+  createInfo.flags = BL_CONTEXT_CREATE_FLAG_OCCLUSION_CULLING;
+
+  BLImage actual(256, 256, BL_FORMAT_PRGB32);
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+
+  INFO("Testing occlusion culling against synchronous rendering");
+  {
+    BLContext ctx(actual, createInfo);
+    ctx.clearAll();
+    test_context_render_occluded_fills(ctx);
+  }
+
+  {
+    BLContext ctx(expected);
+    ctx.clearAll();
+    test_context_render_occluded_fills(ctx);
+  }
+
+  uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+  EXPECT_EQ(maxDiff, 0u).message("Rendering with occlusion culling doesn't match synchronous rendering");
+}
+
+static void test_context_create_large_path(BLPath& path) {
+  BLRandom rnd(0x1357);
+
+  // A single figure with many vertices that is split across all shards.
+  path.moveTo(128, 4);
+  for (uint32_t i = 1; i < 60000; i++) {
+    double angle = double(i) * (Math::kPI * 2.0 / 60000.0);
+    double r = 90.0 + rnd.nextDouble() * 60.0;
+    path.lineTo(128 + Math::sin(angle) * r, 128 - Math::cos(angle) * r);
+  }
+
+  // Many small figures with curves, some of them are explicitly closed and some cross the target bounds.
+  for (uint32_t i = 0; i < 4000; i++) {
+    double x = rnd.nextDouble() * 300.0 - 20.0;
+    double y = rnd.nextDouble() * 300.0 - 20.0;
+
+    path.moveTo(x, y);
+    path.quadTo(x + 12, y - 6, x + 10, y + 4);
+    path.cubicTo(x + 8, y + 14, x - 4, y + 12, x - 2, y + 6);
+    path.lineTo(x + 3, y + 1);
+    if (i & 1)
+      path.close();
+  }
+}
+
+static void test_context_path_shards() {
+  BLPath path;
+  test_context_create_large_path(path);
+
+  BLContextCreateInfo createInfo {};
+  createInfo.threadCount = 4;
+
+  BLImage actual(256, 256, BL_FORMAT_PRGB32);
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+
+  INFO("Testing fills of large paths built by several workers against synchronous rendering");
+  for (uint32_t fillRule = 0; fillRule <= BL_FILL_RULE_MAX_VALUE; fillRule++) {
+    {
+      BLContext ctx(actual, createInfo);
+      ctx.clearAll();
+      ctx.setFillRule(BLFillRule(fillRule));
+      ctx.fillPath(path, BLRgba32(0xFFFFFFFFu));
+      ctx.fillPath(BLPoint(10.5, 20.25), path, BLRgba32(0x80FF0000u));
+    }
+
+    {
+      BLContext ctx(expected);
+      ctx.clearAll();
+      ctx.setFillRule(BLFillRule(fillRule));
+      ctx.fillPath(path, BLRgba32(0xFFFFFFFFu));
+      ctx.fillPath(BLPoint(10.5, 20.25), path, BLRgba32(0x80FF0000u));
+    }
+
+    uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+    EXPECT_EQ(maxDiff, 0u).message("Sharded path fill doesn't match synchronous rendering (fillRule=%u)", fillRule);
+  }
+
+  // A stroke job followed by enough fills to make shards of a single path span multiple job queues.
+  INFO("Testing fills of large paths whose shards don't fit into a single job queue");
+  {
+    constexpr uint32_t kFillCount = 120;
+
+    {
+      BLContext ctx(actual, createInfo);
+      ctx.clearAll();
+      ctx.strokeCircle(128, 128, 100, BLRgba32(0xFF0000FFu));
+      for (uint32_t i = 0; i < kFillCount; i++)
+        ctx.fillPath(BLPoint(double(i % 16), double(i / 16)), path, BLRgba32(0x10204080u));
+    }
+
+    {
+      BLContext ctx(expected);
+      ctx.clearAll();
+      ctx.strokeCircle(128, 128, 100, BLRgba32(0xFF0000FFu));
+      for (uint32_t i = 0; i < kFillCount; i++)
+        ctx.fillPath(BLPoint(double(i % 16), double(i / 16)), path, BLRgba32(0x10204080u));
+    }
+
+    uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+    EXPECT_EQ(maxDiff, 0u).message("Sharded path fill spanning multiple job queues doesn't match synchronous rendering");
+  }
+}
+
+static void test_context_render_prepared_content(BLContext& ctx, BLPath& path, bool prepare) {
+  ctx.clearAll();
+  ctx.setFillRule(BL_FILL_RULE_EVEN_ODD);
+
+  if (prepare)
+    EXPECT_SUCCESS(ctx.preparePath(path));
+
+  ctx.fillPath(path, BLRgba32(0xFFFFFFFFu));
+  ctx.fillPath(path, BLRgba32(0x8000FF00u));
+
+  // Doesn't match the prepared state, thus the path is filled regularly.
+  ctx.fillPath(BLPoint(10.5, 20.25), path, BLRgba32(0x80FF0000u));
+
+  if (prepare)
+    EXPECT_SUCCESS(ctx.preparePath(BLPoint(-7.75, 3.5), path));
+
+  ctx.fillPath(BLPoint(-7.75, 3.5), path, BLRgba32(0x400000FFu));
+
+  // The path is modified while a multithreaded context may still use its edges, then filled again.
+  path.lineTo(10, 250);
+  ctx.fillPath(BLPoint(-7.75, 3.5), path, BLRgba32(0x40FF00FFu));
+}
+
+static void test_context_prepared_paths() {
+  BLPath source;
+  test_context_create_large_path(source);
+
+  BLContextCreateInfo createInfos[2] {};
+  createInfos[1].threadCount = 4;
+
+  BLImage actual(256, 256, BL_FORMAT_PRGB32);
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+
+  INFO("Testing fills of prepared paths against fills of paths that were not prepared");
+  for (const BLContextCreateInfo& createInfo : createInfos) {
+    // Paths are copied deeply so the edge cache of a prepared path is never shared with the path that isn't prepared.
+    BLPath prepared;
+    BLPath regular;
+
+    prepared.assignDeep(source);
+    regular.assignDeep(source);
+
+    {
+      BLContext ctx(actual, createInfo);
+      test_context_render_prepared_content(ctx, prepared, true);
+      EXPECT_NULL(PathInternal::getImpl(&prepared)->edgeCache);
+
+      EXPECT_SUCCESS(ctx.preparePath(prepared));
+      EXPECT_NOT_NULL(PathInternal::getImpl(&prepared)->edgeCache);
+    }
+
+    {
+      BLContext ctx(expected, createInfo);
+      test_context_render_prepared_content(ctx, regular, false);
+    }
+
+    uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+    EXPECT_EQ(maxDiff, 0u).message("Prepared path fill doesn't match regular path fill (threadCount=%u)", createInfo.threadCount);
+  }
+}
+
+static void test_context_prepared_paths_concurrently() {
+  BLPath path;
+  test_context_create_large_path(path);
+
+  constexpr uint32_t kThreadCount = 4;
+  constexpr uint32_t kIterationCount = 50;
+
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+  BLImage images[kThreadCount];
+
+  {
+    BLPath regular;
+    regular.assignDeep(path);
+
+    BLContext ctx(expected);
+    ctx.clearAll();
+    ctx.fillPath(BLPoint(-7.75, 3.5), regular, BLRgba32(0x400000FFu));
+    ctx.fillPath(regular, BLRgba32(0x8000FF00u));
+  }
+
+  INFO("Testing fills of a shared path that is prepared concurrently for different states");
+  std::thread threads[kThreadCount];
+
+  for (uint32_t i = 0; i < kThreadCount; i++) {
+    images[i].create(256, 256, BL_FORMAT_PRGB32);
+    threads[i] = std::thread([&path, &image = images[i], i]() {
+      BLContextCreateInfo createInfo {};
+      createInfo.threadCount = i & 1u;
+
+      BLContext ctx(image, createInfo);
+      for (uint32_t iter = 0; iter < kIterationCount; iter++) {
+        ctx.clearAll();
+        ctx.preparePath(BLPoint(-7.75, 3.5), path);
+        ctx.fillPath(BLPoint(-7.75, 3.5), path, BLRgba32(0x400000FFu));
+        ctx.preparePath(path);
+        ctx.fillPath(path, BLRgba32(0x8000FF00u));
+        ctx.flush(BL_CONTEXT_FLUSH_SYNC);
+      }
+    });
+  }
+
+  for (uint32_t i = 0; i < kThreadCount; i++) {
+    threads[i].join();
+
+    uint32_t maxDiff = test_context_max_pixel_diff(images[i], expected);
+    EXPECT_EQ(maxDiff, 0u).message("Concurrently prepared path fill doesn't match regular path fill (thread=%u)", i);
+  }
+}
+
+static void test_context_render_group_content(BLContext& ctx) {
+  ctx.setFillStyle(BLRgba32(0xC0FF2000u));
+  ctx.fillCircle(40, 40, 30);
+
+  ctx.save();
+  ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+  ctx.setFillStyle(BLRgba32(0x800040FFu));
+  ctx.fillRect(30, 20, 50, 30);
+  ctx.restore();
+
+  ctx.setFillStyle(BLRgba32(0xFF20C040u));
+  ctx.fillCircle(70, 60, 25);
+}
+
+static void test_context_groups() {
+  struct GroupTest {
+    double opacity;
+    BLCompOp compOp;
+    double outerAlpha;
+    BLCompOp outerCompOp;
+  };
+
+  // Global alpha and composition operator used before the group must only be applied when compositing the layer.
+  const GroupTest tests[] = {
+    { 0.5 , BL_COMP_OP_SRC_OVER, 1.0, BL_COMP_OP_SRC_OVER },
+    { 1.0 , BL_COMP_OP_SRC_OVER, 1.0, BL_COMP_OP_SRC_OVER },
+    { 0.75, BL_COMP_OP_SRC_COPY, 1.0, BL_COMP_OP_SRC_OVER },
+    { 1.0 , BL_COMP_OP_SRC_OVER, 0.5, BL_COMP_OP_SRC_COPY },
+    { 0.5 , BL_COMP_OP_SRC_COPY, 0.5, BL_COMP_OP_SRC_OVER }
+  };
+
+  BLContextCreateInfo createInfos[2] {};
+  createInfos[1].threadCount = 2;
+
+  // Bounds of the group are mapped to integral device coordinates, which is what the layer covers.
+  BLRect bounds(10, 5, 80, 70);
+  BLRectI deviceBounds(30, 20, 160, 140);
+
+  BLImage actual(256, 256, BL_FORMAT_PRGB32);
+  BLImage expected(256, 256, BL_FORMAT_PRGB32);
+  BLImage layer(256, 256, BL_FORMAT_PRGB32);
+
+  BLGradient background(BLLinearGradientValues(0, 0, 256, 256));
+  background.addStop(0.0, BLRgba32(0xFF102030u));
+  background.addStop(1.0, BLRgba32(0x80F0E0D0u));
+
+  INFO("Testing beginGroup() and endGroup() against rendering into a separate image");
+  for (const BLContextCreateInfo& createInfo : createInfos) {
+    for (const GroupTest& test : tests) {
+      {
+        BLContext ctx(actual, createInfo);
+        ctx.clearAll();
+        ctx.fillAll(background);
+        ctx.translate(10, 10);
+        ctx.scale(2);
+        ctx.setGlobalAlpha(test.outerAlpha);
+        ctx.setCompOp(test.outerCompOp);
+
+        EXPECT_SUCCESS(ctx.beginGroup(test.opacity, test.compOp, bounds));
+        test_context_render_group_content(ctx);
+        EXPECT_SUCCESS(ctx.endGroup());
+
+        // Rendering after the group must go to the original destination again.
+        ctx.fillRect(100, 100, 10, 10, BLRgba32(0xFFFFFFFFu));
+      }
+
+      {
+        BLContext ctx(layer, createInfo);
+        ctx.clearAll();
+        ctx.clipToRect(deviceBounds);
+        ctx.translate(10, 10);
+        ctx.scale(2);
+        test_context_render_group_content(ctx);
+      }
+
+      {
+        BLContext ctx(expected, createInfo);
+        ctx.clearAll();
+        ctx.fillAll(background);
+        ctx.save();
+        ctx.setCompOp(test.compOp);
+        ctx.setGlobalAlpha(test.outerAlpha * test.opacity);
+        ctx.blitImage(BLPointI(deviceBounds.x, deviceBounds.y), layer, deviceBounds);
+        ctx.restore();
+
+        ctx.translate(10, 10);
+        ctx.scale(2);
+        ctx.setGlobalAlpha(test.outerAlpha);
+        ctx.setCompOp(test.outerCompOp);
+        ctx.fillRect(100, 100, 10, 10, BLRgba32(0xFFFFFFFFu));
+      }
+
+      uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+      EXPECT_EQ(maxDiff, 0u)
+        .message("Group doesn't match a separately rendered layer (threadCount=%u opacity=%g compOp=%u outerAlpha=%g outerCompOp=%u)",
+                 createInfo.threadCount, test.opacity, uint32_t(test.compOp), test.outerAlpha, uint32_t(test.outerCompOp));
+    }
+  }
+
+  INFO("Testing state management of groups");
+  {
+    BLContext ctx(actual);
+
+    EXPECT_EQ(ctx.endGroup(), BL_ERROR_INVALID_STATE);
+
+    ctx.setFillStyle(BLRgba32(0xFF000000u));
+    ctx.save();
+    EXPECT_SUCCESS(ctx.beginGroup(0.5));
+    ctx.setFillStyle(BLRgba32(0xFFFFFFFFu));
+    ctx.setGlobalAlpha(0.25);
+
+    // States saved before the group has started can only be restored by `endGroup()`.
+    EXPECT_EQ(ctx.restore(), BL_ERROR_NO_STATES_TO_RESTORE);
+
+    // Unrestored states within the group, nested groups, and empty groups are all ended properly.
+    ctx.save();
+    EXPECT_SUCCESS(ctx.beginGroup(1.0, BL_COMP_OP_SRC_OVER, BLRect(1000, 1000, 10, 10)));
+    ctx.fillAll();
+    EXPECT_SUCCESS(ctx.endGroup());
+
+    EXPECT_SUCCESS(ctx.endGroup());
+    EXPECT_EQ(ctx.globalAlpha(), 1.0);
+    EXPECT_EQ(ctx.savedStateCount(), 1u);
+
+    BLVar style;
+    BLRgba32 rgba32;
+    EXPECT_SUCCESS(ctx.getFillStyle(style));
+    EXPECT_SUCCESS(style.toRgba32(&rgba32));
+    EXPECT_EQ(rgba32, BLRgba32(0xFF000000u));
+
+    EXPECT_SUCCESS(ctx.restore());
+  }
+}
+
+// Glyph origins are quantized in device space, thus text rendered with a quantized glyph positioning must match the
+// same glyphs rendered one by one at their quantized origins without quantization.
+static void test_context_glyph_positioning() {
+  BLFontData fontData;
+  BLFontFace face;
+  BLFont font;
+
+  EXPECT_SUCCESS(fontData.createFromData(resource_abeezee_regular_ttf, sizeof(resource_abeezee_regular_ttf)));
+  EXPECT_SUCCESS(face.createFromData(fontData, 0));
+  EXPECT_SUCCESS(font.createFromFace(face, 17.0f));
+
+  BLGlyphBuffer gb;
+  EXPECT_SUCCESS(gb.setUtf8Text("Hello lollipop"));
+  EXPECT_SUCCESS(font.shape(gb));
+
+  struct PositioningTest {
+    BLGlyphPositioning positioning;
+    double stepX;
+    double stepY;
+  };
+
+  const PositioningTest tests[] = {
+    { BL_GLYPH_POSITIONING_SUBPIXEL_4X4, 0.25, 0.25 },
+    { BL_GLYPH_POSITIONING_SUBPIXEL_4X1, 0.25, 1.0 },
+    { BL_GLYPH_POSITIONING_PIXEL, 1.0, 1.0 }
+  };
+
+  BLContextCreateInfo createInfos[2] {};
+  createInfos[1].threadCount = 2;
+
+  const BLPoint origin(10.3, 40.6);
+  const double scale = font.matrix().m00;
+
+  BLImage actual(200, 64, BL_FORMAT_A8);
+  BLImage expected(200, 64, BL_FORMAT_A8);
+
+  INFO("Testing state management of glyph positioning hint");
+  {
+    BLContext ctx(actual);
+    EXPECT_EQ(ctx.glyphPositioning(), BL_GLYPH_POSITIONING_EXACT);
+    EXPECT_SUCCESS(ctx.setGlyphPositioning(BL_GLYPH_POSITIONING_SUBPIXEL_4X1));
+    EXPECT_EQ(ctx.glyphPositioning(), BL_GLYPH_POSITIONING_SUBPIXEL_4X1);
+    EXPECT_EQ(ctx.setHint(BL_CONTEXT_HINT_GLYPH_POSITIONING, BL_GLYPH_POSITIONING_MAX_VALUE + 1u), BL_ERROR_INVALID_VALUE);
+    EXPECT_EQ(ctx.glyphPositioning(), BL_GLYPH_POSITIONING_SUBPIXEL_4X1);
+
+    EXPECT_SUCCESS(ctx.save());
+    EXPECT_SUCCESS(ctx.setGlyphPositioning(BL_GLYPH_POSITIONING_PIXEL));
+    EXPECT_SUCCESS(ctx.restore());
+    EXPECT_EQ(ctx.glyphPositioning(), BL_GLYPH_POSITIONING_SUBPIXEL_4X1);
+  }
+
+  INFO("Testing quantized glyph positioning against glyphs rendered at quantized origins");
+  for (const BLContextCreateInfo& createInfo : createInfos) {
+    for (const PositioningTest& test : tests) {
+      {
+        BLContext ctx(actual, createInfo);
+        ctx.clearAll();
+        ctx.setGlyphPositioning(test.positioning);
+        ctx.fillGlyphRun(origin, font, gb.glyphRun(), BLRgba32(0xFFFFFFFFu));
+      }
+
+      {
+        BLContext ctx(expected, createInfo);
+        ctx.clearAll();
+
+        BLGlyphRunIterator it(gb.glyphRun());
+        double x = origin.x;
+
+        while (!it.atEnd()) {
+          const BLGlyphPlacement& pos = it.placement<BLGlyphPlacement>();
+          uint32_t glyphId = it.glyphId();
+
+          BLGlyphPlacement glyphPlacement {};
+          BLGlyphRun glyphRun {};
+          glyphRun.glyphData = &glyphId;
+          glyphRun.placementData = &glyphPlacement;
+          glyphRun.size = 1;
+          glyphRun.placementType = BL_GLYPH_PLACEMENT_TYPE_ADVANCE_OFFSET;
+          glyphRun.glyphAdvance = int8_t(sizeof(uint32_t));
+          glyphRun.placementAdvance = int8_t(sizeof(BLGlyphPlacement));
+
+          BLPoint glyphOrigin(Math::round((x + pos.placement.x * scale) / test.stepX) * test.stepX,
+                              Math::round((origin.y - pos.placement.y * scale) / test.stepY) * test.stepY);
+          ctx.fillGlyphRun(glyphOrigin, font, glyphRun, BLRgba32(0xFFFFFFFFu));
+
+          x += pos.advance.x * scale;
+          it.advance();
+        }
+      }
+
+      uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+      EXPECT_EQ(maxDiff, 0u)
+        .message("Quantized glyph positioning doesn't match (threadCount=%u positioning=%u)",
+                 createInfo.threadCount, uint32_t(test.positioning));
+    }
+  }
+}
+
+static void test_context_fill_random_pixels(BLImage& img, uint32_t seed) {
+  BLImageData data;
+  EXPECT_SUCCESS(img.makeMutable(&data));
+
+  BLRandom rnd(seed);
+  for (int y = 0; y < data.size.h; y++) {
+    uint32_t* line = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(data.pixelData) + y * data.stride);
+    for (int x = 0; x < data.size.w; x++) {
+      uint32_t a = rnd.nextUInt32() & 0xFFu;
+      uint32_t c = rnd.nextUInt32();
+      line[x] = (a << 24) | ((((c >> 16) & 0xFFu) * a / 255u) << 16) | ((((c >> 8) & 0xFFu) * a / 255u) << 8) | ((c & 0xFFu) * a / 255u);
+    }
+  }
+}
+
+// Reference implementation of composition operators tested by `test_context_bicubic_comp_ops()`.
+static uint32_t test_context_composite_pixel(BLCompOp compOp, uint32_t d, uint32_t s) {
+  double da = double(d >> 24) / 255.0;
+  double sa = double(s >> 24) / 255.0;
+  uint32_t result = 0;
+
+  for (uint32_t shift = 0; shift < 32; shift += 8) {
+    double dc = double((d >> shift) & 0xFFu) / 255.0;
+    double sc = double((s >> shift) & 0xFFu) / 255.0;
+    double x = 0.0;
+
+    switch (compOp) {
+      case BL_COMP_OP_PLUS:
+        x = dc + sc;
+        break;
+
+      case BL_COMP_OP_MULTIPLY:
+        x = shift == 24 ? sa + da - sa * da : sc * dc + sc * (1.0 - da) + dc * (1.0 - sa);
+        break;
+
+      case BL_COMP_OP_DST_OUT:
+        x = dc * (1.0 - sa);
+        break;
+
+      default:
+        break;
+    }
+
+    result |= uint32_t(blClamp(x, 0.0, 1.0) * 255.0 + 0.5) << shift;
+  }
+
+  return result;
+}
+
+static void test_context_blit_aligned_src_over() {
+  BLImage texture(67, 41, BL_FORMAT_PRGB32);
+  test_context_fill_random_pixels(texture, 0x9ABC);
+
+  BLImage background(96, 64, BL_FORMAT_PRGB32);
+  test_context_fill_random_pixels(background, 0xDEF0);
+
+  static const uint32_t globalAlphas[] = { 255, 128 };
+
+  for (uint32_t globalAlpha : globalAlphas) {
+    INFO("Testing aligned SrcOver blit with global alpha %u", globalAlpha);
+
+    BLImage actual(96, 64, BL_FORMAT_PRGB32);
+    BLImage expected(96, 64, BL_FORMAT_PRGB32);
+
+    {
+      BLContext ctx(actual);
+      ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+      ctx.blitImage(BLPointI(0, 0), background);
+      ctx.setCompOp(BL_COMP_OP_SRC_OVER);
+      ctx.setGlobalAlpha(double(globalAlpha) / 255.0);
+      EXPECT_SUCCESS(ctx.blitImage(BLPointI(3, 5), texture));
+      EXPECT_SUCCESS(ctx.blitImage(BLPointI(80, 50), texture, BLRectI(1, 2, 13, 9)));
+    }
+
+    {
+      BLContext ctx(expected);
+      ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+      ctx.blitImage(BLPointI(0, 0), background);
+    }
+
+    BLImageData srcData;
+    BLImageData expectedData;
+
+    EXPECT_SUCCESS(texture.getData(&srcData));
+    EXPECT_SUCCESS(expected.makeMutable(&expectedData));
+
+    // Dca' = Sca.m + Dca.(1 - Sa.m) - both blits are composited by scalar code here.
+    struct BlitInfo { int dx, dy, sx, sy, w, h; };
+    static const BlitInfo blits[] = { { 3, 5, 0, 0, 67, 41 }, { 80, 50, 1, 2, 13, 9 } };
+
+    for (const BlitInfo& blit : blits) {
+      for (int y = 0; y < blit.h; y++) {
+        const uint32_t* srcLine = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(srcData.pixelData) + (blit.sy + y) * srcData.stride) + blit.sx;
+        uint32_t* dstLine = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(expectedData.pixelData) + (blit.dy + y) * expectedData.stride) + blit.dx;
+
+        for (int x = 0; x < blit.w; x++) {
+          uint32_t s = srcLine[x];
+          uint32_t d = dstLine[x];
+          uint32_t sa = PixelOps::Scalar::udiv255((s >> 24) * globalAlpha);
+          uint32_t result = 0;
+
+          for (uint32_t shift = 0; shift < 32; shift += 8) {
+            uint32_t sc = PixelOps::Scalar::udiv255(((s >> shift) & 0xFFu) * globalAlpha);
+            uint32_t dc = (d >> shift) & 0xFFu;
+            result |= (sc + PixelOps::Scalar::udiv255(dc * (255u - sa))) << shift;
+          }
+
+          dstLine[x] = result;
+        }
+      }
+    }
+
+    uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+    EXPECT_EQ(maxDiff, 0u).message("Aligned SrcOver blit with global alpha %u doesn't match the reference", globalAlpha);
+  }
+}
+
+static void test_context_bicubic_comp_ops() {
+  BLImage texture(24, 24, BL_FORMAT_PRGB32);
+  test_context_fill_random_pixels(texture, 0x1234);
+
+  BLPattern pattern(texture);
+  pattern.rotate(0.3);
+  pattern.scale(2.7, 2.3);
+
+  BLImage background(64, 64, BL_FORMAT_PRGB32);
+  test_context_fill_random_pixels(background, 0x5678);
+
+  // Pixels of the pattern, which are then composited by `test_context_composite_pixel()`.
+  BLImage source(64, 64, BL_FORMAT_PRGB32);
+  {
+    BLContext ctx(source);
+    ctx.clearAll();
+    ctx.setPatternQuality(BL_PATTERN_QUALITY_BICUBIC);
+    ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+    EXPECT_SUCCESS(ctx.fillAll(pattern));
+  }
+
+  static const BLCompOp compOps[] = { BL_COMP_OP_PLUS, BL_COMP_OP_MULTIPLY, BL_COMP_OP_DST_OUT };
+
+  for (BLCompOp compOp : compOps) {
+    INFO("Testing bicubic pattern fill with comp-op %u", unsigned(compOp));
+
+    BLImage actual(64, 64, BL_FORMAT_PRGB32);
+    BLImage expected(64, 64, BL_FORMAT_PRGB32);
+
+    {
+      BLContext ctx(actual);
+      ctx.setCompOp(BL_COMP_OP_SRC_COPY);
+      ctx.blitImage(BLPointI(0, 0), background);
+      ctx.setPatternQuality(BL_PATTERN_QUALITY_BICUBIC);
+      ctx.setCompOp(compOp);
+      EXPECT_SUCCESS(ctx.fillAll(pattern));
+    }
+
+    BLImageData srcData;
+    BLImageData bgData;
+    BLImageData expectedData;
+
+    EXPECT_SUCCESS(source.getData(&srcData));
+    EXPECT_SUCCESS(background.getData(&bgData));
+    EXPECT_SUCCESS(expected.makeMutable(&expectedData));
+
+    for (int y = 0; y < 64; y++) {
+      const uint32_t* srcLine = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(srcData.pixelData) + y * srcData.stride);
+      const uint32_t* bgLine = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(bgData.pixelData) + y * bgData.stride);
+      uint32_t* expectedLine = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(expectedData.pixelData) + y * expectedData.stride);
+
+      for (int x = 0; x < 64; x++)
+        expectedLine[x] = test_context_composite_pixel(compOp, bgLine[x], srcLine[x]);
+    }
+
+    uint32_t maxDiff = test_context_max_pixel_diff(actual, expected);
+    EXPECT_LE(maxDiff, 1u).message("Bicubic pattern fill with comp-op %u doesn't match the reference", unsigned(compOp));
+  }
+}
+
 UNIT(context, BL_TEST_GROUP_RENDERING_CONTEXT) {
   BLImage img(256, 256, BL_FORMAT_PRGB32);
   BLContext ctx(img);
 
   test_context_state(ctx);
   test_context_blit_fill_clip(ctx);
+  test_context_hairline_stroke();
+  test_context_fill_path_instances();
+  test_context_box_fill_coalescing();
+  test_context_occlusion_culling();
+  test_context_blit_aligned_src_over();
+  test_context_bicubic_comp_ops();
+  test_context_path_shards();
+  test_context_prepared_paths();
+  test_context_prepared_paths_concurrently();
+  test_context_groups();
+  test_context_glyph_positioning();
 }
 
 } // {Tests}
@@ -12,6 +12,7 @@
 #include "unicode/unicode_p.h"
 
 #if !defined(_WIN32)
+  #include <dirent.h>
   #include <errno.h>
   #include <fcntl.h>
   #include <unistd.h>
@@ -510,6 +511,57 @@ BL_API_IMPL BLResult BL_CDECL blFileSystemGetInfo(const char* fileName, BLFileIn
   return bl::FileSystem::fileInfoFromFileAttributeData(*infoOut, fa);
 }
 
+// BLFileSystem - Internal - Windows Implementation
+// ================================================
+
+BLResult bl::FileSystem::readDirectory(const char* dirName, BLArray<BLString>& out) noexcept {
+  BLString pattern;
+  BL_PROPAGATE(pattern.assign(dirName));
+  BL_PROPAGATE(pattern.append("\\*"));
+
+  BLUtf16StringTmp<kStaticUTF16StringSize> patternW;
+  BL_PROPAGATE(patternW.fromUtf8(pattern.data()));
+
+  WIN32_FIND_DATAW fd;
+  HANDLE handle = FindFirstFileW(patternW.dataAsWCharT(), &fd);
+
+  if (handle == INVALID_HANDLE_VALUE) {
+    DWORD e = GetLastError();
+    if (e == ERROR_FILE_NOT_FOUND)
+      return BL_SUCCESS;
+    return blTraceError(blResultFromWinError(e));
+  }
+
+  BLResult result = BL_SUCCESS;
+  do {
+    const uint16_t* nameW = reinterpret_cast<const uint16_t*>(fd.cFileName);
+    size_t nameSize = wcslen(fd.cFileName);
+
+    if (nameW[0] == '.' && (nameSize == 1 || (nameSize == 2 && nameW[1] == '.')))
+      continue;
+
+    // A single UTF-16 code unit is never encoded to more than 3 UTF-8 bytes.
+    char name[MAX_PATH * 3];
+    Unicode::ConversionState conversionState;
+
+    result = Unicode::convertUnicode(name, sizeof(name), BL_TEXT_ENCODING_UTF8, nameW, nameSize * 2u, BL_TEXT_ENCODING_UTF16, conversionState);
+    if (result != BL_SUCCESS)
+      break;
+
+    BLString nameStr;
+    result = nameStr.assign(name, conversionState.dstIndex);
+    if (result != BL_SUCCESS)
+      break;
+
+    result = out.append(nameStr);
+    if (result != BL_SUCCESS)
+      break;
+  } while (FindNextFileW(handle, &fd));
+
+  FindClose(handle);
+  return result;
+}
+
 #else
 
 // BLFileSystem - API - POSIX Implementation (Internal)
@@ -845,6 +897,34 @@ BL_API_IMPL BLResult blFileSystemGetInfo(const char* fileName, BLFileInfo* infoO
 
   return bl::FileSystem::fileInfoFromStat(*infoOut, s);
 }
+
+// BLFileSystem - Internal - POSIX Implementation
+// ==============================================
+
+BLResult bl::FileSystem::readDirectory(const char* dirName, BLArray<BLString>& out) noexcept {
+  DIR* dir = opendir(dirName);
+  if (!dir)
+    return blTraceError(blResultFromPosixError(errno));
+
+  BLResult result = BL_SUCCESS;
+  while (struct dirent* entry = readdir(dir)) {
+    const char* name = entry->d_name;
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+      continue;
+
+    BLString nameStr;
+    result = nameStr.assign(name);
+    if (result != BL_SUCCESS)
+      break;
+
+    result = out.append(nameStr);
+    if (result != BL_SUCCESS)
+      break;
+  }
+
+  closedir(dir);
+  return result;
+}
 #endif
 
 #if defined(_WIN32)
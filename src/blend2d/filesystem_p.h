@@ -6,7 +6,9 @@
 #ifndef BLEND2D_FILESYSTEM_P_H_INCLUDED
 #define BLEND2D_FILESYSTEM_P_H_INCLUDED
 
+#include "array.h"
 #include "filesystem.h"
+#include "string.h"
 
 //! \cond INTERNAL
 //! \addtogroup blend2d_internal
@@ -121,6 +123,17 @@ public:
   //! \}
 };
 
+namespace bl {
+namespace FileSystem {
+
+//! Reads names of all entries of the directory `dirName` (except `.` and `..`) and appends them to `out`.
+//!
+//! The names are not prefixed with `dirName` and are returned in the order provided by the operating system.
+BL_HIDDEN BLResult readDirectory(const char* dirName, BLArray<BLString>& out) noexcept;
+
+} // {FileSystem}
+} // {bl}
+
 //! \}
 //! \endcond
 
@@ -10,6 +10,7 @@
 #include "font_p.h"
 #include "fontface_p.h"
 #include "fontfeaturesettings_p.h"
+#include "fontshapingcache_p.h"
 #include "matrix.h"
 #include "object_p.h"
 #include "path.h"
@@ -17,6 +18,8 @@
 #include "support/intops_p.h"
 #include "support/ptrops_p.h"
 #include "support/scopedbuffer_p.h"
+#include "support/stringops_p.h"
+#include "threading/threadpool_p.h"
 
 #include "opentype/otface_p.h"
 #include "opentype/otlayout_p.h"
@@ -71,11 +74,13 @@ static BL_INLINE BLResult allocImpl(BLFontCore* self, const BLFontFaceCore* face
   impl->weight = 0;
   impl->stretch = 0;
   impl->style = 0;
+  impl->varInstance = nullptr;
   blFontCalcProperties(impl, FontFaceInternal::getImpl(face), size);
   return BL_SUCCESS;
 }
 
 BLResult freeImpl(BLFontPrivateImpl* impl) noexcept {
+  releaseVarInstance(impl->varInstance);
   blCallDtor(impl->variationSettings.dcast());
   blCallDtor(impl->featureSettings.dcast());
   blCallDtor(impl->face.dcast());
@@ -103,10 +108,27 @@ static BL_NOINLINE BLResult makeMutableInternal(BLFontCore* self) noexcept {
   newI->matrix = selfI->matrix;
   blCallCtor(newI->featureSettings.dcast(), selfI->featureSettings.dcast());
   blCallCtor(newI->variationSettings.dcast(), selfI->variationSettings.dcast());
+  newI->varInstance = retainVarInstance(selfI->varInstance);
 
   return replaceInstance(self, &newO);
 }
 
+// bl::Font - Internals - Variation Instance
+// =========================================
+
+//! Replaces the variation instance of `impl` by a new one that matches its `face` and `variationSettings`.
+static BLResult updateVarInstance(BLFontPrivateImpl* impl) noexcept {
+  const BLFontFacePrivateImpl* faceI = FontFaceInternal::getImpl(&impl->face);
+  FontVarInstance* instance = nullptr;
+
+  if (!impl->variationSettings.dcast().empty())
+    BL_PROPAGATE(faceI->funcs.createVarInstance(faceI, &impl->variationSettings, &instance));
+
+  releaseVarInstance(impl->varInstance);
+  impl->varInstance = instance;
+  return BL_SUCCESS;
+}
+
 static BL_INLINE BLResult makeMutable(BLFontCore* self) noexcept {
   if (isInstanceMutable(self))
     return BL_SUCCESS;
@@ -219,6 +241,9 @@ BL_API_IMPL BLResult blFontCreateFromFace(BLFontCore* self, const BLFontFaceCore
     selfI->style = 0;
     blFontCalcProperties(selfI, faceI, size);
 
+    bl::releaseVarInstance(selfI->varInstance);
+    selfI->varInstance = nullptr;
+
     return bl::ObjectInternal::assignVirtualInstance(&selfI->face, face);
   }
   else {
@@ -257,7 +282,8 @@ BL_API_IMPL BLResult blFontCreateFromFaceWithSettings(BLFontCore* self, const BL
     selfI->style = 0;
     blFontCalcProperties(selfI, faceI, size);
 
-    return bl::ObjectInternal::assignVirtualInstance(&selfI->face, face);
+    BL_PROPAGATE(bl::ObjectInternal::assignVirtualInstance(&selfI->face, face));
+    return updateVarInstance(selfI);
   }
   else {
     BLFontCore newO;
@@ -266,6 +292,13 @@ BL_API_IMPL BLResult blFontCreateFromFaceWithSettings(BLFontCore* self, const BL
     BLFontPrivateImpl* newI = getImpl(&newO);
     newI->featureSettings.dcast().assign(featureSettings->dcast());
     newI->variationSettings.dcast().assign(variationSettings->dcast());
+
+    BLResult result = updateVarInstance(newI);
+    if (BL_UNLIKELY(result != BL_SUCCESS)) {
+      releaseInstance(&newO);
+      return result;
+    }
+
     return replaceInstance(self, &newO);
   }
 }
@@ -392,7 +425,9 @@ BL_API_IMPL BLResult blFontSetVariationSettings(BLFontCore* self, const BLFontVa
 
   BL_PROPAGATE(makeMutable(self));
   BLFontPrivateImpl* selfI = getImpl(self);
-  return blFontVariationSettingsAssignWeak(&selfI->variationSettings, variationSettings);
+
+  BL_PROPAGATE(blFontVariationSettingsAssignWeak(&selfI->variationSettings, variationSettings));
+  return updateVarInstance(selfI);
 }
 
 BL_API_IMPL BLResult blFontResetVariationSettings(BLFontCore* self) noexcept {
@@ -405,16 +440,16 @@ BL_API_IMPL BLResult blFontResetVariationSettings(BLFontCore* self) noexcept {
 
   BL_PROPAGATE(makeMutable(self));
   BLFontPrivateImpl* selfI = getImpl(self);
+
+  bl::releaseVarInstance(selfI->varInstance);
+  selfI->varInstance = nullptr;
   return blFontVariationSettingsReset(&selfI->variationSettings);
 }
 
 // bl::Font - Shaping
 // ==================
 
-BL_API_IMPL BLResult blFontShape(const BLFontCore* self, BLGlyphBufferCore* gb) noexcept {
-  using namespace bl::FontInternal;
-  BL_ASSERT(self->_d.isFont());
-
+static BLResult BL_CDECL blFontShapeInternal(const BLFontCore* self, BLGlyphBufferCore* gb) noexcept {
   BL_PROPAGATE(blFontMapTextToGlyphs(self, gb, nullptr));
 
   bl::OpenType::OTFaceImpl* faceI = bl::FontFaceInternal::getImpl<bl::OpenType::OTFaceImpl>(&self->dcast().face());
@@ -427,6 +462,15 @@ BL_API_IMPL BLResult blFontShape(const BLFontCore* self, BLGlyphBufferCore* gb)
   return blFontPositionGlyphs(self, gb);
 }
 
+BL_API_IMPL BLResult blFontShape(const BLFontCore* self, BLGlyphBufferCore* gb) noexcept {
+  BL_ASSERT(self->_d.isFont());
+
+  if (bl::FontShapingCache::isEnabled())
+    return bl::FontShapingCache::shape(self, gb, blFontShapeInternal);
+  else
+    return blFontShapeInternal(self, gb);
+}
+
 BL_API_IMPL BLResult blFontMapTextToGlyphs(const BLFontCore* self, BLGlyphBufferCore* gb, BLGlyphMappingState* stateOut) noexcept {
   using namespace bl::FontInternal;
   BL_ASSERT(self->_d.isFont());
@@ -470,7 +514,7 @@ BL_API_IMPL BLResult blFontPositionGlyphs(const BLFontCore* self, BLGlyphBufferC
 
   if (!(gbI->flags & BL_GLYPH_BUFFER_GLYPH_ADVANCES)) {
     BL_PROPAGATE(gbI->ensurePlacement());
-    faceI->funcs.getGlyphAdvances(faceI, gbI->content, sizeof(uint32_t), gbI->placementData, gbI->size);
+    faceI->funcs.getGlyphAdvances(faceI, selfI->varInstance, gbI->content, sizeof(uint32_t), gbI->placementData, gbI->size);
     gbI->glyphRun.placementType = uint8_t(BL_GLYPH_PLACEMENT_TYPE_ADVANCE_OFFSET);
     gbI->flags |= BL_GLYPH_BUFFER_GLYPH_ADVANCES;
   }
@@ -583,6 +627,258 @@ BL_API_IMPL BLResult blFontGetTextMetrics(const BLFontCore* self, BLGlyphBufferC
   return BL_SUCCESS;
 }
 
+// bl::Font - Batch Processing
+// ===========================
+
+namespace bl {
+namespace FontInternal {
+
+//! Number of text runs a batch worker claims at once.
+static constexpr size_t kBatchChunkSize = 16;
+
+//! Minimum number of code units of all text runs processed by a single thread - smaller batches use less threads.
+static constexpr size_t kBatchMinCodeUnitsPerThread = 4096;
+
+//! Size of a single glyph stored by a batch (glyph id followed by its placement).
+static constexpr size_t kBatchGlyphSize = sizeof(uint32_t) + sizeof(BLGlyphPlacement);
+
+struct BatchWork {
+  const BLFontCore* font;
+  BLTextBatchItem* items;
+  size_t count;
+  size_t chunkCount;
+  size_t chunkIndex;
+  BLGlyphBuffer* glyphBuffers;
+
+  //! Glyph storage provided by the caller (null if glyphs are not stored), which workers write to directly.
+  uint8_t* glyphData;
+  //! Capacity of `glyphData` in bytes.
+  size_t glyphCapacity;
+  //! Number of bytes of `glyphData` used (atomic).
+  size_t glyphUsed;
+};
+
+// Returns the size of the text of `item` in code units or zero if its encoding is invalid.
+static size_t batchItemTextSize(const BLTextBatchItem& item) noexcept {
+  if (item.size != SIZE_MAX)
+    return item.encoding <= BL_TEXT_ENCODING_MAX_VALUE ? item.size : size_t(0);
+
+  switch (item.encoding) {
+    case BL_TEXT_ENCODING_LATIN1:
+    case BL_TEXT_ENCODING_UTF8:
+      return strlen(static_cast<const char*>(item.text));
+
+    case BL_TEXT_ENCODING_UTF16:
+      return StringOps::length(static_cast<const uint16_t*>(item.text));
+
+    case BL_TEXT_ENCODING_UTF32:
+      return StringOps::length(static_cast<const uint32_t*>(item.text));
+
+    default:
+      return 0;
+  }
+}
+
+// Allocates `size` bytes from the glyph storage shared by all workers, returns null if it's full.
+static BL_INLINE uint8_t* allocBatchGlyphs(BatchWork* work, size_t size) noexcept {
+  size_t used = blAtomicFetchRelaxed(&work->glyphUsed);
+  do {
+    if (size > work->glyphCapacity - used)
+      return nullptr;
+  } while (!blAtomicCompareExchange(&work->glyphUsed, &used, used + size));
+
+  return work->glyphData + used;
+}
+
+static BL_INLINE void storeBatchGlyphs(BLTextBatchItem& item, const BLGlyphBuffer& gb, uint8_t* dst) noexcept {
+  size_t size = gb.size();
+  uint32_t* glyphData = reinterpret_cast<uint32_t*>(dst);
+  BLGlyphPlacement* placementData = reinterpret_cast<BLGlyphPlacement*>(dst + size * sizeof(uint32_t));
+
+  memcpy(glyphData, gb.content(), size * sizeof(uint32_t));
+  memcpy(placementData, gb.placementData(), size * sizeof(BLGlyphPlacement));
+
+  item.glyphRun = gb.glyphRun();
+  item.glyphRun.setGlyphData(glyphData);
+  item.glyphRun.setPlacementData(placementData);
+}
+
+static BLResult processBatchItem(BatchWork* work, BLTextBatchItem& item, BLGlyphBuffer& gb) noexcept {
+  BL_PROPAGATE(blGlyphBufferSetText(&gb, item.text, item.size, BLTextEncoding(item.encoding)));
+  BL_PROPAGATE(blFontGetTextMetrics(work->font, &gb, &item.metrics));
+
+  size_t size = gb.size();
+  if (!work->glyphData || !size)
+    return BL_SUCCESS;
+
+  uint8_t* dst = allocBatchGlyphs(work, size * kBatchGlyphSize);
+  if (BL_UNLIKELY(!dst)) {
+    // Shaping produced more glyphs than code units (multiple substitution), so the glyph storage is full. The item
+    // is shaped again by `storeDeferredBatchGlyphs()`, which grows the glyph storage after all workers finish.
+    item.glyphRun.size = size;
+    return BL_SUCCESS;
+  }
+
+  storeBatchGlyphs(item, gb, dst);
+  return BL_SUCCESS;
+}
+
+static void BL_CDECL batchWorker(void* data, uint32_t workerId) noexcept {
+  BatchWork* work = static_cast<BatchWork*>(data);
+  BLGlyphBuffer& gb = work->glyphBuffers[workerId];
+
+  for (;;) {
+    size_t chunkIndex = blAtomicFetchAddRelaxed(&work->chunkIndex);
+    if (chunkIndex >= work->chunkCount)
+      break;
+
+    size_t start = chunkIndex * kBatchChunkSize;
+    size_t end = blMin(start + kBatchChunkSize, work->count);
+
+    for (size_t i = start; i < end; i++) {
+      BLTextBatchItem& item = work->items[i];
+      item.glyphRun.reset();
+      item.metrics.reset();
+      item.result = processBatchItem(work, item, gb);
+    }
+  }
+}
+
+// Stores glyphs of items that didn't fit into the glyph storage, which is grown to fit them. Glyph runs of other
+// items are updated in case the glyph storage was reallocated.
+static BLResult storeDeferredBatchGlyphs(BatchWork* work, BLArray<uint8_t>& glyphStorage) noexcept {
+  BLTextBatchItem* items = work->items;
+  size_t count = work->count;
+
+  size_t deferredSize = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (items[i].glyphRun.size && !items[i].glyphRun.glyphData)
+      deferredSize += items[i].glyphRun.size * kBatchGlyphSize;
+  }
+
+  uint8_t* dst = nullptr;
+  BLResult result = BL_SUCCESS;
+
+  if (deferredSize)
+    result = glyphStorage.modifyOp(BL_MODIFY_OP_APPEND_FIT, deferredSize, &dst);
+
+  const uint8_t* oldData = work->glyphData;
+  const uint8_t* newData = glyphStorage.data();
+
+  if (!deferredSize && oldData == newData)
+    return BL_SUCCESS;
+
+  BLGlyphBuffer& gb = work->glyphBuffers[0];
+
+  for (size_t i = 0; i < count; i++) {
+    BLTextBatchItem& item = items[i];
+    BLGlyphRun& glyphRun = item.glyphRun;
+
+    if (!glyphRun.size)
+      continue;
+
+    if (glyphRun.glyphData) {
+      if (oldData != newData) {
+        size_t offset = size_t(static_cast<const uint8_t*>(glyphRun.glyphData) - oldData);
+        glyphRun.setGlyphData(reinterpret_cast<const uint32_t*>(newData + offset));
+        glyphRun.setPlacementData(reinterpret_cast<const BLGlyphPlacement*>(newData + offset + glyphRun.size * sizeof(uint32_t)));
+      }
+      continue;
+    }
+
+    if (BL_UNLIKELY(result != BL_SUCCESS)) {
+      item.result = result;
+      glyphRun.reset();
+      continue;
+    }
+
+    // Shaping is deterministic, so the item produces the same number of glyphs again.
+    BLResult itemResult = blGlyphBufferSetText(&gb, item.text, item.size, BLTextEncoding(item.encoding));
+    if (itemResult == BL_SUCCESS)
+      itemResult = blFontShape(work->font, &gb);
+
+    if (BL_UNLIKELY(itemResult != BL_SUCCESS || gb.size() != glyphRun.size)) {
+      item.result = itemResult != BL_SUCCESS ? itemResult : blTraceError(BL_ERROR_INVALID_STATE);
+      glyphRun.reset();
+      continue;
+    }
+
+    storeBatchGlyphs(item, gb, dst);
+    dst += glyphRun.size * kBatchGlyphSize;
+  }
+
+  return result;
+}
+
+} // {FontInternal}
+} // {bl}
+
+BL_API_IMPL BLResult blFontShapeBatch(const BLFontCore* self, BLTextBatchItem* items, size_t count, BLArrayCore* glyphStorage) noexcept {
+  using namespace bl::FontInternal;
+  BL_ASSERT(self->_d.isFont());
+  BL_ASSERT(!glyphStorage || glyphStorage->_d.rawType() == BL_OBJECT_TYPE_ARRAY_UINT8);
+
+  size_t codeUnitCount = 0;
+  for (size_t i = 0; i < count; i++)
+    codeUnitCount += batchItemTextSize(items[i]);
+
+  BatchWork work {};
+  work.font = self;
+  work.items = items;
+  work.count = count;
+  work.chunkCount = (count + kBatchChunkSize - 1u) / kBatchChunkSize;
+
+  // Workers write glyphs directly to the glyph storage, which is sized for one glyph per code unit - that's enough
+  // unless shaping substitutes a glyph by multiple glyphs, which is handled by `storeDeferredBatchGlyphs()`.
+  if (glyphStorage) {
+    if (BL_UNLIKELY(codeUnitCount > SIZE_MAX / kBatchGlyphSize))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+    uint8_t* glyphData;
+    work.glyphCapacity = codeUnitCount * kBatchGlyphSize;
+    BL_PROPAGATE(glyphStorage->dcast<BLArray<uint8_t>>().modifyOp(BL_MODIFY_OP_ASSIGN_FIT, work.glyphCapacity, &glyphData));
+    work.glyphData = glyphData;
+  }
+
+  size_t maxThreadCount = blMin<size_t>(blRuntimeContext.systemInfo.threadCount, work.chunkCount);
+  uint32_t threadCount = uint32_t(blClamp<size_t>(codeUnitCount / kBatchMinCodeUnitsPerThread, 1u, blMax<size_t>(maxThreadCount, 1u)));
+
+  bl::ScopedBufferTmp<sizeof(BLGlyphBuffer) * 4> glyphBufferStorage;
+  work.glyphBuffers = static_cast<BLGlyphBuffer*>(glyphBufferStorage.alloc(sizeof(BLGlyphBuffer) * threadCount));
+
+  if (BL_UNLIKELY(!work.glyphBuffers))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  for (uint32_t i = 0; i < threadCount; i++)
+    blCallCtor(work.glyphBuffers[i]);
+
+  if (threadCount > 1)
+    blThreadPoolRunParallel(blThreadPoolGlobal(), threadCount, batchWorker, &work);
+  else
+    batchWorker(&work, 0);
+
+  BLResult result = BL_SUCCESS;
+  if (glyphStorage) {
+    BLArray<uint8_t>& storage = glyphStorage->dcast<BLArray<uint8_t>>();
+    storage.truncate(work.glyphUsed);
+    result = storeDeferredBatchGlyphs(&work, storage);
+  }
+
+  for (uint32_t i = 0; i < threadCount; i++)
+    blCallDtor(work.glyphBuffers[i]);
+
+  if (result == BL_SUCCESS) {
+    for (size_t i = 0; i < count; i++) {
+      if (items[i].result != BL_SUCCESS) {
+        result = items[i].result;
+        break;
+      }
+    }
+  }
+
+  return result;
+}
+
 // bl::Font - Low-Level API
 // ========================
 
@@ -603,7 +899,7 @@ BL_API_IMPL BLResult blFontGetGlyphAdvances(const BLFontCore* self, const uint32
   BLFontPrivateImpl* selfI = getImpl(self);
   BLFontFacePrivateImpl* faceI = bl::FontFaceInternal::getImpl(&selfI->face);
 
-  return faceI->funcs.getGlyphAdvances(faceI, glyphData, glyphAdvance, out, count);
+  return faceI->funcs.getGlyphAdvances(faceI, selfI->varInstance, glyphData, glyphAdvance, out, count);
 }
 
 // bl::Font - Glyph Outlines
@@ -631,7 +927,7 @@ BL_API_IMPL BLResult blFontGetGlyphOutlines(const BLFontCore* self, BLGlyphId gl
 
   bl::ScopedBufferTmp<BL_FONT_GET_GLYPH_OUTLINE_BUFFER_SIZE> tmpBuffer;
   BLGlyphOutlineSinkInfo sinkInfo;
-  BL_PROPAGATE(faceI->funcs.getGlyphOutlines(faceI, glyphId, &finalTransform, static_cast<BLPath*>(out), &sinkInfo.contourCount, &tmpBuffer));
+  BL_PROPAGATE(faceI->funcs.getGlyphOutlines(faceI, selfI->varInstance, glyphId, &finalTransform, static_cast<BLPath*>(out), &sinkInfo.contourCount, &tmpBuffer));
 
   if (!sink)
     return BL_SUCCESS;
@@ -650,95 +946,20 @@ BL_API_IMPL BLResult blFontGetGlyphRunOutlines(const BLFontCore* self, const BLG
   if (!glyphRun->size)
     return BL_SUCCESS;
 
-  BLMatrix2D finalTransform;
-  const BLFontMatrix& fMat = selfI->matrix;
-
-  if (userTransform) {
-    blFontMatrixMultiply(&finalTransform, &fMat, userTransform);
-  }
-  else {
-    userTransform = &bl::TransformInternal::identityTransform;
-    finalTransform.reset(fMat.m00, fMat.m01, fMat.m10, fMat.m11, 0.0, 0.0);
-  }
-
   if (!sink)
     sink = blFontDummyPathSink;
 
   bl::ScopedBufferTmp<BL_FONT_GET_GLYPH_OUTLINE_BUFFER_SIZE> tmpBuffer;
   BLGlyphOutlineSinkInfo sinkInfo;
 
-  uint32_t placementType = glyphRun->placementType;
-  BLGlyphRunIterator it(*glyphRun);
   auto getGlyphOutlinesFunc = faceI->funcs.getGlyphOutlines;
+  const bl::FontVarInstance* varInstance = selfI->varInstance;
 
-  if (it.hasPlacement() && placementType != BL_GLYPH_PLACEMENT_TYPE_NONE) {
-    BLMatrix2D offsetTransform(1.0, 0.0, 0.0, 1.0, finalTransform.m20, finalTransform.m21);
-
-    switch (placementType) {
-      case BL_GLYPH_PLACEMENT_TYPE_ADVANCE_OFFSET:
-      case BL_GLYPH_PLACEMENT_TYPE_DESIGN_UNITS:
-        offsetTransform.m00 = finalTransform.m00;
-        offsetTransform.m01 = finalTransform.m01;
-        offsetTransform.m10 = finalTransform.m10;
-        offsetTransform.m11 = finalTransform.m11;
-        break;
-
-      case BL_GLYPH_PLACEMENT_TYPE_USER_UNITS:
-        offsetTransform.m00 = userTransform->m00;
-        offsetTransform.m01 = userTransform->m01;
-        offsetTransform.m10 = userTransform->m10;
-        offsetTransform.m11 = userTransform->m11;
-        break;
-    }
-
-    if (placementType == BL_GLYPH_PLACEMENT_TYPE_ADVANCE_OFFSET) {
-      double ox = finalTransform.m20;
-      double oy = finalTransform.m21;
-      double px;
-      double py;
-
-      while (!it.atEnd()) {
-        const BLGlyphPlacement& pos = it.placement<BLGlyphPlacement>();
-
-        px = pos.placement.x;
-        py = pos.placement.y;
-        finalTransform.m20 = px * offsetTransform.m00 + py * offsetTransform.m10 + ox;
-        finalTransform.m21 = px * offsetTransform.m01 + py * offsetTransform.m11 + oy;
-
-        sinkInfo.glyphIndex = it.index;
-        BL_PROPAGATE(getGlyphOutlinesFunc(faceI, it.glyphId(), &finalTransform, static_cast<BLPath*>(out), &sinkInfo.contourCount, &tmpBuffer));
-        BL_PROPAGATE(sink(out, &sinkInfo, userData));
-        it.advance();
-
-        px = pos.advance.x;
-        py = pos.advance.y;
-        ox += px * offsetTransform.m00 + py * offsetTransform.m10;
-        oy += px * offsetTransform.m01 + py * offsetTransform.m11;
-      }
-    }
-    else {
-      while (!it.atEnd()) {
-        const BLPoint& placement = it.placement<BLPoint>();
-        finalTransform.m20 = placement.x * offsetTransform.m00 + placement.y * offsetTransform.m10 + offsetTransform.m20;
-        finalTransform.m21 = placement.x * offsetTransform.m01 + placement.y * offsetTransform.m11 + offsetTransform.m21;
-
-        sinkInfo.glyphIndex = it.index;
-        BL_PROPAGATE(getGlyphOutlinesFunc(faceI, it.glyphId(), &finalTransform, static_cast<BLPath*>(out), &sinkInfo.contourCount, &tmpBuffer));
-        BL_PROPAGATE(sink(out, &sinkInfo, userData));
-        it.advance();
-      }
-    }
-  }
-  else {
-    while (!it.atEnd()) {
-      sinkInfo.glyphIndex = it.index;
-      BL_PROPAGATE(getGlyphOutlinesFunc(faceI, it.glyphId(), &finalTransform, static_cast<BLPath*>(out), &sinkInfo.contourCount, &tmpBuffer));
-      BL_PROPAGATE(sink(out, &sinkInfo, userData));
-      it.advance();
-    }
-  }
-
-  return BL_SUCCESS;
+  return forEachGlyphRunTransform(selfI, glyphRun, userTransform, [&](size_t glyphIndex, BLGlyphId glyphId, const BLMatrix2D& transform) noexcept -> BLResult {
+    sinkInfo.glyphIndex = glyphIndex;
+    BL_PROPAGATE(getGlyphOutlinesFunc(faceI, varInstance, glyphId, &transform, static_cast<BLPath*>(out), &sinkInfo.contourCount, &tmpBuffer));
+    return sink(out, &sinkInfo, userData);
+  });
 }
 
 // bl::Font - Runtime Registration
@@ -24,6 +24,35 @@
 //! \addtogroup blend2d_api_text
 //! \{
 
+//! \name BLFont - Structs
+//! \{
+
+//! A single text run processed by \ref BLFont::shapeBatch() and \ref BLFont::getTextMetricsBatch().
+//!
+//! The caller provides `text`, `size`, and `encoding`, the remaining members are filled by the batch function.
+struct BLTextBatchItem {
+  //! \name Members
+  //! \{
+
+  //! Text data (input).
+  const void* text;
+  //! Size of the text in code units, or `SIZE_MAX` if the text is null terminated (input).
+  size_t size;
+  //! Text encoding, see \ref BLTextEncoding (input).
+  uint32_t encoding;
+  //! Result of processing this text run (output).
+  BLResult result;
+  //! Shaped glyphs and their placements, which point to the glyph storage passed to the batch function. The glyph
+  //! run is empty if the glyph storage was not provided or if processing of the text run failed (output).
+  BLGlyphRun glyphRun;
+  //! Text metrics (output).
+  BLTextMetrics metrics;
+
+  //! \}
+};
+
+//! \}
+
 //! \name BLFont - C API
 //! \{
 
@@ -58,10 +87,13 @@ BL_API BLResult BL_CDECL blFontApplyKerning(const BLFontCore* self, BLGlyphBuffe
 BL_API BLResult BL_CDECL blFontApplyGSub(const BLFontCore* self, BLGlyphBufferCore* gb, const BLBitArrayCore* lookups) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontApplyGPos(const BLFontCore* self, BLGlyphBufferCore* gb, const BLBitArrayCore* lookups) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontGetTextMetrics(const BLFontCore* self, BLGlyphBufferCore* gb, BLTextMetrics* out) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blFontShapeBatch(const BLFontCore* self, BLTextBatchItem* items, size_t count, BLArrayCore* glyphStorage) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontGetGlyphBounds(const BLFontCore* self, const uint32_t* glyphData, intptr_t glyphAdvance, BLBoxI* out, size_t count) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontGetGlyphAdvances(const BLFontCore* self, const uint32_t* glyphData, intptr_t glyphAdvance, BLGlyphPlacement* out, size_t count) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontGetGlyphOutlines(const BLFontCore* self, BLGlyphId glyphId, const BLMatrix2D* userTransform, BLPathCore* out, BLPathSinkFunc sink, void* userData) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontGetGlyphRunOutlines(const BLFontCore* self, const BLGlyphRun* glyphRun, const BLMatrix2D* userTransform, BLPathCore* out, BLPathSinkFunc sink, void* userData) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blFontShapingCacheSetCapacity(size_t capacity) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blFontShapingCacheGetInfo(BLFontShapingCacheInfo* out) BL_NOEXCEPT_C;
 
 BL_END_C_DECLS
 
@@ -245,6 +277,12 @@ public:
   //! Returns font variation settings.
   BL_INLINE_NODEBUG const BLFontVariationSettings& variationSettings() const noexcept { return _impl()->variationSettings.dcast(); }
   //! Sets font variation settings to `variationSettings`.
+  //!
+  //! Variations of OpenType fonts ('gvar', 'HVAR', and 'CFF2' tables) are applied to glyph outlines and advances.
+  //! Region scalars and glyph advances of up to 16 distinct variation instances are cached per font face, however,
+  //! glyph outlines are not cached - they are interpolated each time they are requested or rendered, which makes
+  //! rendering of varied glyphs slower than rendering glyphs of the default instance. Glyph bounds returned by
+  //! \ref getGlyphBounds() and text metrics that depend on them are always calculated from the default instance.
   BL_INLINE_NODEBUG BLResult setVariationSettings(const BLFontVariationSettingsCore& variationSettings) noexcept { return blFontSetVariationSettings(this, &variationSettings); }
   //! Resets font variation settings.
   BL_INLINE_NODEBUG BLResult resetVariationSettings() noexcept { return blFontResetVariationSettings(this); }
@@ -286,6 +324,26 @@ public:
     return blFontGetTextMetrics(this, &gb, &out);
   }
 
+  //! Shapes and measures `count` independent text runs described by `items`.
+  //!
+  //! Text runs are distributed across the threads of Blend2D's thread pool when the batch is large enough (each
+  //! thread processes at least a few thousand code units), each thread using its own glyph buffer. Shaped glyphs of
+  //! all text runs are stored in `glyphStorage`, which is replaced by this function - glyph runs stored in `items`
+  //! point to it and stay valid until `glyphStorage` is modified or destroyed. The order of glyph runs within
+  //! `glyphStorage` is unspecified.
+  //!
+  //! Each item receives its own result. The returned value is `BL_SUCCESS` if all text runs were processed
+  //! successfully, otherwise it's the result of the first text run that failed.
+  BL_INLINE_NODEBUG BLResult shapeBatch(BLTextBatchItem* items, size_t count, BLArray<uint8_t>& glyphStorage) const noexcept {
+    return blFontShapeBatch(this, items, count, &glyphStorage);
+  }
+
+  //! Measures `count` independent text runs described by `items` - the same as \ref shapeBatch(), but only text
+  //! metrics are provided (glyph runs of all items are empty).
+  BL_INLINE_NODEBUG BLResult getTextMetricsBatch(BLTextBatchItem* items, size_t count) const noexcept {
+    return blFontShapeBatch(this, items, count, nullptr);
+  }
+
   BL_INLINE_NODEBUG BLResult getGlyphBounds(const uint32_t* glyphData, intptr_t glyphAdvance, BLBoxI* out, size_t count) const noexcept {
     return blFontGetGlyphBounds(this, glyphData, glyphAdvance, out, count);
   }
@@ -311,6 +369,26 @@ public:
   }
 
   //! \}
+
+  //! \name Shaping Cache
+  //! \{
+
+  //! Sets the capacity (maximum number of cached text runs) of the global shaping cache used by `shape()`.
+  //!
+  //! The cache is disabled by default (capacity is zero). When enabled, `shape()` stores its results keyed by the
+  //! text run (including clusters), font face, and font feature and variation settings, and a repeated request is
+  //! served by copying the cached result into the glyph buffer. Text runs longer than 1024 code points and glyph
+  //! buffers that have a debug sink are never cached. Changing the capacity drops all cached text runs.
+  static BL_INLINE_NODEBUG BLResult setShapingCacheCapacity(size_t capacity) noexcept {
+    return blFontShapingCacheSetCapacity(capacity);
+  }
+
+  //! Retrieves information about the global shaping cache, including hit and miss counters.
+  static BL_INLINE_NODEBUG BLResult getShapingCacheInfo(BLFontShapingCacheInfo& out) noexcept {
+    return blFontShapingCacheGetInfo(&out);
+  }
+
+  //! \}
 };
 
 #endif
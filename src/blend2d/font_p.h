@@ -20,7 +20,16 @@
 
 static constexpr uint32_t BL_FONT_GET_GLYPH_OUTLINE_BUFFER_SIZE = 2048;
 
-struct BLFontPrivateImpl : public BLFontImpl {};
+namespace bl {
+
+struct FontVarInstance;
+
+} // {bl}
+
+struct BLFontPrivateImpl : public BLFontImpl {
+  //! Variation instance created from `variationSettings`, null if the font uses the default instance of its face.
+  bl::FontVarInstance* varInstance;
+};
 
 static BL_INLINE void blFontMatrixMultiply(BLMatrix2D* dst, const BLFontMatrix* a, const BLMatrix2D* b) noexcept {
   dst->reset(a->m00 * b->m00 + a->m01 * b->m10,
@@ -45,6 +54,7 @@ static BL_INLINE void blFontImplCtor(BLFontPrivateImpl* impl) noexcept {
   impl->face._d = blObjectDefaults[BL_OBJECT_TYPE_FONT_FACE]._d;
   blCallCtor(impl->featureSettings.dcast());
   blCallCtor(impl->variationSettings.dcast());
+  impl->varInstance = nullptr;
 }
 
 namespace bl {
@@ -93,6 +103,103 @@ static BL_INLINE BLResult replaceInstance(BLFontCore* self, const BLFontCore* ot
 
 //! \}
 
+//! \name BLFont - Internals - Glyph Run Iteration
+//! \{
+
+//! Calls `fn(glyphIndex, glyphId, transform)` for each glyph of `glyphRun`, where `transform` is a final transform
+//! of the glyph - font matrix multiplied by `userTransform` and translated to the glyph origin. The `transform` is
+//! passed as a mutable reference so the function can use it as a temporary, it's recalculated for each glyph.
+//!
+//! This is the glyph placement logic of `blFontGetGlyphRunOutlines()`, which is shared with rendering contexts that
+//! need to know glyph origins instead of only consuming transformed outlines.
+template<typename Fn>
+static BL_INLINE BLResult forEachGlyphRunTransform(const BLFontPrivateImpl* selfI, const BLGlyphRun* glyphRun, const BLMatrix2D* userTransform, Fn&& fn) noexcept {
+  BLMatrix2D finalTransform;
+  const BLFontMatrix& fMat = selfI->matrix;
+
+  if (userTransform) {
+    blFontMatrixMultiply(&finalTransform, &fMat, userTransform);
+  }
+  else {
+    userTransform = &TransformInternal::identityTransform;
+    finalTransform.reset(fMat.m00, fMat.m01, fMat.m10, fMat.m11, 0.0, 0.0);
+  }
+
+  uint32_t placementType = glyphRun->placementType;
+  BLGlyphRunIterator it(*glyphRun);
+
+  if (it.hasPlacement() && placementType != BL_GLYPH_PLACEMENT_TYPE_NONE) {
+    BLMatrix2D offsetTransform(1.0, 0.0, 0.0, 1.0, finalTransform.m20, finalTransform.m21);
+
+    switch (placementType) {
+      case BL_GLYPH_PLACEMENT_TYPE_ADVANCE_OFFSET:
+      case BL_GLYPH_PLACEMENT_TYPE_DESIGN_UNITS:
+        offsetTransform.m00 = finalTransform.m00;
+        offsetTransform.m01 = finalTransform.m01;
+        offsetTransform.m10 = finalTransform.m10;
+        offsetTransform.m11 = finalTransform.m11;
+        break;
+
+      case BL_GLYPH_PLACEMENT_TYPE_USER_UNITS:
+        offsetTransform.m00 = userTransform->m00;
+        offsetTransform.m01 = userTransform->m01;
+        offsetTransform.m10 = userTransform->m10;
+        offsetTransform.m11 = userTransform->m11;
+        break;
+    }
+
+    if (placementType == BL_GLYPH_PLACEMENT_TYPE_ADVANCE_OFFSET) {
+      double ox = finalTransform.m20;
+      double oy = finalTransform.m21;
+      double px;
+      double py;
+
+      while (!it.atEnd()) {
+        const BLGlyphPlacement& pos = it.placement<BLGlyphPlacement>();
+
+        px = pos.placement.x;
+        py = pos.placement.y;
+        finalTransform.m20 = px * offsetTransform.m00 + py * offsetTransform.m10 + ox;
+        finalTransform.m21 = px * offsetTransform.m01 + py * offsetTransform.m11 + oy;
+
+        BL_PROPAGATE(fn(it.index, it.glyphId(), finalTransform));
+        it.advance();
+
+        px = pos.advance.x;
+        py = pos.advance.y;
+        ox += px * offsetTransform.m00 + py * offsetTransform.m10;
+        oy += px * offsetTransform.m01 + py * offsetTransform.m11;
+      }
+    }
+    else {
+      while (!it.atEnd()) {
+        const BLPoint& placement = it.placement<BLPoint>();
+        finalTransform.m20 = placement.x * offsetTransform.m00 + placement.y * offsetTransform.m10 + offsetTransform.m20;
+        finalTransform.m21 = placement.x * offsetTransform.m01 + placement.y * offsetTransform.m11 + offsetTransform.m21;
+
+        BL_PROPAGATE(fn(it.index, it.glyphId(), finalTransform));
+        it.advance();
+      }
+    }
+  }
+  else {
+    double ox = finalTransform.m20;
+    double oy = finalTransform.m21;
+
+    while (!it.atEnd()) {
+      finalTransform.m20 = ox;
+      finalTransform.m21 = oy;
+
+      BL_PROPAGATE(fn(it.index, it.glyphId(), finalTransform));
+      it.advance();
+    }
+  }
+
+  return BL_SUCCESS;
+}
+
+//! \}
+
 } // {FontInternal}
 } // {bl}
 
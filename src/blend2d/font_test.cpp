@@ -6,12 +6,15 @@
 #include "api-build_test_p.h"
 #if defined(BL_TEST)
 
+#include "array.h"
 #include "bitset.h"
 #include "font.h"
 #include "fontdata.h"
 #include "fontface.h"
+#include "glyphbuffer.h"
 #include "matrix.h"
 #include "path.h"
+#include "string.h"
 
 #include "../test/resources/abeezee_regular_ttf.h"
 
@@ -37,6 +40,135 @@ UNIT(font, BL_TEST_GROUP_TEXT_COMBINED) {
     // The font provides 252 characters - verify at least this.
     uint32_t cardinality = characterCoverage.cardinality();
     EXPECT_EQ(cardinality, 252u);
+
+    INFO("Testing mapping of all code points against the character coverage");
+    BLFont font;
+    EXPECT_SUCCESS(font.createFromFace(fontFace, 20.0f));
+
+    // Maps the text twice - the first mapping builds the lookup table, the second one uses it.
+    for (uint32_t pass = 0; pass < 2; pass++) {
+      BLGlyphBuffer gb;
+      BLArray<uint32_t> text;
+
+      for (uint32_t uc = 1; uc < 0x20000u; uc++)
+        if (uc < 0xD800u || uc > 0xDFFFu)
+          EXPECT_SUCCESS(text.append(uc));
+
+      EXPECT_SUCCESS(gb.setUtf32Text(text.data(), text.size()));
+
+      BLGlyphMappingState state;
+      EXPECT_SUCCESS(font.mapTextToGlyphs(gb, state));
+      EXPECT_EQ(state.glyphCount, text.size());
+      EXPECT_EQ(state.undefinedCount, text.size() - cardinality);
+
+      const uint32_t* glyphData = gb.content();
+      for (size_t i = 0; i < text.size(); i++) {
+        EXPECT_EQ(glyphData[i] != 0, characterCoverage.hasBit(text[i]))
+          .message("Mapping of U+%04X doesn't match the character coverage", text[i]);
+      }
+    }
+  }
+
+  INFO("Testing shaping cache");
+  {
+    BLFont font;
+    EXPECT_SUCCESS(font.createFromFace(fontFace, 20.0f));
+
+    static const char* const texts[] = { "Hello World!", "AVAST Wavy", "Hello World!", "AVAST Wavy", "Hello World!" };
+
+    BLGlyphBuffer expected[2];
+    for (uint32_t i = 0; i < 2; i++) {
+      EXPECT_SUCCESS(expected[i].setUtf8Text(texts[i]));
+      EXPECT_SUCCESS(font.shape(expected[i]));
+    }
+
+    EXPECT_SUCCESS(BLFont::setShapingCacheCapacity(16));
+
+    for (uint32_t i = 0; i < BL_ARRAY_SIZE(texts); i++) {
+      BLGlyphBuffer gb;
+      EXPECT_SUCCESS(gb.setUtf8Text(texts[i]));
+      EXPECT_SUCCESS(font.shape(gb));
+
+      const BLGlyphBuffer& e = expected[i & 1];
+      EXPECT_EQ(gb.size(), e.size());
+      EXPECT_EQ(gb.flags(), e.flags());
+      EXPECT_EQ(memcmp(gb.content(), e.content(), gb.size() * sizeof(uint32_t)), 0);
+      EXPECT_EQ(memcmp(gb.infoData(), e.infoData(), gb.size() * sizeof(BLGlyphInfo)), 0);
+      EXPECT_EQ(memcmp(gb.placementData(), e.placementData(), gb.size() * sizeof(BLGlyphPlacement)), 0);
+    }
+
+    BLFontShapingCacheInfo info;
+    EXPECT_SUCCESS(BLFont::getShapingCacheInfo(info));
+    EXPECT_EQ(info.capacity, 16u);
+    EXPECT_EQ(info.size, 2u);
+    EXPECT_EQ(info.missCount, 2u);
+    EXPECT_EQ(info.hitCount, 3u);
+
+    // Different feature settings must not hit the cached result.
+    BLFontFeatureSettings fs;
+    EXPECT_SUCCESS(fs.setValue(BL_MAKE_TAG('k', 'e', 'r', 'n'), 0));
+    EXPECT_SUCCESS(font.setFeatureSettings(fs));
+
+    BLGlyphBuffer gb;
+    EXPECT_SUCCESS(gb.setUtf8Text(texts[0]));
+    EXPECT_SUCCESS(font.shape(gb));
+    EXPECT_SUCCESS(BLFont::getShapingCacheInfo(info));
+    EXPECT_EQ(info.size, 3u);
+    EXPECT_EQ(info.missCount, 3u);
+
+    EXPECT_SUCCESS(BLFont::setShapingCacheCapacity(0));
+    EXPECT_SUCCESS(BLFont::getShapingCacheInfo(info));
+    EXPECT_EQ(info.capacity, 0u);
+    EXPECT_EQ(info.size, 0u);
+  }
+
+  INFO("Testing batch shaping and text metrics");
+  {
+    BLFont font;
+    EXPECT_SUCCESS(font.createFromFace(fontFace, 20.0f));
+
+    static const char* const words[] = { "Hello", "World!", "AVAST", "Wavy", "Typography", "", "To", "fi" };
+
+    // Large enough to be distributed across multiple threads.
+    constexpr size_t kItemCount = 500;
+
+    BLString texts[kItemCount];
+    BLTextBatchItem items[kItemCount] {};
+
+    for (size_t i = 0; i < kItemCount; i++) {
+      for (size_t j = 0; j <= i % 5u; j++) {
+        EXPECT_SUCCESS(texts[i].append(words[(i + j * 3u) % BL_ARRAY_SIZE(words)]));
+        EXPECT_SUCCESS(texts[i].append(' '));
+      }
+
+      items[i].text = texts[i].data();
+      items[i].size = texts[i].size();
+      items[i].encoding = BL_TEXT_ENCODING_UTF8;
+    }
+
+    BLArray<uint8_t> glyphStorage;
+    EXPECT_SUCCESS(font.shapeBatch(items, kItemCount, glyphStorage));
+
+    for (size_t i = 0; i < kItemCount; i++) {
+      BLGlyphBuffer gb;
+      BLTextMetrics tm;
+
+      EXPECT_SUCCESS(gb.setUtf8Text(texts[i].data(), texts[i].size()));
+      EXPECT_SUCCESS(font.getTextMetrics(gb, tm));
+
+      const BLTextBatchItem& item = items[i];
+      EXPECT_SUCCESS(item.result);
+      EXPECT_EQ(item.glyphRun.size, gb.size());
+      EXPECT_EQ(memcmp(item.glyphRun.glyphData, gb.content(), gb.size() * sizeof(uint32_t)), 0);
+      EXPECT_EQ(memcmp(item.glyphRun.placementData, gb.placementData(), gb.size() * sizeof(BLGlyphPlacement)), 0);
+      EXPECT_EQ(memcmp(&item.metrics, &tm, sizeof(BLTextMetrics)), 0);
+    }
+
+    EXPECT_SUCCESS(font.getTextMetricsBatch(items, kItemCount));
+    for (size_t i = 0; i < kItemCount; i++) {
+      EXPECT_SUCCESS(items[i].result);
+      EXPECT_TRUE(items[i].glyphRun.empty());
+    }
   }
 }
 
@@ -450,6 +450,32 @@ struct BLGlyphMappingState {
 #endif
 };
 
+//! Font shaping cache information, see `BLFont::getShapingCacheInfo()`.
+struct BLFontShapingCacheInfo {
+  //! \name Members
+  //! \{
+
+  //! Maximum number of cached text runs (0 if the cache is disabled).
+  size_t capacity;
+  //! Number of text runs currently cached.
+  size_t size;
+  //! Number of shaping requests served from the cache.
+  uint64_t hitCount;
+  //! Number of shaping requests that had to shape the text.
+  uint64_t missCount;
+
+  //! \}
+
+#ifdef __cplusplus
+  //! \name Common Functionality
+  //! \{
+
+  BL_INLINE_NODEBUG void reset() noexcept { *this = BLFontShapingCacheInfo{}; }
+
+  //! \}
+#endif
+};
+
 //! Information passed to a `BLPathSinkFunc` sink by `BLFont::getGlyphOutlines()`.
 struct BLGlyphOutlineSinkInfo {
   size_t glyphIndex;
@@ -58,6 +58,7 @@ static BLResult BL_CDECL blNullFontFaceGetGlyphBounds(
 
 static BLResult BL_CDECL blNullFontFaceGetGlyphAdvances(
   const BLFontFaceImpl* impl,
+  const bl::FontVarInstance* varInstance,
   const uint32_t* glyphData,
   intptr_t glyphAdvance,
   BLGlyphPlacement* placementData,
@@ -68,6 +69,7 @@ static BLResult BL_CDECL blNullFontFaceGetGlyphAdvances(
 
 static BLResult BL_CDECL blNullFontFaceGetGlyphOutlines(
   const BLFontFaceImpl* impl,
+  const bl::FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* userTransform,
   BLPath* out,
@@ -78,6 +80,15 @@ static BLResult BL_CDECL blNullFontFaceGetGlyphOutlines(
   return blTraceError(BL_ERROR_FONT_NOT_INITIALIZED);
 }
 
+static BLResult BL_CDECL blNullFontFaceCreateVarInstance(
+  const BLFontFaceImpl* impl,
+  const BLFontVariationSettingsCore* variationSettings,
+  bl::FontVarInstance** out) noexcept {
+
+  *out = nullptr;
+  return BL_SUCCESS;
+}
+
 static BLResult BL_CDECL blNullFontFaceApplyKern(
   const BLFontFaceImpl* faceI,
   uint32_t* glyphData,
@@ -370,6 +381,7 @@ void blFontFaceRtInit(BLRuntimeContext* rt) noexcept {
   blNullFontFaceFuncs.getGlyphBounds = blNullFontFaceGetGlyphBounds;
   blNullFontFaceFuncs.getGlyphAdvances = blNullFontFaceGetGlyphAdvances;
   blNullFontFaceFuncs.getGlyphOutlines = blNullFontFaceGetGlyphOutlines;
+  blNullFontFaceFuncs.createVarInstance = blNullFontFaceCreateVarInstance;
   blNullFontFaceFuncs.applyKern = blNullFontFaceApplyKern;
   blNullFontFaceFuncs.applyGSub = blNullFontFaceApplyGSub;
   blNullFontFaceFuncs.applyGPos = blNullFontFaceApplyGPos;
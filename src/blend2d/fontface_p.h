@@ -23,6 +23,28 @@ namespace OpenType {
 struct OTFaceImpl;
 
 } // {OpenType}
+
+//! Font variation instance.
+//!
+//! Holds data calculated from font variation settings that are required to vary glyph outlines and metrics. The
+//! content of the instance is provided by the font face implementation - the base only provides reference counting
+//! and the instance must be allocated as a single memory block by `malloc()` so it can be released without knowing
+//! the implementation.
+struct FontVarInstance {
+  size_t refCount;
+};
+
+static BL_INLINE FontVarInstance* retainVarInstance(FontVarInstance* instance) noexcept {
+  if (instance)
+    blAtomicFetchAddRelaxed(&instance->refCount);
+  return instance;
+}
+
+static BL_INLINE void releaseVarInstance(FontVarInstance* instance) noexcept {
+  if (instance && blAtomicFetchSubStrong(&instance->refCount) == 1)
+    free(instance);
+}
+
 } // {bl}
 
 //! \addtogroup blend2d_internal
@@ -47,6 +69,7 @@ struct BLFontFacePrivateFuncs {
 
   BLResult (BL_CDECL* getGlyphAdvances)(
     const BLFontFaceImpl* impl,
+    const bl::FontVarInstance* varInstance,
     const uint32_t* glyphData,
     intptr_t glyphAdvance,
     BLGlyphPlacement* placementData,
@@ -54,12 +77,20 @@ struct BLFontFacePrivateFuncs {
 
   BLResult (BL_CDECL* getGlyphOutlines)(
     const BLFontFaceImpl* impl,
+    const bl::FontVarInstance* varInstance,
     BLGlyphId glyphId,
     const BLMatrix2D* userTransform,
     BLPath* out,
     size_t* contourCountOut,
     bl::ScopedBuffer* tmpBuffer) BL_NOEXCEPT;
 
+  //! Creates a variation instance from `variationSettings`, or sets `out` to null if the settings select the
+  //! default instance of the face (or if the face is not variable).
+  BLResult (BL_CDECL* createVarInstance)(
+    const BLFontFaceImpl* impl,
+    const BLFontVariationSettingsCore* variationSettings,
+    bl::FontVarInstance** out) BL_NOEXCEPT;
+
   BLResult (BL_CDECL* applyKern)(
     const BLFontFaceImpl* faceI,
     uint32_t* glyphData,
@@ -4,14 +4,20 @@
 // SPDX-License-Identifier: Zlib
 
 #include "api-build_p.h"
-#include "filesystem.h"
+#include "filesystem_p.h"
 #include "font_p.h"
+#include "fontdata.h"
 #include "fontface_p.h"
 #include "fontmanager_p.h"
 #include "object_p.h"
 #include "runtime_p.h"
 #include "string_p.h"
+#include "support/algorithm_p.h"
 #include "support/hashops_p.h"
+#include "support/memops_p.h"
+#include "support/scopedbuffer_p.h"
+#include "support/stringops_p.h"
+#include "unicode/unicode_p.h"
 
 namespace bl {
 namespace FontManagerInternal {
@@ -36,6 +42,12 @@ enum QueryPrecedenceBits : uint32_t {
 
 static constexpr uint32_t kQueryInvalidDiff = 0xFFFFFFFFu;
 
+//! Read flags used to load font files registered by `addDirectory()`.
+static constexpr BLFileReadFlags kLazyFaceReadFlags = BLFileReadFlags(BL_FILE_READ_MMAP_ENABLED | BL_FILE_READ_MMAP_AVOID_SMALL);
+
+typedef BLFontManagerPrivateImpl::FamiliesMapNode FamiliesMapNode;
+typedef BLFontManagerPrivateImpl::LazyFace LazyFace;
+
 // bl::FontManager - Internals - Alloc & Free Impl
 // ===============================================
 
@@ -88,6 +100,428 @@ static BL_INLINE size_t indexForInsertion(const BLFontFace* array, size_t size,
   return i;
 }
 
+static BL_INLINE bool hasLoadedLazyFace(const LazyFace* lazyFace, BLFontFaceImpl* faceI) noexcept {
+  while (lazyFace) {
+    if (lazyFace->face._d.impl == faceI)
+      return true;
+    lazyFace = lazyFace->next;
+  }
+  return false;
+}
+
+// Loads a face registered by `addDirectory()` if it was not loaded yet. The file is read without holding the lock so
+// other queries are not blocked by IO. If two threads load the same face concurrently the first stored face wins.
+static BLResult loadLazyFace(BLFontManagerPrivateImpl* impl, LazyFace* lazyFace) noexcept {
+  {
+    BLSharedLockGuard<BLSharedMutex> guard(impl->mutex);
+    if (lazyFace->face.isValid())
+      return BL_SUCCESS;
+  }
+
+  BLFontData fontData;
+  BLFontFace face;
+
+  BL_PROPAGATE(fontData.createFromFile(lazyFace->fileName.data(), kLazyFaceReadFlags));
+  BL_PROPAGATE(face.createFromData(fontData, lazyFace->faceIndex));
+
+  BLLockGuard<BLSharedMutex> guard(impl->mutex);
+  if (!lazyFace->face.isValid())
+    lazyFace->face = face;
+  return BL_SUCCESS;
+}
+
+// bl::FontManager - Directory Index
+// =================================
+
+// Layout of the index file - all values are stored in native byte order, which is verified by the magic number:
+//
+//   Header:
+//     [u32 magic] [u32 version] [u32 fileCount]
+//
+//   File record (repeated `fileCount` times):
+//     [u32 nameSize] [u8 name[nameSize]] [u64 fileSize] [i64 modifiedTime] [u32 faceCount] [u32 faceDataSize]
+//
+//   Face record (repeated `faceCount` times, `faceDataSize` bytes in total):
+//     [u32 faceIndex] [u16 weight] [u8 style] [u8 stretch] [u32 familyNameSize] [u8 familyName[familyNameSize]]
+//     [u32 runCount] {[u32 startWord] [u32 wordCount] [u32 words[wordCount]]}[runCount]
+//
+// Coverage is stored as runs of consecutive non-zero words of the character coverage BitSet. Runs are sorted, don't
+// overlap, and only cover Unicode code-points - index records that don't follow these rules are treated as invalid.
+
+static constexpr uint32_t kIndexMagic = BL_MAKE_TAG('B', 'L', 'F', 'I');
+static constexpr uint32_t kIndexVersion = 1;
+static constexpr size_t kIndexHeaderSize = 12;
+static constexpr size_t kIndexFileRecordFixedSize = 28;
+static constexpr uint32_t kIndexCoverageWordCount = (Unicode::kCharMax + 1u) / 32u;
+
+//! File record of a directory index.
+struct IndexFileRecord {
+  BLStringView name;
+  uint64_t fileSize;
+  int64_t modifiedTime;
+  uint32_t faceCount;
+  //! Whole record data (used to copy the record to a new index verbatim).
+  const uint8_t* data;
+  size_t size;
+  //! Face records.
+  const uint8_t* faceData;
+  size_t faceDataSize;
+};
+
+//! Face record of a directory index.
+struct IndexFaceRecord {
+  uint32_t faceIndex;
+  uint32_t style;
+  uint32_t weight;
+  uint32_t stretch;
+  BLStringView familyName;
+  const uint8_t* coverageData;
+  uint32_t coverageRunCount;
+};
+
+class IndexReader {
+public:
+  const uint8_t* _ptr;
+  const uint8_t* _end;
+
+  BL_INLINE IndexReader(const uint8_t* data, size_t size) noexcept
+    : _ptr(data),
+      _end(data + size) {}
+
+  BL_INLINE const uint8_t* ptr() const noexcept { return _ptr; }
+  BL_INLINE size_t remainingSize() const noexcept { return (size_t)(_end - _ptr); }
+  BL_INLINE bool atEnd() const noexcept { return _ptr == _end; }
+
+  BL_INLINE bool skip(size_t n) noexcept {
+    if (remainingSize() < n)
+      return false;
+    _ptr += n;
+    return true;
+  }
+
+  BL_INLINE bool readU32(uint32_t* out) noexcept {
+    if (remainingSize() < 4u)
+      return false;
+    *out = MemOps::readU32u(_ptr);
+    _ptr += 4;
+    return true;
+  }
+
+  BL_INLINE bool readU64(uint64_t* out) noexcept {
+    if (remainingSize() < 8u)
+      return false;
+    *out = MemOps::readU64u(_ptr);
+    _ptr += 8;
+    return true;
+  }
+
+  BL_INLINE bool readString(BLStringView* out) noexcept {
+    uint32_t size;
+    if (!readU32(&size) || remainingSize() < size)
+      return false;
+    out->reset(reinterpret_cast<const char*>(_ptr), size);
+    _ptr += size;
+    return true;
+  }
+};
+
+static bool readIndexFileRecord(IndexReader& reader, IndexFileRecord* out) noexcept {
+  uint64_t modifiedTime;
+  uint32_t faceDataSize;
+
+  out->data = reader.ptr();
+  if (!reader.readString(&out->name) ||
+      !reader.readU64(&out->fileSize) ||
+      !reader.readU64(&modifiedTime) ||
+      !reader.readU32(&out->faceCount) ||
+      !reader.readU32(&faceDataSize))
+    return false;
+
+  out->modifiedTime = int64_t(modifiedTime);
+  out->faceData = reader.ptr();
+  out->faceDataSize = faceDataSize;
+
+  if (!reader.skip(faceDataSize))
+    return false;
+
+  out->size = (size_t)(reader.ptr() - out->data);
+  return true;
+}
+
+static bool readIndexFaceRecord(IndexReader& reader, IndexFaceRecord* out) noexcept {
+  uint32_t properties;
+
+  if (!reader.readU32(&out->faceIndex) ||
+      !reader.readU32(&properties) ||
+      !reader.readString(&out->familyName) ||
+      !reader.readU32(&out->coverageRunCount))
+    return false;
+
+  out->weight = properties & 0xFFFFu;
+  out->style = (properties >> 16) & 0xFFu;
+  out->stretch = properties >> 24;
+  out->coverageData = reader.ptr();
+
+  if (out->weight > 1000u || out->style > BL_FONT_STYLE_MAX_VALUE || out->stretch > BL_FONT_STRETCH_ULTRA_EXPANDED)
+    return false;
+
+  uint32_t nextWord = 0;
+  for (uint32_t i = 0; i < out->coverageRunCount; i++) {
+    uint32_t startWord;
+    uint32_t wordCount;
+
+    if (!reader.readU32(&startWord) || !reader.readU32(&wordCount) || wordCount > reader.remainingSize() / 4u)
+      return false;
+
+    if (!wordCount || startWord < nextWord || startWord >= kIndexCoverageWordCount || wordCount > kIndexCoverageWordCount - startWord)
+      return false;
+
+    nextWord = startWord + wordCount;
+    reader.skip(wordCount * 4u);
+  }
+
+  return true;
+}
+
+static bool validateIndexFaceRecords(const IndexFileRecord& record) noexcept {
+  IndexReader reader(record.faceData, record.faceDataSize);
+  IndexFaceRecord faceRecord;
+
+  for (uint32_t i = 0; i < record.faceCount; i++)
+    if (!readIndexFaceRecord(reader, &faceRecord))
+      return false;
+
+  return reader.atEnd();
+}
+
+static BL_INLINE int compareIndexNames(const BLStringView& a, const BLStringView& b) noexcept {
+  size_t minSize = blMin(a.size, b.size);
+  int c = minSize ? memcmp(a.data, b.data, minSize) : 0;
+  return c ? c : int(a.size > b.size) - int(a.size < b.size);
+}
+
+// Reads file records of an existing index to `recordsBuffer` sorted by name. An invalid index is treated as empty.
+static size_t readIndexFileRecords(const BLArray<uint8_t>& index, ScopedBuffer& recordsBuffer, IndexFileRecord** recordsOut) noexcept {
+  IndexReader reader(index.data(), index.size());
+
+  uint32_t magic;
+  uint32_t version;
+  uint32_t fileCount;
+
+  *recordsOut = nullptr;
+  if (!reader.readU32(&magic) || !reader.readU32(&version) || !reader.readU32(&fileCount))
+    return 0;
+
+  if (magic != kIndexMagic || version != kIndexVersion || fileCount > reader.remainingSize() / kIndexFileRecordFixedSize)
+    return 0;
+
+  IndexFileRecord* records = static_cast<IndexFileRecord*>(recordsBuffer.alloc(size_t(fileCount) * sizeof(IndexFileRecord)));
+  if (!records)
+    return 0;
+
+  for (uint32_t i = 0; i < fileCount; i++)
+    if (!readIndexFileRecord(reader, &records[i]))
+      return 0;
+
+  quickSort(records, fileCount, [](const IndexFileRecord& a, const IndexFileRecord& b) noexcept -> int {
+    return compareIndexNames(a.name, b.name);
+  });
+
+  *recordsOut = records;
+  return fileCount;
+}
+
+static const IndexFileRecord* findIndexFileRecord(const IndexFileRecord* records, size_t count, const BLStringView& name) noexcept {
+  size_t i = lowerBound(records, count, name, [](const IndexFileRecord& a, const BLStringView& b) noexcept -> bool {
+    return compareIndexNames(a.name, b) < 0;
+  });
+
+  if (i < count && compareIndexNames(records[i].name, name) == 0)
+    return &records[i];
+  return nullptr;
+}
+
+static BL_INLINE BLResult appendU32(BLArray<uint8_t>& dst, uint32_t value) noexcept {
+  return dst.appendData(reinterpret_cast<const uint8_t*>(&value), 4u);
+}
+
+static BL_INLINE BLResult appendU64(BLArray<uint8_t>& dst, uint64_t value) noexcept {
+  return dst.appendData(reinterpret_cast<const uint8_t*>(&value), 8u);
+}
+
+static BL_INLINE BLResult appendString(BLArray<uint8_t>& dst, const BLStringView& str) noexcept {
+  BL_PROPAGATE(appendU32(dst, uint32_t(str.size)));
+  return dst.appendData(reinterpret_cast<const uint8_t*>(str.data), str.size);
+}
+
+static BL_INLINE void patchU32(BLArray<uint8_t>& dst, size_t offset, uint32_t value) noexcept {
+  uint8_t* data;
+  if (dst.makeMutable(&data) == BL_SUCCESS)
+    MemOps::writeU32u(data + offset, value);
+}
+
+static BLResult appendIndexFaceRecord(BLArray<uint8_t>& dst, const BLFontFace& face, uint32_t faceIndex) noexcept {
+  const BLFontFacePrivateImpl* faceI = FontFaceInternal::getImpl(&face);
+
+  BLBitSet coverage;
+  BL_PROPAGATE(face.getCharacterCoverage(&coverage));
+
+  uint32_t properties = faceI->weight | (uint32_t(faceI->style) << 16) | (uint32_t(faceI->stretch) << 24);
+  BL_PROPAGATE(appendU32(dst, faceIndex));
+  BL_PROPAGATE(appendU32(dst, properties));
+  BL_PROPAGATE(appendString(dst, faceI->familyName.dcast().view()));
+
+  size_t runCountOffset = dst.size();
+  size_t wordCountOffset = 0;
+  uint32_t runCount = 0;
+  uint32_t wordCount = 0;
+  uint32_t nextWordIndex = 0;
+
+  BL_PROPAGATE(appendU32(dst, 0));
+
+  BLBitSetWordIterator it(coverage);
+  while (uint32_t bits = it.nextWord()) {
+    if (!wordCount || it.wordIndex() != nextWordIndex) {
+      if (wordCount)
+        patchU32(dst, wordCountOffset, wordCount);
+
+      BL_PROPAGATE(appendU32(dst, it.wordIndex()));
+      wordCountOffset = dst.size();
+      BL_PROPAGATE(appendU32(dst, 0));
+
+      runCount++;
+      wordCount = 0;
+    }
+
+    BL_PROPAGATE(appendU32(dst, bits));
+    nextWordIndex = it.wordIndex() + 1u;
+    wordCount++;
+  }
+
+  if (wordCount)
+    patchU32(dst, wordCountOffset, wordCount);
+
+  patchU32(dst, runCountOffset, runCount);
+  return BL_SUCCESS;
+}
+
+// Parses all faces of `fileName` and appends a complete file record to `dst`. Files that are not fonts are recorded
+// as well (having no faces) so they are not parsed again when the index is reused.
+static BLResult appendIndexFileRecord(BLArray<uint8_t>& dst, const char* fileName, const BLStringView& name, const BLFileInfo& info) noexcept {
+  BL_PROPAGATE(appendString(dst, name));
+  BL_PROPAGATE(appendU64(dst, info.size));
+  BL_PROPAGATE(appendU64(dst, uint64_t(info.modifiedTime)));
+
+  size_t faceCountOffset = dst.size();
+  uint32_t faceCount = 0;
+
+  BL_PROPAGATE(appendU32(dst, 0));
+  BL_PROPAGATE(appendU32(dst, 0));
+
+  BLFontData fontData;
+  if (fontData.createFromFile(fileName, kLazyFaceReadFlags) == BL_SUCCESS) {
+    uint32_t dataFaceCount = fontData.faceCount();
+    for (uint32_t faceIndex = 0; faceIndex < dataFaceCount; faceIndex++) {
+      BLFontFace face;
+      if (face.createFromData(fontData, faceIndex) != BL_SUCCESS)
+        continue;
+
+      BL_PROPAGATE(appendIndexFaceRecord(dst, face, faceIndex));
+      faceCount++;
+    }
+  }
+
+  patchU32(dst, faceCountOffset, faceCount);
+  patchU32(dst, faceCountOffset + 4u, uint32_t(dst.size() - faceCountOffset - 8u));
+  return BL_SUCCESS;
+}
+
+static bool isFontFileName(const BLString& name) noexcept {
+  static const char extensions[][5] = { ".ttf", ".otf", ".ttc", ".otc" };
+
+  if (name.size() < 5)
+    return false;
+
+  const char* ext = name.data() + name.size() - 4;
+  for (const char* candidate : extensions) {
+    uint32_t i = 0;
+    while (i < 4 && Unicode::asciiToLower(uint8_t(ext[i])) == uint8_t(candidate[i]))
+      i++;
+    if (i == 4)
+      return true;
+  }
+
+  return false;
+}
+
+// Registers faces of a single file record. Must be called with exclusive lock held.
+static BLResult registerIndexFileRecord(BLFontManagerPrivateImpl* impl, const IndexFileRecord& record, const BLString& fileName) noexcept {
+  IndexReader reader(record.faceData, record.faceDataSize);
+  IndexFaceRecord faceRecord;
+
+  for (uint32_t i = 0; i < record.faceCount; i++) {
+    if (!readIndexFaceRecord(reader, &faceRecord))
+      break;
+
+    uint32_t nameHash = HashOps::hashStringCI(faceRecord.familyName);
+    FamiliesMapNode* familiesNode = impl->familiesMap.get(BLFontManagerPrivateImpl::FamilyMatcher{faceRecord.familyName, nameHash});
+
+    if (!familiesNode) {
+      BLString familyName;
+      BL_PROPAGATE(familyName.assign(faceRecord.familyName));
+
+      familiesNode = impl->allocator.newT<FamiliesMapNode>(nameHash, familyName);
+      if (!familiesNode)
+        return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+      impl->familiesMap.insert(familiesNode);
+    }
+    else {
+      // Don't register the same face twice if the directory is added again.
+      LazyFace* existing = familiesNode->lazyFaces;
+      while (existing && !(existing->faceIndex == faceRecord.faceIndex && existing->fileName.equals(fileName)))
+        existing = existing->next;
+
+      if (existing)
+        continue;
+    }
+
+    LazyFace* lazyFace = impl->allocator.newT<LazyFace>(fileName, faceRecord.faceIndex, faceRecord.style, faceRecord.weight, faceRecord.stretch);
+    if (!lazyFace)
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+    const uint8_t* p = faceRecord.coverageData;
+    for (uint32_t run = 0; run < faceRecord.coverageRunCount; run++) {
+      uint32_t startWord = MemOps::readU32u(p + 0);
+      uint32_t wordCount = MemOps::readU32u(p + 4);
+      p += 8;
+
+      // Words are not necessarily aligned in the index, thus copy them in small batches.
+      uint32_t words[64];
+      while (wordCount) {
+        uint32_t n = blMin<uint32_t>(wordCount, 64u);
+        for (uint32_t j = 0; j < n; j++)
+          words[j] = MemOps::readU32u(p + j * 4u);
+
+        BLResult result = lazyFace->coverage.addWords(startWord, words, n);
+        if (BL_UNLIKELY(result != BL_SUCCESS)) {
+          blCallDtor(*lazyFace);
+          return result;
+        }
+
+        p += n * 4u;
+        startWord += n;
+        wordCount -= n;
+      }
+    }
+
+    lazyFace->next = familiesNode->lazyFaces;
+    familiesNode->lazyFaces = lazyFace;
+    impl->faceCount++;
+  }
+
+  return BL_SUCCESS;
+}
+
 // bl::FontManager - Query - Utilities
 // ===================================
 
@@ -168,13 +602,9 @@ static BL_INLINE uint32_t calcFamilyNameDiff(BLStringView aStr, BLStringView bSt
   return diff << kQueryDiffFamilyNameShift;
 }
 
-static BL_INLINE uint32_t calcPropertyDiff(const BLFontFaceImpl* faceI, const BLFontQueryProperties* properties) noexcept {
+static BL_INLINE uint32_t calcPropertyDiff(uint32_t fStyle, uint32_t fWeight, uint32_t fStretch, const BLFontQueryProperties* properties) noexcept {
   uint32_t diff = 0;
 
-  uint32_t fStyle = faceI->style;
-  uint32_t fWeight = faceI->weight;
-  uint32_t fStretch = faceI->stretch;
-
   uint32_t pStyle = properties->style;
   uint32_t pWeight = properties->weight;
   uint32_t pStretch = properties->stretch;
@@ -202,24 +632,293 @@ class QueryBestMatch {
 public:
   const BLFontQueryProperties* properties;
   const BLFontFace* face;
+  LazyFace* lazyFace;
   uint32_t diff;
 
   BL_INLINE QueryBestMatch(const BLFontQueryProperties* properties) noexcept
     : properties(properties),
       face(nullptr),
+      lazyFace(nullptr),
       diff(0xFFFFFFFFu) {}
 
-  BL_INLINE bool hasFace() const noexcept { return face != nullptr; }
+  BL_INLINE bool hasFace() const noexcept { return face != nullptr || lazyFace != nullptr; }
 
   void match(const BLFontFace& faceIn, uint32_t baseDiff = 0) noexcept {
-    uint32_t localDiff = baseDiff + calcPropertyDiff(faceIn._impl(), properties);
+    const BLFontFaceImpl* faceI = faceIn._impl();
+    uint32_t localDiff = baseDiff + calcPropertyDiff(faceI->style, faceI->weight, faceI->stretch, properties);
     if (diff > localDiff) {
       face = &faceIn;
+      lazyFace = nullptr;
       diff = localDiff;
     }
   }
+
+  void match(LazyFace* lazyFaceIn, uint32_t baseDiff = 0) noexcept {
+    uint32_t localDiff = baseDiff + calcPropertyDiff(lazyFaceIn->style, lazyFaceIn->weight, lazyFaceIn->stretch, properties);
+    if (diff > localDiff) {
+      face = nullptr;
+      lazyFace = lazyFaceIn;
+      diff = localDiff;
+    }
+  }
+};
+
+// bl::FontManager - Fallback - Resolver
+// =====================================
+
+//! Maximum number of faces that can participate in a single fallback query.
+static constexpr uint32_t kFallbackCandidateCapacity = 64;
+static constexpr uint32_t kFallbackNoCandidate = 0xFFFFFFFFu;
+
+//! A face that participates in a fallback query.
+//!
+//! Only the character coverage is needed to itemize the text, thus faces registered by `addDirectory()` are not
+//! loaded until the very end of the query and only if they are used by a run.
+struct FallbackCandidate {
+  //! Face, which is default constructed if it's a lazy face that was not loaded yet.
+  BLFontFace face;
+  //! Lazy face or null if `face` was added by `addFace()`.
+  LazyFace* lazyFace;
+  //! Character coverage of the face.
+  BLBitSet coverage;
+  //! Index of the face in the output array or `kFallbackNoCandidate` if it was not used by any run yet.
+  uint32_t outputIndex;
+};
+
+class FallbackResolver {
+public:
+  BLFontManagerPrivateImpl* impl;
+  const BLFontQueryProperties* properties;
+
+  //! Number of candidates.
+  uint32_t candidateCount;
+  //! Number of faces used by runs.
+  uint32_t outputCount;
+  //! Characters that are known to not be covered by any face of the font manager.
+  BLBitSet uncovered;
+  //! Candidates - faces of the fallback chain first, then faces found by searching all families.
+  FallbackCandidate candidates[kFallbackCandidateCapacity];
+
+  BL_INLINE FallbackResolver(BLFontManagerPrivateImpl* impl, const BLFontQueryProperties* properties) noexcept
+    : impl(impl),
+      properties(properties),
+      candidateCount(0),
+      outputCount(0) {}
+
+  // Adds the best face of a family matched by `bestMatch`. Must be called with the lock held.
+  bool addCandidate(const QueryBestMatch& bestMatch) noexcept {
+    if (!bestMatch.hasFace() || candidateCount >= kFallbackCandidateCapacity)
+      return false;
+
+    const BLFontFace* face = bestMatch.face;
+    LazyFace* lazyFace = bestMatch.lazyFace;
+
+    if (lazyFace && lazyFace->face.isValid())
+      face = &lazyFace->face;
+
+    for (uint32_t i = 0; i < candidateCount; i++) {
+      const FallbackCandidate& candidate = candidates[i];
+      if (lazyFace ? candidate.lazyFace == lazyFace : candidate.face._d.impl == face->_d.impl)
+        return false;
+    }
+
+    FallbackCandidate& candidate = candidates[candidateCount];
+    candidate.lazyFace = lazyFace;
+    candidate.outputIndex = kFallbackNoCandidate;
+
+    if (face) {
+      candidate.face = *face;
+      // A face that doesn't provide character coverage can still be used as a primary face.
+      if (candidate.face.getCharacterCoverage(&candidate.coverage) != BL_SUCCESS)
+        candidate.coverage.reset();
+    }
+    else {
+      candidate.coverage = lazyFace->coverage;
+    }
+
+    candidateCount++;
+    return true;
+  }
+
+  // Adds all families of a comma separated list `names` to the fallback chain.
+  void addFamilies(const char* names, size_t namesSize) noexcept {
+    BLSharedLockGuard<BLSharedMutex> guard(impl->mutex);
+
+    size_t i = 0;
+    while (i < namesSize) {
+      size_t start = i;
+      while (i < namesSize && names[i] != ',')
+        i++;
+
+      size_t end = i++;
+      while (start < end && (names[start] == ' ' || names[start] == '\t'))
+        start++;
+      while (end > start && (names[end - 1] == ' ' || names[end - 1] == '\t'))
+        end--;
+
+      PreparedQuery query;
+      if (!prepareQuery(impl, names + start, end - start, &query))
+        continue;
+
+      QueryBestMatch bestMatch(properties);
+      FamiliesMapNode* node = impl->familiesMap.nodesByHashCode(query.hashCode());
+
+      while (node) {
+        uint32_t familyDiff = calcFamilyNameDiff(node->familyName.view(), query.name());
+        if (familyDiff != kQueryInvalidDiff)
+          matchFamily(bestMatch, node, familyDiff);
+        node = node->next();
+      }
+
+      addCandidate(bestMatch);
+    }
+  }
+
+  static BL_INLINE void matchFamily(QueryBestMatch& bestMatch, FamiliesMapNode* node, uint32_t familyDiff) noexcept {
+    for (const BLFontFace& face : node->faces.dcast<BLArray<BLFontFace>>())
+      bestMatch.match(face, familyDiff);
+
+    for (LazyFace* lazyFace = node->lazyFaces; lazyFace; lazyFace = lazyFace->next)
+      bestMatch.match(lazyFace, familyDiff);
+  }
+
+  static BL_INLINE bool isNeutralChar(uint32_t uc) noexcept {
+    return uc == 0x20u || uc == 0x09u || uc == 0xA0u ||
+           (uc >= 0x200Bu && uc <= 0x200Du) ||         // Zero width space, non-joiner, and joiner.
+           (uc >= 0xFE00u && uc <= 0xFE0Fu) ||         // Variation selectors.
+           (uc >= 0xE0100u && uc <= 0xE01EFu);         // Variation selectors supplement.
+  }
+
+  static BL_INLINE bool faceCoversChar(const BLFontFace& face, uint32_t uc) noexcept {
+    BLBitSet coverage;
+    return face.getCharacterCoverage(&coverage) == BL_SUCCESS && coverage.hasBit(uc);
+  }
+
+  // Searches faces of all families for the best match of the query properties that covers `uc` and adds it as a
+  // candidate. Faces that match equally well are ordered by family name so the result doesn't depend on the order
+  // of families in the hash map.
+  uint32_t searchAllFamilies(uint32_t uc) noexcept {
+    if (candidateCount >= kFallbackCandidateCapacity || uncovered.hasBit(uc))
+      return kFallbackNoCandidate;
+
+    {
+      BLSharedLockGuard<BLSharedMutex> guard(impl->mutex);
+
+      QueryBestMatch found(properties);
+      const FamiliesMapNode* foundNode = nullptr;
+
+      auto isBetterMatch = [&](uint32_t diff, const FamiliesMapNode* node) noexcept {
+        if (diff != found.diff)
+          return diff < found.diff;
+        return foundNode && foundNode != node && node->familyName.compare(foundNode->familyName) < 0;
+      };
+
+      impl->familiesMap.forEach([&](FamiliesMapNode* node) noexcept {
+        for (const BLFontFace& face : node->faces.dcast<BLArray<BLFontFace>>()) {
+          const BLFontFaceImpl* faceI = face._impl();
+          uint32_t diff = calcPropertyDiff(faceI->style, faceI->weight, faceI->stretch, properties);
+
+          if (isBetterMatch(diff, node) && faceCoversChar(face, uc)) {
+            found.face = &face;
+            found.lazyFace = nullptr;
+            found.diff = diff;
+            foundNode = node;
+          }
+        }
+
+        for (LazyFace* lazyFace = node->lazyFaces; lazyFace; lazyFace = lazyFace->next) {
+          uint32_t diff = calcPropertyDiff(lazyFace->style, lazyFace->weight, lazyFace->stretch, properties);
+
+          if (isBetterMatch(diff, node) && lazyFace->coverage.hasBit(uc)) {
+            found.face = nullptr;
+            found.lazyFace = lazyFace;
+            found.diff = diff;
+            foundNode = node;
+          }
+        }
+      });
+
+      if (addCandidate(found) && candidates[candidateCount - 1].coverage.hasBit(uc))
+        return candidateCount - 1;
+    }
+
+    uncovered.addBit(uc);
+    return kFallbackNoCandidate;
+  }
+
+  // Returns an index of the first candidate that covers `uc` - the primary face (index 0) is used if no face covers it.
+  BL_INLINE uint32_t resolve(uint32_t uc) noexcept {
+    for (uint32_t i = 0; i < candidateCount; i++)
+      if (candidates[i].coverage.hasBit(uc))
+        return i;
+
+    uint32_t index = searchAllFamilies(uc);
+    return index != kFallbackNoCandidate ? index : 0u;
+  }
+
+  BL_INLINE uint32_t outputIndexOf(uint32_t candidateIndex) noexcept {
+    FallbackCandidate& candidate = candidates[candidateIndex];
+    if (candidate.outputIndex == kFallbackNoCandidate)
+      candidate.outputIndex = outputCount++;
+    return candidate.outputIndex;
+  }
 };
 
+//! Reader of LATIN1 text, which provides the same interface as readers in `bl::Unicode` namespace.
+class Latin1Reader {
+public:
+  const uint8_t* _ptr;
+  const uint8_t* _end;
+
+  BL_INLINE Latin1Reader(const void* data, size_t byteSize) noexcept
+    : _ptr(static_cast<const uint8_t*>(data)),
+      _end(static_cast<const uint8_t*>(data) + byteSize) {}
+
+  BL_INLINE bool hasNext() const noexcept { return _ptr != _end; }
+  BL_INLINE size_t nativeIndex(const void* start) const noexcept { return (size_t)(_ptr - static_cast<const uint8_t*>(start)); }
+  BL_INLINE void skipOneUnit() noexcept { _ptr++; }
+
+  BL_INLINE BLResult next(uint32_t& uc) noexcept {
+    uc = *_ptr++;
+    return BL_SUCCESS;
+  }
+};
+
+template<typename Reader>
+static BLResult itemizeFallbackRuns(FallbackResolver& resolver, const void* text, size_t byteSize, BLArray<BLFontFallbackRun>& runs) noexcept {
+  Reader reader(text, byteSize);
+
+  uint32_t runStart = 0;
+  uint32_t runCandidate = kFallbackNoCandidate;
+
+  while (reader.hasNext()) {
+    uint32_t index = uint32_t(reader.nativeIndex(text));
+    uint32_t uc;
+
+    if (BL_UNLIKELY(reader.next(uc) != BL_SUCCESS)) {
+      uc = Unicode::kCharReplacement;
+      reader.skipOneUnit();
+    }
+
+    uint32_t candidateIndex = runCandidate;
+    if (runCandidate == kFallbackNoCandidate || !FallbackResolver::isNeutralChar(uc))
+      candidateIndex = resolver.resolve(uc);
+
+    if (candidateIndex != runCandidate) {
+      if (runCandidate != kFallbackNoCandidate)
+        BL_PROPAGATE(runs.append(BLFontFallbackRun{runStart, index, resolver.outputIndexOf(runCandidate), 0u}));
+
+      runStart = index;
+      runCandidate = candidateIndex;
+    }
+  }
+
+  if (runCandidate != kFallbackNoCandidate)
+    BL_PROPAGATE(runs.append(BLFontFallbackRun{runStart, uint32_t(reader.nativeIndex(text)), resolver.outputIndexOf(runCandidate), 0u}));
+
+  return BL_SUCCESS;
+}
+
 } // {FontManagerInternal}
 } // {bl}
 
@@ -370,7 +1069,7 @@ BL_API_IMPL bool blFontManagerHasFace(const BLFontManagerCore* self, const BLFon
     return false;
 
   size_t index = indexOfFace(familiesNode->faces.data(), familiesNode->faces.size(), faceI);
-  return index != SIZE_MAX;
+  return index != SIZE_MAX || hasLoadedLazyFace(familiesNode->lazyFaces, faceI);
 }
 
 BL_API_IMPL BLResult blFontManagerAddFace(BLFontManagerCore* self, const BLFontFaceCore* face) noexcept {
@@ -423,6 +1122,87 @@ BL_API_IMPL BLResult blFontManagerAddFace(BLFontManagerCore* self, const BLFontF
   return BL_SUCCESS;
 }
 
+BL_API_IMPL BLResult blFontManagerAddDirectory(BLFontManagerCore* self, const char* dirName, const char* indexFileName) noexcept {
+  using namespace bl::FontManagerInternal;
+  BL_ASSERT(self->_d.isFontManager());
+
+  BLArray<BLString> entries;
+  BL_PROPAGATE(bl::FileSystem::readDirectory(dirName, entries));
+  BL_PROPAGATE(blFontManagerMakeMutable(self));
+
+  BLFontManagerPrivateImpl* selfI = getImpl(self);
+
+  // A missing or invalid index is not an error - it's created from scratch in that case.
+  BLArray<uint8_t> oldIndex;
+  bl::ScopedBuffer oldRecordsBuffer;
+  IndexFileRecord* oldRecords = nullptr;
+  size_t oldRecordCount = 0;
+
+  if (indexFileName && BLFileSystem::readFile(indexFileName, oldIndex) == BL_SUCCESS)
+    oldRecordCount = readIndexFileRecords(oldIndex, oldRecordsBuffer, &oldRecords);
+
+  // The new index is always built as it's also the input of face registration. Unchanged records of the old index are
+  // copied verbatim, other font files are parsed.
+  BLArray<uint8_t> newIndex;
+  BL_PROPAGATE(appendU32(newIndex, kIndexMagic));
+  BL_PROPAGATE(appendU32(newIndex, kIndexVersion));
+  BL_PROPAGATE(appendU32(newIndex, 0));
+
+  BLString dirPrefix;
+  BL_PROPAGATE(dirPrefix.assign(dirName));
+  if (!dirPrefix.empty() && dirPrefix.data()[dirPrefix.size() - 1] != '/' && dirPrefix.data()[dirPrefix.size() - 1] != '\\')
+    BL_PROPAGATE(dirPrefix.append('/'));
+
+  uint32_t fileCount = 0;
+  for (const BLString& entry : entries) {
+    if (!isFontFileName(entry))
+      continue;
+
+    BLString fileName;
+    BL_PROPAGATE(fileName.assign(dirPrefix));
+    BL_PROPAGATE(fileName.append(entry));
+
+    BLFileInfo info;
+    if (BLFileSystem::fileInfo(fileName.data(), &info) != BL_SUCCESS || !(info.flags & BL_FILE_INFO_REGULAR))
+      continue;
+
+    const IndexFileRecord* record = findIndexFileRecord(oldRecords, oldRecordCount, entry.view());
+    if (record && record->fileSize == info.size && record->modifiedTime == info.modifiedTime && validateIndexFaceRecords(*record))
+      BL_PROPAGATE(newIndex.appendData(record->data, record->size));
+    else
+      BL_PROPAGATE(appendIndexFileRecord(newIndex, fileName.data(), entry.view(), info));
+
+    fileCount++;
+  }
+  patchU32(newIndex, 8u, fileCount);
+
+  // Register faces described by the new index.
+  {
+    IndexReader reader(newIndex.data(), newIndex.size());
+    reader.skip(kIndexHeaderSize);
+
+    BLLockGuard<BLSharedMutex> guard(selfI->mutex);
+    for (uint32_t i = 0; i < fileCount; i++) {
+      IndexFileRecord record;
+      if (!readIndexFileRecord(reader, &record))
+        break;
+
+      if (!record.faceCount)
+        continue;
+
+      BLString fileName;
+      BL_PROPAGATE(fileName.assign(dirPrefix));
+      BL_PROPAGATE(fileName.append(record.name));
+      BL_PROPAGATE(registerIndexFileRecord(selfI, record, fileName));
+    }
+  }
+
+  if (indexFileName && !newIndex.equals(oldIndex))
+    BL_PROPAGATE(BLFileSystem::writeFile(indexFileName, newIndex.data(), newIndex.size()));
+
+  return BL_SUCCESS;
+}
+
 // bl::FontManager - Query - API
 // =============================
 
@@ -433,13 +1213,15 @@ BL_API_IMPL BLResult blFontManagerQueryFacesByFamilyName(const BLFontManagerCore
   if (BL_UNLIKELY(out->_d.rawType() != BL_OBJECT_TYPE_ARRAY_OBJECT))
     return blTraceError(BL_ERROR_INVALID_VALUE);
 
+  BLFontManagerPrivateImpl* selfI = getImpl(self);
+  BLFontManagerPrivateImpl::FamiliesMapNode* candidate = nullptr;
+  LazyFace* lazyFaces = nullptr;
+
   {
-    BLFontManagerPrivateImpl* selfI = getImpl(self);
     BLSharedLockGuard<BLSharedMutex> guard(selfI->mutex);
 
     PreparedQuery query;
     uint32_t candidateDiff = 0xFFFFFFFF;
-    BLFontManagerPrivateImpl::FamiliesMapNode* candidate = nullptr;
 
     if (prepareQuery(selfI, name, nameSize, &query)) {
       BLFontManagerPrivateImpl::FamiliesMapNode* node = selfI->familiesMap.get(query);
@@ -453,8 +1235,37 @@ BL_API_IMPL BLResult blFontManagerQueryFacesByFamilyName(const BLFontManagerCore
       }
     }
 
-    if (candidate)
-      return out->dcast<BLArray<BLFontFace>>().assign(candidate->faces);
+    if (candidate) {
+      lazyFaces = candidate->lazyFaces;
+      if (!lazyFaces)
+        return out->dcast<BLArray<BLFontFace>>().assign(candidate->faces);
+    }
+  }
+
+  if (candidate) {
+    // Faces registered by `addDirectory()` must be loaded first. Faces that cannot be loaded are not reported.
+    for (LazyFace* lazyFace = lazyFaces; lazyFace; lazyFace = lazyFace->next)
+      loadLazyFace(selfI, lazyFace);
+
+    BLArray<BLFontFace> faces;
+    {
+      BLSharedLockGuard<BLSharedMutex> guard(selfI->mutex);
+      BL_PROPAGATE(faces.assign(candidate->faces));
+
+      for (LazyFace* lazyFace = lazyFaces; lazyFace; lazyFace = lazyFace->next) {
+        if (!lazyFace->face.isValid())
+          continue;
+
+        uint32_t faceOrder = calcFaceOrder(lazyFace->face._impl());
+        size_t index = 0;
+        while (index < faces.size() && calcFaceOrder(faces[index]._impl()) <= faceOrder)
+          index++;
+        BL_PROPAGATE(faces.insert(index, lazyFace->face));
+      }
+    }
+
+    if (!faces.empty())
+      return out->dcast<BLArray<BLFontFace>>().assign(BLInternal::move(faces));
   }
 
   // This is not considered to be an error, thus don't use blTraceError().
@@ -478,8 +1289,10 @@ BL_API_IMPL BLResult blFontManagerQueryFace(
   if (!sanitizeQueryProperties(sanitizedProperties, *properties))
     return blTraceError(BL_ERROR_INVALID_VALUE);
 
+  BLFontManagerPrivateImpl* selfI = getImpl(self);
+  LazyFace* lazyFace = nullptr;
+
   {
-    BLFontManagerPrivateImpl* selfI = getImpl(self);
     BLSharedLockGuard<BLSharedMutex> guard(selfI->mutex);
 
     PreparedQuery query;
@@ -492,13 +1305,33 @@ BL_API_IMPL BLResult blFontManagerQueryFace(
         if (familyDiff != kQueryInvalidDiff) {
           for (const BLFontFace& face : node->faces.dcast<BLArray<BLFontFace>>())
             bestMatch.match(face, familyDiff);
+
+          for (LazyFace* nodeLazyFace = node->lazyFaces; nodeLazyFace; nodeLazyFace = nodeLazyFace->next)
+            bestMatch.match(nodeLazyFace, familyDiff);
         }
         node = node->next();
       }
     }
 
-    if (bestMatch.hasFace())
+    if (bestMatch.face)
       return out->dcast().assign(*bestMatch.face);
+
+    if (bestMatch.lazyFace) {
+      if (bestMatch.lazyFace->face.isValid())
+        return out->dcast().assign(bestMatch.lazyFace->face);
+      lazyFace = bestMatch.lazyFace;
+    }
+  }
+
+  if (lazyFace) {
+    BLResult result = loadLazyFace(selfI, lazyFace);
+    if (BL_UNLIKELY(result != BL_SUCCESS)) {
+      out->dcast().reset();
+      return result;
+    }
+
+    BLSharedLockGuard<BLSharedMutex> guard(selfI->mutex);
+    return out->dcast().assign(lazyFace->face);
   }
 
   // This is not considered to be an error, thus don't use blTraceError().
@@ -506,6 +1339,107 @@ BL_API_IMPL BLResult blFontManagerQueryFace(
   return BL_ERROR_FONT_NO_MATCH;
 }
 
+BL_API_IMPL BLResult blFontManagerQueryFallbackRuns(
+  const BLFontManagerCore* self,
+  const char* name, size_t nameSize,
+  const BLFontQueryProperties* properties,
+  const void* text, size_t size, BLTextEncoding encoding,
+  BLArrayCore* facesOut,
+  BLArrayCore* runsOut) noexcept {
+
+  using namespace bl::FontManagerInternal;
+  BL_ASSERT(self->_d.isFontManager());
+
+  if (BL_UNLIKELY(facesOut->_d.rawType() != BL_OBJECT_TYPE_ARRAY_OBJECT ||
+                  runsOut->_d.rawType() != BL_OBJECT_TYPE_ARRAY_STRUCT_16 ||
+                  uint32_t(encoding) > BL_TEXT_ENCODING_MAX_VALUE))
+    return blTraceError(BL_ERROR_INVALID_VALUE);
+
+  if (!properties)
+    properties = &defaultQueryProperties;
+
+  BLFontQueryProperties sanitizedProperties;
+  if (!sanitizeQueryProperties(sanitizedProperties, *properties))
+    return blTraceError(BL_ERROR_INVALID_VALUE);
+
+  if (nameSize == SIZE_MAX)
+    nameSize = strlen(name);
+
+  BLArray<BLFontFace>& faces = facesOut->dcast<BLArray<BLFontFace>>();
+  BLArray<BLFontFallbackRun>& runs = runsOut->dcast<BLArray<BLFontFallbackRun>>();
+
+  faces.clear();
+  runs.clear();
+
+  BLFontManagerPrivateImpl* selfI = getImpl(self);
+  FallbackResolver resolver(selfI, &sanitizedProperties);
+
+  resolver.addFamilies(name, nameSize);
+  if (!resolver.candidateCount) {
+    // This is not considered to be an error, thus don't use blTraceError().
+    return BL_ERROR_FONT_NO_MATCH;
+  }
+
+  size_t byteSize = 0;
+  switch (encoding) {
+    case BL_TEXT_ENCODING_LATIN1:
+    case BL_TEXT_ENCODING_UTF8:
+      byteSize = size == SIZE_MAX ? strlen(static_cast<const char*>(text)) : size;
+      break;
+
+    case BL_TEXT_ENCODING_UTF16:
+      byteSize = (size == SIZE_MAX ? bl::StringOps::length(static_cast<const uint16_t*>(text)) : size) * 2u;
+      break;
+
+    case BL_TEXT_ENCODING_UTF32:
+      byteSize = (size == SIZE_MAX ? bl::StringOps::length(static_cast<const uint32_t*>(text)) : size) * 4u;
+      break;
+
+    default:
+      break;
+  }
+
+  if (BL_UNLIKELY(byteSize > 0xFFFFFFFFu))
+    return blTraceError(BL_ERROR_DATA_TOO_LARGE);
+
+  BLResult result = BL_SUCCESS;
+  switch (encoding) {
+    case BL_TEXT_ENCODING_LATIN1: result = itemizeFallbackRuns<Latin1Reader>(resolver, text, byteSize, runs); break;
+    case BL_TEXT_ENCODING_UTF8  : result = itemizeFallbackRuns<bl::Unicode::Utf8Reader>(resolver, text, byteSize, runs); break;
+    case BL_TEXT_ENCODING_UTF16 : result = itemizeFallbackRuns<bl::Unicode::Utf16Reader>(resolver, text, byteSize, runs); break;
+    case BL_TEXT_ENCODING_UTF32 : result = itemizeFallbackRuns<bl::Unicode::Utf32Reader>(resolver, text, byteSize, runs); break;
+    default: break;
+  }
+
+  if (result == BL_SUCCESS)
+    result = faces.resize(resolver.outputCount, BLFontFace());
+
+  // Load lazy faces used by runs - this is the only place where faces are loaded during a fallback query.
+  for (uint32_t i = 0; i < resolver.candidateCount && result == BL_SUCCESS; i++) {
+    FallbackCandidate& candidate = resolver.candidates[i];
+    if (candidate.outputIndex == kFallbackNoCandidate)
+      continue;
+
+    if (!candidate.face.isValid()) {
+      result = loadLazyFace(selfI, candidate.lazyFace);
+      if (result != BL_SUCCESS)
+        break;
+
+      BLSharedLockGuard<BLSharedMutex> guard(selfI->mutex);
+      candidate.face = candidate.lazyFace->face;
+    }
+
+    result = faces.replace(candidate.outputIndex, candidate.face);
+  }
+
+  if (BL_UNLIKELY(result != BL_SUCCESS)) {
+    faces.clear();
+    runs.clear();
+  }
+
+  return result;
+}
+
 // bl::FontManager - Runtime Registration
 // ======================================
 
@@ -42,6 +42,34 @@ struct BLFontQueryProperties {
 #endif
 };
 
+//! A run of text that should be rendered by a single font face.
+//!
+//! \sa BLFontManager::queryFallbackRuns().
+struct BLFontFallbackRun {
+  //! \name Members
+  //! \{
+
+  //! Index of the first code unit of the run in the input text.
+  uint32_t start;
+  //! Index of the code unit that follows the last code unit of the run in the input text.
+  uint32_t end;
+  //! Index of a face, which should be used to render the run, in the array of faces returned by the query.
+  uint32_t faceIndex;
+  //! Reserved for future use, always zero.
+  uint32_t reserved;
+
+  //! \}
+
+#ifdef __cplusplus
+  //! \name Common Functionality
+  //! \{
+
+  BL_INLINE_NODEBUG void reset() noexcept { *this = BLFontFallbackRun{}; }
+
+  //! \}
+#endif
+};
+
 //! \}
 
 //! \name BLFontManager - C API
@@ -68,8 +96,10 @@ BL_API size_t BL_CDECL blFontManagerGetFaceCount(const BLFontManagerCore* self)
 BL_API size_t BL_CDECL blFontManagerGetFamilyCount(const BLFontManagerCore* self) BL_NOEXCEPT_C;
 BL_API bool BL_CDECL blFontManagerHasFace(const BLFontManagerCore* self, const BLFontFaceCore* face) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontManagerAddFace(BLFontManagerCore* self, const BLFontFaceCore* face) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blFontManagerAddDirectory(BLFontManagerCore* self, const char* dirName, const char* indexFileName) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontManagerQueryFace(const BLFontManagerCore* self, const char* name, size_t nameSize, const BLFontQueryProperties* properties, BLFontFaceCore* out) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blFontManagerQueryFacesByFamilyName(const BLFontManagerCore* self, const char* name, size_t nameSize, BLArrayCore* out) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blFontManagerQueryFallbackRuns(const BLFontManagerCore* self, const char* name, size_t nameSize, const BLFontQueryProperties* properties, const void* text, size_t size, BLTextEncoding encoding, BLArrayCore* facesOut, BLArrayCore* runsOut) BL_NOEXCEPT_C;
 BL_API bool BL_CDECL blFontManagerEquals(const BLFontManagerCore* a, const BLFontManagerCore* b) BL_NOEXCEPT_C;
 
 BL_END_C_DECLS
@@ -178,6 +208,21 @@ public:
     return blFontManagerAddFace(this, &face);
   }
 
+  //! Adds all font files (`.ttf`, `.otf`, `.ttc`, and `.otc`) of the directory `dirName` to the font manager.
+  //!
+  //! Faces added this way are only described by their metadata (family name, style, weight, stretch, and character
+  //! coverage) and are loaded when they are selected by a query for the first time. If `indexFileName` is given,
+  //! the metadata is read from it and only files that were added or changed since the index was written are parsed,
+  //! after which the index is updated. Files that are not valid fonts are silently ignored.
+  //!
+  //! Important conditions:
+  //!   - `BL_SUCCESS` is returned if the directory was successfully read, even if it contains no fonts.
+  //!   - `BL_ERROR_OUT_OF_MEMORY` is returned if memory allocation failed.
+  //!   - Other error is returned if the directory cannot be read or the index file cannot be written.
+  BL_INLINE_NODEBUG BLResult addDirectory(const char* dirName, const char* indexFileName = nullptr) noexcept {
+    return blFontManagerAddDirectory(this, dirName, indexFileName);
+  }
+
   //! Queries a font face by family `name` and stores the result to `out`.
   BL_INLINE_NODEBUG BLResult queryFace(const char* name, BLFontFaceCore& out) const noexcept {
     return blFontManagerQueryFace(this, name, SIZE_MAX, nullptr, &out);
@@ -214,6 +259,31 @@ public:
     return blFontManagerQueryFacesByFamilyName(this, name.data, name.size, &out);
   }
 
+  //! Splits `text` into runs that should be rendered by a single face each and stores the faces to `facesOut` and
+  //! the runs to `runsOut`.
+  //!
+  //! The `names` parameter is a comma separated list of family names that form a fallback chain, the first family is
+  //! the primary one. Each character is assigned to the first face of the chain (selected by `properties`) that
+  //! covers it. Characters not covered by any face of the chain are assigned to the best face of any family known
+  //! to the font manager that covers them, and to the primary face if there is no such face. Whitespace, joiners,
+  //! and variation selectors don't break the current run.
+  //!
+  //! Faces are selected by their character coverage, so faces added by `addDirectory()` are only loaded when they
+  //! are used by a run. Indexes of runs are in code units of the input `encoding`.
+  //!
+  //! Important conditions:
+  //!   - `BL_SUCCESS` is returned if the text was successfully split into runs (empty text produces no runs).
+  //!   - `BL_ERROR_FONT_NO_MATCH` is returned if none of the families given by `names` matches any face.
+  //!   - `BL_ERROR_INVALID_VALUE` is returned if `properties` or `encoding` is invalid.
+  BL_INLINE_NODEBUG BLResult queryFallbackRuns(const char* names, const BLFontQueryProperties& properties, const void* text, size_t size, BLTextEncoding encoding, BLArray<BLFontFace>& facesOut, BLArray<BLFontFallbackRun>& runsOut) const noexcept {
+    return blFontManagerQueryFallbackRuns(this, names, SIZE_MAX, &properties, text, size, encoding, &facesOut, &runsOut);
+  }
+
+  //! \overload
+  BL_INLINE_NODEBUG BLResult queryFallbackRuns(BLStringView names, const BLFontQueryProperties& properties, const void* text, size_t size, BLTextEncoding encoding, BLArray<BLFontFace>& facesOut, BLArray<BLFontFallbackRun>& runsOut) const noexcept {
+    return blFontManagerQueryFallbackRuns(this, names.data, names.size, &properties, text, size, encoding, &facesOut, &runsOut);
+  }
+
   //! \}
 };
 
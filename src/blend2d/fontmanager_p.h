@@ -7,6 +7,7 @@
 #define BLEND2D_FONTMANAGER_P_H_INCLUDED
 
 #include "api-internal_p.h"
+#include "bitset.h"
 #include "fontmanager.h"
 #include "support/arenaallocator_p.h"
 #include "support/arenahashmap_p.h"
@@ -23,18 +24,56 @@ class BLFontManagerPrivateImpl : public BLFontManagerImpl {
 public:
   BL_NONCOPYABLE(BLFontManagerPrivateImpl)
 
+  //! Face registered by `addDirectory()`, which is described by metadata only until it's selected by a query.
+  class LazyFace {
+  public:
+    BL_NONCOPYABLE(LazyFace)
+
+    LazyFace* next;
+    BLString fileName;
+    uint32_t faceIndex;
+    uint8_t style;
+    uint8_t stretch;
+    uint16_t weight;
+    BLBitSet coverage;
+    //! Loaded face, default constructed until the face is selected by a query for the first time.
+    BLFontFace face;
+
+    BL_INLINE LazyFace(const BLString& fileName, uint32_t faceIndex, uint32_t style, uint32_t weight, uint32_t stretch) noexcept
+      : next(nullptr),
+        fileName(fileName),
+        faceIndex(faceIndex),
+        style(uint8_t(style)),
+        stretch(uint8_t(stretch)),
+        weight(uint16_t(weight)),
+        coverage(),
+        face() {}
+    BL_INLINE ~LazyFace() noexcept {}
+  };
+
   class FamiliesMapNode : public bl::ArenaHashMapNode {
   public:
     BL_NONCOPYABLE(FamiliesMapNode)
 
     BLString familyName;
     BLArray<BLFontFace> faces;
+    LazyFace* lazyFaces;
 
     BL_INLINE FamiliesMapNode(uint32_t hashCode, const BLString& familyName) noexcept
       : bl::ArenaHashMapNode(hashCode),
         familyName(familyName),
-        faces() {}
-    BL_INLINE ~FamiliesMapNode() noexcept {}
+        faces(),
+        lazyFaces(nullptr) {}
+
+    BL_INLINE ~FamiliesMapNode() noexcept {
+      // Lazy faces are allocated by the arena allocator, which releases their memory.
+      LazyFace* lazyFace = lazyFaces;
+      while (lazyFace) {
+        LazyFace* next = lazyFace->next;
+        blCallDtor(*lazyFace);
+        lazyFace = next;
+      }
+    }
 
     BL_INLINE FamiliesMapNode* next() const noexcept { return static_cast<FamiliesMapNode*>(_hashNext); }
   };
@@ -0,0 +1,349 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_test_p.h"
+#if defined(BL_TEST)
+
+#include "array.h"
+#include "filesystem.h"
+#include "fontdata.h"
+#include "fontface.h"
+#include "fontmanager.h"
+#include "support/memops_p.h"
+
+#include "../test/resources/abeezee_regular_ttf.h"
+#include "../test/resources/vartest_ttf.h"
+
+#include <stdio.h>
+
+#if defined(_WIN32)
+  #include <direct.h>
+#else
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// bl::FontManager - Tests
+// =======================
+
+namespace bl {
+namespace Tests {
+
+static void createFace(BLFontFace& face, const uint8_t* data, size_t size) noexcept {
+  BLFontData fontData;
+  EXPECT_SUCCESS(fontData.createFromData(data, size));
+  EXPECT_SUCCESS(face.createFromData(fontData, 0));
+}
+
+// Creates a copy of ABeeZee that has a different family name and weight, which is used to test how fallback faces
+// covering the same characters are ranked. The last character of the family name is replaced by `nameSuffix`.
+static void createModifiedFace(BLFontFace& face, char nameSuffix, uint32_t weight) noexcept {
+  BLArray<uint8_t> data;
+  EXPECT_SUCCESS(data.appendData(resource_abeezee_regular_ttf, sizeof(resource_abeezee_regular_ttf)));
+
+  uint8_t* p;
+  EXPECT_SUCCESS(data.makeMutable(&p));
+
+  size_t size = data.size();
+  uint32_t tableCount = MemOps::readU16uBE(p + 4u);
+
+  for (uint32_t i = 0; i < tableCount; i++) {
+    const uint8_t* record = p + 12u + i * 16u;
+    if (memcmp(record, "OS/2", 4) == 0)
+      MemOps::writeU16uBE(p + MemOps::readU32uBE(record + 8u) + 4u, weight);
+  }
+
+  // The family name is stored both as ASCII and UTF-16BE string in the 'name' table.
+  static const char familyName[] = "ABeeZee";
+  constexpr size_t nameSize = sizeof(familyName) - 1u;
+
+  for (size_t i = 0; i + nameSize * 2u <= size; i++) {
+    if (memcmp(p + i, familyName, nameSize) == 0) {
+      p[i + nameSize - 1u] = uint8_t(nameSuffix);
+      continue;
+    }
+
+    size_t j = 0;
+    while (j < nameSize && p[i + j * 2u] == 0 && p[i + j * 2u + 1u] == uint8_t(familyName[j]))
+      j++;
+
+    if (j == nameSize)
+      p[i + nameSize * 2u - 1u] = uint8_t(nameSuffix);
+  }
+
+  BLFontData fontData;
+  EXPECT_SUCCESS(fontData.createFromData(data));
+  EXPECT_SUCCESS(face.createFromData(fontData, 0));
+}
+
+static void expectRun(const BLFontFallbackRun& run, uint32_t start, uint32_t end, uint32_t faceIndex) noexcept {
+  EXPECT_EQ(run.start, start);
+  EXPECT_EQ(run.end, end);
+  EXPECT_EQ(run.faceIndex, faceIndex);
+}
+
+// Font directory used to test `BLFontManager::addDirectory()`, created in the current working directory.
+static const char testDirName[] = "bl_test_fontmanager_dir";
+static const char testIndexName[] = "bl_test_fontmanager_dir.index";
+static const char* const testFileNames[] = { "abeezee.ttf", "vartest.ttf", "broken.ttf" };
+
+static void makeTestFileName(BLString& out, const char* name) noexcept {
+  out.assignFormat("%s/%s", testDirName, name);
+}
+
+static void writeTestFile(const char* name, const void* data, size_t size) noexcept {
+  BLString fileName;
+  makeTestFileName(fileName, name);
+  EXPECT_SUCCESS(BLFileSystem::writeFile(fileName.data(), data, size));
+}
+
+static void removeTestDirectory() noexcept {
+  BLString fileName;
+  for (const char* name : testFileNames) {
+    makeTestFileName(fileName, name);
+    remove(fileName.data());
+  }
+  remove(testIndexName);
+
+#if defined(_WIN32)
+  _rmdir(testDirName);
+#else
+  rmdir(testDirName);
+#endif
+}
+
+static void createTestDirectory() noexcept {
+  removeTestDirectory();
+
+#if defined(_WIN32)
+  EXPECT_EQ(_mkdir(testDirName), 0);
+#else
+  EXPECT_EQ(mkdir(testDirName, 0755), 0);
+#endif
+
+  const char notAFont[] = "Not a font";
+  writeTestFile(testFileNames[0], resource_abeezee_regular_ttf, sizeof(resource_abeezee_regular_ttf));
+  writeTestFile(testFileNames[1], resource_vartest_ttf, sizeof(resource_vartest_ttf));
+  writeTestFile(testFileNames[2], notAFont, sizeof(notAFont) - 1);
+}
+
+static void addTestDirectory(BLFontManager& fm, size_t expectedFaceCount) noexcept {
+  EXPECT_SUCCESS(fm.create());
+  EXPECT_SUCCESS(fm.addDirectory(testDirName, testIndexName));
+  EXPECT_EQ(fm.faceCount(), expectedFaceCount);
+}
+
+static void expectDirectoryFamily(const BLFontManager& fm, const char* familyName, bool exists) noexcept {
+  BLFontFace face;
+  BLResult result = fm.queryFace(familyName, face);
+
+  if (exists) {
+    EXPECT_SUCCESS(result).message("Family '%s' not found", familyName);
+    EXPECT_TRUE(face.familyName().equals(familyName));
+  }
+  else {
+    EXPECT_EQ(result, BL_ERROR_FONT_NO_MATCH).message("Family '%s' must not be found", familyName);
+  }
+}
+
+// Returns an offset of the first coverage run of the first face stored in `index` or zero if there is no face.
+static size_t findFirstCoverageRun(const BLArray<uint8_t>& index) noexcept {
+  const uint8_t* data = index.data();
+  uint32_t fileCount = MemOps::readU32u(data + 8u);
+  size_t offset = 12u;
+
+  for (uint32_t i = 0; i < fileCount; i++) {
+    offset += 4u + MemOps::readU32u(data + offset) + 16u;
+    uint32_t faceCount = MemOps::readU32u(data + offset);
+    uint32_t faceDataSize = MemOps::readU32u(data + offset + 4u);
+    offset += 8u;
+
+    if (faceCount) {
+      // Skip face index, properties, and family name.
+      offset += 8u;
+      offset += 4u + MemOps::readU32u(data + offset);
+
+      EXPECT_GT(MemOps::readU32u(data + offset), 0u);
+      return offset + 4u;
+    }
+
+    offset += faceDataSize;
+  }
+
+  return 0;
+}
+
+static void testDirectory() noexcept {
+  createTestDirectory();
+
+  BLArray<uint8_t> index;
+
+  INFO("Testing addDirectory() without an existing index");
+  {
+    BLFontManager fm;
+    addTestDirectory(fm, 2);
+    expectDirectoryFamily(fm, "ABeeZee", true);
+    expectDirectoryFamily(fm, "BLVarTest", true);
+
+    EXPECT_SUCCESS(BLFileSystem::readFile(testIndexName, index));
+  }
+
+  INFO("Testing addDirectory() with an index written by a previous call");
+  {
+    BLFontManager fm;
+    addTestDirectory(fm, 2);
+    expectDirectoryFamily(fm, "ABeeZee", true);
+    expectDirectoryFamily(fm, "BLVarTest", true);
+
+    // Nothing has changed, thus the index must be the same.
+    BLArray<uint8_t> roundTrip;
+    EXPECT_SUCCESS(BLFileSystem::readFile(testIndexName, roundTrip));
+    EXPECT_TRUE(roundTrip.equals(index));
+  }
+
+  INFO("Testing addDirectory() with a corrupted index");
+  {
+    // The first coverage run of the first face starts beyond Unicode range, which makes the record invalid.
+    BLArray<uint8_t> corrupted;
+    EXPECT_SUCCESS(corrupted.appendData(index.data(), index.size()));
+
+    uint8_t* corruptedData;
+    EXPECT_SUCCESS(corrupted.makeMutable(&corruptedData));
+    size_t runOffset = findFirstCoverageRun(index);
+    EXPECT_NE(runOffset, 0u);
+
+    MemOps::writeU32u(corruptedData + runOffset, 0xFFFFFFF0u);
+    EXPECT_SUCCESS(BLFileSystem::writeFile(testIndexName, corrupted));
+
+    BLFontManager fm;
+    addTestDirectory(fm, 2);
+    expectDirectoryFamily(fm, "ABeeZee", true);
+    expectDirectoryFamily(fm, "BLVarTest", true);
+
+    // Files of invalid records are parsed again, which restores the original index.
+    BLArray<uint8_t> restored;
+    EXPECT_SUCCESS(BLFileSystem::readFile(testIndexName, restored));
+    EXPECT_TRUE(restored.equals(index));
+  }
+
+  INFO("Testing addDirectory() with a truncated index");
+  {
+    EXPECT_SUCCESS(BLFileSystem::writeFile(testIndexName, index.data(), index.size() / 2u));
+
+    BLFontManager fm;
+    addTestDirectory(fm, 2);
+    expectDirectoryFamily(fm, "ABeeZee", true);
+    expectDirectoryFamily(fm, "BLVarTest", true);
+  }
+
+  INFO("Testing addDirectory() with a stale index");
+  {
+    // Replacing 'vartest.ttf' by a different font changes its size, thus its record of the index is stale.
+    writeTestFile(testFileNames[1], resource_abeezee_regular_ttf, sizeof(resource_abeezee_regular_ttf));
+
+    BLFontManager fm;
+    addTestDirectory(fm, 2);
+    expectDirectoryFamily(fm, "ABeeZee", true);
+    expectDirectoryFamily(fm, "BLVarTest", false);
+
+    BLArray<uint8_t> updated;
+    EXPECT_SUCCESS(BLFileSystem::readFile(testIndexName, updated));
+    EXPECT_FALSE(updated.equals(index));
+  }
+
+  removeTestDirectory();
+}
+
+UNIT(fontmanager, BL_TEST_GROUP_TEXT_COMBINED) {
+  BLFontFace abeezee;
+  BLFontFace varTest;
+
+  createFace(abeezee, resource_abeezee_regular_ttf, sizeof(resource_abeezee_regular_ttf));
+  createFace(varTest, resource_vartest_ttf, sizeof(resource_vartest_ttf));
+
+  BLFontManager fm;
+  EXPECT_SUCCESS(fm.create());
+  EXPECT_SUCCESS(fm.addFace(abeezee));
+  EXPECT_SUCCESS(fm.addFace(varTest));
+
+  BLFontQueryProperties properties {};
+  BLArray<BLFontFace> faces;
+  BLArray<BLFontFallbackRun> runs;
+
+  INFO("Testing fallback runs of a fallback chain");
+  {
+    // 'BLVarTest' only covers 'A', 'B', 'C', and 'D'.
+    const char text[] = "AB xy C";
+    EXPECT_SUCCESS(fm.queryFallbackRuns("BLVarTest, ABeeZee", properties, text, sizeof(text) - 1, BL_TEXT_ENCODING_UTF8, faces, runs));
+
+    EXPECT_EQ(faces.size(), 2u);
+    EXPECT_TRUE(faces[0].equals(varTest));
+    EXPECT_TRUE(faces[1].equals(abeezee));
+
+    // The space after 'AB' doesn't break the run although 'BLVarTest' doesn't cover it.
+    EXPECT_EQ(runs.size(), 3u);
+    expectRun(runs[0], 0, 3, 0);
+    expectRun(runs[1], 3, 6, 1);
+    expectRun(runs[2], 6, 7, 0);
+  }
+
+  INFO("Testing fallback runs of characters not covered by the fallback chain");
+  {
+    // Characters not covered by the chain are searched in all families, characters not covered at all use the primary face.
+    const uint16_t text[] = { 'A', 'x', 0x4E2D, 'B' };
+    EXPECT_SUCCESS(fm.queryFallbackRuns("BLVarTest", properties, text, BL_ARRAY_SIZE(text), BL_TEXT_ENCODING_UTF16, faces, runs));
+
+    EXPECT_EQ(faces.size(), 2u);
+    EXPECT_TRUE(faces[0].equals(varTest));
+    EXPECT_TRUE(faces[1].equals(abeezee));
+
+    EXPECT_EQ(runs.size(), 3u);
+    expectRun(runs[0], 0, 1, 0);
+    expectRun(runs[1], 1, 2, 1);
+    expectRun(runs[2], 2, 4, 0);
+  }
+
+  INFO("Testing that fallback faces found by searching all families are ranked by query properties");
+  {
+    BLFontFace regular;
+    BLFontFace bold;
+
+    // Both faces cover the same characters as 'ABeeZee', which is not added to this font manager.
+    createModifiedFace(regular, 'R', BL_FONT_WEIGHT_NORMAL);
+    createModifiedFace(bold, 'B', BL_FONT_WEIGHT_BOLD);
+
+    for (uint32_t order = 0; order < 2; order++) {
+      BLFontManager fm2;
+      EXPECT_SUCCESS(fm2.create());
+      EXPECT_SUCCESS(fm2.addFace(varTest));
+      EXPECT_SUCCESS(fm2.addFace(order ? regular : bold));
+      EXPECT_SUCCESS(fm2.addFace(order ? bold : regular));
+
+      for (uint32_t weight : { uint32_t(BL_FONT_WEIGHT_NORMAL), uint32_t(BL_FONT_WEIGHT_BOLD), uint32_t(BL_FONT_WEIGHT_BLACK) }) {
+        BLFontQueryProperties weightProperties {};
+        weightProperties.weight = weight;
+
+        EXPECT_SUCCESS(fm2.queryFallbackRuns("BLVarTest", weightProperties, "Ax", 2, BL_TEXT_ENCODING_LATIN1, faces, runs));
+        EXPECT_EQ(faces.size(), 2u);
+        EXPECT_TRUE(faces[1].equals(weight == BL_FONT_WEIGHT_NORMAL ? regular : bold))
+          .message("Wrong fallback face for weight %u (order %u)", weight, order);
+      }
+    }
+  }
+
+  INFO("Testing fallback runs of an unknown family");
+  {
+    EXPECT_EQ(fm.queryFallbackRuns("Unknown", properties, "x", 1, BL_TEXT_ENCODING_LATIN1, faces, runs), BL_ERROR_FONT_NO_MATCH);
+    EXPECT_EQ(faces.size(), 0u);
+    EXPECT_EQ(runs.size(), 0u);
+  }
+
+  testDirectory();
+}
+
+} // {Tests}
+} // {bl}
+
+#endif // BL_TEST
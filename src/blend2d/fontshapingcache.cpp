@@ -0,0 +1,406 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_p.h"
+#include "font_p.h"
+#include "fontface_p.h"
+#include "fontshapingcache_p.h"
+#include "glyphbuffer_p.h"
+#include "runtime_p.h"
+#include "support/hashops_p.h"
+#include "support/intops_p.h"
+#include "support/scopedbuffer_p.h"
+#include "support/wrap_p.h"
+#include "threading/atomic_p.h"
+#include "threading/mutex_p.h"
+
+namespace bl {
+namespace FontShapingCache {
+
+// bl::FontShapingCache - Entry
+// ============================
+
+//! A single cached text run.
+//!
+//! The entry is allocated by a single `malloc()` call - input text, input infos, output glyphs, output infos, and
+//! output placements follow the entry header in this order.
+struct Entry {
+  Entry* hashNext;
+  Entry* lruPrev;
+  Entry* lruNext;
+
+  uint32_t hashCode;
+  uint32_t inputFlags;
+  uint32_t outputFlags;
+  uint32_t placementType;
+
+  BLUniqueId faceUniqueId;
+  BLFontFeatureSettingsCore featureSettings;
+  BLFontVariationSettingsCore variationSettings;
+
+  size_t textSize;
+  size_t glyphCount;
+
+  static BL_INLINE size_t sizeOf(size_t textSize, size_t glyphCount) noexcept {
+    return sizeof(Entry) + textSize   * (sizeof(uint32_t) + sizeof(BLGlyphInfo))
+                         + glyphCount * (sizeof(uint32_t) + sizeof(BLGlyphInfo) + sizeof(BLGlyphPlacement));
+  }
+
+  BL_INLINE uint32_t* textData() noexcept { return reinterpret_cast<uint32_t*>(this + 1); }
+  BL_INLINE BLGlyphInfo* textInfoData() noexcept { return reinterpret_cast<BLGlyphInfo*>(textData() + textSize); }
+  BL_INLINE uint32_t* glyphData() noexcept { return reinterpret_cast<uint32_t*>(textInfoData() + textSize); }
+  BL_INLINE BLGlyphInfo* glyphInfoData() noexcept { return reinterpret_cast<BLGlyphInfo*>(glyphData() + glyphCount); }
+  BL_INLINE BLGlyphPlacement* placementData() noexcept { return reinterpret_cast<BLGlyphPlacement*>(glyphInfoData() + glyphCount); }
+};
+
+//! Lookup key - describes a text run to be shaped and the font properties that affect shaping.
+struct Key {
+  uint32_t hashCode;
+  uint32_t inputFlags;
+  BLUniqueId faceUniqueId;
+  const BLFontFeatureSettingsCore* featureSettings;
+  const BLFontVariationSettingsCore* variationSettings;
+  const uint32_t* textData;
+  const BLGlyphInfo* textInfoData;
+  size_t textSize;
+
+  BL_INLINE bool matches(Entry* entry) const noexcept {
+    return entry->hashCode == hashCode &&
+           entry->inputFlags == inputFlags &&
+           entry->faceUniqueId == faceUniqueId &&
+           entry->textSize == textSize &&
+           memcmp(entry->textData(), textData, textSize * sizeof(uint32_t)) == 0 &&
+           memcmp(entry->textInfoData(), textInfoData, textSize * sizeof(BLGlyphInfo)) == 0 &&
+           entry->featureSettings.dcast().equals(featureSettings->dcast()) &&
+           entry->variationSettings.dcast().equals(variationSettings->dcast());
+  }
+};
+
+static BL_INLINE uint32_t hashKey(const Key& key) noexcept {
+  uint32_t hashCode = uint32_t(key.faceUniqueId) ^ uint32_t(key.faceUniqueId >> 32);
+  hashCode = HashOps::hashRound(hashCode, uint32_t(key.textSize));
+
+  for (size_t i = 0; i < key.textSize; i++) {
+    hashCode = HashOps::hashRound(hashCode, key.textData[i]);
+    hashCode = HashOps::hashRound(hashCode, key.textInfoData[i].cluster);
+  }
+
+  // Feature and variation settings are not part of the hash code, they are only compared when the text matches.
+  return hashCode;
+}
+
+static void destroyEntry(Entry* entry) noexcept {
+  blCallDtor(entry->variationSettings.dcast());
+  blCallDtor(entry->featureSettings.dcast());
+  free(entry);
+}
+
+// bl::FontShapingCache - Cache
+// ============================
+
+//! Bounded LRU cache of shaped text runs, protected by a mutex.
+struct Cache {
+  BLMutex mutex;
+
+  //! Maximum number of entries, zero if the cache is disabled (also read without a lock by `isEnabled()`).
+  size_t capacity {};
+  //! Number of entries in the cache.
+  size_t size {};
+
+  uint64_t hitCount {};
+  uint64_t missCount {};
+
+  //! Hash buckets (power of 2).
+  Entry** buckets {};
+  uint32_t bucketMask {};
+
+  //! Most recently used entry.
+  Entry* lruFirst {};
+  //! Least recently used entry, evicted first.
+  Entry* lruLast {};
+
+  BL_INLINE ~Cache() noexcept {
+    clear();
+    free(buckets);
+  }
+
+  //! Releases all cached entries, but keeps the capacity and hash buckets.
+  void clear() noexcept {
+    Entry* entry = lruFirst;
+    while (entry) {
+      Entry* next = entry->lruNext;
+      destroyEntry(entry);
+      entry = next;
+    }
+
+    if (buckets)
+      memset(buckets, 0, (size_t(bucketMask) + 1u) * sizeof(Entry*));
+
+    lruFirst = nullptr;
+    lruLast = nullptr;
+    size = 0;
+  }
+
+  BL_INLINE void lruUnlink(Entry* entry) noexcept {
+    Entry* prev = entry->lruPrev;
+    Entry* next = entry->lruNext;
+
+    if (prev)
+      prev->lruNext = next;
+    else
+      lruFirst = next;
+
+    if (next)
+      next->lruPrev = prev;
+    else
+      lruLast = prev;
+  }
+
+  BL_INLINE void lruPrepend(Entry* entry) noexcept {
+    entry->lruPrev = nullptr;
+    entry->lruNext = lruFirst;
+
+    if (lruFirst)
+      lruFirst->lruPrev = entry;
+    else
+      lruLast = entry;
+
+    lruFirst = entry;
+  }
+
+  BL_INLINE Entry* find(const Key& key) noexcept {
+    Entry* entry = buckets[key.hashCode & bucketMask];
+    while (entry) {
+      if (key.matches(entry))
+        return entry;
+      entry = entry->hashNext;
+    }
+    return nullptr;
+  }
+
+  void remove(Entry* entry) noexcept {
+    Entry** pPrev = &buckets[entry->hashCode & bucketMask];
+    while (*pPrev != entry)
+      pPrev = &(*pPrev)->hashNext;
+
+    *pPrev = entry->hashNext;
+    lruUnlink(entry);
+    size--;
+  }
+
+  void insert(Entry* entry) noexcept {
+    while (size >= capacity) {
+      Entry* last = lruLast;
+      remove(last);
+      destroyEntry(last);
+    }
+
+    Entry** pBucket = &buckets[entry->hashCode & bucketMask];
+    entry->hashNext = *pBucket;
+    *pBucket = entry;
+
+    lruPrepend(entry);
+    size++;
+  }
+};
+
+static Wrap<Cache> cache;
+
+// bl::FontShapingCache - API
+// ==========================
+
+bool isEnabled() noexcept {
+  return blAtomicFetchRelaxed(&cache->capacity) != 0;
+}
+
+static BL_INLINE bool isCacheable(const BLGlyphBufferPrivateImpl* gbI) noexcept {
+  return (gbI->flags & BL_GLYPH_RUN_FLAG_UCS4_CONTENT) != 0 &&
+         gbI->size != 0 &&
+         gbI->size <= kMaxTextSize &&
+         gbI->debugSink == nullptr;
+}
+
+static BLResult copyEntryToGlyphBuffer(Entry* entry, BLGlyphBufferPrivateImpl* gbI) noexcept {
+  size_t glyphCount = entry->glyphCount;
+
+  BL_PROPAGATE(gbI->ensureBuffer(0, 0, glyphCount));
+  gbI->getGlyphDataPtrs(0, &gbI->content, &gbI->infoData);
+  gbI->size = glyphCount;
+  BL_PROPAGATE(gbI->ensurePlacement());
+
+  memcpy(gbI->content, entry->glyphData(), glyphCount * sizeof(uint32_t));
+  memcpy(gbI->infoData, entry->glyphInfoData(), glyphCount * sizeof(BLGlyphInfo));
+  memcpy(gbI->placementData, entry->placementData(), glyphCount * sizeof(BLGlyphPlacement));
+
+  gbI->flags = entry->outputFlags;
+  gbI->glyphRun.placementType = uint8_t(entry->placementType);
+  return BL_SUCCESS;
+}
+
+static Entry* createEntry(const Key& key, const BLGlyphBufferPrivateImpl* gbI) noexcept {
+  size_t textSize = key.textSize;
+  size_t glyphCount = gbI->size;
+
+  Entry* entry = static_cast<Entry*>(malloc(Entry::sizeOf(textSize, glyphCount)));
+  if (BL_UNLIKELY(!entry))
+    return nullptr;
+
+  entry->hashNext = nullptr;
+  entry->lruPrev = nullptr;
+  entry->lruNext = nullptr;
+  entry->hashCode = key.hashCode;
+  entry->inputFlags = key.inputFlags;
+  entry->outputFlags = gbI->flags;
+  entry->placementType = gbI->glyphRun.placementType;
+  entry->faceUniqueId = key.faceUniqueId;
+  blCallCtor(entry->featureSettings.dcast(), key.featureSettings->dcast());
+  blCallCtor(entry->variationSettings.dcast(), key.variationSettings->dcast());
+  entry->textSize = textSize;
+  entry->glyphCount = glyphCount;
+
+  memcpy(entry->textData(), key.textData, textSize * sizeof(uint32_t));
+  memcpy(entry->textInfoData(), key.textInfoData, textSize * sizeof(BLGlyphInfo));
+  memcpy(entry->glyphData(), gbI->content, glyphCount * sizeof(uint32_t));
+  memcpy(entry->glyphInfoData(), gbI->infoData, glyphCount * sizeof(BLGlyphInfo));
+  memcpy(entry->placementData(), gbI->placementData, glyphCount * sizeof(BLGlyphPlacement));
+  return entry;
+}
+
+BLResult shape(const BLFontCore* font, BLGlyphBufferCore* gb, ShapeFunc shapeFunc) noexcept {
+  BLFontPrivateImpl* fontI = FontInternal::getImpl(font);
+  BLGlyphBufferPrivateImpl* gbI = blGlyphBufferGetImpl(gb);
+
+  if (!isCacheable(gbI))
+    return shapeFunc(font, gb);
+
+  Key key;
+  key.inputFlags = gbI->flags;
+  key.faceUniqueId = fontI->face.dcast().uniqueId();
+  key.featureSettings = &fontI->featureSettings;
+  key.variationSettings = &fontI->variationSettings;
+  key.textData = gbI->content;
+  key.textInfoData = gbI->infoData;
+  key.textSize = gbI->size;
+  key.hashCode = hashKey(key);
+
+  {
+    BLLockGuard<BLMutex> guard(cache->mutex);
+    if (cache->capacity) {
+      Entry* entry = cache->find(key);
+      if (entry) {
+        cache->lruUnlink(entry);
+        cache->lruPrepend(entry);
+        cache->hitCount++;
+        return copyEntryToGlyphBuffer(entry, gbI);
+      }
+      cache->missCount++;
+    }
+  }
+
+  // Shaping reuses the input buffer, so the input must be copied as it's part of the key.
+  size_t textSize = key.textSize;
+  ScopedBufferTmp<1024> tmp;
+
+  uint32_t* textCopy = static_cast<uint32_t*>(tmp.alloc(textSize * (sizeof(uint32_t) + sizeof(BLGlyphInfo))));
+  if (BL_UNLIKELY(!textCopy))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  BLGlyphInfo* textInfoCopy = reinterpret_cast<BLGlyphInfo*>(textCopy + textSize);
+  memcpy(textCopy, key.textData, textSize * sizeof(uint32_t));
+  memcpy(textInfoCopy, key.textInfoData, textSize * sizeof(BLGlyphInfo));
+
+  key.textData = textCopy;
+  key.textInfoData = textInfoCopy;
+
+  BL_PROPAGATE(shapeFunc(font, gb));
+
+  // Runs that don't have placement data (shaping didn't finish) are never cached.
+  gbI = blGlyphBufferGetImpl(gb);
+  if (!gbI->placementData || (gbI->flags & BL_GLYPH_RUN_FLAG_UCS4_CONTENT))
+    return BL_SUCCESS;
+
+  // Failing to cache the result is not an error - the glyph buffer already contains the shaped run.
+  Entry* entry = createEntry(key, gbI);
+  if (BL_UNLIKELY(!entry))
+    return BL_SUCCESS;
+
+  BLLockGuard<BLMutex> guard(cache->mutex);
+  if (!cache->capacity || cache->find(key)) {
+    destroyEntry(entry);
+    return BL_SUCCESS;
+  }
+
+  cache->insert(entry);
+  return BL_SUCCESS;
+}
+
+} // {FontShapingCache}
+} // {bl}
+
+// bl::FontShapingCache - API - Public
+// ===================================
+
+BL_API_IMPL BLResult blFontShapingCacheSetCapacity(size_t capacity) noexcept {
+  using namespace bl::FontShapingCache;
+
+  Entry** buckets = nullptr;
+  uint32_t bucketCount = 0;
+
+  if (capacity) {
+    if (BL_UNLIKELY(capacity > 0x1000000u))
+      return blTraceError(BL_ERROR_INVALID_VALUE);
+
+    bucketCount = bl::IntOps::alignUpPowerOf2(uint32_t(blMax<size_t>(capacity, 16u)));
+    buckets = static_cast<Entry**>(calloc(bucketCount, sizeof(Entry*)));
+
+    if (BL_UNLIKELY(!buckets))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+  }
+
+  BLLockGuard<BLMutex> guard(cache->mutex);
+  cache->clear();
+  free(cache->buckets);
+
+  cache->buckets = buckets;
+  cache->bucketMask = bucketCount ? bucketCount - 1u : 0u;
+  blAtomicStoreRelaxed(&cache->capacity, capacity);
+  return BL_SUCCESS;
+}
+
+BL_API_IMPL BLResult blFontShapingCacheGetInfo(BLFontShapingCacheInfo* out) noexcept {
+  using namespace bl::FontShapingCache;
+
+  BLLockGuard<BLMutex> guard(cache->mutex);
+  out->capacity = cache->capacity;
+  out->size = cache->size;
+  out->hitCount = cache->hitCount;
+  out->missCount = cache->missCount;
+  return BL_SUCCESS;
+}
+
+// bl::FontShapingCache - Runtime Registration
+// ===========================================
+
+static void BL_CDECL blFontShapingCacheRtShutdown(BLRuntimeContext* rt) noexcept {
+  blUnused(rt);
+  bl::FontShapingCache::cache.destroy();
+}
+
+static void BL_CDECL blFontShapingCacheRtCleanup(BLRuntimeContext* rt, BLRuntimeCleanupFlags cleanupFlags) noexcept {
+  using namespace bl::FontShapingCache;
+  blUnused(rt);
+
+  if (cleanupFlags & BL_RUNTIME_CLEANUP_FONT_SHAPING_CACHE) {
+    BLLockGuard<BLMutex> guard(cache->mutex);
+    cache->clear();
+  }
+}
+
+void blFontShapingCacheRtInit(BLRuntimeContext* rt) noexcept {
+  bl::FontShapingCache::cache.init();
+
+  rt->shutdownHandlers.add(blFontShapingCacheRtShutdown);
+  rt->cleanupHandlers.add(blFontShapingCacheRtCleanup);
+}
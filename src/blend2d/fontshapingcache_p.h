@@ -0,0 +1,39 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_FONTSHAPINGCACHE_P_H_INCLUDED
+#define BLEND2D_FONTSHAPINGCACHE_P_H_INCLUDED
+
+#include "api-internal_p.h"
+#include "font.h"
+#include "glyphbuffer.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_internal
+//! \{
+
+namespace bl {
+namespace FontShapingCache {
+
+//! Maximum number of code points of a text run that can be cached - longer runs are always shaped.
+static constexpr size_t kMaxTextSize = 1024;
+
+//! Shaping function called on a cache miss.
+typedef BLResult (BL_CDECL* ShapeFunc)(const BLFontCore* font, BLGlyphBufferCore* gb) BL_NOEXCEPT;
+
+//! Tests whether the shaping cache is enabled (has a non-zero capacity).
+BL_HIDDEN bool isEnabled() noexcept;
+
+//! Shapes the content of `gb` by using the shaping cache - if the text run with the same font settings has been
+//! shaped already, the cached result is copied to `gb`, otherwise `shapeFunc` is called and its result is cached.
+BL_HIDDEN BLResult shape(const BLFontCore* font, BLGlyphBufferCore* gb, ShapeFunc shapeFunc) noexcept;
+
+} // {FontShapingCache}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_FONTSHAPINGCACHE_P_H_INCLUDED
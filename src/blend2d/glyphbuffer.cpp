@@ -126,8 +126,20 @@ static BL_INLINE BLResult blInternalGlyphBufferData_setUnicodeText(BLGlyphBuffer
   BLGlyphInfo* infoData = d->infoData;
 
   while (reader.hasNext()) {
-    uint32_t uc;
     uint32_t cluster = uint32_t(reader.nativeIndex(src));
+
+    // Characters that don't need any validation are decoded in bulk - each of them is a single code unit.
+    size_t runSize = reader.decodeSimpleRun(textData, SIZE_MAX);
+    if (runSize) {
+      for (size_t i = 0; i < runSize; i++)
+        infoData[i] = blGlyphInfoFromCluster(cluster + uint32_t(i));
+
+      textData += runSize;
+      infoData += runSize;
+      continue;
+    }
+
+    uint32_t uc;
     BLResult result = reader.next(uc);
 
     *textData++ = uc;
@@ -12,11 +12,14 @@
 #include "runtime_p.h"
 #include "pixelops/funcs_p.h"
 #include "support/algorithm_p.h"
+#include "support/hashops_p.h"
 #include "support/intops_p.h"
 #include "support/lookuptable_p.h"
 #include "support/math_p.h"
 #include "support/ptrops_p.h"
+#include "support/wrap_p.h"
 #include "threading/atomic_p.h"
+#include "threading/mutex_p.h"
 
 namespace bl {
 namespace GradientInternal {
@@ -288,56 +291,201 @@ BLGradientInfo ensureInfo(BLGradientPrivateImpl* impl) noexcept {
   return info;
 }
 
-BLGradientLUT* ensureLut32(BLGradientPrivateImpl* impl, uint32_t lutSize) noexcept {
-  BLGradientLUT* lut = impl->lut32;
-  if (lut) {
-    BL_ASSERT(lut->size == lutSize);
-    return lut;
+// bl::Gradient - Internals - Global LUT Cache
+// ===========================================
+//
+// Gradients that have the same stops share the same LUTs, which helps when gradients are recreated often (for example
+// each frame) as the LUT doesn't have to be interpolated again. LUTs don't depend on the extend mode, so the key only
+// consists of stops, LUT size, and pixel size. The cache is bounded - the least recently used LUT is replaced when
+// it's full, and it's never accessed when a gradient already holds its LUT.
+
+namespace LUTCache {
+
+//! Maximum number of LUTs cached.
+static constexpr uint32_t kCapacity = 64;
+//! Maximum number of stops of a gradient to be cached - LUTs of gradients having more stops are never shared.
+static constexpr size_t kMaxStopCount = 256;
+
+struct Entry {
+  uint32_t hashCode;
+  uint32_t lutSize;
+  uint32_t pixelSize;
+  uint32_t stopCount;
+  uint64_t lastUsed;
+  BLGradientLUT* lut;
+  BLGradientStop* stops;
+
+  BL_INLINE bool matches(uint32_t hashCode_, uint32_t lutSize_, uint32_t pixelSize_, const BLGradientStop* stops_, size_t stopCount_) const noexcept {
+    return hashCode == hashCode_ &&
+           lutSize == lutSize_ &&
+           pixelSize == pixelSize_ &&
+           stopCount == stopCount_ &&
+           memcmp(stops, stops_, stopCount_ * sizeof(BLGradientStop)) == 0;
   }
 
-  lut = BLGradientLUT::alloc(lutSize, 4);
+  BL_INLINE void release() noexcept {
+    lut->release();
+    free(stops);
+  }
+};
+
+struct Cache {
+  BLMutex mutex;
+  uint32_t size;
+  uint64_t useCounter;
+  Entry entries[kCapacity];
+
+  BL_INLINE Cache() noexcept
+    : size(0),
+      useCounter(0) {}
+
+  BL_INLINE ~Cache() noexcept { clear(); }
+
+  BL_INLINE void clear() noexcept {
+    for (uint32_t i = 0; i < size; i++)
+      entries[i].release();
+    size = 0;
+  }
+
+  // Returns a retained LUT, or null if it's not in the cache.
+  BL_INLINE BLGradientLUT* find(uint32_t hashCode, uint32_t lutSize, uint32_t pixelSize, const BLGradientStop* stops, size_t stopCount) noexcept {
+    for (uint32_t i = 0; i < size; i++) {
+      Entry& entry = entries[i];
+      if (entry.matches(hashCode, lutSize, pixelSize, stops, stopCount)) {
+        entry.lastUsed = ++useCounter;
+        return entry.lut->retain();
+      }
+    }
+    return nullptr;
+  }
+
+  // Inserts a LUT into the cache, replaces the least recently used entry if the cache is full. The LUT is not cached
+  // if the copy of stops cannot be allocated, which is not an error.
+  BL_INLINE void insert(uint32_t hashCode, uint32_t lutSize, uint32_t pixelSize, const BLGradientStop* stops, size_t stopCount, BLGradientLUT* lut) noexcept {
+    BLGradientStop* stopsCopy = static_cast<BLGradientStop*>(malloc(stopCount * sizeof(BLGradientStop)));
+    if (BL_UNLIKELY(!stopsCopy))
+      return;
+
+    uint32_t index = size;
+    if (index < kCapacity) {
+      size++;
+    }
+    else {
+      index = 0;
+      for (uint32_t i = 1; i < kCapacity; i++)
+        if (entries[i].lastUsed < entries[index].lastUsed)
+          index = i;
+      entries[index].release();
+    }
+
+    memcpy(stopsCopy, stops, stopCount * sizeof(BLGradientStop));
+
+    Entry& entry = entries[index];
+    entry.hashCode = hashCode;
+    entry.lutSize = lutSize;
+    entry.pixelSize = pixelSize;
+    entry.stopCount = uint32_t(stopCount);
+    entry.lastUsed = ++useCounter;
+    entry.lut = lut->retain();
+    entry.stops = stopsCopy;
+  }
+};
+
+static Wrap<Cache> cache;
+
+static BL_INLINE uint32_t hashStops(const BLGradientStop* stops, size_t stopCount, uint32_t lutSize, uint32_t pixelSize) noexcept {
+  uint32_t hashCode = HashOps::hashRound(lutSize, pixelSize);
+  for (size_t i = 0; i < stopCount; i++) {
+    uint64_t offsetBits = blBitCast<uint64_t>(stops[i].offset);
+    uint64_t rgba = stops[i].rgba.value;
+
+    hashCode = HashOps::hashRound(hashCode, uint32_t(offsetBits >> 32) ^ uint32_t(offsetBits));
+    hashCode = HashOps::hashRound(hashCode, uint32_t(rgba >> 32));
+    hashCode = HashOps::hashRound(hashCode, uint32_t(rgba));
+  }
+  return hashCode;
+}
+
+//! Returns a retained LUT of the given `stops` - either a cached one or a newly created one, which is interpolated by
+//! `interpolateFunc` and inserted into the cache. Returns null if the LUT cannot be allocated.
+template<typename InterpolateFunc>
+static BLGradientLUT* acquire(const BLGradientStop* stops, size_t stopCount, uint32_t lutSize, uint32_t pixelSize, InterpolateFunc&& interpolateFunc) noexcept {
+  bool cacheable = stopCount <= kMaxStopCount;
+  uint32_t hashCode = 0;
+
+  if (cacheable) {
+    hashCode = hashStops(stops, stopCount, lutSize, pixelSize);
+
+    BLLockGuard<BLMutex> guard(cache->mutex);
+    BLGradientLUT* lut = cache->find(hashCode, lutSize, pixelSize, stops, stopCount);
+
+    if (lut)
+      return lut;
+  }
+
+  // Interpolate outside of the lock - another thread could insert the same LUT meanwhile, in that case we would use
+  // the cached one and drop ours.
+  BLGradientLUT* lut = BLGradientLUT::alloc(lutSize, pixelSize);
   if (BL_UNLIKELY(!lut))
     return nullptr;
 
-  const BLGradientStop* stops = impl->stops;
-  PixelOps::funcs.interpolate_prgb32(lut->data<uint32_t>(), lutSize, stops, impl->size);
+  interpolateFunc(lut->data(), lutSize, stops, stopCount);
 
-  // We must drop this LUT if another thread created it meanwhile.
-  BLGradientLUT* expected = nullptr;
-  if (!blAtomicCompareExchange(&impl->lut32, &expected, lut)) {
-    BL_ASSERT(expected != nullptr);
-    BLGradientLUT::destroy(lut);
-    lut = expected;
+  if (cacheable) {
+    BLLockGuard<BLMutex> guard(cache->mutex);
+    BLGradientLUT* cachedLut = cache->find(hashCode, lutSize, pixelSize, stops, stopCount);
+
+    if (cachedLut) {
+      BLGradientLUT::destroy(lut);
+      return cachedLut;
+    }
+
+    cache->insert(hashCode, lutSize, pixelSize, stops, stopCount, lut);
   }
 
   return lut;
 }
 
-BLGradientLUT* ensureLut64(BLGradientPrivateImpl* impl, uint32_t lutSize) noexcept {
-  BLGradientLUT* lut = impl->lut64;
+} // {LUTCache}
+
+// bl::Gradient - Internals - LUT Access
+// =====================================
+
+template<typename InterpolateFunc>
+static BL_INLINE BLGradientLUT* ensureLut(BLGradientPrivateImpl* impl, uint32_t lutIndex, uint32_t lutSize, uint32_t pixelSize, InterpolateFunc&& interpolateFunc) noexcept {
+  BLGradientLUT* lut = impl->lut[lutIndex];
   if (lut) {
     BL_ASSERT(lut->size == lutSize);
     return lut;
   }
 
-  lut = BLGradientLUT::alloc(lutSize, 8);
+  lut = LUTCache::acquire(impl->stops, impl->size, lutSize, pixelSize, interpolateFunc);
   if (BL_UNLIKELY(!lut))
     return nullptr;
 
-  const BLGradientStop* stops = impl->stops;
-  PixelOps::funcs.interpolate_prgb64(lut->data<uint64_t>(), lutSize, stops, impl->size);
-
-  // We must drop this LUT if another thread created it meanwhile.
+  // We must drop this LUT if another thread assigned it meanwhile.
   BLGradientLUT* expected = nullptr;
-  if (!blAtomicCompareExchange(&impl->lut64, &expected, lut)) {
+  if (!blAtomicCompareExchange(&impl->lut[lutIndex], &expected, lut)) {
     BL_ASSERT(expected != nullptr);
-    BLGradientLUT::destroy(lut);
+    lut->release();
     lut = expected;
   }
 
   return lut;
 }
 
+BLGradientLUT* ensureLut32(BLGradientPrivateImpl* impl, uint32_t lutSize) noexcept {
+  return ensureLut(impl, 0, lutSize, 4, [](void* dst, uint32_t dstSize, const BLGradientStop* stops, size_t stopCount) noexcept {
+    PixelOps::funcs.interpolate_prgb32(static_cast<uint32_t*>(dst), dstSize, stops, stopCount);
+  });
+}
+
+BLGradientLUT* ensureLut64(BLGradientPrivateImpl* impl, uint32_t lutSize) noexcept {
+  return ensureLut(impl, 1, lutSize, 8, [](void* dst, uint32_t dstSize, const BLGradientStop* stops, size_t stopCount) noexcept {
+    PixelOps::funcs.interpolate_prgb64(static_cast<uint64_t*>(dst), dstSize, stops, stopCount);
+  });
+}
+
 // bl::Gradient - Internals - Alloc & Free Impl
 // ============================================
 
@@ -1023,10 +1171,28 @@ BL_API_IMPL bool blGradientEquals(const BLGradientCore* a, const BLGradientCore*
 // bl::Gradient - Runtime Registration
 // ===================================
 
-void blGradientRtInit(BLRuntimeContext* rt) noexcept {
+static void BL_CDECL blGradientRtShutdown(BLRuntimeContext* rt) noexcept {
+  blUnused(rt);
+  bl::GradientInternal::LUTCache::cache.destroy();
+}
+
+static void BL_CDECL blGradientRtCleanup(BLRuntimeContext* rt, BLRuntimeCleanupFlags cleanupFlags) noexcept {
+  using namespace bl::GradientInternal;
   blUnused(rt);
 
+  if (cleanupFlags & BL_RUNTIME_CLEANUP_GRADIENT_LUT_CACHE) {
+    BLLockGuard<BLMutex> guard(LUTCache::cache->mutex);
+    LUTCache::cache->clear();
+  }
+}
+
+void blGradientRtInit(BLRuntimeContext* rt) noexcept {
   bl::GradientInternal::defaultImpl.impl->transform.reset();
   blObjectDefaults[BL_OBJECT_TYPE_GRADIENT]._d.initDynamic(
     BLObjectInfo::fromTypeWithMarker(BL_OBJECT_TYPE_GRADIENT), &bl::GradientInternal::defaultImpl.impl);
+
+  bl::GradientInternal::LUTCache::cache.init();
+
+  rt->shutdownHandlers.add(blGradientRtShutdown);
+  rt->cleanupHandlers.add(blGradientRtCleanup);
 }
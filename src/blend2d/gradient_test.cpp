@@ -9,6 +9,7 @@
 #include "gradient_p.h"
 #include "object_p.h"
 #include "rgba_p.h"
+#include "runtime.h"
 
 namespace bl {
 namespace Tests {
@@ -128,6 +129,50 @@ UNIT(gradient_values, BL_TEST_GROUP_RENDERING_STYLES) {
   }
 }
 
+UNIT(gradient_lut_cache, BL_TEST_GROUP_RENDERING_STYLES) {
+  INFO("Testing that gradients having the same stops share LUTs");
+  {
+    BLGradient a(BLLinearGradientValues(0, 0, 100, 0));
+    BLGradient b(BLRadialGradientValues(0, 0, 0, 0, 50), BL_EXTEND_MODE_REPEAT);
+
+    for (BLGradient* g : { &a, &b }) {
+      g->addStop(0.0, BLRgba32(0xFF000000u));
+      g->addStop(0.3, BLRgba32(0x80FF0000u));
+      g->addStop(1.0, BLRgba32(0xFFFFFFFFu));
+    }
+
+    BLGradientLUT* a32 = GradientInternal::ensureLut32(GradientInternal::getImpl(&a), 512);
+    BLGradientLUT* b32 = GradientInternal::ensureLut32(GradientInternal::getImpl(&b), 512);
+    BLGradientLUT* a64 = GradientInternal::ensureLut64(GradientInternal::getImpl(&a), 512);
+
+    EXPECT_NE(a32, nullptr);
+    EXPECT_EQ(a32, b32);
+    EXPECT_NE(a32, a64);
+
+    // Modifying stops invalidates the LUT of the modified gradient only.
+    b.addStop(0.5, BLRgba32(0xFF00FF00u));
+    b32 = GradientInternal::ensureLut32(GradientInternal::getImpl(&b), 512);
+    EXPECT_NE(a32, b32);
+    EXPECT_EQ(a32, GradientInternal::ensureLut32(GradientInternal::getImpl(&a), 512));
+
+    // A new gradient having the same stops shares the cached LUT, which has the same content as an uncached one.
+    BLGradient c(BLLinearGradientValues(0, 0, 100, 0));
+    EXPECT_SUCCESS(c.assignStops(a.stops(), a.size()));
+
+    BLGradientLUT* c32 = GradientInternal::ensureLut32(GradientInternal::getImpl(&c), 512);
+    EXPECT_EQ(a32, c32);
+
+    EXPECT_SUCCESS(BLRuntime::cleanup(BL_RUNTIME_CLEANUP_GRADIENT_LUT_CACHE));
+    BLGradient d(BLLinearGradientValues(0, 0, 100, 0));
+    EXPECT_SUCCESS(d.assignStops(a.stops(), a.size()));
+
+    BLGradientLUT* d32 = GradientInternal::ensureLut32(GradientInternal::getImpl(&d), 512);
+    EXPECT_NE(d32, nullptr);
+    EXPECT_NE(a32, d32);
+    EXPECT_EQ(memcmp(a32->data(), d32->data(), 512 * sizeof(uint32_t)), 0);
+  }
+}
+
 } // {Tests}
 } // {bl}
 
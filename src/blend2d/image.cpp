@@ -8,6 +8,7 @@
 #include "filesystem.h"
 #include "format.h"
 #include "image_p.h"
+#include "imageblur_p.h"
 #include "imagecodec.h"
 #include "imagedecoder.h"
 #include "imageencoder.h"
@@ -110,6 +111,112 @@ static void copyImageData(uint8_t* dstData, intptr_t dstStride, const uint8_t* s
   }
 }
 
+// bl::Image - Mipmap Chain
+// ========================
+
+// Calculates a single mipmap level from `src` level. The last column and row of `src` are duplicated if its width
+// or height is odd. Each 32-bit pixel is processed as two 16-bit lanes holding two 8-bit components, which cannot
+// overflow as a sum of 4 components is at most 10 bits.
+static void downsampleMipLevel(uint8_t* dst, intptr_t dstStride, const BLSizeI& dstSize, const uint8_t* src, intptr_t srcStride, const BLSizeI& srcSize, uint32_t format) noexcept {
+  uint32_t dw = uint32_t(dstSize.w);
+  uint32_t dh = uint32_t(dstSize.h);
+  uint32_t sxLast = uint32_t(srcSize.w) - 1u;
+  uint32_t syLast = uint32_t(srcSize.h) - 1u;
+
+  for (uint32_t y = 0; y < dh; y++) {
+    const uint8_t* s0 = src + intptr_t(blMin(y * 2u + 0u, syLast)) * srcStride;
+    const uint8_t* s1 = src + intptr_t(blMin(y * 2u + 1u, syLast)) * srcStride;
+
+    if (format == BL_FORMAT_A8) {
+      for (uint32_t x = 0; x < dw; x++) {
+        uint32_t x0 = x * 2u;
+        uint32_t x1 = blMin(x0 + 1u, sxLast);
+        dst[x] = uint8_t((uint32_t(s0[x0]) + uint32_t(s0[x1]) + uint32_t(s1[x0]) + uint32_t(s1[x1]) + 2u) >> 2);
+      }
+    }
+    else {
+      uint32_t* d = reinterpret_cast<uint32_t*>(dst);
+      for (uint32_t x = 0; x < dw; x++) {
+        uint32_t x0 = x * 2u;
+        uint32_t x1 = blMin(x0 + 1u, sxLast);
+
+        uint32_t p0 = MemOps::readU32a(s0 + x0 * 4u);
+        uint32_t p1 = MemOps::readU32a(s0 + x1 * 4u);
+        uint32_t p2 = MemOps::readU32a(s1 + x0 * 4u);
+        uint32_t p3 = MemOps::readU32a(s1 + x1 * 4u);
+
+        uint32_t rb = (p0 & 0x00FF00FFu) + (p1 & 0x00FF00FFu) + (p2 & 0x00FF00FFu) + (p3 & 0x00FF00FFu) + 0x00020002u;
+        uint32_t ag = ((p0 >> 8) & 0x00FF00FFu) + ((p1 >> 8) & 0x00FF00FFu) + ((p2 >> 8) & 0x00FF00FFu) + ((p3 >> 8) & 0x00FF00FFu) + 0x00020002u;
+
+        d[x] = ((rb >> 2) & 0x00FF00FFu) | ((ag << 6) & 0xFF00FF00u);
+      }
+    }
+
+    dst += dstStride;
+  }
+}
+
+const BLImageMipChain* ensureMipChain(BLImagePrivateImpl* impl) noexcept {
+  BLImageMipChain* mipChain = impl->mipChain;
+  if (mipChain)
+    return mipChain;
+
+  uint32_t format = impl->format;
+  if (format != BL_FORMAT_PRGB32 && format != BL_FORMAT_XRGB32 && format != BL_FORMAT_A8)
+    return nullptr;
+
+  uint32_t bytesPerPixel = impl->depth / 8u;
+  uint32_t levelCount = 0;
+  size_t dataSize = 0;
+
+  BLSizeI size = impl->size;
+  while ((size.w | size.h) > 1) {
+    size.reset((size.w + 1) >> 1, (size.h + 1) >> 1);
+    dataSize += size_t(IntOps::alignUp(uint32_t(size.w) * bytesPerPixel, 16u)) * uint32_t(size.h);
+    levelCount++;
+  }
+
+  if (!levelCount)
+    return nullptr;
+
+  size_t headerSize = IntOps::alignUp(sizeof(BLImageMipChain), 16u);
+  mipChain = static_cast<BLImageMipChain*>(malloc(headerSize + dataSize));
+
+  if (BL_UNLIKELY(!mipChain))
+    return nullptr;
+
+  uint8_t* levelData = reinterpret_cast<uint8_t*>(mipChain) + headerSize;
+
+  const uint8_t* srcData = static_cast<const uint8_t*>(impl->pixelData);
+  intptr_t srcStride = impl->stride;
+  BLSizeI srcSize = impl->size;
+
+  mipChain->levelCount = levelCount;
+  for (uint32_t i = 0; i < levelCount; i++) {
+    BLImageMipChain::Level& level = mipChain->levels[i];
+    level.pixelData = levelData;
+    level.stride = intptr_t(IntOps::alignUp(uint32_t((srcSize.w + 1) >> 1) * bytesPerPixel, 16u));
+    level.size.reset((srcSize.w + 1) >> 1, (srcSize.h + 1) >> 1);
+
+    downsampleMipLevel(levelData, level.stride, level.size, srcData, srcStride, srcSize, format);
+
+    srcData = levelData;
+    srcStride = level.stride;
+    srcSize = level.size;
+    levelData += size_t(level.stride) * uint32_t(level.size.h);
+  }
+
+  // We must drop this chain if another thread created it meanwhile.
+  BLImageMipChain* expected = nullptr;
+  if (!blAtomicCompareExchange(&impl->mipChain, &expected, mipChain)) {
+    BL_ASSERT(expected != nullptr);
+    free(mipChain);
+    mipChain = expected;
+  }
+
+  return mipChain;
+}
+
 // bl::Image - Alloc & Free Impl
 // =============================
 
@@ -148,6 +255,7 @@ static BL_NOINLINE BLResult allocImpl(BLImageCore* self, int w, int h, BLFormat
 
   initImplData(impl, w, h, format, pixelData, stride);
   impl->writerCount = 0;
+  impl->mipChain = nullptr;
   return BL_SUCCESS;
 }
 
@@ -163,6 +271,7 @@ static BL_NOINLINE BLResult allocExternal(BLImageCore* self, int w, int h, BLFor
   BLImagePrivateImpl* impl = getImpl(self);
   initImplData(impl, w, h, format, pixelData, stride);
   impl->writerCount = 0;
+  impl->mipChain = nullptr;
   return BL_SUCCESS;
 }
 
@@ -174,6 +283,8 @@ BLResult freeImpl(BLImagePrivateImpl* impl) noexcept {
   if (impl->writerCount != 0)
     return BL_SUCCESS;
 
+  invalidateMipChain(impl);
+
   if (ObjectInternal::isImplExternal(impl))
     ObjectInternal::callExternalDestroyFunc(impl, impl->pixelData);
 
@@ -353,6 +464,7 @@ BL_API_IMPL BLResult blImageCreateFromData(
     bl::ObjectInternal::initExternalDestroyFunc(selfI, destroyFunc, userData);
     bl::ObjectInternal::initRefCountToBase(selfI, immutable);
 
+    invalidateMipChain(selfI);
     initImplData(selfI, w, h, format, pixelData, stride);
     return BL_SUCCESS;
   }
@@ -408,6 +520,9 @@ BL_API_IMPL BLResult blImageMakeMutable(BLImageCore* self, BLImageData* dataOut)
     return replaceInstance(self, &newO);
   }
   else {
+    // The caller is going to modify the pixels, so a cached mipmap chain would be out of date.
+    invalidateMipChain(selfI);
+
     dataOut->pixelData = selfI->pixelData;
     dataOut->stride = selfI->stride;
     dataOut->size = size;
@@ -452,6 +567,7 @@ BL_API_IMPL BLResult blImageConvert(BLImageCore* self, BLFormat format) noexcept
 
   if (di.depth == si.depth && isImplMutable(selfI)) {
     // Prefer in-place conversion if the depths are equal and the image mutable.
+    invalidateMipChain(selfI);
     pc.convertFunc(&pc, static_cast<uint8_t*>(selfI->pixelData), selfI->stride,
                         static_cast<uint8_t*>(selfI->pixelData), selfI->stride, uint32_t(size.w), uint32_t(size.h), nullptr);
   }
@@ -530,41 +646,50 @@ BL_API_IMPL BLResult blImageScale(BLImageCore* dst, const BLImageCore* src, cons
   BL_PROPAGATE(scaleCtx.create(*size, srcI->size, filter));
 
   BLFormat format = BLFormat(srcI->format);
-  int tw = scaleCtx.dstWidth();
-  int th = scaleCtx.srcHeight();
-
   BLImage tmp;
   BLImageData buf;
 
-  if (th == scaleCtx.dstHeight() || tw == scaleCtx.srcWidth()) {
-    // Only horizontal or vertical scale.
+  // Move to `tmp` so it's not destroyed by `dst->create()`.
+  if (dst == src)
+    tmp = src->dcast();
 
-    // Move to `tmp` so it's not destroyed by `dst->create()`.
-    if (dst == src)
-      tmp = src->dcast();
+  BL_PROPAGATE(blImageCreate(dst, scaleCtx.dstWidth(), scaleCtx.dstHeight(), format));
+  BL_PROPAGATE(blImageMakeMutable(dst, &buf));
 
-    BL_PROPAGATE(blImageCreate(dst, scaleCtx.dstWidth(), scaleCtx.dstHeight(), format));
-    BL_PROPAGATE(blImageMakeMutable(dst, &buf));
+  // Scales in horizontal bands so the intermediate (horizontally scaled) rows stay in cache, bands are distributed
+  // across worker threads in case that the destination image is large enough.
+  return scaleCtx.processData(static_cast<uint8_t*>(buf.pixelData), buf.stride, static_cast<const uint8_t*>(srcI->pixelData), srcI->stride, format);
+}
 
-    if (th == scaleCtx.dstHeight())
-      scaleCtx.processHorzData(static_cast<uint8_t*>(buf.pixelData), buf.stride, static_cast<const uint8_t*>(srcI->pixelData), srcI->stride, format);
-    else
-      scaleCtx.processVertData(static_cast<uint8_t*>(buf.pixelData), buf.stride, static_cast<const uint8_t*>(srcI->pixelData), srcI->stride, format);
-  }
-  else {
-    // Both horizontal and vertical scale.
-    BL_PROPAGATE(tmp.create(tw, th, format));
-    BL_PROPAGATE(tmp.makeMutable(&buf));
-    scaleCtx.processHorzData(static_cast<uint8_t*>(buf.pixelData), buf.stride, static_cast<const uint8_t*>(srcI->pixelData), srcI->stride, format);
+// bl::Image - API - Blur
+// ======================
 
-    srcI = getImpl(&tmp);
-    BL_PROPAGATE(blImageCreate(dst, scaleCtx.dstWidth(), scaleCtx.dstHeight(), format));
-    BL_PROPAGATE(blImageMakeMutable(dst, &buf));
+BL_API_IMPL BLResult blImageBlur(BLImageCore* dst, const BLImageCore* src, double sigma, BLImageBlurType type) noexcept {
+  using namespace bl::ImageInternal;
 
-    scaleCtx.processVertData(static_cast<uint8_t*>(buf.pixelData), buf.stride, static_cast<const uint8_t*>(srcI->pixelData), srcI->stride, format);
-  }
+  BL_ASSERT(dst->_d.isImage());
+  BL_ASSERT(src->_d.isImage());
 
-  return BL_SUCCESS;
+  if (BL_UNLIKELY(!(sigma >= 0.0 && sigma <= bl::ImageBlurInternal::kMaxSigma) || uint32_t(type) > BL_IMAGE_BLUR_TYPE_MAX_VALUE))
+    return blTraceError(BL_ERROR_INVALID_VALUE);
+
+  BLImagePrivateImpl* srcI = getImpl(src);
+  if (srcI->format == BL_FORMAT_NONE)
+    return blImageReset(dst);
+
+  BLFormat format = BLFormat(srcI->format);
+  BLSizeI size = srcI->size;
+  BLImage tmp;
+  BLImageData buf;
+
+  // Keep the source alive in `tmp` as `dst->create()` would release it if `dst` and `src` are the same instance.
+  tmp = src->dcast();
+  const BLImagePrivateImpl* tmpI = getImpl(&tmp);
+
+  BL_PROPAGATE(blImageCreate(dst, size.w, size.h, format));
+  BL_PROPAGATE(blImageMakeMutable(dst, &buf));
+
+  return bl::ImageBlurInternal::blurData(static_cast<uint8_t*>(buf.pixelData), buf.stride, static_cast<const uint8_t*>(tmpI->pixelData), tmpI->stride, size, format, sigma, type);
 }
 
 // bl::Image - API - Read File
@@ -47,6 +47,19 @@ BL_DEFINE_ENUM(BLImageScaleFilter) {
   BL_FORCE_ENUM_UINT32(BL_IMAGE_SCALE_FILTER)
 };
 
+//! Blur type used by `BLImage::blur()`.
+BL_DEFINE_ENUM(BLImageBlurType) {
+  //! Gaussian blur calculated by a separable convolution (its cost grows with sigma).
+  BL_IMAGE_BLUR_TYPE_GAUSSIAN = 0,
+  //! Gaussian blur approximated by three successive box blurs (its cost doesn't depend on sigma).
+  BL_IMAGE_BLUR_TYPE_BOX = 1,
+
+  //! Maximum value of `BLImageBlurType`.
+  BL_IMAGE_BLUR_TYPE_MAX_VALUE = 1
+
+  BL_FORCE_ENUM_UINT32(BL_IMAGE_BLUR_TYPE)
+};
+
 //! \}
 
 //! \name BLImage - Structs
@@ -115,6 +128,7 @@ BL_API BLResult BL_CDECL blImageMakeMutable(BLImageCore* self, BLImageData* data
 BL_API BLResult BL_CDECL blImageConvert(BLImageCore* self, BLFormat format) BL_NOEXCEPT_C;
 BL_API bool BL_CDECL blImageEquals(const BLImageCore* a, const BLImageCore* b) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blImageScale(BLImageCore* dst, const BLImageCore* src, const BLSizeI* size, BLImageScaleFilter filter) BL_NOEXCEPT_C;
+BL_API BLResult BL_CDECL blImageBlur(BLImageCore* dst, const BLImageCore* src, double sigma, BLImageBlurType type) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blImageReadFromFile(BLImageCore* self, const char* fileName, const BLArrayCore* codecs) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blImageReadFromData(BLImageCore* self, const void* data, size_t size, const BLArrayCore* codecs) BL_NOEXCEPT_C;
 BL_API BLResult BL_CDECL blImageWriteToFile(const BLImageCore* self, const char* fileName, const BLImageCodecCore* codec) BL_NOEXCEPT_C;
@@ -342,6 +356,15 @@ public:
   static BL_INLINE_NODEBUG BLResult scale(BLImage& dst, const BLImage& src, const BLSizeI& size, BLImageScaleFilter filter) noexcept {
     return blImageScale(&dst, &src, &size, filter);
   }
+
+  //! Blurs `src` image by a blur of the given `type` and standard deviation `sigma` and stores the result to `dst`.
+  //!
+  //! The blurred image has the same size and format as `src`. Pixels outside of \ref BL_FORMAT_PRGB32 and
+  //! \ref BL_FORMAT_A8 images are considered transparent, \ref BL_FORMAT_XRGB32 images extend their edge pixels
+  //! instead. Zero `sigma` makes a copy of `src`, negative `sigma` or `sigma` greater than 1000 is invalid.
+  static BL_INLINE_NODEBUG BLResult blur(BLImage& dst, const BLImage& src, double sigma, BLImageBlurType type = BL_IMAGE_BLUR_TYPE_GAUSSIAN) noexcept {
+    return blImageBlur(&dst, &src, sigma, type);
+  }
 };
 
 #endif
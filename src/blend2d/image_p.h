@@ -17,6 +17,27 @@
 //! \name BLImage - Internals - Structs
 //! \{
 
+//! Mipmap chain of an image.
+//!
+//! Each level halves the size of the previous level (rounding up) and each of its pixels is an average of 2x2 pixels
+//! of the previous level. The chain is built lazily by the rendering context when an image is scaled down and it's
+//! cached by the image until it's modified (see `ImageInternal::ensureMipChain()`).
+struct BLImageMipChain {
+  //! Maximum number of levels (excluding the image itself, which is level 0).
+  static constexpr uint32_t kMaxLevels = 16;
+
+  struct Level {
+    const uint8_t* pixelData;
+    intptr_t stride;
+    BLSizeI size;
+  };
+
+  //! Number of levels (excluding the image itself).
+  uint32_t levelCount;
+  //! Mipmap levels, `levels[0]` describes level 1 (half of the image size).
+  Level levels[kMaxLevels];
+};
+
 //! Private implementation that extends \ref BLImageImpl.
 struct BLImagePrivateImpl : public BLImageImpl {
   //! Count of writers that write to this image.
@@ -24,6 +45,8 @@ struct BLImagePrivateImpl : public BLImageImpl {
   //! Writers don't increase the reference count of the image to keep it mutable. However, we must keep
   //! a counter that would tell the BLImage destructor that it's not the time if `writerCount > 0`.
   size_t writerCount;
+  //! Mipmap chain cache (lazily created, can be null).
+  BLImageMipChain* mipChain;
 };
 
 //! \}
@@ -47,6 +70,26 @@ static BL_INLINE BLResult releaseImpl(BLImageImpl* impl) noexcept {
 
 //! \}
 
+//! \name BLImage - Internals - Mipmap Chain
+//! \{
+
+//! Returns a mipmap chain of the image `impl`, which is created if it doesn't exist yet. Returns null if the image
+//! has no mipmap levels (1x1 image), has an unsupported format, or in case of out of memory condition.
+//!
+//! \note This function can be called concurrently, however, the image must not be modified during the call.
+BL_HIDDEN const BLImageMipChain* ensureMipChain(BLImagePrivateImpl* impl) noexcept;
+
+//! Destroys a mipmap chain cached by the image `impl`, must be called before its pixels are modified.
+static BL_INLINE void invalidateMipChain(BLImagePrivateImpl* impl) noexcept {
+  BLImageMipChain* mipChain = impl->mipChain;
+  if (mipChain) {
+    impl->mipChain = nullptr;
+    free(mipChain);
+  }
+}
+
+//! \}
+
 //! \name BLImage - Internals - Common Functionality (Instance)
 //! \{
 
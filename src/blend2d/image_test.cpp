@@ -180,6 +180,44 @@ UNIT(image, BL_TEST_GROUP_IMAGE_CONTAINERS) {
     EXPECT_NE(imgData0.pixelData, imgData1.pixelData);
     EXPECT_EQ(img0, img1);
   }
+
+  INFO("Testing BLImage mipmap chain");
+  {
+    BLImage img;
+    BLImageData imgData;
+
+    EXPECT_SUCCESS(img.create(5, 3, BL_FORMAT_PRGB32));
+    EXPECT_SUCCESS(img.makeMutable(&imgData));
+
+    for (uint32_t y = 0; y < 3; y++) {
+      uint32_t* line = reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(imgData.pixelData) + y * imgData.stride);
+      for (uint32_t x = 0; x < 5; x++) {
+        line[x] = 0xFF000000u | ((x * 40u) << 16) | ((y * 80u) << 8) | (x * y * 10u);
+      }
+    }
+
+    BLImagePrivateImpl* imgI = ImageInternal::getImpl(&img);
+    const BLImageMipChain* mipChain = ImageInternal::ensureMipChain(imgI);
+
+    EXPECT_TRUE(mipChain != nullptr);
+    EXPECT_EQ(mipChain->levelCount, 3u);
+    EXPECT_EQ(mipChain->levels[0].size, BLSizeI(3, 2));
+    EXPECT_EQ(mipChain->levels[1].size, BLSizeI(2, 1));
+    EXPECT_EQ(mipChain->levels[2].size, BLSizeI(1, 1));
+
+    // Pixel [1, 0] of level 1 averages pixels [2..3, 0..1] of the image.
+    const uint32_t* level1 = reinterpret_cast<const uint32_t*>(mipChain->levels[0].pixelData);
+    EXPECT_EQ(level1[1], 0xFF000000u | (100u << 16) | (40u << 8) | 13u);
+
+    // Pixel [2, 1] of level 1 duplicates the last column and row of the image.
+    level1 = reinterpret_cast<const uint32_t*>(mipChain->levels[0].pixelData + mipChain->levels[0].stride);
+    EXPECT_EQ(level1[2], 0xFF000000u | (160u << 16) | (160u << 8) | 80u);
+
+    // The same chain must be returned until the image is modified.
+    EXPECT_EQ(ImageInternal::ensureMipChain(imgI), mipChain);
+    EXPECT_SUCCESS(img.makeMutable(&imgData));
+    EXPECT_TRUE(imgI->mipChain == nullptr);
+  }
 }
 
 } // {Tests}
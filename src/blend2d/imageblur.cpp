@@ -0,0 +1,593 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_p.h"
+#include "imageblur_p.h"
+#include "format_p.h"
+#include "image_p.h"
+#include "runtime_p.h"
+#include "support/intops_p.h"
+#include "support/math_p.h"
+#include "support/memops_p.h"
+#include "support/scopedbuffer_p.h"
+#include "threading/atomic_p.h"
+#include "threading/threadpool_p.h"
+
+namespace bl {
+namespace ImageBlurInternal {
+
+// bl::ImageBlur - Ops
+// ===================
+
+struct ImageBlurOps {
+  ConvolveFunc convolve;
+  BoxHorzFunc boxHorz[BL_FORMAT_MAX_VALUE + 1];
+  BoxVertFunc boxVert;
+};
+static ImageBlurOps imageBlurOps;
+
+// bl::ImageBlur - Kernels
+// =======================
+
+void gaussianWeights(int32_t* weights, double sigma) noexcept {
+  uint32_t radius = gaussianRadius(sigma);
+  double scale = -0.5 / (sigma * sigma);
+
+  double total = 1.0;
+  for (uint32_t i = 1; i <= radius; i++)
+    total += 2.0 * exp(double(i * i) * scale);
+
+  // Tail weights are calculated from a rounded cumulative sum starting at the outermost tap, which guarantees that
+  // all integer weights are non-negative and that their sum is exact regardless of how many of them are rounded.
+  double cumulative = 0.0;
+  int32_t prev = 0;
+
+  for (uint32_t i = radius; i > 0; i--) {
+    cumulative += exp(double(i * i) * scale) / total;
+    int32_t cur = int32_t(Math::round(cumulative * double(kGaussianWeightScale)));
+    weights[i] = cur - prev;
+    prev = cur;
+  }
+
+  weights[0] = kGaussianWeightScale - prev * 2;
+}
+
+void boxRadii(uint32_t* radii, double sigma) noexcept {
+  // Calculates sizes of boxes so the variance of all passes matches the variance of the gaussian - the first `m`
+  // boxes have the size `wl` and the remaining boxes have the size `wl + 2` (both sizes are odd).
+  double n = double(kBoxPassCount);
+  double sigmaSq12 = 12.0 * sigma * sigma;
+
+  uint32_t wl = uint32_t(Math::floor(Math::sqrt(sigmaSq12 / n + 1.0)));
+  if (!(wl & 1u))
+    wl--;
+
+  double wlD = double(wl);
+  double mIdeal = (sigmaSq12 - n * wlD * wlD - 4.0 * n * wlD - 3.0 * n) / (-4.0 * wlD - 4.0);
+  uint32_t m = uint32_t(blClamp(Math::round(mIdeal), 0.0, n));
+
+  for (uint32_t i = 0; i < kBoxPassCount; i++)
+    radii[i] = (i < m ? wl : wl + 2u) / 2u;
+}
+
+// bl::ImageBlur - Portable Implementation
+// =======================================
+
+static void BL_CDECL imageBlurConvolve(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) noexcept {
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t* sp = src + i;
+    int32_t c = 0x8000 + int32_t(sp[0]) * weights[0];
+
+    for (uint32_t k = 1; k <= radius; k++) {
+      intptr_t offset = intptr_t(k) * tapStride;
+      c += int32_t(uint32_t(sp[-offset]) + uint32_t(sp[offset])) * weights[k];
+    }
+
+    dst[i] = uint8_t(c >> 16);
+  }
+}
+
+template<uint32_t kBpp>
+static void BL_CDECL imageBlurBoxHorz(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) noexcept {
+  uint32_t sums[kBpp] {};
+
+  const uint8_t* subPtr = src - size_t(radius) * kBpp;
+  const uint8_t* addPtr = subPtr;
+
+  for (uint32_t i = radius * 2u + 1u; i; i--) {
+    for (uint32_t c = 0; c < kBpp; c++)
+      sums[c] += addPtr[c];
+    addPtr += kBpp;
+  }
+
+  for (uint32_t x = 0; x < w; x++) {
+    for (uint32_t c = 0; c < kBpp; c++) {
+      dst[c] = uint8_t((sums[c] * recip + 0x800000u) >> 24);
+      sums[c] += uint32_t(addPtr[c]) - uint32_t(subPtr[c]);
+    }
+
+    dst += kBpp;
+    addPtr += kBpp;
+    subPtr += kBpp;
+  }
+}
+
+static void BL_CDECL imageBlurBoxVert(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) noexcept {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] = uint8_t((sums[i] * recip + 0x800000u) >> 24);
+    sums[i] += uint32_t(addLine[i]) - uint32_t(subLine[i]);
+  }
+}
+
+// bl::ImageBlur - Rows
+// ====================
+
+//! Copies a row of `w` pixels from `src` to `dst` - XRGB32 pixels are made opaque so the blur never sees undefined
+//! alpha values.
+static void imageBlurCopyRow(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t format, uint32_t bpp) noexcept {
+  if (format == BL_FORMAT_XRGB32) {
+    for (uint32_t x = 0; x < w; x++)
+      MemOps::writeU32u(dst + x * 4u, MemOps::readU32u(src + x * 4u) | 0xFF000000u);
+  }
+  else {
+    memcpy(dst, src, size_t(w) * bpp);
+  }
+}
+
+//! Pads a row of `w` pixels by `padL` pixels on the left side and by `padR` pixels on the right side. Pad pixels are
+//! either transparent or copies of edge pixels if `extend` is true.
+static void imageBlurPadRow(uint8_t* row, uint32_t w, uint32_t bpp, uint32_t padL, uint32_t padR, bool extend) noexcept {
+  uint8_t* end = row + size_t(w) * bpp;
+
+  if (!extend) {
+    memset(row - size_t(padL) * bpp, 0, size_t(padL) * bpp);
+    memset(end, 0, size_t(padR) * bpp);
+    return;
+  }
+
+  for (uint32_t i = 1; i <= padL; i++)
+    memcpy(row - size_t(i) * bpp, row, bpp);
+
+  for (uint32_t i = 0; i < padR; i++)
+    memcpy(end + size_t(i) * bpp, end - bpp, bpp);
+}
+
+// bl::ImageBlur - Work
+// ====================
+
+//! Maximum size of rows required to calculate a single band (should fit into L2 cache).
+static constexpr size_t kImageBlurBandBudget = 256u * 1024u;
+
+//! Maximum number of bytes of a column strip processed by vertical box passes.
+static constexpr size_t kImageBlurStripSize = 4096u;
+
+//! Minimum number of pixels required to distribute bands or strips across the thread-pool.
+static constexpr uint64_t kImageBlurThreadingThreshold = 256u * 256u;
+
+struct ImageBlurWork;
+typedef void (*ImageBlurItemFunc)(const ImageBlurWork* work, uint32_t itemIndex, uint8_t* workerData) BL_NOEXCEPT;
+
+struct ImageBlurWork {
+  uint32_t w;
+  uint32_t h;
+  uint32_t format;
+  uint32_t bpp;
+  bool extend;
+
+  //! Gaussian weights and radius.
+  const int32_t* weights;
+  uint32_t radius;
+
+  //! Box radii and reciprocals.
+  uint32_t boxRadius[kBoxPassCount];
+  uint32_t boxRecip[kBoxPassCount];
+
+  //! Processes a single item (band of rows or strip of columns).
+  ImageBlurItemFunc itemFunc;
+  //! Number of rows of a band or number of bytes of a strip.
+  uint32_t itemSize;
+  uint32_t itemCount;
+  uint32_t itemIndex;
+
+  uint8_t* dstLine;
+  intptr_t dstStride;
+  const uint8_t* srcLine;
+  intptr_t srcStride;
+
+  //! Intermediate image used by box blur passes.
+  uint8_t* tmpLine;
+  intptr_t tmpStride;
+  //! Zeroed row used to read pixels outside of the image by vertical box passes.
+  const uint8_t* zeroLine;
+
+  //! Padded row used by horizontal passes.
+  size_t rowBufferSize;
+
+  uint8_t* workerData;
+  size_t workerDataSize;
+};
+
+static void BL_CDECL imageBlurWorker(void* data, uint32_t workerId) noexcept {
+  ImageBlurWork* work = static_cast<ImageBlurWork*>(data);
+  uint8_t* workerData = work->workerData + size_t(workerId) * work->workerDataSize;
+
+  for (;;) {
+    uint32_t itemIndex = blAtomicFetchAddRelaxed(&work->itemIndex);
+    if (itemIndex >= work->itemCount)
+      break;
+    work->itemFunc(work, itemIndex, workerData);
+  }
+}
+
+static BLResult imageBlurRun(ImageBlurWork& work, uint32_t threadCount, ScopedBuffer& workerBuffer) noexcept {
+  threadCount = blMax<uint32_t>(blMin(threadCount, work.itemCount), 1u);
+
+  work.itemIndex = 0;
+  work.workerData = static_cast<uint8_t*>(workerBuffer.alloc(work.workerDataSize * threadCount));
+
+  if (BL_UNLIKELY(!work.workerData))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  if (threadCount > 1)
+    blThreadPoolRunParallel(blThreadPoolGlobal(), threadCount, imageBlurWorker, &work);
+  else
+    imageBlurWorker(&work, 0);
+
+  return BL_SUCCESS;
+}
+
+// bl::ImageBlur - Gaussian
+// ========================
+
+// Destination rows are processed in bands - all source rows required by a band are convolved horizontally into a
+// per-worker buffer, which is then convolved vertically into the destination, so no full-size intermediate image is
+// needed. Rows outside of the image are either transparent or copies of the nearest edge row.
+static void imageBlurGaussianBand(const ImageBlurWork* work, uint32_t bandIndex, uint8_t* workerData) noexcept {
+  ConvolveFunc convolve = imageBlurOps.convolve;
+
+  uint32_t w = work->w;
+  uint32_t h = work->h;
+  uint32_t bpp = work->bpp;
+  uint32_t r = work->radius;
+  size_t rowSize = size_t(w) * bpp;
+
+  uint32_t y0 = bandIndex * work->itemSize;
+  uint32_t y1 = blMin(y0 + work->itemSize, h);
+
+  uint8_t* paddedRow = workerData + size_t(r) * bpp;
+  uint8_t* tmpLines = workerData + work->rowBufferSize;
+  intptr_t tmpStride = work->tmpStride;
+
+  uint8_t* tmpRow = tmpLines;
+  for (int ty = int(y0) - int(r); ty < int(y1 + r); ty++, tmpRow += tmpStride) {
+    if (uint32_t(ty) >= h && !work->extend) {
+      memset(tmpRow, 0, rowSize);
+      continue;
+    }
+
+    int sy = blClamp(ty, 0, int(h) - 1);
+    imageBlurCopyRow(paddedRow, work->srcLine + intptr_t(sy) * work->srcStride, w, work->format, bpp);
+    imageBlurPadRow(paddedRow, w, bpp, r, r, work->extend);
+    convolve(tmpRow, paddedRow, intptr_t(bpp), rowSize, work->weights, r);
+  }
+
+  uint8_t* dstRow = work->dstLine + intptr_t(y0) * work->dstStride;
+  tmpRow = tmpLines + intptr_t(r) * tmpStride;
+
+  for (uint32_t y = y0; y < y1; y++) {
+    convolve(dstRow, tmpRow, tmpStride, rowSize, work->weights, r);
+    dstRow += work->dstStride;
+    tmpRow += tmpStride;
+  }
+}
+
+// bl::ImageBlur - Box
+// ===================
+
+// Box passes are applied horizontally to bands of rows (each row stays in L1 cache during all passes) and then
+// vertically to strips of columns by sliding column sums down the image. Each pass considers pixels outside of the
+// image transparent (or copies of edge pixels), which only matters when the source has visible pixels near edges.
+static void imageBlurBoxHorzBand(const ImageBlurWork* work, uint32_t bandIndex, uint8_t* workerData) noexcept {
+  BoxHorzFunc boxHorz = imageBlurOps.boxHorz[work->format];
+
+  uint32_t w = work->w;
+  uint32_t bpp = work->bpp;
+  uint32_t pad = work->boxRadius[kBoxPassCount - 1] + 1u;
+
+  uint32_t y0 = bandIndex * work->itemSize;
+  uint32_t y1 = blMin(y0 + work->itemSize, work->h);
+
+  uint8_t* bufA = workerData + size_t(pad) * bpp;
+  uint8_t* bufB = bufA + work->rowBufferSize;
+
+  const uint8_t* srcRow = work->srcLine + intptr_t(y0) * work->srcStride;
+  uint8_t* tmpRow = work->tmpLine + intptr_t(y0) * work->tmpStride;
+
+  for (uint32_t y = y0; y < y1; y++) {
+    uint8_t* passSrc = bufA;
+    uint8_t* passDst = bufB;
+
+    imageBlurCopyRow(passSrc, srcRow, w, work->format, bpp);
+    for (uint32_t pass = 0; pass < kBoxPassCount; pass++) {
+      uint32_t r = work->boxRadius[pass];
+      imageBlurPadRow(passSrc, w, bpp, r, r + 1u, work->extend);
+
+      boxHorz(pass == kBoxPassCount - 1 ? tmpRow : passDst, passSrc, w, r, work->boxRecip[pass]);
+      BLInternal::swap(passSrc, passDst);
+    }
+
+    srcRow += work->srcStride;
+    tmpRow += work->tmpStride;
+  }
+}
+
+static void imageBlurBoxVertPass(const ImageBlurWork* work, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, size_t n, uint32_t r, uint32_t recip, uint32_t* sums) noexcept {
+  BoxVertFunc boxVert = imageBlurOps.boxVert;
+  int h = int(work->h);
+
+  auto rowAt = [&](int y) noexcept -> const uint8_t* {
+    if (unsigned(y) < unsigned(h))
+      return srcLine + intptr_t(y) * srcStride;
+    else if (work->extend)
+      return srcLine + intptr_t(blClamp(y, 0, h - 1)) * srcStride;
+    else
+      return work->zeroLine;
+  };
+
+  memset(sums, 0, n * sizeof(uint32_t));
+  for (int y = -int(r); y <= int(r); y++) {
+    const uint8_t* row = rowAt(y);
+    for (size_t i = 0; i < n; i++)
+      sums[i] += row[i];
+  }
+
+  for (int y = 0; y < h; y++) {
+    boxVert(dstLine, sums, rowAt(y + int(r) + 1), rowAt(y - int(r)), n, recip);
+    dstLine += dstStride;
+  }
+}
+
+static void imageBlurBoxVertStrip(const ImageBlurWork* work, uint32_t stripIndex, uint8_t* workerData) noexcept {
+  size_t x0 = size_t(stripIndex) * work->itemSize;
+  size_t n = blMin<size_t>(work->itemSize, size_t(work->w) * work->bpp - x0);
+  uint32_t* sums = reinterpret_cast<uint32_t*>(workerData);
+
+  // Passes alternate between the intermediate image and the destination, the last pass writes to the destination.
+  static_assert((kBoxPassCount & 1u) != 0, "The number of box passes must be odd");
+
+  uint8_t* lines[2] = { work->tmpLine + x0, work->dstLine + x0 };
+  intptr_t strides[2] = { work->tmpStride, work->dstStride };
+
+  for (uint32_t pass = 0; pass < kBoxPassCount; pass++) {
+    uint32_t srcIndex = pass & 1u;
+    uint32_t dstIndex = srcIndex ^ 1u;
+    imageBlurBoxVertPass(work, lines[dstIndex], strides[dstIndex], lines[srcIndex], strides[srcIndex], n, work->boxRadius[pass], work->boxRecip[pass], sums);
+  }
+}
+
+// bl::ImageBlur - Blur Data
+// =========================
+
+static void imageBlurCopy(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, const BLSizeI& size, uint32_t format, uint32_t bpp) noexcept {
+  for (int y = 0; y < size.h; y++) {
+    imageBlurCopyRow(dstLine, srcLine, uint32_t(size.w), format, bpp);
+    dstLine += dstStride;
+    srcLine += srcStride;
+  }
+}
+
+BLResult blurData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, const BLSizeI& size, uint32_t format, double sigma, BLImageBlurType type) noexcept {
+  if (BL_UNLIKELY(!(sigma >= 0.0 && sigma <= kMaxSigma) || uint32_t(type) > BL_IMAGE_BLUR_TYPE_MAX_VALUE))
+    return blTraceError(BL_ERROR_INVALID_VALUE);
+
+  ImageBlurWork work {};
+  work.w = uint32_t(size.w);
+  work.h = uint32_t(size.h);
+  work.format = format;
+  work.bpp = blFormatInfo[format].depth / 8u;
+  work.extend = format == BL_FORMAT_XRGB32;
+  work.dstLine = dstLine;
+  work.dstStride = dstStride;
+  work.srcLine = srcLine;
+  work.srcStride = srcStride;
+
+  size_t rowSize = size_t(work.w) * work.bpp;
+  size_t rowStride = IntOps::alignUp(rowSize, 16);
+
+  uint32_t threadCount = 1;
+  if (uint64_t(work.w) * uint64_t(work.h) >= kImageBlurThreadingThreshold)
+    threadCount = blMax<uint32_t>(blRuntimeContext.systemInfo.threadCount, 1u);
+
+  ScopedBuffer workerBuffer;
+
+  if (type == BL_IMAGE_BLUR_TYPE_GAUSSIAN) {
+    uint32_t r = gaussianRadius(sigma);
+
+    ScopedBufferTmp<1024> weightsBuffer;
+    int32_t* weights = static_cast<int32_t*>(weightsBuffer.alloc((size_t(r) + 1u) * sizeof(int32_t)));
+
+    if (BL_UNLIKELY(!weights))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+    gaussianWeights(weights, sigma);
+    if (weights[0] == kGaussianWeightScale) {
+      imageBlurCopy(dstLine, dstStride, srcLine, srcStride, size, format, work.bpp);
+      return BL_SUCCESS;
+    }
+
+    // Each band needs `2 * r` additional rows, bands should be at least as tall to keep the overhead reasonable.
+    size_t budgetRows = kImageBlurBandBudget / rowStride;
+    size_t bandHeight = budgetRows > size_t(r) * 4u ? budgetRows - size_t(r) * 2u : size_t(r) * 2u;
+
+    work.weights = weights;
+    work.radius = r;
+    work.itemFunc = imageBlurGaussianBand;
+    work.itemSize = uint32_t(blClamp<size_t>(bandHeight, 1u, work.h));
+    work.itemCount = (work.h + work.itemSize - 1u) / work.itemSize;
+    work.tmpStride = intptr_t(rowStride);
+    work.rowBufferSize = IntOps::alignUp((size_t(work.w) + size_t(r) * 2u) * work.bpp, 16);
+    work.workerDataSize = work.rowBufferSize + rowStride * (size_t(work.itemSize) + size_t(r) * 2u);
+
+    return imageBlurRun(work, threadCount, workerBuffer);
+  }
+  else {
+    boxRadii(work.boxRadius, sigma);
+    if (work.boxRadius[kBoxPassCount - 1] == 0) {
+      imageBlurCopy(dstLine, dstStride, srcLine, srcStride, size, format, work.bpp);
+      return BL_SUCCESS;
+    }
+
+    for (uint32_t pass = 0; pass < kBoxPassCount; pass++)
+      work.boxRecip[pass] = boxReciprocal(work.boxRadius[pass]);
+
+    size_t stripSize = blMin(kImageBlurStripSize, IntOps::alignUp((rowSize + threadCount - 1u) / threadCount, 64));
+
+    ScopedBuffer tmpBuffer;
+    uint8_t* tmpData = static_cast<uint8_t*>(tmpBuffer.alloc(rowStride * work.h + stripSize));
+
+    if (BL_UNLIKELY(!tmpData))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+    uint8_t* zeroLine = tmpData + rowStride * work.h;
+    memset(zeroLine, 0, stripSize);
+
+    work.tmpLine = tmpData;
+    work.tmpStride = intptr_t(rowStride);
+    work.zeroLine = zeroLine;
+
+    // Horizontal passes - the radius of the last pass is the largest one.
+    uint32_t pad = work.boxRadius[kBoxPassCount - 1] + 1u;
+    work.itemFunc = imageBlurBoxHorzBand;
+    work.itemSize = uint32_t(blClamp<size_t>(kImageBlurBandBudget / rowStride, 1u, work.h));
+    work.itemCount = (work.h + work.itemSize - 1u) / work.itemSize;
+    work.rowBufferSize = IntOps::alignUp((size_t(work.w) + size_t(pad) * 2u) * work.bpp, 16);
+    work.workerDataSize = work.rowBufferSize * 2u;
+    BL_PROPAGATE(imageBlurRun(work, threadCount, workerBuffer));
+
+    // Vertical passes.
+    work.itemFunc = imageBlurBoxVertStrip;
+    work.itemSize = uint32_t(stripSize);
+    work.itemCount = uint32_t((rowSize + stripSize - 1u) / stripSize);
+    work.workerDataSize = stripSize * sizeof(uint32_t);
+    return imageBlurRun(work, threadCount, workerBuffer);
+  }
+}
+
+// bl::ImageBlur - Shadow Mask
+// ===========================
+
+BLResult makeShadowMask(BLImageCore* dst, const BLImageCore* src, double sigma, BLPointI* offsetOut) noexcept {
+  using namespace ImageInternal;
+
+  *offsetOut = BLPointI(0, 0);
+  if (BL_UNLIKELY(!(sigma >= 0.0 && sigma <= kMaxSigma)))
+    return blTraceError(BL_ERROR_INVALID_VALUE);
+
+  const BLImagePrivateImpl* srcI = getImpl(src);
+  uint32_t format = srcI->format;
+
+  if (format == BL_FORMAT_NONE)
+    return blImageReset(dst);
+
+  uint32_t r = gaussianRadius(sigma);
+  int w = srcI->size.w;
+  int h = srcI->size.h;
+
+  if (BL_UNLIKELY(uint32_t(w) + r * 2u > uint32_t(BL_RUNTIME_MAX_IMAGE_SIZE) ||
+                  uint32_t(h) + r * 2u > uint32_t(BL_RUNTIME_MAX_IMAGE_SIZE)))
+    return blTraceError(BL_ERROR_IMAGE_TOO_LARGE);
+
+  BLSizeI maskSize(w + int(r * 2u), h + int(r * 2u));
+
+  // The alpha channel is extracted into a padded image first, so the blur never has to look outside of it.
+  BLImage alpha;
+  BLImageData alphaData;
+  BL_PROPAGATE(alpha.create(maskSize.w, maskSize.h, BL_FORMAT_A8));
+  BL_PROPAGATE(alpha.makeMutable(&alphaData));
+
+  uint8_t* alphaLine = static_cast<uint8_t*>(alphaData.pixelData);
+  for (int y = 0; y < maskSize.h; y++)
+    memset(alphaLine + intptr_t(y) * alphaData.stride, 0, size_t(maskSize.w));
+
+  const uint8_t* srcLine = static_cast<const uint8_t*>(srcI->pixelData);
+  uint8_t* dstLine = alphaLine + intptr_t(r) * alphaData.stride + r;
+
+  for (int y = 0; y < h; y++) {
+    switch (format) {
+      case BL_FORMAT_PRGB32:
+        for (int x = 0; x < w; x++)
+          dstLine[x] = srcLine[x * 4 + 3];
+        break;
+
+      case BL_FORMAT_XRGB32:
+        memset(dstLine, 0xFF, size_t(w));
+        break;
+
+      case BL_FORMAT_A8:
+        memcpy(dstLine, srcLine, size_t(w));
+        break;
+
+      default:
+        BL_NOT_REACHED();
+    }
+
+    srcLine += srcI->stride;
+    dstLine += alphaData.stride;
+  }
+
+  BLImageData maskData;
+  BL_PROPAGATE(blImageCreate(dst, maskSize.w, maskSize.h, BL_FORMAT_A8));
+  BL_PROPAGATE(blImageMakeMutable(dst, &maskData));
+  BL_PROPAGATE(blurData(static_cast<uint8_t*>(maskData.pixelData), maskData.stride, alphaLine, alphaData.stride, maskSize, BL_FORMAT_A8, sigma, BL_IMAGE_BLUR_TYPE_GAUSSIAN));
+
+  *offsetOut = BLPointI(int(r), int(r));
+  return BL_SUCCESS;
+}
+
+} // {ImageBlurInternal}
+} // {bl}
+
+// bl::ImageBlur - Runtime Registration
+// ====================================
+
+void blImageBlurRtInit(BLRuntimeContext* rt) noexcept {
+  // Maybe unused, if no architecture dependent optimizations are available.
+  blUnused(rt);
+
+  bl::ImageBlurInternal::ImageBlurOps& ops = bl::ImageBlurInternal::imageBlurOps;
+
+  ops.convolve = bl::ImageBlurInternal::imageBlurConvolve;
+  ops.boxHorz[BL_FORMAT_PRGB32] = bl::ImageBlurInternal::imageBlurBoxHorz<4>;
+  ops.boxHorz[BL_FORMAT_XRGB32] = bl::ImageBlurInternal::imageBlurBoxHorz<4>;
+  ops.boxHorz[BL_FORMAT_A8    ] = bl::ImageBlurInternal::imageBlurBoxHorz<1>;
+  ops.boxVert = bl::ImageBlurInternal::imageBlurBoxVert;
+
+#if defined(BL_BUILD_OPT_SSE4_1)
+  if (blRuntimeHasSSE4_1(rt)) {
+    ops.convolve = bl::ImageBlurInternal::convolve_SSE4_1;
+    ops.boxHorz[BL_FORMAT_PRGB32] = bl::ImageBlurInternal::boxHorz32_SSE4_1;
+    ops.boxHorz[BL_FORMAT_XRGB32] = bl::ImageBlurInternal::boxHorz32_SSE4_1;
+    ops.boxVert = bl::ImageBlurInternal::boxVert_SSE4_1;
+  }
+#endif
+
+#if defined(BL_BUILD_OPT_AVX2)
+  if (blRuntimeHasAVX2(rt)) {
+    ops.convolve = bl::ImageBlurInternal::convolve_AVX2;
+    ops.boxHorz[BL_FORMAT_PRGB32] = bl::ImageBlurInternal::boxHorz32_AVX2;
+    ops.boxHorz[BL_FORMAT_XRGB32] = bl::ImageBlurInternal::boxHorz32_AVX2;
+    ops.boxVert = bl::ImageBlurInternal::boxVert_AVX2;
+  }
+#endif
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+  if (blRuntimeHasASIMD(rt)) {
+    ops.convolve = bl::ImageBlurInternal::convolve_ASIMD;
+    ops.boxHorz[BL_FORMAT_PRGB32] = bl::ImageBlurInternal::boxHorz32_ASIMD;
+    ops.boxHorz[BL_FORMAT_XRGB32] = bl::ImageBlurInternal::boxHorz32_ASIMD;
+    ops.boxVert = bl::ImageBlurInternal::boxVert_ASIMD;
+  }
+#endif
+}
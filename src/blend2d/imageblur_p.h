@@ -0,0 +1,92 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_IMAGEBLUR_P_H_INCLUDED
+#define BLEND2D_IMAGEBLUR_P_H_INCLUDED
+
+#include "geometry.h"
+#include "image.h"
+#include "support/math_p.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_internal
+//! \{
+
+namespace bl {
+namespace ImageBlurInternal {
+
+//! Maximum sigma accepted by `blImageBlur()`.
+static constexpr double kMaxSigma = 1000.0;
+
+//! Number of box blurs that approximate a gaussian blur.
+static constexpr uint32_t kBoxPassCount = 3;
+
+//! Sum of integer gaussian weights (16-bit fixed point).
+static constexpr int32_t kGaussianWeightScale = 0x10000;
+
+//! Returns the radius of a gaussian kernel of the given `sigma`.
+static BL_INLINE uint32_t gaussianRadius(double sigma) noexcept {
+  return uint32_t(Math::ceil(sigma * 3.0));
+}
+
+//! Returns a 24-bit fixed point reciprocal of a box of the given `radius`, which is used to calculate an average.
+static BL_INLINE uint32_t boxReciprocal(uint32_t radius) noexcept {
+  uint32_t size = radius * 2u + 1u;
+  return ((1u << 24) + size / 2u) / size;
+}
+
+//! Calculates integer weights of a symmetric gaussian kernel of `sigma` and stores them to `weights`, which must
+//! have `gaussianRadius(sigma) + 1` items. The first weight is the center weight, the remaining weights are used
+//! by taps on both sides, and the sum of all taps is exactly `kGaussianWeightScale`.
+BL_HIDDEN void gaussianWeights(int32_t* weights, double sigma) noexcept;
+
+//! Calculates radii of `kBoxPassCount` box blurs that approximate a gaussian blur of `sigma`.
+BL_HIDDEN void boxRadii(uint32_t* radii, double sigma) noexcept;
+
+//! Convolves `n` bytes by a symmetric kernel of the given `radius` - taps are `tapStride` bytes apart, thus the same
+//! function is used to convolve rows (`tapStride` is bytes per pixel) and columns (`tapStride` is a row stride).
+//! The `src` must be readable from `-radius * tapStride` to `n + radius * tapStride` bytes.
+typedef void (BL_CDECL* ConvolveFunc)(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) BL_NOEXCEPT;
+
+//! Blurs a row of `w` pixels by a box of the given `radius`. The `src` must be readable from `-radius` to
+//! `w + radius` pixels (inclusive).
+typedef void (BL_CDECL* BoxHorzFunc)(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) BL_NOEXCEPT;
+
+//! Stores `n` bytes of averaged column `sums` to `dst` and then slides the box down by adding `addLine` and
+//! subtracting `subLine` from the sums.
+typedef void (BL_CDECL* BoxVertFunc)(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) BL_NOEXCEPT;
+
+#if defined(BL_BUILD_OPT_SSE4_1)
+BL_HIDDEN void BL_CDECL convolve_SSE4_1(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) noexcept;
+BL_HIDDEN void BL_CDECL boxHorz32_SSE4_1(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) noexcept;
+BL_HIDDEN void BL_CDECL boxVert_SSE4_1(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) noexcept;
+#endif // BL_BUILD_OPT_SSE4_1
+
+#if defined(BL_BUILD_OPT_AVX2)
+BL_HIDDEN void BL_CDECL convolve_AVX2(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) noexcept;
+BL_HIDDEN void BL_CDECL boxHorz32_AVX2(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) noexcept;
+BL_HIDDEN void BL_CDECL boxVert_AVX2(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) noexcept;
+#endif // BL_BUILD_OPT_AVX2
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+BL_HIDDEN void BL_CDECL convolve_ASIMD(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) noexcept;
+BL_HIDDEN void BL_CDECL boxHorz32_ASIMD(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) noexcept;
+BL_HIDDEN void BL_CDECL boxVert_ASIMD(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) noexcept;
+#endif // BL_BUILD_OPT_ASIMD
+
+//! Blurs `src` pixels of the given `size` and `format` and stores the result to `dst`, which must not overlap `src`.
+BL_HIDDEN BLResult blurData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, const BLSizeI& size, uint32_t format, double sigma, BLImageBlurType type) noexcept;
+
+//! Creates an A8 `dst` mask from the alpha channel of `src` blurred by a gaussian blur of `sigma`. The mask is larger
+//! than `src` so it contains the whole blur - the offset of `src` within the mask is stored to `offsetOut`.
+BL_HIDDEN BLResult makeShadowMask(BLImageCore* dst, const BLImageCore* src, double sigma, BLPointI* offsetOut) noexcept;
+
+} // {ImageBlurInternal}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_IMAGEBLUR_P_H_INCLUDED
@@ -0,0 +1,29 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_p.h"
+#if defined(BL_BUILD_OPT_SSE4_1)
+
+#include "imageblursimdimpl_p.h"
+
+namespace bl {
+namespace ImageBlurInternal {
+
+void BL_CDECL convolve_SSE4_1(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) noexcept {
+  convolve(dst, src, tapStride, n, weights, radius);
+}
+
+void BL_CDECL boxHorz32_SSE4_1(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) noexcept {
+  boxHorz32(dst, src, w, radius, recip);
+}
+
+void BL_CDECL boxVert_SSE4_1(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) noexcept {
+  boxVert(dst, sums, addLine, subLine, n, recip);
+}
+
+} // {ImageBlurInternal}
+} // {bl}
+
+#endif // BL_BUILD_OPT_SSE4_1
@@ -0,0 +1,324 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_test_p.h"
+#if defined(BL_TEST)
+
+#include "context.h"
+#include "image_p.h"
+#include "imageblur_p.h"
+#include "random.h"
+#include "support/memops_p.h"
+
+// bl::ImageBlur - Tests
+// =====================
+
+namespace bl {
+namespace Tests {
+
+// Reference implementation that blurs a single row (horizontally) or a single column (vertically) of 32-bit or 8-bit
+// pixels. It uses the same integer math as the optimized implementation, but full-size intermediate images.
+static BL_INLINE const uint8_t* blurReferenceTap(const uint8_t* src, intptr_t advance, int count, int j, bool extend) noexcept {
+  if (j < 0 || j >= count) {
+    if (!extend)
+      return nullptr;
+    j = blClamp(j, 0, count - 1);
+  }
+  return src + intptr_t(j) * advance;
+}
+
+static void gaussianReferenceLine(uint8_t* dst, const uint8_t* src, intptr_t advance, int count, uint32_t bpp, bool extend, const int32_t* weights, int radius) noexcept {
+  for (int i = 0; i < count; i++) {
+    for (uint32_t c = 0; c < bpp; c++) {
+      int32_t acc = 0x8000;
+      for (int k = -radius; k <= radius; k++) {
+        const uint8_t* p = blurReferenceTap(src, advance, count, i + k, extend);
+        if (p)
+          acc += int32_t(p[c]) * weights[blAbs(k)];
+      }
+      dst[intptr_t(i) * advance + intptr_t(c)] = uint8_t(acc >> 16);
+    }
+  }
+}
+
+static void boxReferenceLine(uint8_t* dst, const uint8_t* src, intptr_t advance, int count, uint32_t bpp, bool extend, int radius, uint32_t recip) noexcept {
+  for (int i = 0; i < count; i++) {
+    for (uint32_t c = 0; c < bpp; c++) {
+      uint32_t sum = 0;
+      for (int k = -radius; k <= radius; k++) {
+        const uint8_t* p = blurReferenceTap(src, advance, count, i + k, extend);
+        if (p)
+          sum += p[c];
+      }
+      dst[intptr_t(i) * advance + intptr_t(c)] = uint8_t((sum * recip + 0x800000u) >> 24);
+    }
+  }
+}
+
+static void blurReference(BLImage& dst, const BLImage& src, double sigma, BLImageBlurType type) noexcept {
+  uint32_t format = src.format();
+  uint32_t bpp = format == BL_FORMAT_A8 ? 1u : 4u;
+  bool extend = format == BL_FORMAT_XRGB32;
+
+  int w = src.width();
+  int h = src.height();
+
+  BLImage tmp;
+  BLImageData srcData;
+  BLImageData tmpData;
+  BLImageData dstData;
+
+  EXPECT_SUCCESS(dst.create(w, h, BLFormat(format)));
+  EXPECT_SUCCESS(tmp.create(w, h, BLFormat(format)));
+
+  EXPECT_SUCCESS(src.getData(&srcData));
+  EXPECT_SUCCESS(dst.makeMutable(&dstData));
+  EXPECT_SUCCESS(tmp.makeMutable(&tmpData));
+
+  uint8_t* dstPixels = static_cast<uint8_t*>(dstData.pixelData);
+  uint8_t* tmpPixels = static_cast<uint8_t*>(tmpData.pixelData);
+
+  // The blur starts with a copy of the source in `dst` (XRGB32 pixels are made opaque).
+  for (int y = 0; y < h; y++) {
+    const uint8_t* sp = static_cast<const uint8_t*>(srcData.pixelData) + y * srcData.stride;
+    uint8_t* dp = dstPixels + y * dstData.stride;
+
+    memcpy(dp, sp, size_t(w) * bpp);
+    if (extend) {
+      for (int x = 0; x < w; x++)
+        dp[x * 4 + 3] = 0xFF;
+    }
+  }
+
+  if (type == BL_IMAGE_BLUR_TYPE_GAUSSIAN) {
+    int radius = int(ImageBlurInternal::gaussianRadius(sigma));
+    int32_t weights[256];
+    ImageBlurInternal::gaussianWeights(weights, sigma);
+
+    for (int y = 0; y < h; y++)
+      gaussianReferenceLine(tmpPixels + y * tmpData.stride, dstPixels + y * dstData.stride, intptr_t(bpp), w, bpp, extend, weights, radius);
+
+    for (int x = 0; x < w; x++)
+      gaussianReferenceLine(dstPixels + x * int(bpp), tmpPixels + x * int(bpp), dstData.stride, h, bpp, extend, weights, radius);
+  }
+  else {
+    uint32_t radii[ImageBlurInternal::kBoxPassCount];
+    ImageBlurInternal::boxRadii(radii, sigma);
+
+    for (uint32_t pass = 0; pass < ImageBlurInternal::kBoxPassCount; pass++) {
+      uint32_t recip = ImageBlurInternal::boxReciprocal(radii[pass]);
+      for (int y = 0; y < h; y++)
+        boxReferenceLine(tmpPixels + y * tmpData.stride, dstPixels + y * dstData.stride, intptr_t(bpp), w, bpp, extend, int(radii[pass]), recip);
+      EXPECT_SUCCESS(dst.assignDeep(tmp));
+      EXPECT_SUCCESS(dst.makeMutable(&dstData));
+      dstPixels = static_cast<uint8_t*>(dstData.pixelData);
+    }
+
+    for (uint32_t pass = 0; pass < ImageBlurInternal::kBoxPassCount; pass++) {
+      uint32_t recip = ImageBlurInternal::boxReciprocal(radii[pass]);
+      for (int x = 0; x < w; x++)
+        boxReferenceLine(tmpPixels + x * int(bpp), dstPixels + x * int(bpp), dstData.stride, h, bpp, extend, int(radii[pass]), recip);
+      EXPECT_SUCCESS(dst.assignDeep(tmp));
+      EXPECT_SUCCESS(dst.makeMutable(&dstData));
+      dstPixels = static_cast<uint8_t*>(dstData.pixelData);
+    }
+  }
+}
+
+static void fillRandomPixels(BLImage& img, BLRandom& rnd) noexcept {
+  BLImageData imgData;
+  EXPECT_SUCCESS(img.makeMutable(&imgData));
+
+  for (int y = 0; y < imgData.size.h; y++) {
+    uint8_t* p = static_cast<uint8_t*>(imgData.pixelData) + y * imgData.stride;
+
+    if (imgData.format == BL_FORMAT_A8) {
+      for (int x = 0; x < imgData.size.w; x++)
+        p[x] = uint8_t(rnd.nextUInt32() & 0xFFu);
+    }
+    else {
+      for (int x = 0; x < imgData.size.w; x++) {
+        uint32_t pixel = rnd.nextUInt32();
+        uint32_t a = imgData.format == BL_FORMAT_XRGB32 ? 0xFFu : (pixel >> 24);
+        uint32_t r = ((pixel >> 16) & 0xFFu) * a / 255u;
+        uint32_t g = ((pixel >>  8) & 0xFFu) * a / 255u;
+        uint32_t b = ((pixel      ) & 0xFFu) * a / 255u;
+        MemOps::writeU32u(p + x * 4, (a << 24) | (r << 16) | (g << 8) | b);
+      }
+    }
+  }
+}
+
+static bool isPremultiplied(const BLImage& img) noexcept {
+  BLImageData imgData;
+  EXPECT_SUCCESS(img.getData(&imgData));
+
+  for (int y = 0; y < imgData.size.h; y++) {
+    const uint8_t* p = static_cast<const uint8_t*>(imgData.pixelData) + y * imgData.stride;
+    for (int x = 0; x < imgData.size.w; x++, p += 4) {
+      if (p[0] > p[3] || p[1] > p[3] || p[2] > p[3])
+        return false;
+    }
+  }
+
+  return true;
+}
+
+static void testWeights() noexcept {
+  static const double sigmas[] = { 0.1, 0.5, 1.0, 3.3, 12.0, 85.0 };
+
+  for (double sigma : sigmas) {
+    uint32_t radius = ImageBlurInternal::gaussianRadius(sigma);
+    int32_t weights[256];
+    ImageBlurInternal::gaussianWeights(weights, sigma);
+
+    int32_t sum = weights[0];
+    for (uint32_t i = 1; i <= radius; i++) {
+      // Rounding of cumulative sums can make a weight larger than its inner neighbor by one, but never more.
+      EXPECT_GE(weights[i], 0);
+      EXPECT_LE(weights[i], weights[i - 1] + 1);
+      sum += weights[i] * 2;
+    }
+    EXPECT_EQ(sum, ImageBlurInternal::kGaussianWeightScale).message("Gaussian weights of sigma=%g don't sum to 1", sigma);
+
+    uint32_t radii[ImageBlurInternal::kBoxPassCount];
+    ImageBlurInternal::boxRadii(radii, sigma);
+
+    // The variance of all box passes must approximate the variance of the gaussian.
+    double variance = 0.0;
+    for (uint32_t i = 0; i < ImageBlurInternal::kBoxPassCount; i++)
+      variance += double(radii[i] * (radii[i] + 1u)) / 3.0;
+
+    if (sigma >= 1.0)
+      EXPECT_LT(blAbs(Math::sqrt(variance) - sigma), 0.5).message("Box radii don't approximate sigma=%g", sigma);
+  }
+}
+
+UNIT(image_blur, BL_TEST_GROUP_IMAGE_UTILITIES) {
+  static const BLFormat formats[] = { BL_FORMAT_PRGB32, BL_FORMAT_XRGB32, BL_FORMAT_A8 };
+  static const BLImageBlurType types[] = { BL_IMAGE_BLUR_TYPE_GAUSSIAN, BL_IMAGE_BLUR_TYPE_BOX };
+  static const double sigmas[] = { 0.0, 0.3, 1.0, 2.5, 6.0 };
+
+  // The last size is large enough to distribute bands and strips across worker threads.
+  static const BLSizeI sizes[] = {
+    BLSizeI(1, 1),
+    BLSizeI(37, 23),
+    BLSizeI(5, 61),
+    BLSizeI(301, 257)
+  };
+
+  BLRandom rnd(0x1234);
+
+  INFO("Testing gaussian weights and box radii");
+  testWeights();
+
+  INFO("Testing BLImage::blur() against a reference implementation");
+  for (const BLSizeI& size : sizes) {
+    for (BLFormat format : formats) {
+      BLImage src;
+      EXPECT_SUCCESS(src.create(size.w, size.h, format));
+      fillRandomPixels(src, rnd);
+
+      for (BLImageBlurType type : types) {
+        for (double sigma : sigmas) {
+          BLImage expected;
+          BLImage actual;
+
+          blurReference(expected, src, sigma, type);
+          EXPECT_SUCCESS(BLImage::blur(actual, src, sigma, type));
+
+          EXPECT_TRUE(actual.equals(expected))
+            .message("Blurred image doesn't match the reference (format=%u type=%u sigma=%g size=%dx%d)",
+                     uint32_t(format), uint32_t(type), sigma, size.w, size.h);
+
+          if (format == BL_FORMAT_PRGB32)
+            EXPECT_TRUE(isPremultiplied(actual));
+        }
+      }
+    }
+  }
+
+  INFO("Testing BLImage::blur() in place");
+  {
+    BLImage img;
+    BLImage expected;
+
+    EXPECT_SUCCESS(img.create(67, 45, BL_FORMAT_PRGB32));
+    fillRandomPixels(img, rnd);
+
+    blurReference(expected, img, 2.0, BL_IMAGE_BLUR_TYPE_GAUSSIAN);
+    EXPECT_SUCCESS(BLImage::blur(img, img, 2.0));
+    EXPECT_TRUE(img.equals(expected));
+  }
+
+  INFO("Testing BLImage::blur() with invalid arguments");
+  {
+    BLImage img(16, 16, BL_FORMAT_A8);
+    BLImage dst;
+
+    EXPECT_EQ(BLImage::blur(dst, img, -1.0), BL_ERROR_INVALID_VALUE);
+    EXPECT_EQ(BLImage::blur(dst, img, Math::nan<double>()), BL_ERROR_INVALID_VALUE);
+    EXPECT_EQ(BLImage::blur(dst, img, ImageBlurInternal::kMaxSigma + 1.0), BL_ERROR_INVALID_VALUE);
+    EXPECT_EQ(BLImage::blur(dst, img, 1.0, BLImageBlurType(BL_IMAGE_BLUR_TYPE_MAX_VALUE + 1)), BL_ERROR_INVALID_VALUE);
+
+    EXPECT_SUCCESS(BLImage::blur(dst, BLImage(), 1.0));
+    EXPECT_TRUE(dst.empty());
+  }
+
+  INFO("Testing BLContext::fillShadow()");
+  {
+    double sigma = 3.0;
+    int r = int(ImageBlurInternal::gaussianRadius(sigma));
+
+    BLImage glyph(20, 12, BL_FORMAT_PRGB32);
+    fillRandomPixels(glyph, rnd);
+
+    // The shadow mask is the alpha of the image padded by the blur radius and blurred.
+    BLImage alpha(20 + r * 2, 12 + r * 2, BL_FORMAT_A8);
+    {
+      BLImageData glyphData;
+      BLImageData alphaData;
+      EXPECT_SUCCESS(glyph.getData(&glyphData));
+      EXPECT_SUCCESS(alpha.makeMutable(&alphaData));
+
+      for (int y = 0; y < alphaData.size.h; y++) {
+        uint8_t* dp = static_cast<uint8_t*>(alphaData.pixelData) + y * alphaData.stride;
+        memset(dp, 0, size_t(alphaData.size.w));
+
+        if (y >= r && y - r < glyphData.size.h) {
+          const uint8_t* sp = static_cast<const uint8_t*>(glyphData.pixelData) + (y - r) * glyphData.stride;
+          for (int x = 0; x < glyphData.size.w; x++)
+            dp[r + x] = sp[x * 4 + 3];
+        }
+      }
+    }
+
+    BLImage mask;
+    EXPECT_SUCCESS(BLImage::blur(mask, alpha, sigma));
+
+    BLImage expected(64, 48, BL_FORMAT_PRGB32);
+    BLImage actual(64, 48, BL_FORMAT_PRGB32);
+
+    {
+      BLContext ctx(expected);
+      ctx.clearAll();
+      ctx.fillMask(BLPointI(10 - r, 12 - r), mask, BLRgba32(0xFF102030u));
+    }
+
+    {
+      BLContext ctx(actual);
+      ctx.clearAll();
+      EXPECT_SUCCESS(ctx.fillShadow(BLPoint(10, 12), glyph, sigma, BLRgba32(0xFF102030u)));
+      EXPECT_SUCCESS(ctx.fillShadow(BLPoint(10, 12), BLImage(), sigma));
+    }
+
+    EXPECT_TRUE(actual.equals(expected));
+  }
+}
+
+} // {Tests}
+} // {bl}
+
+#endif // BL_TEST
@@ -0,0 +1,231 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_IMAGEBLURSIMDIMPL_P_H_INCLUDED
+#define BLEND2D_IMAGEBLURSIMDIMPL_P_H_INCLUDED
+
+#include "imageblur_p.h"
+#include "simd/simd_p.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_internal
+//! \{
+
+namespace bl {
+namespace ImageBlurInternal {
+
+// bl::ImageBlur - SIMD Implementation [SSE4.1 & AVX2 & ASIMD]
+// ===========================================================
+//
+// The SIMD implementation must produce exactly the same output as the portable implementation in `imageblur.cpp`.
+// Gaussian convolution adds symmetric taps in 16-bit lanes first and then accumulates products in 32-bit lanes, box
+// blur keeps its sums in 32-bit lanes, which are stored linearly (one sum per byte) in the same way as the portable
+// implementation does, thus box passes always use 128-bit vectors.
+
+namespace {
+
+using namespace SIMD;
+
+// The widest integer vector, which is used by gaussian convolution.
+#if BL_SIMD_WIDTH_I >= 256
+typedef Vec32xU8 VecWide;
+#else
+typedef Vec16xU8 VecWide;
+#endif
+
+#if BL_TARGET_ARCH_X86
+template<typename V> static BL_INLINE V broadcastI32(int32_t x) noexcept { return make_i32<V>(x); }
+#else
+template<typename V> static BL_INLINE V broadcastI32(int32_t x) noexcept { return make128_i32<V>(x); }
+#endif
+
+// Loads and stores either a full vector or just 4 bytes, which is used to process the remaining 32-bit pixels.
+template<typename V, size_t kSize>
+struct VecIO {
+  static BL_INLINE V load(const uint8_t* p) noexcept { return loadu<V>(p); }
+  static BL_INLINE void store(uint8_t* p, const V& v) noexcept { storeu(p, v); }
+};
+
+template<typename V>
+struct VecIO<V, 4> {
+  static BL_INLINE V load(const uint8_t* p) noexcept { return loadu_32<V>(p); }
+  static BL_INLINE void store(uint8_t* p, const V& v) noexcept { storeu_32(p, v); }
+};
+
+// Converts four vectors of 32-bit fixed point values to bytes (shifting right by `kShift`).
+template<uint32_t kShift, typename V>
+static BL_INLINE V packFixed(const V& a0, const V& a1, const V& a2, const V& a3) noexcept {
+  V lo = packs_128_i32_i16(srli_u32<kShift>(a0), srli_u32<kShift>(a1));
+  V hi = packs_128_i32_i16(srli_u32<kShift>(a2), srli_u32<kShift>(a3));
+  return packs_128_i16_u8(lo, hi);
+}
+
+// bl::ImageBlur - SIMD Implementation - Gaussian
+// ==============================================
+
+template<typename V, size_t kSize>
+static BL_INLINE V convolveChunk(const uint8_t* sp, intptr_t tapStride, const int32_t* weights, uint32_t radius) noexcept {
+  V zero = make_zero<V>();
+  V half = broadcastI32<V>(0x8000);
+
+  V p0 = VecIO<V, kSize>::load(sp);
+  V w0 = broadcastI32<V>(weights[0]);
+
+  V pLo = interleave_lo_u8(p0, zero);
+  V pHi = interleave_hi_u8(p0, zero);
+
+  V acc0 = add_i32(half, mul_i32(interleave_lo_u16(pLo, zero), w0));
+  V acc1 = add_i32(half, mul_i32(interleave_hi_u16(pLo, zero), w0));
+  V acc2 = add_i32(half, mul_i32(interleave_lo_u16(pHi, zero), w0));
+  V acc3 = add_i32(half, mul_i32(interleave_hi_u16(pHi, zero), w0));
+
+  const uint8_t* spL = sp;
+  const uint8_t* spR = sp;
+
+  for (uint32_t k = 1; k <= radius; k++) {
+    spL -= tapStride;
+    spR += tapStride;
+
+    V a = VecIO<V, kSize>::load(spL);
+    V b = VecIO<V, kSize>::load(spR);
+    V w = broadcastI32<V>(weights[k]);
+
+    V sLo = add_u16(interleave_lo_u8(a, zero), interleave_lo_u8(b, zero));
+    V sHi = add_u16(interleave_hi_u8(a, zero), interleave_hi_u8(b, zero));
+
+    acc0 = add_i32(acc0, mul_i32(interleave_lo_u16(sLo, zero), w));
+    acc1 = add_i32(acc1, mul_i32(interleave_hi_u16(sLo, zero), w));
+    acc2 = add_i32(acc2, mul_i32(interleave_lo_u16(sHi, zero), w));
+    acc3 = add_i32(acc3, mul_i32(interleave_hi_u16(sHi, zero), w));
+  }
+
+  return packFixed<16>(acc0, acc1, acc2, acc3);
+}
+
+static BL_INLINE void convolve(uint8_t* dst, const uint8_t* src, intptr_t tapStride, size_t n, const int32_t* weights, uint32_t radius) noexcept {
+  constexpr size_t kWideSize = sizeof(VecWide);
+
+  while (n >= kWideSize) {
+    VecIO<VecWide, kWideSize>::store(dst, convolveChunk<VecWide, kWideSize>(src, tapStride, weights, radius));
+    dst += kWideSize;
+    src += kWideSize;
+    n -= kWideSize;
+  }
+
+  while (n >= 4) {
+    VecIO<Vec16xU8, 4>::store(dst, convolveChunk<Vec16xU8, 4>(src, tapStride, weights, radius));
+    dst += 4;
+    src += 4;
+    n -= 4;
+  }
+
+  // Only A8 can have remaining bytes.
+  while (n) {
+    int32_t c = 0x8000 + int32_t(src[0]) * weights[0];
+    for (uint32_t k = 1; k <= radius; k++) {
+      intptr_t offset = intptr_t(k) * tapStride;
+      c += int32_t(uint32_t(src[-offset]) + uint32_t(src[offset])) * weights[k];
+    }
+
+    dst[0] = uint8_t(c >> 16);
+    dst++;
+    src++;
+    n--;
+  }
+}
+
+// bl::ImageBlur - SIMD Implementation - Box
+// =========================================
+
+static BL_INLINE void boxHorz32(uint8_t* dst, const uint8_t* src, uint32_t w, uint32_t radius, uint32_t recip) noexcept {
+  Vec16xU8 sum = make_zero<Vec16xU8>();
+  Vec16xU8 recipV = broadcastI32<Vec16xU8>(int32_t(recip));
+  Vec16xU8 half = broadcastI32<Vec16xU8>(0x800000);
+
+  const uint8_t* subPtr = src - size_t(radius) * 4u;
+  const uint8_t* addPtr = subPtr;
+
+  for (uint32_t i = radius * 2u + 1u; i; i--) {
+    sum = add_i32(sum, unpack_lo32_u8_u32(loadu_32<Vec16xU8>(addPtr)));
+    addPtr += 4;
+  }
+
+  for (uint32_t x = 0; x < w; x++) {
+    Vec16xU8 pix = srli_u32<24>(add_i32(mul_i32(sum, recipV), half));
+    storeu_32(dst, packs_128_i16_u8(packs_128_i32_i16(pix)));
+
+    Vec16xU8 a = unpack_lo32_u8_u32(loadu_32<Vec16xU8>(addPtr));
+    Vec16xU8 s = unpack_lo32_u8_u32(loadu_32<Vec16xU8>(subPtr));
+    sum = add_i32(sum, sub_i32(a, s));
+
+    dst += 4;
+    addPtr += 4;
+    subPtr += 4;
+  }
+}
+
+static BL_INLINE void boxVert(uint8_t* dst, uint32_t* sums, const uint8_t* addLine, const uint8_t* subLine, size_t n, uint32_t recip) noexcept {
+  Vec16xU8 zero = make_zero<Vec16xU8>();
+  Vec16xU8 recipV = broadcastI32<Vec16xU8>(int32_t(recip));
+  Vec16xU8 half = broadcastI32<Vec16xU8>(0x800000);
+
+  while (n >= 16) {
+    Vec16xU8 s0 = loadu<Vec16xU8>(sums + 0);
+    Vec16xU8 s1 = loadu<Vec16xU8>(sums + 4);
+    Vec16xU8 s2 = loadu<Vec16xU8>(sums + 8);
+    Vec16xU8 s3 = loadu<Vec16xU8>(sums + 12);
+
+    Vec16xU8 pix = packFixed<24>(add_i32(mul_i32(s0, recipV), half),
+                                 add_i32(mul_i32(s1, recipV), half),
+                                 add_i32(mul_i32(s2, recipV), half),
+                                 add_i32(mul_i32(s3, recipV), half));
+    storeu(dst, pix);
+
+    Vec16xU8 a = loadu<Vec16xU8>(addLine);
+    Vec16xU8 b = loadu<Vec16xU8>(subLine);
+
+    Vec16xU8 aLo = interleave_lo_u8(a, zero);
+    Vec16xU8 aHi = interleave_hi_u8(a, zero);
+    Vec16xU8 bLo = interleave_lo_u8(b, zero);
+    Vec16xU8 bHi = interleave_hi_u8(b, zero);
+
+    s0 = add_i32(s0, sub_i32(interleave_lo_u16(aLo, zero), interleave_lo_u16(bLo, zero)));
+    s1 = add_i32(s1, sub_i32(interleave_hi_u16(aLo, zero), interleave_hi_u16(bLo, zero)));
+    s2 = add_i32(s2, sub_i32(interleave_lo_u16(aHi, zero), interleave_lo_u16(bHi, zero)));
+    s3 = add_i32(s3, sub_i32(interleave_hi_u16(aHi, zero), interleave_hi_u16(bHi, zero)));
+
+    storeu(sums + 0, s0);
+    storeu(sums + 4, s1);
+    storeu(sums + 8, s2);
+    storeu(sums + 12, s3);
+
+    dst += 16;
+    sums += 16;
+    addLine += 16;
+    subLine += 16;
+    n -= 16;
+  }
+
+  while (n) {
+    dst[0] = uint8_t((sums[0] * recip + 0x800000u) >> 24);
+    sums[0] += uint32_t(addLine[0]) - uint32_t(subLine[0]);
+
+    dst++;
+    sums++;
+    addLine++;
+    subLine++;
+    n--;
+  }
+}
+
+} // {anonymous}
+
+} // {ImageBlurInternal}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_IMAGEBLURSIMDIMPL_P_H_INCLUDED
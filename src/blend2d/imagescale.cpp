@@ -13,6 +13,8 @@
 #include "support/memops_p.h"
 #include "support/ptrops_p.h"
 #include "support/scopedbuffer_p.h"
+#include "threading/atomic_p.h"
+#include "threading/threadpool_p.h"
 
 namespace bl {
 
@@ -23,8 +25,8 @@ typedef void (BL_CDECL* ImageScaleFilterFunc)(double* dst, const double* tArray,
 
 struct ImageScaleOps {
   BLResult (BL_CDECL* weights)(ImageScaleContext::Data* d, uint32_t dir, ImageScaleFilterFunc filterFunc) BL_NOEXCEPT;
-  void (BL_CDECL* horz[BL_FORMAT_MAX_VALUE + 1])(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) BL_NOEXCEPT;
-  void (BL_CDECL* vert[BL_FORMAT_MAX_VALUE + 1])(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) BL_NOEXCEPT;
+  ImageScaleInternal::HorzFunc horz[BL_FORMAT_MAX_VALUE + 1];
+  ImageScaleInternal::VertFunc vert[BL_FORMAT_MAX_VALUE + 1];
 };
 static ImageScaleOps imageScaleOps;
 
@@ -190,16 +192,62 @@ static BLResult BL_CDECL imageScaleWeights(ImageScaleContext::Data* d, uint32_t
   return BL_SUCCESS;
 }
 
+static void imageScaleHorzPairs(ImageScaleContext::Data* d) noexcept {
+  uint32_t dw = uint32_t(d->dstSize[ImageScaleContext::kDirHorz]);
+  uint32_t sw = uint32_t(d->srcSize[ImageScaleContext::kDirHorz]);
+  uint32_t kernelSize = uint32_t(d->kernelSize[ImageScaleContext::kDirHorz]);
+
+  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
+  const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
+
+  ImageScaleContext::PairRecord* pairList = d->horzPairList;
+  int16_t* pairWeightList = d->horzPairWeightList;
+
+  for (uint32_t i = 0; i < dw; i += 2) {
+    uint32_t n = blMin<uint32_t>(dw - i, 2);
+    uint32_t count = 0;
+
+    for (uint32_t k = 0; k < n; k++)
+      count = blMax(count, recordList[i + k].count);
+
+    memset(pairWeightList, 0, size_t(kernelSize) * 8u * sizeof(int16_t));
+    pairList->pos[0] = 0;
+    pairList->pos[1] = 0;
+    pairList->count = count;
+
+    for (uint32_t k = 0; k < n; k++) {
+      const ImageScaleContext::Record& record = recordList[i + k];
+      const int32_t* wp = weightList + size_t(i + k) * kernelSize;
+
+      uint32_t pos = blMin(record.pos, sw - count);
+      uint32_t shift = record.pos - pos;
+
+      for (uint32_t j = 0; j < record.count; j++) {
+        BL_ASSERT(wp[j] >= 0 && wp[j] <= 0x100);
+        int16_t* pw = pairWeightList + (shift + j) * 8u + k * 4u;
+        pw[0] = int16_t(wp[j]);
+        pw[1] = int16_t(wp[j]);
+        pw[2] = int16_t(wp[j]);
+        pw[3] = int16_t(wp[j]);
+      }
+
+      pairList->pos[k] = pos;
+    }
+
+    pairList++;
+    pairWeightList += size_t(kernelSize) * 8u;
+  }
+}
+
 // bl::ImageScale - Horz
 // =====================
 
-static void BL_CDECL imageScaleHorzPrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) noexcept {
+static void BL_CDECL imageScaleHorzPrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
   uint32_t dw = uint32_t(d->dstSize[0]);
-  uint32_t sh = uint32_t(d->srcSize[1]);
   uint32_t kernelSize = uint32_t(d->kernelSize[0]);
 
   if (!d->isUnbound[ImageScaleContext::kDirHorz]) {
-    for (uint32_t y = 0; y < sh; y++) {
+    for (uint32_t y = 0; y < h; y++) {
       const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
       const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
 
@@ -235,7 +283,7 @@ static void BL_CDECL imageScaleHorzPrgb32(const ImageScaleContext::Data* d, uint
     }
   }
   else {
-    for (uint32_t y = 0; y < sh; y++) {
+    for (uint32_t y = 0; y < h; y++) {
       const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
       const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
 
@@ -281,13 +329,12 @@ static void BL_CDECL imageScaleHorzPrgb32(const ImageScaleContext::Data* d, uint
   }
 }
 
-static void BL_CDECL imageScaleHorzXrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) noexcept {
+static void BL_CDECL imageScaleHorzXrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
   uint32_t dw = uint32_t(d->dstSize[0]);
-  uint32_t sh = uint32_t(d->srcSize[1]);
   uint32_t kernelSize = uint32_t(d->kernelSize[0]);
 
   if (!d->isUnbound[ImageScaleContext::kDirHorz]) {
-    for (uint32_t y = 0; y < sh; y++) {
+    for (uint32_t y = 0; y < h; y++) {
       const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
       const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
 
@@ -323,7 +370,7 @@ static void BL_CDECL imageScaleHorzXrgb32(const ImageScaleContext::Data* d, uint
     }
   }
   else {
-    for (uint32_t y = 0; y < sh; y++) {
+    for (uint32_t y = 0; y < h; y++) {
       const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
       const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
 
@@ -366,13 +413,12 @@ static void BL_CDECL imageScaleHorzXrgb32(const ImageScaleContext::Data* d, uint
   }
 }
 
-static void BL_CDECL imageScaleHorzA8(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) noexcept {
+static void BL_CDECL imageScaleHorzA8(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
   uint32_t dw = uint32_t(d->dstSize[0]);
-  uint32_t sh = uint32_t(d->srcSize[1]);
   uint32_t kernelSize = uint32_t(d->kernelSize[0]);
 
   if (!d->isUnbound[ImageScaleContext::kDirHorz]) {
-    for (uint32_t y = 0; y < sh; y++) {
+    for (uint32_t y = 0; y < h; y++) {
       const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
       const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
 
@@ -407,7 +453,7 @@ static void BL_CDECL imageScaleHorzA8(const ImageScaleContext::Data* d, uint8_t*
     }
   }
   else {
-    for (uint32_t y = 0; y < sh; y++) {
+    for (uint32_t y = 0; y < h; y++) {
       const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
       const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
 
@@ -446,17 +492,16 @@ static void BL_CDECL imageScaleHorzA8(const ImageScaleContext::Data* d, uint8_t*
 // bl::ImageScale - Vert
 // =====================
 
-static void BL_CDECL imageScaleVertPrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) noexcept {
+static void BL_CDECL imageScaleVertPrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
   uint32_t dw = uint32_t(d->dstSize[0]);
-  uint32_t dh = uint32_t(d->dstSize[1]);
   uint32_t kernelSize = uint32_t(d->kernelSize[ImageScaleContext::kDirVert]);
 
-  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert];
-  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert];
+  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert] + y0;
+  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert] + size_t(y0) * kernelSize;
 
   if (!d->isUnbound[ImageScaleContext::kDirVert]) {
-    for (uint32_t y = 0; y < dh; y++) {
-      const uint8_t* srcData = srcLine + intptr_t(recordList->pos) * srcStride;
+    for (uint32_t y = y0; y < y1; y++) {
+      const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
       uint8_t* dp = dstLine;
 
       uint32_t count = recordList->count;
@@ -490,8 +535,8 @@ static void BL_CDECL imageScaleVertPrgb32(const ImageScaleContext::Data* d, uint
     }
   }
   else {
-    for (uint32_t y = 0; y < dh; y++) {
-      const uint8_t* srcData = srcLine + intptr_t(recordList->pos) * srcStride;
+    for (uint32_t y = y0; y < y1; y++) {
+      const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
       uint8_t* dp = dstLine;
 
       uint32_t count = recordList->count;
@@ -535,17 +580,16 @@ static void BL_CDECL imageScaleVertPrgb32(const ImageScaleContext::Data* d, uint
   }
 }
 
-static void BL_CDECL imageScaleVertXrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) noexcept {
+static void BL_CDECL imageScaleVertXrgb32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
   uint32_t dw = uint32_t(d->dstSize[0]);
-  uint32_t dh = uint32_t(d->dstSize[1]);
   uint32_t kernelSize = uint32_t(d->kernelSize[ImageScaleContext::kDirVert]);
 
-  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert];
-  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert];
+  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert] + y0;
+  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert] + size_t(y0) * kernelSize;
 
   if (!d->isUnbound[ImageScaleContext::kDirVert]) {
-    for (uint32_t y = 0; y < dh; y++) {
-      const uint8_t* srcData = srcLine + intptr_t(recordList->pos) * srcStride;
+    for (uint32_t y = y0; y < y1; y++) {
+      const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
       uint8_t* dp = dstLine;
 
       uint32_t count = recordList->count;
@@ -579,8 +623,8 @@ static void BL_CDECL imageScaleVertXrgb32(const ImageScaleContext::Data* d, uint
     }
   }
   else {
-    for (uint32_t y = 0; y < dh; y++) {
-      const uint8_t* srcData = srcLine + intptr_t(recordList->pos) * srcStride;
+    for (uint32_t y = y0; y < y1; y++) {
+      const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
       uint8_t* dp = dstLine;
 
       uint32_t count = recordList->count;
@@ -621,17 +665,16 @@ static void BL_CDECL imageScaleVertXrgb32(const ImageScaleContext::Data* d, uint
   }
 }
 
-static void BL_CDECL blImageScaleVertBytes(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t wScale) noexcept {
+static void BL_CDECL blImageScaleVertBytes(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY, uint32_t wScale) noexcept {
   uint32_t dw = uint32_t(d->dstSize[0]) * wScale;
-  uint32_t dh = uint32_t(d->dstSize[1]);
   uint32_t kernelSize = uint32_t(d->kernelSize[ImageScaleContext::kDirVert]);
 
-  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert];
-  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert];
+  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert] + y0;
+  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert] + size_t(y0) * kernelSize;
 
   if (!d->isUnbound[ImageScaleContext::kDirVert]) {
-    for (uint32_t y = 0; y < dh; y++) {
-      const uint8_t* srcData = srcLine + intptr_t(recordList->pos) * srcStride;
+    for (uint32_t y = y0; y < y1; y++) {
+      const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
       uint8_t* dp = dstLine;
 
       uint32_t x = dw;
@@ -640,7 +683,7 @@ static void BL_CDECL blImageScaleVertBytes(const ImageScaleContext::Data* d, uin
 
       if (((intptr_t)dp & 0x7) == 0)
         goto BoundLarge;
-      i = 8u - uint32_t((uintptr_t)dp & 0x7u);
+      i = blMin<uint32_t>(8u - uint32_t((uintptr_t)dp & 0x7u), x);
 
 BoundSmall:
       x -= i;
@@ -708,8 +751,8 @@ BoundLarge:
     }
   }
   else {
-    for (uint32_t y = 0; y < dh; y++) {
-      const uint8_t* srcData = srcLine + intptr_t(recordList->pos) * srcStride;
+    for (uint32_t y = y0; y < y1; y++) {
+      const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
       uint8_t* dp = dstLine;
 
       uint32_t x = dw;
@@ -718,7 +761,7 @@ BoundLarge:
 
       if (((size_t)dp & 0x3) == 0)
         goto UnboundLarge;
-      i = 4u - uint32_t((uintptr_t)dp & 0x3u);
+      i = blMin<uint32_t>(4u - uint32_t((uintptr_t)dp & 0x3u), x);
 
 UnboundSmall:
       x -= i;
@@ -787,8 +830,8 @@ UnboundLarge:
   }
 }
 
-static void BL_CDECL imageScaleVertA8(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride) noexcept {
-  blImageScaleVertBytes(d, dstLine, dstStride, srcLine, srcStride, 1);
+static void BL_CDECL imageScaleVertA8(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
+  blImageScaleVertBytes(d, dstLine, dstStride, srcLine, srcStride, y0, y1, srcY, 1);
 }
 
 // bl::ImageScaleContext - Reset
@@ -854,7 +897,10 @@ BLResult ImageScaleContext::create(const BLSizeI& to, const BLSizeI& from, uint3
   size_t hWeightDataSize = size_t(to.h) * unsigned(kernelSize[1]) * sizeof(int32_t);
   size_t wRecordDataSize = size_t(to.w) * sizeof(Record);
   size_t hRecordDataSize = size_t(to.h) * sizeof(Record);
-  size_t dataSize = sizeof(Data) + wWeightDataSize + hWeightDataSize + wRecordDataSize + hRecordDataSize;
+  size_t wPairCount = (size_t(to.w) + 1u) / 2u;
+  size_t wPairDataSize = wPairCount * sizeof(PairRecord);
+  size_t wPairWeightDataSize = wPairCount * unsigned(kernelSize[0]) * 8u * sizeof(int16_t);
+  size_t dataSize = sizeof(Data) + wWeightDataSize + hWeightDataSize + wRecordDataSize + hRecordDataSize + wPairDataSize + wPairWeightDataSize;
 
   if (this->data)
     free(this->data);
@@ -887,13 +933,18 @@ BLResult ImageScaleContext::create(const BLSizeI& to, const BLSizeI& from, uint3
   d->weightList[kDirHorz] = reinterpret_cast<int32_t*>(dataPtr); dataPtr += wWeightDataSize;
   d->weightList[kDirVert] = reinterpret_cast<int32_t*>(dataPtr); dataPtr += hWeightDataSize;
   d->recordList[kDirHorz] = reinterpret_cast<Record*>(dataPtr); dataPtr += wRecordDataSize;
-  d->recordList[kDirVert] = reinterpret_cast<Record*>(dataPtr);
+  d->recordList[kDirVert] = reinterpret_cast<Record*>(dataPtr); dataPtr += hRecordDataSize;
+  d->horzPairList = reinterpret_cast<PairRecord*>(dataPtr); dataPtr += wPairDataSize;
+  d->horzPairWeightList = reinterpret_cast<int16_t*>(dataPtr);
 
   // Built-in filters will probably never fail, however, custom filters can and
   // it wouldn't be safe to just continue.
   imageScaleOps.weights(d, kDirHorz, filterFunc);
   imageScaleOps.weights(d, kDirVert, filterFunc);
 
+  if (!d->isUnbound[kDirHorz])
+    imageScaleHorzPairs(d);
+
   return BL_SUCCESS;
 }
 
@@ -902,13 +953,186 @@ BLResult ImageScaleContext::create(const BLSizeI& to, const BLSizeI& from, uint3
 
 BLResult ImageScaleContext::processHorzData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t format) const noexcept {
   BL_ASSERT(isInitialized());
-  imageScaleOps.horz[format](this->data, dstLine, dstStride, srcLine, srcStride);
+  imageScaleOps.horz[format](this->data, dstLine, dstStride, srcLine, srcStride, uint32_t(srcHeight()));
   return BL_SUCCESS;
 }
 
 BLResult ImageScaleContext::processVertData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t format) const noexcept {
   BL_ASSERT(isInitialized());
-  imageScaleOps.vert[format](this->data, dstLine, dstStride, srcLine, srcStride);
+  imageScaleOps.vert[format](this->data, dstLine, dstStride, srcLine, srcStride, 0, uint32_t(dstHeight()), 0);
+  return BL_SUCCESS;
+}
+
+// bl::ImageScale - Process Bands
+// ==============================
+
+//! Maximum size of horizontally scaled rows required to calculate a single band (should fit into L2 cache).
+static constexpr size_t kImageScaleBandBudget = 256u * 1024u;
+
+//! Minimum number of destination pixels required to distribute bands across the thread-pool.
+static constexpr uint64_t kImageScaleThreadingThreshold = 512u * 512u;
+
+enum ImageScaleBandMode : uint32_t {
+  kImageScaleBandHorz = 0,
+  kImageScaleBandVert = 1,
+  kImageScaleBandBoth = 2
+};
+
+struct ImageScaleBandWork {
+  const ImageScaleContext::Data* d;
+  ImageScaleInternal::HorzFunc horz;
+  ImageScaleInternal::VertFunc vert;
+  uint32_t mode;
+
+  uint32_t bandHeight;
+  uint32_t bandCount;
+  uint32_t bandIndex;
+
+  uint8_t* dstLine;
+  intptr_t dstStride;
+  const uint8_t* srcLine;
+  intptr_t srcStride;
+
+  uint8_t* tmpData;
+  intptr_t tmpStride;
+  size_t tmpWorkerSize;
+};
+
+//! Calculates the range of source rows `[srcY0, srcY1)` required to calculate destination rows `[y0, y1)`.
+static BL_INLINE void imageScaleSourceRange(const ImageScaleContext::Data* d, uint32_t y0, uint32_t y1, uint32_t& srcY0, uint32_t& srcY1) noexcept {
+  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert];
+
+  uint32_t minY = 0xFFFFFFFFu;
+  uint32_t maxY = 0;
+
+  for (uint32_t y = y0; y < y1; y++) {
+    const ImageScaleContext::Record& record = recordList[y];
+    if (record.count) {
+      minY = blMin(minY, record.pos);
+      maxY = blMax(maxY, record.pos + record.count);
+    }
+  }
+
+  if (minY >= maxY) {
+    minY = 0;
+    maxY = 0;
+  }
+
+  srcY0 = minY;
+  srcY1 = maxY;
+}
+
+static void imageScaleProcessBand(const ImageScaleBandWork* work, uint32_t bandIndex, uint8_t* tmpData) noexcept {
+  const ImageScaleContext::Data* d = work->d;
+
+  uint32_t y0 = bandIndex * work->bandHeight;
+  uint32_t y1 = blMin(y0 + work->bandHeight, uint32_t(d->dstSize[ImageScaleContext::kDirVert]));
+  uint8_t* dstLine = work->dstLine + intptr_t(y0) * work->dstStride;
+
+  switch (work->mode) {
+    case kImageScaleBandHorz: {
+      const uint8_t* srcLine = work->srcLine + intptr_t(y0) * work->srcStride;
+      work->horz(d, dstLine, work->dstStride, srcLine, work->srcStride, y1 - y0);
+      break;
+    }
+
+    case kImageScaleBandVert: {
+      work->vert(d, dstLine, work->dstStride, work->srcLine, work->srcStride, y0, y1, 0);
+      break;
+    }
+
+    case kImageScaleBandBoth: {
+      uint32_t srcY0;
+      uint32_t srcY1;
+      imageScaleSourceRange(d, y0, y1, srcY0, srcY1);
+
+      const uint8_t* srcLine = work->srcLine + intptr_t(srcY0) * work->srcStride;
+      work->horz(d, tmpData, work->tmpStride, srcLine, work->srcStride, srcY1 - srcY0);
+      work->vert(d, dstLine, work->dstStride, tmpData, work->tmpStride, y0, y1, srcY0);
+      break;
+    }
+
+    default:
+      BL_NOT_REACHED();
+  }
+}
+
+static void BL_CDECL imageScaleBandWorker(void* data, uint32_t workerId) noexcept {
+  ImageScaleBandWork* work = static_cast<ImageScaleBandWork*>(data);
+  uint8_t* tmpData = work->tmpData ? work->tmpData + size_t(workerId) * work->tmpWorkerSize : nullptr;
+
+  for (;;) {
+    uint32_t bandIndex = blAtomicFetchAddRelaxed(&work->bandIndex);
+    if (bandIndex >= work->bandCount)
+      break;
+    imageScaleProcessBand(work, bandIndex, tmpData);
+  }
+}
+
+BLResult ImageScaleContext::processData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t format) const noexcept {
+  BL_ASSERT(isInitialized());
+
+  const Data* d = this->data;
+  uint32_t dw = uint32_t(dstWidth());
+  uint32_t dh = uint32_t(dstHeight());
+  uint32_t bytesPerPixel = blFormatInfo[format].depth / 8u;
+
+  ImageScaleBandWork work {};
+  work.d = d;
+  work.horz = imageScaleOps.horz[format];
+  work.vert = imageScaleOps.vert[format];
+  work.dstLine = dstLine;
+  work.dstStride = dstStride;
+  work.srcLine = srcLine;
+  work.srcStride = srcStride;
+
+  size_t rowSize = size_t(dw) * bytesPerPixel;
+  size_t budgetRows = blMax<size_t>(kImageScaleBandBudget / rowSize, 1u);
+
+  if (uint32_t(srcHeight()) == dh) {
+    work.mode = kImageScaleBandHorz;
+    work.bandHeight = uint32_t(blMin<size_t>(budgetRows, dh));
+  }
+  else if (uint32_t(srcWidth()) == dw) {
+    work.mode = kImageScaleBandVert;
+    work.bandHeight = uint32_t(blMin<size_t>(budgetRows, dh));
+  }
+  else {
+    // Each band needs `bandHeight / scale` source rows plus the rows covered by the kernel.
+    double rowsAvailable = double(blMax<size_t>(budgetRows, size_t(d->kernelSize[kDirVert]) + 1u) - size_t(d->kernelSize[kDirVert]));
+    work.mode = kImageScaleBandBoth;
+    work.bandHeight = uint32_t(blClamp(rowsAvailable * d->scale[kDirVert], 1.0, double(dh)));
+  }
+
+  work.bandCount = (dh + work.bandHeight - 1u) / work.bandHeight;
+
+  uint32_t threadCount = 1;
+  if (uint64_t(dw) * uint64_t(dh) >= kImageScaleThreadingThreshold)
+    threadCount = blMax<uint32_t>(blMin(blRuntimeContext.systemInfo.threadCount, work.bandCount), 1u);
+
+  ScopedBuffer tmpBuffer;
+  if (work.mode == kImageScaleBandBoth) {
+    uint32_t maxSrcRows = 0;
+    for (uint32_t y0 = 0; y0 < dh; y0 += work.bandHeight) {
+      uint32_t srcY0;
+      uint32_t srcY1;
+      imageScaleSourceRange(d, y0, blMin(y0 + work.bandHeight, dh), srcY0, srcY1);
+      maxSrcRows = blMax(maxSrcRows, srcY1 - srcY0);
+    }
+
+    work.tmpStride = intptr_t(IntOps::alignUp(rowSize, 16));
+    work.tmpWorkerSize = size_t(work.tmpStride) * blMax<uint32_t>(maxSrcRows, 1u);
+    work.tmpData = static_cast<uint8_t*>(tmpBuffer.alloc(work.tmpWorkerSize * threadCount));
+
+    if (BL_UNLIKELY(!work.tmpData))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+  }
+
+  if (threadCount > 1)
+    blThreadPoolRunParallel(blThreadPoolGlobal(), threadCount, imageScaleBandWorker, &work);
+  else
+    imageScaleBandWorker(&work, 0);
+
   return BL_SUCCESS;
 }
 
@@ -918,6 +1142,7 @@ BLResult ImageScaleContext::processVertData(uint8_t* dstLine, intptr_t dstStride
 // =====================================
 
 void blImageScaleRtInit(BLRuntimeContext* rt) noexcept {
+  // Maybe unused, if no architecture dependent optimizations are available.
   blUnused(rt);
 
   bl::imageScaleOps.weights = bl::imageScaleWeights;
@@ -929,4 +1154,34 @@ void blImageScaleRtInit(BLRuntimeContext* rt) noexcept {
   bl::imageScaleOps.vert[BL_FORMAT_PRGB32] = bl::imageScaleVertPrgb32;
   bl::imageScaleOps.vert[BL_FORMAT_XRGB32] = bl::imageScaleVertXrgb32;
   bl::imageScaleOps.vert[BL_FORMAT_A8    ] = bl::imageScaleVertA8;
+
+#if defined(BL_BUILD_OPT_SSE4_1)
+  if (blRuntimeHasSSE4_1(rt)) {
+    bl::imageScaleOps.horz[BL_FORMAT_PRGB32] = bl::ImageScaleInternal::horzPrgb32_SSE4_1;
+    bl::imageScaleOps.horz[BL_FORMAT_XRGB32] = bl::ImageScaleInternal::horzXrgb32_SSE4_1;
+    bl::imageScaleOps.vert[BL_FORMAT_PRGB32] = bl::ImageScaleInternal::vertPrgb32_SSE4_1;
+    bl::imageScaleOps.vert[BL_FORMAT_XRGB32] = bl::ImageScaleInternal::vertXrgb32_SSE4_1;
+    bl::imageScaleOps.vert[BL_FORMAT_A8    ] = bl::ImageScaleInternal::vertA8_SSE4_1;
+  }
+#endif
+
+#if defined(BL_BUILD_OPT_AVX2)
+  if (blRuntimeHasAVX2(rt)) {
+    bl::imageScaleOps.horz[BL_FORMAT_PRGB32] = bl::ImageScaleInternal::horzPrgb32_AVX2;
+    bl::imageScaleOps.horz[BL_FORMAT_XRGB32] = bl::ImageScaleInternal::horzXrgb32_AVX2;
+    bl::imageScaleOps.vert[BL_FORMAT_PRGB32] = bl::ImageScaleInternal::vertPrgb32_AVX2;
+    bl::imageScaleOps.vert[BL_FORMAT_XRGB32] = bl::ImageScaleInternal::vertXrgb32_AVX2;
+    bl::imageScaleOps.vert[BL_FORMAT_A8    ] = bl::ImageScaleInternal::vertA8_AVX2;
+  }
+#endif
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+  if (blRuntimeHasASIMD(rt)) {
+    bl::imageScaleOps.horz[BL_FORMAT_PRGB32] = bl::ImageScaleInternal::horzPrgb32_ASIMD;
+    bl::imageScaleOps.horz[BL_FORMAT_XRGB32] = bl::ImageScaleInternal::horzXrgb32_ASIMD;
+    bl::imageScaleOps.vert[BL_FORMAT_PRGB32] = bl::ImageScaleInternal::vertPrgb32_ASIMD;
+    bl::imageScaleOps.vert[BL_FORMAT_XRGB32] = bl::ImageScaleInternal::vertXrgb32_ASIMD;
+    bl::imageScaleOps.vert[BL_FORMAT_A8    ] = bl::ImageScaleInternal::vertA8_ASIMD;
+  }
+#endif
 }
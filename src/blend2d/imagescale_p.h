@@ -28,6 +28,16 @@ public:
     uint32_t count;
   };
 
+  //! Horizontal record of two adjacent destination pixels, which are calculated together by SIMD kernels.
+  //!
+  //! Both pixels use the same `count`, which is the greater count of the two. The weights of a pixel that has less
+  //! weights are padded by zeros, and its position is shifted to the left when reading `count` pixels from its
+  //! original position would read past the end of the source row.
+  struct PairRecord {
+    uint32_t pos[2];
+    uint32_t count;
+  };
+
   struct Data {
     int dstSize[2];
     int srcSize[2];
@@ -40,6 +50,12 @@ public:
 
     int32_t* weightList[2];
     Record* recordList[2];
+
+    //! Horizontal records of destination pixel pairs (only initialized when horizontal weights are bound).
+    PairRecord* horzPairList;
+    //! Horizontal weights of destination pixel pairs, `kernelSize` taps per pair. Each tap is 8 16-bit weights, the
+    //! weight of the first pixel repeated 4 times followed by the weight of the second pixel repeated 4 times.
+    int16_t* horzPairWeightList;
   };
 
   Data* data;
@@ -62,8 +78,49 @@ public:
 
   BL_HIDDEN BLResult processHorzData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t format) const noexcept;
   BL_HIDDEN BLResult processVertData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t format) const noexcept;
+
+  //! Scales the whole image (horizontally, vertically, or in both directions, as specified by the context).
+  //!
+  //! Destination rows are processed in bands, which are sized so the horizontally scaled source rows required by a
+  //! single band fit into L2 cache, so no full-size intermediate image is ever allocated. Bands are distributed
+  //! across the global thread-pool when the destination is large enough to benefit from multi-threading.
+  BL_HIDDEN BLResult processData(uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t format) const noexcept;
 };
 
+namespace ImageScaleInternal {
+
+//! Scales `h` rows horizontally.
+typedef void (BL_CDECL* HorzFunc)(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) BL_NOEXCEPT;
+
+//! Scales destination rows `[y0, y1)` vertically, `srcLine` points to a source row at index `srcY`.
+typedef void (BL_CDECL* VertFunc)(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) BL_NOEXCEPT;
+
+#if defined(BL_BUILD_OPT_SSE4_1)
+BL_HIDDEN void BL_CDECL horzPrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept;
+BL_HIDDEN void BL_CDECL horzXrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept;
+BL_HIDDEN void BL_CDECL vertPrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+BL_HIDDEN void BL_CDECL vertXrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+BL_HIDDEN void BL_CDECL vertA8_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+#endif // BL_BUILD_OPT_SSE4_1
+
+#if defined(BL_BUILD_OPT_AVX2)
+BL_HIDDEN void BL_CDECL horzPrgb32_AVX2(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept;
+BL_HIDDEN void BL_CDECL horzXrgb32_AVX2(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept;
+BL_HIDDEN void BL_CDECL vertPrgb32_AVX2(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+BL_HIDDEN void BL_CDECL vertXrgb32_AVX2(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+BL_HIDDEN void BL_CDECL vertA8_AVX2(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+#endif // BL_BUILD_OPT_AVX2
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+BL_HIDDEN void BL_CDECL horzPrgb32_ASIMD(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept;
+BL_HIDDEN void BL_CDECL horzXrgb32_ASIMD(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept;
+BL_HIDDEN void BL_CDECL vertPrgb32_ASIMD(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+BL_HIDDEN void BL_CDECL vertXrgb32_ASIMD(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+BL_HIDDEN void BL_CDECL vertA8_ASIMD(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept;
+#endif // BL_BUILD_OPT_ASIMD
+
+} // {ImageScaleInternal}
+
 } // {bl}
 
 //! \}
@@ -0,0 +1,37 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_p.h"
+#if defined(BL_BUILD_OPT_SSE4_1)
+
+#include "imagescalesimdimpl_p.h"
+
+namespace bl {
+namespace ImageScaleInternal {
+
+void BL_CDECL horzPrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
+  horz32<BL_FORMAT_PRGB32>(d, dstLine, dstStride, srcLine, srcStride, h);
+}
+
+void BL_CDECL horzXrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
+  horz32<BL_FORMAT_XRGB32>(d, dstLine, dstStride, srcLine, srcStride, h);
+}
+
+void BL_CDECL vertPrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
+  vert<BL_FORMAT_PRGB32>(d, dstLine, dstStride, srcLine, srcStride, y0, y1, srcY);
+}
+
+void BL_CDECL vertXrgb32_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
+  vert<BL_FORMAT_XRGB32>(d, dstLine, dstStride, srcLine, srcStride, y0, y1, srcY);
+}
+
+void BL_CDECL vertA8_SSE4_1(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
+  vert<BL_FORMAT_A8>(d, dstLine, dstStride, srcLine, srcStride, y0, y1, srcY);
+}
+
+} // {ImageScaleInternal}
+} // {bl}
+
+#endif // BL_BUILD_OPT_SSE4_1
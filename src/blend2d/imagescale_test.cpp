@@ -0,0 +1,189 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "api-build_test_p.h"
+#if defined(BL_TEST)
+
+#include "image_p.h"
+#include "imagescale_p.h"
+#include "random.h"
+#include "support/intops_p.h"
+#include "support/memops_p.h"
+
+// bl::ImageScale - Tests
+// ======================
+
+namespace bl {
+namespace Tests {
+
+// Reference implementation that scales a single row (horizontally) or a single column (vertically) of 32-bit or
+// 8-bit pixels. It uses the same weights as the optimized implementation, but a full-size intermediate image.
+static void scaleReferencePass(const ImageScaleContext::Data* d, uint32_t dir, uint32_t format, const uint8_t* src, intptr_t srcAdvance, uint8_t* dst, intptr_t dstAdvance) noexcept {
+  uint32_t bpp = format == BL_FORMAT_A8 ? 1u : 4u;
+  uint32_t dstSize = uint32_t(d->dstSize[dir]);
+  uint32_t kernelSize = uint32_t(d->kernelSize[dir]);
+  bool unbound = d->isUnbound[dir] != 0;
+
+  for (uint32_t i = 0; i < dstSize; i++) {
+    const ImageScaleContext::Record& record = d->recordList[dir][i];
+    const int32_t* weights = d->weightList[dir] + size_t(i) * kernelSize;
+
+    int32_t c[4] = { 0x80, 0x80, 0x80, 0x80 };
+    for (uint32_t j = 0; j < record.count; j++) {
+      const uint8_t* sp = src + intptr_t(record.pos + j) * srcAdvance;
+      for (uint32_t k = 0; k < bpp; k++)
+        c[k] += int32_t(sp[k]) * weights[j];
+    }
+
+    uint8_t* dp = dst + intptr_t(i) * dstAdvance;
+    for (uint32_t k = 0; k < bpp; k++)
+      c[k] = unbound ? int32_t(IntOps::clampToByte(c[k] >> 8)) : ((c[k] >> 8) & 0xFF);
+
+    if (format == BL_FORMAT_PRGB32 && unbound) {
+      for (uint32_t k = 0; k < 3; k++)
+        c[k] = blMin(c[k], c[3]);
+    }
+
+    if (format == BL_FORMAT_XRGB32)
+      c[3] = 0xFF;
+
+    for (uint32_t k = 0; k < bpp; k++)
+      dp[k] = uint8_t(c[k]);
+  }
+}
+
+static void scaleReference(BLImage& dst, const BLImage& src, const BLSizeI& size, BLImageScaleFilter filter) noexcept {
+  ImageScaleContext scaleCtx;
+  EXPECT_SUCCESS(scaleCtx.create(size, src.size(), filter));
+
+  const ImageScaleContext::Data* d = scaleCtx.data;
+  uint32_t format = src.format();
+  uint32_t bpp = format == BL_FORMAT_A8 ? 1u : 4u;
+
+  BLImage tmp;
+  BLImageData srcData;
+  BLImageData tmpData;
+  BLImageData dstData;
+
+  EXPECT_SUCCESS(tmp.create(size.w, src.height(), BLFormat(format)));
+  EXPECT_SUCCESS(dst.create(size.w, size.h, BLFormat(format)));
+
+  EXPECT_SUCCESS(src.getData(&srcData));
+  EXPECT_SUCCESS(tmp.makeMutable(&tmpData));
+  EXPECT_SUCCESS(dst.makeMutable(&dstData));
+
+  const uint8_t* srcPixels = static_cast<const uint8_t*>(srcData.pixelData);
+  uint8_t* tmpPixels = static_cast<uint8_t*>(tmpData.pixelData);
+  uint8_t* dstPixels = static_cast<uint8_t*>(dstData.pixelData);
+
+  if (src.height() == size.h) {
+    for (int y = 0; y < size.h; y++)
+      scaleReferencePass(d, ImageScaleContext::kDirHorz, format, srcPixels + y * srcData.stride, bpp, dstPixels + y * dstData.stride, bpp);
+    return;
+  }
+
+  if (src.width() == size.w) {
+    for (int x = 0; x < size.w; x++)
+      scaleReferencePass(d, ImageScaleContext::kDirVert, format, srcPixels + x * int(bpp), srcData.stride, dstPixels + x * int(bpp), dstData.stride);
+    return;
+  }
+
+  for (int y = 0; y < src.height(); y++)
+    scaleReferencePass(d, ImageScaleContext::kDirHorz, format, srcPixels + y * srcData.stride, bpp, tmpPixels + y * tmpData.stride, bpp);
+
+  for (int x = 0; x < size.w; x++)
+    scaleReferencePass(d, ImageScaleContext::kDirVert, format, tmpPixels + x * int(bpp), tmpData.stride, dstPixels + x * int(bpp), dstData.stride);
+}
+
+static void fillRandomPixels(BLImage& img, BLRandom& rnd) noexcept {
+  BLImageData imgData;
+  EXPECT_SUCCESS(img.makeMutable(&imgData));
+
+  for (int y = 0; y < imgData.size.h; y++) {
+    uint8_t* p = static_cast<uint8_t*>(imgData.pixelData) + y * imgData.stride;
+
+    if (imgData.format == BL_FORMAT_A8) {
+      for (int x = 0; x < imgData.size.w; x++)
+        p[x] = uint8_t(rnd.nextUInt32() & 0xFFu);
+    }
+    else {
+      for (int x = 0; x < imgData.size.w; x++) {
+        uint32_t pixel = rnd.nextUInt32();
+        uint32_t a = imgData.format == BL_FORMAT_XRGB32 ? 0xFFu : (pixel >> 24);
+        uint32_t r = ((pixel >> 16) & 0xFFu) * a / 255u;
+        uint32_t g = ((pixel >>  8) & 0xFFu) * a / 255u;
+        uint32_t b = ((pixel      ) & 0xFFu) * a / 255u;
+        MemOps::writeU32u(p + x * 4, (a << 24) | (r << 16) | (g << 8) | b);
+      }
+    }
+  }
+}
+
+UNIT(image_scale, BL_TEST_GROUP_IMAGE_UTILITIES) {
+  static const BLFormat formats[] = { BL_FORMAT_PRGB32, BL_FORMAT_XRGB32, BL_FORMAT_A8 };
+
+  static const BLImageScaleFilter filters[] = {
+    BL_IMAGE_SCALE_FILTER_NEAREST,
+    BL_IMAGE_SCALE_FILTER_BILINEAR,
+    BL_IMAGE_SCALE_FILTER_BICUBIC,
+    BL_IMAGE_SCALE_FILTER_LANCZOS
+  };
+
+  struct TestCase {
+    BLSizeI src;
+    BLSizeI dst;
+  };
+
+  // The last test case is large enough to distribute bands across worker threads.
+  static const TestCase testCases[] = {
+    { { 67,  45}, { 31,  19} },
+    { { 67,  45}, {133, 101} },
+    { { 67,  45}, { 29,  45} },
+    { { 67,  45}, { 67,  97} },
+    { { 67,  45}, {  3,   2} },
+    { {255, 191}, {613, 533} }
+  };
+
+  BLRandom rnd(0x1234);
+
+  INFO("Testing BLImage::scale() against a reference implementation");
+  for (const TestCase& testCase : testCases) {
+    for (BLFormat format : formats) {
+      BLImage src;
+      EXPECT_SUCCESS(src.create(testCase.src.w, testCase.src.h, format));
+      fillRandomPixels(src, rnd);
+
+      for (BLImageScaleFilter filter : filters) {
+        BLImage expected;
+        BLImage actual;
+
+        scaleReference(expected, src, testCase.dst, filter);
+        EXPECT_SUCCESS(BLImage::scale(actual, src, testCase.dst, filter));
+
+        EXPECT_TRUE(actual.equals(expected))
+          .message("Scaled image doesn't match the reference (format=%u filter=%u src=%dx%d dst=%dx%d)",
+                   uint32_t(format), uint32_t(filter), testCase.src.w, testCase.src.h, testCase.dst.w, testCase.dst.h);
+      }
+    }
+  }
+
+  INFO("Testing BLImage::scale() in place");
+  {
+    BLImage img;
+    BLImage expected;
+
+    EXPECT_SUCCESS(img.create(67, 45, BL_FORMAT_PRGB32));
+    fillRandomPixels(img, rnd);
+
+    scaleReference(expected, img, BLSizeI(131, 77), BL_IMAGE_SCALE_FILTER_BICUBIC);
+    EXPECT_SUCCESS(BLImage::scale(img, img, BLSizeI(131, 77), BL_IMAGE_SCALE_FILTER_BICUBIC));
+    EXPECT_TRUE(img.equals(expected));
+  }
+}
+
+} // {Tests}
+} // {bl}
+
+#endif // BL_TEST
@@ -0,0 +1,320 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_IMAGESCALESIMDIMPL_P_H_INCLUDED
+#define BLEND2D_IMAGESCALESIMDIMPL_P_H_INCLUDED
+
+#include "imagescale_p.h"
+#include "simd/simd_p.h"
+#include "support/intops_p.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_internal
+//! \{
+
+namespace bl {
+namespace ImageScaleInternal {
+
+// bl::ImageScale - SIMD Implementation [SSE4.1 & AVX2 & ASIMD]
+// ============================================================
+//
+// The SIMD implementation must produce exactly the same output as the portable implementation in `imagescale.cpp`.
+// Bound weights (all weights are non-negative and their sum is 0x100) use 16-bit accumulators as the result can never
+// overflow, unbound weights (Lanczos filter can produce negative weights) use 32-bit accumulators and saturate.
+
+namespace {
+
+using namespace SIMD;
+
+// The widest integer vector, which is used by vertical scaling. Horizontal scaling always uses 128-bit vectors as
+// it calculates pairs of destination pixels, each having its own source position.
+#if BL_SIMD_WIDTH_I >= 256
+typedef Vec32xU8 VecWide;
+#else
+typedef Vec16xU8 VecWide;
+#endif
+
+#if BL_TARGET_ARCH_X86
+template<typename V> static BL_INLINE V broadcastWeightU16(int32_t w) noexcept { return make_u16<V>(uint16_t(w)); }
+template<typename V> static BL_INLINE V broadcastWeightI32(int32_t w) noexcept { return make_i32<V>(w); }
+template<typename V> static BL_INLINE V broadcastU32(uint32_t x) noexcept { return make_u32<V>(x); }
+#else
+template<typename V> static BL_INLINE V broadcastWeightU16(int32_t w) noexcept { return make128_u16<V>(uint16_t(w)); }
+template<typename V> static BL_INLINE V broadcastWeightI32(int32_t w) noexcept { return make128_i32<V>(w); }
+template<typename V> static BL_INLINE V broadcastU32(uint32_t x) noexcept { return make128_u32<V>(x); }
+#endif
+
+// Loads and stores either a full vector or just 4 bytes, which is used to process the remaining 32-bit pixels.
+template<typename V, size_t kSize>
+struct VecIO {
+  static BL_INLINE V load(const uint8_t* p) noexcept { return loadu<V>(p); }
+  static BL_INLINE void store(uint8_t* p, const V& v) noexcept { storeu(p, v); }
+};
+
+template<typename V>
+struct VecIO<V, 4> {
+  static BL_INLINE V load(const uint8_t* p) noexcept { return loadu_32<V>(p); }
+  static BL_INLINE void store(uint8_t* p, const V& v) noexcept { storeu_32(p, v); }
+};
+
+// Makes sure that color components of PRGB32 pixels don't exceed alpha. This is only necessary when the weights
+// are unbound as a weighted average of premultiplied pixels with non-negative weights is always premultiplied.
+template<typename V>
+static BL_INLINE V clampToAlpha(const V& pix) noexcept {
+  V a = srli_u32<24>(pix);
+  a = a | slli_i32<8>(a);
+  a = a | slli_i32<16>(a);
+  return min_u8(pix, a);
+}
+
+template<uint32_t kFormat, bool kUnbound, typename V>
+static BL_INLINE V finalizePixels(const V& pix) noexcept {
+  if (kFormat == BL_FORMAT_XRGB32)
+    return pix | broadcastU32<V>(0xFF000000u);
+  else if (kFormat == BL_FORMAT_PRGB32 && kUnbound)
+    return clampToAlpha(pix);
+  else
+    return pix;
+}
+
+// bl::ImageScale - SIMD Implementation - Horz
+// ===========================================
+
+// Calculates a pair of destination pixels described by `pair`, the result is in the low 64 bits. Pixels at both
+// source positions are interleaved into 16-bit lanes, so a single multiplication processes a tap of both pixels.
+// This is only possible with bound weights, as the products of unbound weights don't fit into 16 bits.
+static BL_INLINE Vec16xU8 horzPair(const uint8_t* srcLine, const ImageScaleContext::PairRecord* pair, const int16_t* wp) noexcept {
+  Vec16xU8 zero = make_zero<Vec16xU8>();
+  Vec16xU8 acc = broadcastWeightU16<Vec16xU8>(0x80);
+
+  const uint8_t* sp0 = srcLine + pair->pos[0] * 4u;
+  const uint8_t* sp1 = srcLine + pair->pos[1] * 4u;
+
+  for (uint32_t i = pair->count; i; i--) {
+    Vec16xU8 p01 = interleave_lo_u8(interleave_lo_u32(loadu_32<Vec16xU8>(sp0), loadu_32<Vec16xU8>(sp1)), zero);
+    acc = add_u16(acc, mul_u16(p01, loadu<Vec16xU8>(wp)));
+
+    sp0 += 4;
+    sp1 += 4;
+    wp += 8;
+  }
+
+  return packs_128_i16_u8(srli_u16<8>(acc));
+}
+
+template<uint32_t kFormat>
+static BL_INLINE void horz32Bound(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
+  uint32_t dw = uint32_t(d->dstSize[ImageScaleContext::kDirHorz]);
+  size_t pairWeightStride = size_t(d->kernelSize[ImageScaleContext::kDirHorz]) * 8u;
+
+  for (uint32_t y = 0; y < h; y++) {
+    const ImageScaleContext::PairRecord* pairList = d->horzPairList;
+    const int16_t* pairWeightList = d->horzPairWeightList;
+
+    uint8_t* dp = dstLine;
+    uint32_t x = dw;
+
+    while (x >= 2) {
+      Vec16xU8 pix = horzPair(srcLine, pairList, pairWeightList);
+      storeu_64(dp, finalizePixels<kFormat, false>(pix));
+
+      dp += 8;
+      x -= 2;
+
+      pairList += 1;
+      pairWeightList += pairWeightStride;
+    }
+
+    if (x) {
+      Vec16xU8 pix = horzPair(srcLine, pairList, pairWeightList);
+      storeu_32(dp, finalizePixels<kFormat, false>(pix));
+    }
+
+    dstLine += dstStride;
+    srcLine += srcStride;
+  }
+}
+
+// Unbound weights need 32-bit products, thus each destination pixel is calculated separately.
+template<uint32_t kFormat>
+static BL_INLINE void horz32Unbound(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
+  uint32_t dw = uint32_t(d->dstSize[ImageScaleContext::kDirHorz]);
+  uint32_t kernelSize = uint32_t(d->kernelSize[ImageScaleContext::kDirHorz]);
+
+  Vec16xU8 half = broadcastWeightI32<Vec16xU8>(0x80);
+
+  for (uint32_t y = 0; y < h; y++) {
+    const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirHorz];
+    const int32_t* weightList = d->weightList[ImageScaleContext::kDirHorz];
+
+    uint8_t* dp = dstLine;
+
+    for (uint32_t x = 0; x < dw; x++) {
+      const uint8_t* sp = srcLine + recordList->pos * 4;
+      const int32_t* wp = weightList;
+
+      Vec16xU8 acc = half;
+      for (uint32_t i = recordList->count; i; i--) {
+        Vec16xU8 p0 = unpack_lo32_u8_u32(loadu_32<Vec16xU8>(sp));
+        acc = add_i32(acc, mul_i32(p0, broadcastWeightI32<Vec16xU8>(wp[0])));
+
+        sp += 4;
+        wp += 1;
+      }
+
+      acc = srai_i32<8>(acc);
+      acc = packs_128_i16_u8(packs_128_i32_i16(acc));
+      storeu_32(dp, finalizePixels<kFormat, true>(acc));
+      dp += 4;
+
+      recordList += 1;
+      weightList += kernelSize;
+    }
+
+    dstLine += dstStride;
+    srcLine += srcStride;
+  }
+}
+
+template<uint32_t kFormat>
+static BL_INLINE void horz32(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t h) noexcept {
+  if (!d->isUnbound[ImageScaleContext::kDirHorz])
+    horz32Bound<kFormat>(d, dstLine, dstStride, srcLine, srcStride, h);
+  else
+    horz32Unbound<kFormat>(d, dstLine, dstStride, srcLine, srcStride, h);
+}
+
+// bl::ImageScale - SIMD Implementation - Vert
+// ===========================================
+
+// Calculates `sizeof(V)` bytes (or 4 bytes if `kSize == 4`) of a single destination row. Vertical scaling doesn't
+// depend on pixel layout as each byte uses the same weight, thus it only has to know whether the weights are bound.
+template<typename V, size_t kSize, bool kUnbound>
+static BL_INLINE V vertChunk(const uint8_t* sp, intptr_t srcStride, const int32_t* wp, uint32_t count) noexcept {
+  V zero = make_zero<V>();
+
+  if (!kUnbound) {
+    V acc0 = broadcastWeightU16<V>(0x80);
+    V acc1 = acc0;
+
+    for (uint32_t i = count; i; i--) {
+      V p0 = VecIO<V, kSize>::load(sp);
+      V w0 = broadcastWeightU16<V>(wp[0]);
+
+      acc0 = add_u16(acc0, mul_u16(interleave_lo_u8(p0, zero), w0));
+      acc1 = add_u16(acc1, mul_u16(interleave_hi_u8(p0, zero), w0));
+
+      sp += srcStride;
+      wp += 1;
+    }
+
+    return packs_128_i16_u8(srli_u16<8>(acc0), srli_u16<8>(acc1));
+  }
+  else {
+    V acc0 = broadcastWeightI32<V>(0x80);
+    V acc1 = acc0;
+    V acc2 = acc0;
+    V acc3 = acc0;
+
+    for (uint32_t i = count; i; i--) {
+      V p0 = VecIO<V, kSize>::load(sp);
+      V w0 = broadcastWeightI32<V>(wp[0]);
+
+      V pLo = interleave_lo_u8(p0, zero);
+      V pHi = interleave_hi_u8(p0, zero);
+
+      acc0 = add_i32(acc0, mul_i32(interleave_lo_u16(pLo, zero), w0));
+      acc1 = add_i32(acc1, mul_i32(interleave_hi_u16(pLo, zero), w0));
+      acc2 = add_i32(acc2, mul_i32(interleave_lo_u16(pHi, zero), w0));
+      acc3 = add_i32(acc3, mul_i32(interleave_hi_u16(pHi, zero), w0));
+
+      sp += srcStride;
+      wp += 1;
+    }
+
+    V lo = packs_128_i32_i16(srai_i32<8>(acc0), srai_i32<8>(acc1));
+    V hi = packs_128_i32_i16(srai_i32<8>(acc2), srai_i32<8>(acc3));
+    return packs_128_i16_u8(lo, hi);
+  }
+}
+
+template<uint32_t kFormat, bool kUnbound>
+static BL_INLINE void vertImpl(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
+  constexpr uint32_t kBpp = kFormat == BL_FORMAT_A8 ? 1u : 4u;
+  constexpr size_t kWideSize = sizeof(VecWide);
+
+  size_t byteWidth = size_t(d->dstSize[ImageScaleContext::kDirHorz]) * kBpp;
+  uint32_t kernelSize = uint32_t(d->kernelSize[ImageScaleContext::kDirVert]);
+
+  const ImageScaleContext::Record* recordList = d->recordList[ImageScaleContext::kDirVert] + y0;
+  const int32_t* weightList = d->weightList[ImageScaleContext::kDirVert] + size_t(y0) * kernelSize;
+
+  for (uint32_t y = y0; y < y1; y++) {
+    const uint8_t* srcData = srcLine + (intptr_t(recordList->pos) - intptr_t(srcY)) * srcStride;
+    uint32_t count = recordList->count;
+
+    uint8_t* dp = dstLine;
+    size_t i = byteWidth;
+
+    while (i >= kWideSize) {
+      VecWide pix = vertChunk<VecWide, kWideSize, kUnbound>(srcData, srcStride, weightList, count);
+      VecIO<VecWide, kWideSize>::store(dp, finalizePixels<kFormat, kUnbound>(pix));
+
+      dp += kWideSize;
+      srcData += kWideSize;
+      i -= kWideSize;
+    }
+
+    while (i >= 4) {
+      Vec16xU8 pix = vertChunk<Vec16xU8, 4, kUnbound>(srcData, srcStride, weightList, count);
+      VecIO<Vec16xU8, 4>::store(dp, finalizePixels<kFormat, kUnbound>(pix));
+
+      dp += 4;
+      srcData += 4;
+      i -= 4;
+    }
+
+    // Only A8 can have remaining bytes.
+    while (i) {
+      const uint8_t* sp = srcData;
+      const int32_t* wp = weightList;
+
+      int32_t c0 = 0x80;
+      for (uint32_t j = count; j; j--) {
+        c0 += int32_t(sp[0]) * wp[0];
+        sp += srcStride;
+        wp += 1;
+      }
+
+      dp[0] = IntOps::clampToByte(c0 >> 8);
+      dp++;
+      srcData++;
+      i--;
+    }
+
+    recordList += 1;
+    weightList += kernelSize;
+
+    dstLine += dstStride;
+  }
+}
+
+template<uint32_t kFormat>
+static BL_INLINE void vert(const ImageScaleContext::Data* d, uint8_t* dstLine, intptr_t dstStride, const uint8_t* srcLine, intptr_t srcStride, uint32_t y0, uint32_t y1, uint32_t srcY) noexcept {
+  if (!d->isUnbound[ImageScaleContext::kDirVert])
+    vertImpl<kFormat, false>(d, dstLine, dstStride, srcLine, srcStride, y0, y1, srcY);
+  else
+    vertImpl<kFormat, true>(d, dstLine, dstStride, srcLine, srcStride, y0, y1, srcY);
+}
+
+} // {anonymous}
+
+} // {ImageScaleInternal}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_IMAGESCALESIMDIMPL_P_H_INCLUDED
@@ -339,8 +339,8 @@ BLResult DictIterator::next(DictEntry& entry) noexcept {
   for (;;) {
     uint32_t b0 = *_dataPtr++;
 
-    // Operators are encoded in range [0..21].
-    if (b0 < 22) {
+    // Operators are encoded in range [0..21], CFF2 adds 'vsindex' (22), 'blend' (23), and 'vstore' (24).
+    if (b0 < 25) {
       // 12 is a special escape code to encode additional operators.
       if (b0 == CFFTable::kEscapeDictOp) {
         if (BL_UNLIKELY(_dataPtr == _dataEnd))
@@ -386,7 +386,7 @@ BLResult DictIterator::next(DictEntry& entry) noexcept {
           vInt = MemOps::readI32uBE(_dataPtr - 4);
         }
         else {
-          // Byte values 22..27, 31, and 255 are reserved.
+          // Byte values 25..27, 31, and 255 are reserved.
           return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
         }
 
@@ -426,9 +426,10 @@ static constexpr uint32_t kCFFCallStackSize = 16;
 static constexpr uint32_t kCFFStorageSize = 32;
 
 static constexpr uint32_t kCFFValueStackSizeV1 = 48;
+static constexpr uint32_t kCFFValueStackSizeV2 = 513;
 
-// TODO: [OpenType] Required by CFF2.
-// static constexpr uint32_t kCFFValueStackSizeV2 = 513;
+// Maximum number of regions referenced by a single ItemVariationData used by CFF2 'blend' operator.
+static constexpr uint32_t kCFFBlendRegionCapacity = 64;
 
 // We use `double` precision in our implementation, so this constant is used to convert a fixed-point.
 static constexpr double kCFFDoubleFromF16x16 = (1.0 / 65536.0);
@@ -792,6 +793,7 @@ static BL_INLINE bool findGlyphInRange3(BLGlyphId glyphId, const uint8_t* ranges
 template<typename Consumer>
 static BLResult getGlyphOutlinesT(
   const BLFontFaceImpl* faceI_,
+  const VarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   Consumer& consumer,
@@ -813,7 +815,7 @@ static BLResult getGlyphOutlinesT(
   const uint8_t* ipEnd = nullptr;             // End of the instruction array.
 
   ExecutionState cBuf[kCFFCallStackSize + 1]; // Call stack.
-  double vBuf[kCFFValueStackSizeV1 + 1];      // Value stack.
+  double vBuf[kCFFValueStackSizeV2 + 1];      // Value stack (CFFv1 only uses the first `kCFFValueStackSizeV1` values).
 
   uint32_t cIdx = 0;                          // Call stack index.
   uint32_t vIdx = 0;                          // Value stack index.
@@ -833,9 +835,22 @@ static BLResult getGlyphOutlinesT(
   const CFFData& cffInfo = faceI->cff;
   const uint8_t* cffData = faceI->cff.table.data;
 
+  // CFF2 has a larger value stack, implicit width, and variation operators.
+  uint32_t cffVersion = faceI->faceInfo.outlineType == BL_FONT_OUTLINE_TYPE_CFF2 ? CFFData::kVersion2 : CFFData::kVersion1;
+  uint32_t vLimit = cffVersion == CFFData::kVersion2 ? kCFFValueStackSizeV2 : kCFFValueStackSizeV1;
+
+  if (cffVersion == CFFData::kVersion2)
+    executionFlags |= kCSFlagHasWidth;
+
+  // Region scalars of the current ItemVariationData (selected by 'vsindex'), calculated on the first 'blend'.
+  double blendScalars[kCFFBlendRegionCapacity];
+  uint32_t blendRegionCount = 0;
+  uint32_t vsIndex = 0;
+  bool blendScalarsValid = false;
+
   // Execution features describe either CFFv1 or CFFv2 environment. It contains minimum operand count for each
   // opcode (or operator) and some other data.
-  const ExecutionFeaturesInfo* executionFeatures = &executionFeaturesInfo[0];
+  const ExecutionFeaturesInfo* executionFeatures = &executionFeaturesInfo[cffVersion];
 
   // This is used to perform a function (subroutine) call. Initially we set it to the charstring referenced by the
   // `glyphId`. Later, when we process a function call opcode it would be changed to either GSubR or LSubR index.
@@ -894,24 +909,29 @@ static BLResult getGlyphOutlinesT(
   // Program | SubR - Init
   // ---------------------
 
-  BL_PROPAGATE(consumer.begin(64));
-
 OnSubRCall:
   {
-    uint32_t offsetSize = subrIndex->offsetSize;
     uint32_t payloadSize = subrIndex->payloadSize();
+    uint32_t oArray[2];
 
     ip = cffData + subrIndex->dataRange.offset;
 
-    uint32_t oArray[2];
-    readOffsetArray(ip + subrIndex->offsetsOffset() + subrId * offsetSize, offsetSize, oArray, 2);
+    if (subrIndex->offsets) {
+      // Subroutine offsets were already decoded and adjusted when the face was created.
+      oArray[0] = subrIndex->offsets[subrId + 0];
+      oArray[1] = subrIndex->offsets[subrId + 1];
+    }
+    else {
+      uint32_t offsetSize = subrIndex->offsetSize;
+      readOffsetArray(ip + subrIndex->offsetsOffset() + subrId * offsetSize, offsetSize, oArray, 2);
+
+      oArray[0] -= CFFTable::kOffsetAdjustment;
+      oArray[1] -= CFFTable::kOffsetAdjustment;
+    }
 
     ip += subrIndex->payloadOffset();
     ipEnd = ip;
 
-    oArray[0] -= CFFTable::kOffsetAdjustment;
-    oArray[1] -= CFFTable::kOffsetAdjustment;
-
     if (BL_UNLIKELY(oArray[0] >= oArray[1] || oArray[1] > payloadSize)) {
       trace.fail("Invalid SubR range [Start=%u End=%u Max=%u]\n", oArray[0], oArray[1], payloadSize);
       return blTraceError(BL_ERROR_INVALID_DATA);
@@ -925,6 +945,13 @@ OnSubRCall:
       trace.fail("Program limit exceeded [%zu bytes processed]\n", bytesProcessed);
       return blTraceError(BL_ERROR_FONT_PROGRAM_TERMINATED);
     }
+
+    // Reserve the path storage once, when the glyph's CharString is entered. Each vertex consumes at least one byte
+    // of a CharString (operands of curve operators are shared by 3 vertices, but there is always an operator), so the
+    // size of the program is a good estimate that avoids growing the path in most cases when subroutines are not used.
+    if (bytesProcessed == 0)
+      BL_PROPAGATE(consumer.begin(blMax<size_t>(programSize + 16u, 64u)));
+
     bytesProcessed += programSize;
   }
 
@@ -949,7 +976,7 @@ OnSubRCall:
     b0 = *ip++;
 
     if (b0 >= 32) {
-      if (BL_UNLIKELY(++vIdx > kCFFValueStackSizeV1)) {
+      if (BL_UNLIKELY(++vIdx > vLimit)) {
         goto InvalidData;
       }
       else {
@@ -969,7 +996,7 @@ OnSubRCall:
             if (b0 < 32)
               goto OnOperator;
 
-            if (BL_UNLIKELY(++vIdx > kCFFValueStackSizeV1))
+            if (BL_UNLIKELY(++vIdx > vLimit))
               goto InvalidData;
 
             if (b0 <= 246) {
@@ -1039,7 +1066,7 @@ OnOperator:
 
         case kCSOpPushI16: {
           ip += 2;
-          if (BL_UNLIKELY(ip > ipEnd || ++vIdx > kCFFValueStackSizeV1))
+          if (BL_UNLIKELY(ip > ipEnd || ++vIdx > vLimit))
             goto InvalidData;
 
           int v = MemOps::readI16uBE(ip - 2);
@@ -1387,15 +1414,52 @@ OnVHCurveTo:
 
         // |- ivs vsindex (15) |-
         case kCSOpVSIndex: {
-          // TODO: [OpenType] CFF VARIATIONS
+          BL_ASSERT(vMinOperands >= 1);
+
+          double ivs = vBuf[vIdx - 1];
+          if (BL_UNLIKELY(!(ivs >= 0.0 && ivs <= 65535.0)))
+            goto InvalidData;
+
+          vsIndex = uint32_t(ivs);
+          blendScalarsValid = false;
+
           vIdx = 0;
           continue;
         }
 
         // in(0)...in(N-1), d(0,0)...d(K-1,0), d(0,1)...d(K-1,1) ... d(0,N-1)...d(K-1,N-1) N blend (16) out(0)...(N-1)
         case kCSOpBlend: {
-          // TODO: [OpenType] CFF VARIATIONS
-          vIdx = 0;
+          BL_ASSERT(vMinOperands >= 1);
+
+          if (!blendScalarsValid) {
+            const double* regionScalars = varInstance ? varInstance->cff2RegionScalars : nullptr;
+            uint32_t regionCount = varInstance ? varInstance->cff2RegionCount : 0u;
+
+            if (BL_UNLIKELY(VarImpl::getRegionScalars(faceI->var.cff2Store, regionScalars, regionCount, vsIndex, blendScalars, kCFFBlendRegionCapacity, &blendRegionCount) != BL_SUCCESS))
+              goto InvalidData;
+
+            blendScalarsValid = true;
+          }
+
+          double n = vBuf[--vIdx];
+          if (BL_UNLIKELY(!(n >= 0.0 && n * double(blendRegionCount + 1u) <= double(vIdx))))
+            goto InvalidData;
+
+          // Each of N default values is followed (after all defaults) by K deltas, which are blended into it.
+          uint32_t count = uint32_t(n);
+          uint32_t base = vIdx - count * (blendRegionCount + 1u);
+
+          if (varInstance) {
+            const double* deltas = vBuf + base + count;
+            for (uint32_t i = 0; i < count; i++, deltas += blendRegionCount) {
+              double v = vBuf[base + i];
+              for (uint32_t k = 0; k < blendRegionCount; k++)
+                v += deltas[k] * blendScalars[k];
+              vBuf[base + i] = v;
+            }
+          }
+
+          vIdx = base + count;
           continue;
         }
 
@@ -1694,7 +1758,7 @@ OnReturn:
 
             // random (12 23) out
             case kCSOpRandom & 0xFFu: {
-              if (BL_UNLIKELY(++vIdx > kCFFValueStackSizeV1))
+              if (BL_UNLIKELY(++vIdx > vLimit))
                 goto InvalidData;
 
               // NOTE: Don't allow anything random.
@@ -1705,7 +1769,7 @@ OnReturn:
             // in dup (12 27) out out
             case kCSOpDup & 0xFFu: {
               BL_ASSERT(vMinOperands >= 1);
-              if (BL_UNLIKELY(++vIdx > kCFFValueStackSizeV1))
+              if (BL_UNLIKELY(++vIdx > vLimit))
                 goto InvalidData;
               vBuf[vIdx - 1] = vBuf[vIdx - 2];
               continue;
@@ -1950,7 +2014,7 @@ static BLResult BL_CDECL getGlyphBounds(
     BLGlyphId glyphId = glyphData[0];
     glyphData = PtrOps::offset(glyphData, glyphAdvance);
 
-    BLResult localResult = getGlyphOutlinesT<GlyphBoundsConsumer>(faceI_, glyphId, &transform, consumer, &tmpBuffer);
+    BLResult localResult = getGlyphOutlinesT<GlyphBoundsConsumer>(faceI_, nullptr, glyphId, &transform, consumer, &tmpBuffer);
     if (localResult) {
       boxes[i].reset();
       result = localResult;
@@ -2028,6 +2092,7 @@ public:
 
 static BLResult BL_CDECL getGlyphOutlines(
   const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   BLPath* out,
@@ -2035,7 +2100,7 @@ static BLResult BL_CDECL getGlyphOutlines(
   ScopedBuffer* tmpBuffer) noexcept {
 
   GlyphOutlineConsumer consumer(out);
-  BLResult result = getGlyphOutlinesT<GlyphOutlineConsumer>(faceI_, glyphId, transform, consumer, tmpBuffer);
+  BLResult result = getGlyphOutlinesT<GlyphOutlineConsumer>(faceI_, static_cast<const VarInstance*>(varInstance), glyphId, transform, consumer, tmpBuffer);
 
   *contourCountOut = consumer.contourCount;
   return result;
@@ -2062,6 +2127,47 @@ struct CIDInfo {
 // bl::OpenType::CFFImpl - Init
 // ============================
 
+// Decodes offsets of all subroutine indexes into a single array so calling a subroutine doesn't have to decode
+// variable-size offsets each time. CharStrings index is not decoded as each glyph is only entered once.
+static BLResult decodeSubrOffsets(OTFaceImpl* faceI) noexcept {
+  CFFData::IndexData* gsubrIndex = &faceI->cff.index[CFFData::kIndexGSubR];
+  CFFData::IndexData* lsubrIndex = &faceI->cff.index[CFFData::kIndexLSubR];
+
+  size_t fdCount = faceI->cffFDSubrIndexes.size();
+  CFFData::IndexData* fdSubrIndexes = nullptr;
+
+  if (fdCount)
+    BL_PROPAGATE(faceI->cffFDSubrIndexes.makeMutable(&fdSubrIndexes));
+
+  size_t totalCount = size_t(gsubrIndex->entryCount) + 1u + size_t(lsubrIndex->entryCount) + 1u;
+  for (size_t i = 0; i < fdCount; i++)
+    totalCount += size_t(fdSubrIndexes[i].entryCount) + 1u;
+
+  // The array must not be reallocated after the pointers to its data are stored in indexes.
+  uint32_t* offsets;
+  BL_PROPAGATE(faceI->cffSubrOffsets.modifyOp(BL_MODIFY_OP_ASSIGN_FIT, totalCount, &offsets));
+
+  const uint8_t* cffData = faceI->cff.table.data;
+  auto decodeIndex = [&](CFFData::IndexData* index) noexcept {
+    size_t count = size_t(index->entryCount) + 1u;
+    if (index->entryCount) {
+      readOffsetArray(cffData + index->dataRange.offset + index->offsetsOffset(), index->offsetSize, offsets, count);
+      for (size_t i = 0; i < count; i++)
+        offsets[i] -= CFFTable::kOffsetAdjustment;
+      index->offsets = offsets;
+    }
+    offsets += count;
+  };
+
+  decodeIndex(gsubrIndex);
+  decodeIndex(lsubrIndex);
+
+  for (size_t i = 0; i < fdCount; i++)
+    decodeIndex(&fdSubrIndexes[i]);
+
+  return BL_SUCCESS;
+}
+
 static BL_INLINE bool isSupportedFDSelectFormat(uint32_t format) noexcept {
   return format == 0 || format == 3;
 }
@@ -2087,6 +2193,7 @@ BLResult init(OTFaceImpl* faceI, OTFaceTables& tables, uint32_t cffVersion) noex
   uint32_t privateOffset = 0;
   uint32_t privateLength = 0;
   uint32_t lsubrOffset = 0;
+  uint32_t varStoreOffset = 0;
 
   CIDInfo cid {};
   BLArray<CFFData::IndexData> fdSubrIndexes;
@@ -2155,17 +2262,21 @@ BLResult init(OTFaceImpl* faceI, OTFaceTables& tables, uint32_t cffVersion) noex
       return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
   }
 
-  BL_PROPAGATE(readIndex(cff.data + topDictOffset, topDictSize, cffVersion, &topDictIndex));
   if (cffVersion == CFFData::kVersion1) {
+    BL_PROPAGATE(readIndex(cff.data + topDictOffset, topDictSize, cffVersion, &topDictIndex));
+
     // TopDict index size must match NameIndex size (v1).
     if (BL_UNLIKELY(nameIndex.count != topDictIndex.count))
       return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
-  }
 
-  {
     uint32_t offsets[2] = { topDictIndex.offsetAt(0), topDictIndex.offsetAt(1) };
     dictIter.reset(topDictIndex.payload + offsets[0], offsets[1] - offsets[0]);
   }
+  else {
+    // CFF2 TopDict is not an index, it's a single DICT of `topDictLength` bytes that follows the header.
+    topDictIndex.totalSize = topDictSize;
+    dictIter.reset(cff.data + topDictOffset, topDictSize);
+  }
 
   while (dictIter.hasNext()) {
     BL_PROPAGATE(dictIter.next(dictEntry));
@@ -2211,6 +2322,12 @@ BLResult init(OTFaceImpl* faceI, OTFaceTables& tables, uint32_t cffVersion) noex
         }
         break;
       }
+
+      case CFFTable::kDictOpTopVStore: {
+        if (dictEntry.count == 1 && cffVersion == CFFData::kVersion2)
+          varStoreOffset = uint32_t(dictEntry.values[0]);
+        break;
+      }
     }
   }
 
@@ -2284,16 +2401,21 @@ BLResult init(OTFaceImpl* faceI, OTFaceTables& tables, uint32_t cffVersion) noex
   // CFF/CID
   // -------
 
-  if ((cid.flags & CIDInfo::kFlagsAll) == CIDInfo::kFlagsAll) {
+  // CFF2 has no ROS and always uses FDArray (private dictionaries are only referenced by font dictionaries), FDSelect
+  // is optional in CFF2 if there is only a single font dictionary.
+  bool hasFDArray = cffVersion == CFFData::kVersion1 ? (cid.flags & CIDInfo::kFlagsAll) == CIDInfo::kFlagsAll
+                                                     : (cid.flags & CIDInfo::kFlagHasFDArray) != 0;
+
+  if (hasFDArray) {
     uint32_t fdArrayOffset = cid.fdArrayOffset;
     uint32_t fdSelectOffset = cid.fdSelectOffset;
 
     // CID fonts require both FDArray and FDOffset.
-    if (fdArrayOffset && fdSelectOffset) {
+    if (fdArrayOffset && (fdSelectOffset || cffVersion == CFFData::kVersion2)) {
       if (fdArrayOffset < beginDataOffset || fdArrayOffset >= cff.size)
         return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
 
-      if (fdSelectOffset < beginDataOffset || fdSelectOffset >= cff.size)
+      if (fdSelectOffset && (fdSelectOffset < beginDataOffset || fdSelectOffset >= cff.size))
         return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
 
       // The index contains offsets to the additional TopDicts. To speed up
@@ -2371,13 +2493,40 @@ BLResult init(OTFaceImpl* faceI, OTFaceTables& tables, uint32_t cffVersion) noex
         fdArrayOffsets += fdArrayIndex.offsetSize;
       }
 
-      // Validate FDSelect data.
-      cid.fdSelectFormat = cff.data[fdSelectOffset];
-      if (BL_UNLIKELY(!isSupportedFDSelectFormat(cid.fdSelectFormat)))
-        return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
+      if (fdSelectOffset) {
+        // Validate FDSelect data.
+        cid.fdSelectFormat = cff.data[fdSelectOffset];
+        if (BL_UNLIKELY(!isSupportedFDSelectFormat(cid.fdSelectFormat)))
+          return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
+      }
+      else if (!fdSubrIndexes.empty()) {
+        // Without FDSelect all glyphs use the first font dictionary, so use its local subroutines directly.
+        const CFFData::IndexData& fdSubrIndex = fdSubrIndexes[0];
+        lsubrOffset = fdSubrIndex.dataRange.offset;
+        lsubrIndex.totalSize = fdSubrIndex.dataRange.size;
+        lsubrIndex.headerSize = fdSubrIndex.headerSize;
+        lsubrIndex.offsetSize = fdSubrIndex.offsetSize;
+        lsubrIndex.count = fdSubrIndex.entryCount;
+      }
     }
   }
 
+  // CFF2 VariationStore
+  // -------------------
+
+  // The store is prefixed by a 16-bit length, which is followed by an ItemVariationStore.
+  DataRange varStore { 0, 0 };
+  if (varStoreOffset) {
+    if (BL_UNLIKELY(varStoreOffset < beginDataOffset || varStoreOffset > cff.size - 2u))
+      return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
+
+    uint32_t varStoreLength = MemOps::readU16uBE(cff.data + varStoreOffset);
+    if (BL_UNLIKELY(varStoreLength > cff.size - varStoreOffset - 2u))
+      return blTraceError(BL_ERROR_FONT_CFF_INVALID_DATA);
+
+    varStore.reset(varStoreOffset + 2u, varStoreLength);
+  }
+
   // Done
   // ----
 
@@ -2406,8 +2555,11 @@ BLResult init(OTFaceImpl* faceI, OTFaceTables& tables, uint32_t cffVersion) noex
 
   faceI->cff.fdSelectOffset = cid.fdSelectOffset;
   faceI->cff.fdSelectFormat = cid.fdSelectFormat;
+  faceI->cff.varStore = varStore;
   faceI->cffFDSubrIndexes.swap(fdSubrIndexes);
 
+  BL_PROPAGATE(decodeSubrOffsets(faceI));
+
   faceI->funcs.getGlyphBounds = getGlyphBounds;
   faceI->funcs.getGlyphOutlines = getGlyphOutlines;
   return BL_SUCCESS;
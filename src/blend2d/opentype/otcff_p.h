@@ -97,6 +97,9 @@ struct CFFTable {
     kDictOpTopFDSelect           = 0x0C25,
     kDictOpTopFontName           = 0x0C26,
 
+    // CFF2 Operator Extensions:
+    kDictOpTopVStore             = 0x0018,
+
     // Private Dict Operator Entries.
     kDictOpPrivBlueValues        = 0x0006,
     kDictOpPrivOtherBlues        = 0x0007,
@@ -189,6 +192,8 @@ struct CFFData {
     uint8_t headerSize;
     uint8_t offsetSize;
     uint16_t bias;
+    //! Decoded offsets (`entryCount + 1` values relative to the payload), only provided by subroutine indexes.
+    const uint32_t* offsets;
 
     BL_INLINE void reset(const DataRange& dataRange_, uint32_t headerSize_, uint32_t offsetSize_, uint32_t entryCount_, uint16_t bias_) noexcept {
       this->dataRange = dataRange_;
@@ -196,6 +201,7 @@ struct CFFData {
       this->headerSize = uint8_t(headerSize_);
       this->offsetSize = uint8_t(offsetSize_);
       this->bias = bias_;
+      this->offsets = nullptr;
     }
 
     //! Returns the offset to the offsets data (array of offsets).
@@ -218,6 +224,8 @@ struct CFFData {
   //! Format of FDSelect data (0 or 3).
   uint8_t fdSelectFormat;
   uint8_t reserved[3];
+  //! Item variation store used by CFF2 'blend' operator (empty if the font is not CFF2 or has no variations).
+  DataRange varStore;
 };
 
 namespace CFFImpl {
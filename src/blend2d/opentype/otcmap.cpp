@@ -10,6 +10,7 @@
 #include "../opentype/otplatform_p.h"
 #include "../support/memops_p.h"
 #include "../support/ptrops_p.h"
+#include "../threading/atomic_p.h"
 #include "../unicode/unicode_p.h"
 
 namespace bl {
@@ -325,6 +326,197 @@ Done:
   return BL_SUCCESS;
 }
 
+// bl::OpenType::CMapImpl - Page Table
+// ===================================
+
+typedef BLResult (BL_CDECL* SearchFunc)(const BLFontFaceImpl* impl, uint32_t* content, size_t count, BLGlyphMappingState* state) BL_NOEXCEPT;
+
+//! Shared by all pages that don't map any character.
+static const uint16_t cmapZeroPage[CMapPageTable::kPageSize] {};
+
+static const uint16_t* buildPage(const OTFaceImpl* faceI, CMapPageTable* table, uint32_t pageIndex) noexcept {
+  constexpr uint32_t kPageSize = CMapPageTable::kPageSize;
+
+  uint32_t content[kPageSize];
+  uint32_t base = pageIndex << CMapPageTable::kPageShift;
+
+  for (uint32_t i = 0; i < kPageSize; i++)
+    content[i] = base + i;
+
+  BLGlyphMappingState state;
+  if (table->searchFunc(faceI, content, kPageSize, &state) != BL_SUCCESS)
+    return nullptr;
+
+  const uint16_t* page = cmapZeroPage;
+  if (state.undefinedCount != kPageSize) {
+    uint16_t* newPage = static_cast<uint16_t*>(malloc(kPageSize * sizeof(uint16_t)));
+    if (BL_UNLIKELY(!newPage))
+      return nullptr;
+
+    for (uint32_t i = 0; i < kPageSize; i++)
+      newPage[i] = uint16_t(content[i]);
+    page = newPage;
+  }
+
+  // We must drop this page if another thread built it meanwhile.
+  const uint16_t* expected = nullptr;
+  if (!blAtomicCompareExchange(&table->pages[pageIndex], &expected, page)) {
+    BL_ASSERT(expected != nullptr);
+    if (page != cmapZeroPage)
+      free(const_cast<uint16_t*>(page));
+    page = expected;
+  }
+
+  return page;
+}
+
+static SearchFunc searchFuncByFormat(uint32_t format) noexcept {
+  switch (format) {
+    case  4: return mapTextToGlyphsFormat4;
+    case 12: return mapTextToGlyphsFormat12_13<12>;
+    default: return mapTextToGlyphsFormat12_13<13>;
+  }
+}
+
+static uint32_t pageCountOfSubTable(const OTFaceImpl* faceI) noexcept {
+  // Format4 can only map BMP characters.
+  if (faceI->cmapFormat == 4)
+    return 0x10000u >> CMapPageTable::kPageShift;
+
+  const CMapTable::Format12_13* subTable = PtrOps::offset<CMapTable::Format12_13>(faceI->cmap.cmapTable.data, faceI->cmap.encoding.offset);
+  const CMapTable::Group* groupArray = subTable->groups.array();
+  size_t groupCount = faceI->cmap.encoding.entryCount;
+
+  uint32_t ucMax = 0;
+  for (size_t i = 0; i < groupCount; i++)
+    ucMax = blMax(ucMax, groupArray[i].last());
+
+  return blMin<uint32_t>((ucMax >> CMapPageTable::kPageShift) + 1u, CMapPageTable::kMaxPageCount);
+}
+
+static void freePageTableData(CMapPageTable* table) noexcept {
+  for (uint32_t i = 0; i < table->pageCount; i++) {
+    const uint16_t* page = table->pages[i];
+    if (page && page != cmapZeroPage)
+      free(const_cast<uint16_t*>(page));
+  }
+  free(table);
+}
+
+static CMapPageTable* createPageTable(const OTFaceImpl* faceI) noexcept {
+  uint32_t pageCount = pageCountOfSubTable(faceI);
+
+  CMapPageTable* table = static_cast<CMapPageTable*>(calloc(1, CMapPageTable::sizeOf(pageCount)));
+  if (BL_UNLIKELY(!table))
+    return nullptr;
+
+  table->searchFunc = searchFuncByFormat(faceI->cmapFormat);
+  table->pageCount = pageCount;
+
+  // The first page (ASCII and Latin-1) is always built as it's used by the fast path.
+  if (!buildPage(faceI, table, 0)) {
+    free(table);
+    return nullptr;
+  }
+
+  // We must drop this table if another thread created it meanwhile.
+  CMapPageTable* expected = nullptr;
+  if (!blAtomicCompareExchange(&faceI->cmap.pageTable, &expected, table)) {
+    BL_ASSERT(expected != nullptr);
+    freePageTableData(table);
+    table = expected;
+  }
+
+  return table;
+}
+
+static BLResult BL_CDECL mapTextToGlyphsPageTable(const BLFontFaceImpl* faceI_, uint32_t* content, size_t count, BLGlyphMappingState* state) noexcept {
+  const OTFaceImpl* faceI = static_cast<const OTFaceImpl*>(faceI_);
+
+  CMapPageTable* table = blAtomicFetchStrong(&faceI->cmap.pageTable);
+  if (BL_UNLIKELY(!table)) {
+    table = createPageTable(faceI);
+
+    // Not having a page table is not fatal, we can still search the sub-table.
+    if (BL_UNLIKELY(!table))
+      return searchFuncByFormat(faceI->cmapFormat)(faceI_, content, count, state);
+  }
+
+  const uint16_t* latin1Page = table->pages[0];
+  uint32_t pageCount = table->pageCount;
+
+  uint32_t* ptr = content;
+  uint32_t* end = content + count;
+
+  while (ptr != end) {
+    // Fast path - ASCII and Latin-1 text is mapped 4 characters at a time by using the always present first page.
+    while (size_t(end - ptr) >= 4) {
+      uint32_t uc0 = ptr[0];
+      uint32_t uc1 = ptr[1];
+      uint32_t uc2 = ptr[2];
+      uint32_t uc3 = ptr[3];
+
+      if ((uc0 | uc1 | uc2 | uc3) > 0xFFu)
+        break;
+
+      ptr[0] = latin1Page[uc0];
+      ptr[1] = latin1Page[uc1];
+      ptr[2] = latin1Page[uc2];
+      ptr[3] = latin1Page[uc3];
+      ptr += 4;
+    }
+
+    if (ptr == end)
+      break;
+
+    uint32_t uc = ptr[0];
+    uint32_t pageIndex = uc >> CMapPageTable::kPageShift;
+    BLGlyphId glyphId = 0;
+
+    if (pageIndex < pageCount) {
+      const uint16_t* page = blAtomicFetchStrong(&table->pages[pageIndex]);
+      if (BL_UNLIKELY(!page)) {
+        page = buildPage(faceI, table, pageIndex);
+
+        // Search the rest of the text if the page couldn't be built (out of memory).
+        if (BL_UNLIKELY(!page)) {
+          BLGlyphMappingState tmpState;
+          BL_PROPAGATE(table->searchFunc(faceI_, ptr, size_t(end - ptr), &tmpState));
+          ptr = end;
+          break;
+        }
+      }
+      glyphId = page[uc & CMapPageTable::kPageMask];
+    }
+
+    *ptr++ = glyphId;
+  }
+
+  size_t undefinedCount = 0;
+  state->undefinedFirst = SIZE_MAX;
+
+  for (size_t i = 0; i < count; i++) {
+    if (BL_UNLIKELY(content[i] == 0)) {
+      if (!undefinedCount)
+        state->undefinedFirst = i;
+      undefinedCount++;
+    }
+  }
+
+  state->glyphCount = count;
+  state->undefinedCount = undefinedCount;
+
+  return BL_SUCCESS;
+}
+
+void freePageTable(OTFaceImpl* faceI) noexcept {
+  CMapPageTable* table = faceI->cmap.pageTable;
+  if (table) {
+    faceI->cmap.pageTable = nullptr;
+    freePageTableData(table);
+  }
+}
+
 // bl::OpenType::CMapImpl - Validate
 // =================================
 
@@ -728,11 +920,14 @@ static bool isSupportedCMapFormat(uint32_t format) noexcept {
 static BLResult initCMapFuncs(OTFaceImpl* faceI) noexcept {
   switch (faceI->cmapFormat) {
     case  0: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsFormat0; break;
-    case  4: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsFormat4; break;
     case  6: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsFormat6; break;
     case 10: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsFormat10; break;
-    case 12: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsFormat12_13<12>; break;
-    case 13: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsFormat12_13<13>; break;
+
+    // Formats that have to search the sub-table use a lazily built page table instead.
+    case  4:
+    case 12:
+    case 13: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsPageTable; break;
+
     default: faceI->funcs.mapTextToGlyphs = mapTextToGlyphsNone; break;
   }
   return BL_SUCCESS;
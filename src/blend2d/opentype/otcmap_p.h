@@ -195,12 +195,45 @@ struct CMapEncoding {
   BL_INLINE void reset() noexcept { memset(this, 0, sizeof(*this)); }
 };
 
+//! Direct-mapped character to glyph lookup table, which is lazily built from a 'cmap' sub-table that requires a
+//! search to map a single character (Format4, Format12, and Format13).
+//!
+//! The table has two levels - the first level is an array of pages and each page maps `kPageSize` consecutive code
+//! points to 16-bit glyph ids. Pages are built on demand, when a code point of the page is mapped for the first time,
+//! and are installed atomically as a font face can be used by multiple threads. Pages that don't map any character
+//! share a single zero page.
+struct CMapPageTable {
+  enum : uint32_t {
+    kPageShift = 8,
+    kPageSize = 1u << kPageShift,
+    kPageMask = kPageSize - 1u,
+    kMaxPageCount = 0x110000u >> kPageShift
+  };
+
+  //! Maps a text by searching the 'cmap' sub-table, used to build pages.
+  BLResult (BL_CDECL* searchFunc)(const BLFontFaceImpl* impl, uint32_t* content, size_t count, BLGlyphMappingState* state) BL_NOEXCEPT;
+
+  //! Number of pages - code points above `pageCount * kPageSize` are not mapped.
+  uint32_t pageCount;
+  //! Reserved for future use.
+  uint32_t reserved;
+
+  //! Pages (`pageCount` entries follow), each entry is either null (not built yet) or points to `kPageSize` glyph ids.
+  const uint16_t* pages[1];
+
+  static BL_INLINE size_t sizeOf(uint32_t pageCount) noexcept {
+    return sizeof(CMapPageTable) + (pageCount - 1u) * sizeof(const uint16_t*);
+  }
+};
+
 //! Character to glyph mapping data for making it easier to use `CMapTable`.
 struct CMapData {
   //! CMap table.
   RawTable cmapTable;
   //! CMap encoding [selected].
   CMapEncoding encoding;
+  //! Direct-mapped lookup table (built lazily, only used by some formats).
+  mutable CMapPageTable* pageTable;
 
   BL_INLINE void reset() noexcept { memset(this, 0, sizeof(*this)); }
 };
@@ -214,6 +247,9 @@ BL_HIDDEN BLResult validateSubTable(RawTable cmapTable, uint32_t subTableOffset,
 //! Populates character coverage of the given font face into `out` bit-set.
 BL_HIDDEN BLResult populateCharacterCoverage(const OTFaceImpl* faceI, BLBitSet* out) noexcept;
 
+//! Releases the direct-mapped lookup table of `faceI`, if it was built.
+BL_HIDDEN void freePageTable(OTFaceImpl* faceI) noexcept;
+
 //! Tries to find the best encoding in the provided 'cmap' and store this information into the given `faceI` instance.
 //! The function will return `BL_SUCCESS` even if there is no encoding to be used, however, in such case the character
 //! to glyph mapping feature will not be available to the users of this font face.
@@ -64,6 +64,7 @@ static BLResult initOpenTypeFace(OTFaceImpl* faceI, const BLFontData* fontData)
 
   BL_PROPAGATE(MetricsImpl::init(faceI, tables));
   BL_PROPAGATE(LayoutImpl::init(faceI, tables));
+  BL_PROPAGATE(VarImpl::init(faceI, tables));
 
   // Only setup legacy kerning if we don't have GlyphPositioning 'GPOS' table.
   if (!blTestFlag(faceI->otFlags, OTFaceFlags::kGPosLookupList))
@@ -79,9 +80,12 @@ static BLResult initOpenTypeFace(OTFaceImpl* faceI, const BLFontData* fontData)
 static BLResult BL_CDECL destroyOpenTypeFace(BLObjectImpl* impl) noexcept {
   OTFaceImpl* faceI = static_cast<OTFaceImpl*>(impl);
 
+  CMapImpl::freePageTable(faceI);
   blCallDtor(faceI->kern);
   blCallDtor(faceI->layout);
+  blCallDtor(faceI->var);
   blCallDtor(faceI->cffFDSubrIndexes);
+  blCallDtor(faceI->cffSubrOffsets);
   blFontFaceImplDtor(faceI);
 
   return blObjectFreeImpl(faceI);
@@ -104,7 +108,9 @@ BLResult createOpenTypeFace(BLFontFaceCore* self, const BLFontData* fontData, ui
 
   blCallCtor(faceI->kern);
   blCallCtor(faceI->layout);
+  blCallCtor(faceI->var);
   blCallCtor(faceI->cffFDSubrIndexes);
+  blCallCtor(faceI->cffSubrOffsets);
 
   BLResult result = initOpenTypeFace(faceI, fontData);
 
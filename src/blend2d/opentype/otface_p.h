@@ -15,6 +15,7 @@
 #include "../opentype/otlayout_p.h"
 #include "../opentype/otmetrics_p.h"
 #include "../opentype/otname_p.h"
+#include "../opentype/otvar_p.h"
 
 //! \cond INTERNAL
 //! \addtogroup blend2d_opentype_impl
@@ -84,6 +85,8 @@ struct OTFaceImpl : public BLFontFacePrivateImpl {
   KernData kern;
   //! OpenType layout data - 'GDEF', 'GSUB', and 'GPOS' tables.
   LayoutData layout;
+  //! Font variations data - 'fvar', 'avar', 'gvar', and 'HVAR' tables.
+  VarData var;
 
   union {
     //! OpenType font data [Compact Font Format] [CFF or CFF2].
@@ -93,6 +96,8 @@ struct OTFaceImpl : public BLFontFacePrivateImpl {
   };
   //! Array of LSubR indexes used by CID fonts (CFF/CFF2).
   BLArray<CFFData::IndexData> cffFDSubrIndexes;
+  //! Decoded offsets of all subroutine indexes (CFF/CFF2), see \ref CFFData::IndexData::offsets.
+  BLArray<uint32_t> cffSubrOffsets;
 
   BL_INLINE uint32_t locaOffsetSize() const noexcept {
     return uint32_t(otFlags & (OTFaceFlags::kLocaOffset16 | OTFaceFlags::kLocaOffset32));
@@ -101,7 +106,7 @@ struct OTFaceImpl : public BLFontFacePrivateImpl {
 
 //! OpenType tables that are used during the initialization of \ref OTFaceImpl.
 union OTFaceTables {
-  enum : uint32_t { kTableCount = 19 };
+  enum : uint32_t { kTableCount = 23 };
 
   BLFontTable tables[kTableCount];
 
@@ -130,6 +135,11 @@ union OTFaceTables {
 
     BLFontTable cff;
     BLFontTable cff2;
+
+    BLFontTable fvar;
+    BLFontTable avar;
+    BLFontTable gvar;
+    BLFontTable hvar;
   };
 
   BL_INLINE void init(OTFaceImpl* faceI, const BLFontData* fontData) noexcept {
@@ -157,7 +167,12 @@ union OTFaceTables {
       BL_MAKE_TAG('l', 'o', 'c', 'a'),
 
       BL_MAKE_TAG('C', 'F', 'F', ' '),
-      BL_MAKE_TAG('C', 'F', 'F', '2')
+      BL_MAKE_TAG('C', 'F', 'F', '2'),
+
+      BL_MAKE_TAG('f', 'v', 'a', 'r'),
+      BL_MAKE_TAG('a', 'v', 'a', 'r'),
+      BL_MAKE_TAG('g', 'v', 'a', 'r'),
+      BL_MAKE_TAG('H', 'V', 'A', 'R')
     };
 
     fontData->getTables(faceI->faceInfo.faceIndex, tables, tags, kTableCount);
@@ -176,12 +176,16 @@ public:
 
 static BLResult BL_CDECL getGlyphOutlines(
   const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   BLPath* out,
   size_t* contourCountOut,
   ScopedBuffer* tmpBuffer) noexcept {
 
+  if (varInstance)
+    return getGlyphOutlinesVar(faceI_, varInstance, glyphId, transform, out, contourCountOut, tmpBuffer);
+
   const OTFaceImpl* faceI = static_cast<const OTFaceImpl*>(faceI_);
 
   typedef GlyfTable::Simple Simple;
@@ -616,6 +620,397 @@ InvalidData:
   return blTraceError(BL_ERROR_INVALID_DATA);
 }
 
+// bl::OpenType::GlyfImpl - GetGlyphOutlines (Variations)
+// ======================================================
+
+// Variations require absolute glyph coordinates (deltas are applied to points and untouched points are interpolated
+// by using the original coordinates), so the variation path decodes each glyph into an array of points first, which
+// is then converted to BLPath. Compound glyphs are processed recursively as each component can be varied as well.
+
+namespace {
+
+struct GlyfVarContext {
+  const OTFaceImpl* faceI;
+  const VarInstance* instance;
+  BLPath* out;
+  size_t contourCount;
+};
+
+} // {anonymous}
+
+static BL_INLINE bool getGlyphDataRange(const OTFaceImpl* faceI, BLGlyphId glyphId, size_t& offset, size_t& endOff) noexcept {
+  RawTable locaTable = faceI->glyf.locaTable;
+
+  if (faceI->locaOffsetSize() == 2) {
+    size_t index = size_t(glyphId) * 2u;
+    if (BL_UNLIKELY(index + sizeof(UInt16) * 2u > locaTable.size))
+      return false;
+    offset = uint32_t(MemOps::readU16uBE(locaTable.data + index + 0)) * 2u;
+    endOff = uint32_t(MemOps::readU16uBE(locaTable.data + index + 2)) * 2u;
+  }
+  else {
+    size_t index = size_t(glyphId) * 4u;
+    if (BL_UNLIKELY(index + sizeof(UInt32) * 2u > locaTable.size))
+      return false;
+    offset = MemOps::readU32uBE(locaTable.data + index + 0);
+    endOff = MemOps::readU32uBE(locaTable.data + index + 4);
+  }
+
+  return offset <= endOff && endOff <= faceI->glyf.glyfTable.size;
+}
+
+// Converts TrueType contours (on-curve and off-curve points) to BLPath.
+static BLResult appendVarContours(BLPath* out, const BLPoint* points, const uint8_t* flags, const uint16_t* contourEnds, size_t contourCount, const BLMatrix2D& transform) noexcept {
+  typedef GlyfTable::Simple Simple;
+
+  size_t start = 0;
+  for (size_t contourIndex = 0; contourIndex < contourCount; contourIndex++) {
+    size_t end = contourEnds[contourIndex];
+    size_t count = end - start + 1u;
+
+    if (count < 2u) {
+      start = end + 1u;
+      continue;
+    }
+
+    // The contour can start with an off-curve point, in that case start with the last point if it's on-curve or
+    // with an implied on-curve point between the first and the last point.
+    BLPoint startPt;
+    size_t i = start;
+    size_t iEnd = end + 1u;
+
+    if (flags[start] & Simple::kOnCurvePoint) {
+      startPt = points[start];
+      i++;
+    }
+    else if (flags[end] & Simple::kOnCurvePoint) {
+      startPt = points[end];
+      iEnd--;
+    }
+    else {
+      startPt = (points[start] + points[end]) * 0.5;
+    }
+
+    BL_PROPAGATE(out->moveTo(transform.mapPoint(startPt)));
+
+    bool hasControl = false;
+    BLPoint control;
+
+    for (; i < iEnd; i++) {
+      BLPoint pt = points[i];
+      if (flags[i] & Simple::kOnCurvePoint) {
+        if (hasControl)
+          BL_PROPAGATE(out->quadTo(transform.mapPoint(control), transform.mapPoint(pt)));
+        else
+          BL_PROPAGATE(out->lineTo(transform.mapPoint(pt)));
+        hasControl = false;
+      }
+      else {
+        if (hasControl)
+          BL_PROPAGATE(out->quadTo(transform.mapPoint(control), transform.mapPoint((control + pt) * 0.5)));
+        control = pt;
+        hasControl = true;
+      }
+    }
+
+    if (hasControl)
+      BL_PROPAGATE(out->quadTo(transform.mapPoint(control), transform.mapPoint(startPt)));
+
+    BL_PROPAGATE(out->close());
+    start = end + 1u;
+  }
+
+  return BL_SUCCESS;
+}
+
+static BLResult decodeVarSimpleGlyph(GlyfVarContext& ctx, BLGlyphId glyphId, const uint8_t* gPtr, size_t remainingSize, size_t contourCount, const BLMatrix2D& transform) noexcept {
+  typedef GlyfTable::Simple Simple;
+
+  // Header is [endPtsOfContours] followed by [instructionLength] and [instructions].
+  if (BL_UNLIKELY(remainingSize < contourCount * 2u + 2u))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  const uint8_t* contourArray = gPtr;
+  size_t instructionCount = MemOps::readU16uBE(gPtr + contourCount * 2u);
+
+  gPtr += contourCount * 2u + 2u;
+  remainingSize -= contourCount * 2u + 2u;
+
+  if (BL_UNLIKELY(remainingSize < instructionCount))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  gPtr += instructionCount;
+  remainingSize -= instructionCount;
+
+  const uint8_t* gEnd = gPtr + remainingSize;
+  size_t pointCount = size_t(MemOps::readU16uBE(contourArray + (contourCount - 1u) * 2u)) + 1u;
+
+  // Points are followed by 4 phantom points, which are required by 'gvar', but not used for outlines.
+  size_t totalCount = pointCount + 4u;
+
+  ScopedBufferTmp<4096> buffer;
+  BLPoint* points = static_cast<BLPoint*>(buffer.alloc(totalCount * sizeof(BLPoint) + contourCount * sizeof(uint16_t) + pointCount));
+  if (BL_UNLIKELY(!points))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  uint16_t* contourEnds = reinterpret_cast<uint16_t*>(points + totalCount);
+  uint8_t* flags = reinterpret_cast<uint8_t*>(contourEnds + contourCount);
+
+  size_t prevEnd = 0;
+  for (size_t i = 0; i < contourCount; i++) {
+    size_t end = MemOps::readU16uBE(contourArray + i * 2u);
+    if (BL_UNLIKELY(end >= pointCount || (i && end < prevEnd)))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+    contourEnds[i] = uint16_t(end);
+    prevEnd = end;
+  }
+
+  // Decode flags.
+  size_t i = 0;
+  while (i < pointCount) {
+    if (BL_UNLIKELY(gPtr == gEnd))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+
+    uint8_t f = *gPtr++;
+    flags[i++] = f;
+
+    if (f & Simple::kRepeatFlag) {
+      if (BL_UNLIKELY(gPtr == gEnd))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+
+      size_t n = *gPtr++;
+      if (BL_UNLIKELY(n > pointCount - i))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+
+      memset(flags + i, f, n);
+      i += n;
+    }
+  }
+
+  // Decode X coordinates followed by Y coordinates - both are stored as deltas.
+  int x = 0;
+  for (i = 0; i < pointCount; i++) {
+    uint32_t f = flags[i];
+    if (f & Simple::kXIsByte) {
+      if (BL_UNLIKELY(gPtr == gEnd))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+      x += (f & Simple::kXIsSameOrXByteIsPositive) ? int(gPtr[0]) : -int(gPtr[0]);
+      gPtr += 1;
+    }
+    else if (!(f & Simple::kXIsSameOrXByteIsPositive)) {
+      if (BL_UNLIKELY(size_t(gEnd - gPtr) < 2u))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+      x += MemOps::readI16uBE(gPtr);
+      gPtr += 2;
+    }
+    points[i].x = double(x);
+  }
+
+  int y = 0;
+  for (i = 0; i < pointCount; i++) {
+    uint32_t f = flags[i];
+    if (f & Simple::kYIsByte) {
+      if (BL_UNLIKELY(gPtr == gEnd))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+      y += (f & Simple::kYIsSameOrYByteIsPositive) ? int(gPtr[0]) : -int(gPtr[0]);
+      gPtr += 1;
+    }
+    else if (!(f & Simple::kYIsSameOrYByteIsPositive)) {
+      if (BL_UNLIKELY(size_t(gEnd - gPtr) < 2u))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+      y += MemOps::readI16uBE(gPtr);
+      gPtr += 2;
+    }
+    points[i].y = double(y);
+  }
+
+  for (i = pointCount; i < totalCount; i++)
+    points[i].reset();
+
+  BL_PROPAGATE(VarImpl::applyGlyphDeltas(ctx.faceI, ctx.instance, glyphId, points, totalCount, contourEnds, contourCount));
+
+  ctx.contourCount += contourCount;
+  return appendVarContours(ctx.out, points, flags, contourEnds, contourCount, transform);
+}
+
+static BLResult decodeVarGlyph(GlyfVarContext& ctx, BLGlyphId glyphId, const BLMatrix2D& transform, size_t level) noexcept;
+
+static BLResult decodeVarCompoundGlyph(GlyfVarContext& ctx, BLGlyphId glyphId, const uint8_t* gPtr, size_t remainingSize, const BLMatrix2D& transform, size_t level) noexcept {
+  typedef GlyfTable::Compound Compound;
+
+  if (BL_UNLIKELY(level >= CompoundEntry::kMaxLevel))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  // The first pass validates components and calculates their count.
+  size_t componentCount = 0;
+  {
+    const uint8_t* p = gPtr;
+    size_t remaining = remainingSize;
+    uint32_t flags;
+
+    do {
+      if (BL_UNLIKELY(remaining < 4u))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+
+      flags = MemOps::readU16uBE(p);
+      size_t componentSize = 4u + ((flags & Compound::kArgsAreWords) ? 4u : 2u) +
+                             ((flags & Compound::kWeHaveScale) ? 2u :
+                              (flags & Compound::kWeHaveScaleXY) ? 4u :
+                              (flags & Compound::kWeHave2x2) ? 8u : 0u);
+
+      if (BL_UNLIKELY(remaining < componentSize))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+
+      p += componentSize;
+      remaining -= componentSize;
+      componentCount++;
+    } while (flags & Compound::kMoreComponents);
+  }
+
+  // Component offsets are represented as points (followed by 4 phantom points) so 'gvar' deltas can be applied to them.
+  size_t totalCount = componentCount + 4u;
+
+  ScopedBufferTmp<1024> buffer;
+  BLPoint* offsets = static_cast<BLPoint*>(buffer.alloc(totalCount * sizeof(BLPoint)));
+  if (BL_UNLIKELY(!offsets))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  const uint8_t* p = gPtr;
+  for (size_t i = 0; i < componentCount; i++) {
+    uint32_t flags = MemOps::readU16uBE(p);
+    int arg1, arg2;
+
+    if (flags & Compound::kArgsAreWords) {
+      arg1 = MemOps::readI16uBE(p + 4);
+      arg2 = MemOps::readI16uBE(p + 6);
+    }
+    else {
+      arg1 = MemOps::readI8(p + 4);
+      arg2 = MemOps::readI8(p + 5);
+    }
+
+    // Point matching (arguments are not XY values) is not supported, the same as in non-variable case.
+    if (!(flags & Compound::kArgsAreXYValues))
+      offsets[i].reset();
+    else
+      offsets[i].reset(double(arg1), double(arg2));
+
+    p += 4u + ((flags & Compound::kArgsAreWords) ? 4u : 2u) +
+         ((flags & Compound::kWeHaveScale) ? 2u : (flags & Compound::kWeHaveScaleXY) ? 4u : (flags & Compound::kWeHave2x2) ? 8u : 0u);
+  }
+
+  for (size_t i = componentCount; i < totalCount; i++)
+    offsets[i].reset();
+
+  BL_PROPAGATE(VarImpl::applyGlyphDeltas(ctx.faceI, ctx.instance, glyphId, offsets, totalCount, nullptr, 0));
+
+  constexpr double kScaleF2x14 = 1.0 / 16384.0;
+
+  p = gPtr;
+  for (size_t i = 0; i < componentCount; i++) {
+    uint32_t flags = MemOps::readU16uBE(p);
+    BLGlyphId componentId = MemOps::readU16uBE(p + 2);
+    p += 4u + ((flags & Compound::kArgsAreWords) ? 4u : 2u);
+
+    BLMatrix2D cm(1.0, 0.0, 0.0, 1.0, offsets[i].x, offsets[i].y);
+
+    if (flags & Compound::kAnyCompoundScale) {
+      if (flags & Compound::kWeHaveScale) {
+        double scale = double(MemOps::readI16uBE(p)) * kScaleF2x14;
+        cm.m00 = scale;
+        cm.m11 = scale;
+        p += 2;
+      }
+      else if (flags & Compound::kWeHaveScaleXY) {
+        cm.m00 = double(MemOps::readI16uBE(p + 0)) * kScaleF2x14;
+        cm.m11 = double(MemOps::readI16uBE(p + 2)) * kScaleF2x14;
+        p += 4;
+      }
+      else {
+        cm.m00 = double(MemOps::readI16uBE(p + 0)) * kScaleF2x14;
+        cm.m01 = double(MemOps::readI16uBE(p + 2)) * kScaleF2x14;
+        cm.m10 = double(MemOps::readI16uBE(p + 4)) * kScaleF2x14;
+        cm.m11 = double(MemOps::readI16uBE(p + 6)) * kScaleF2x14;
+        p += 8;
+      }
+
+      // Matches the offset scaling of the non-variable implementation.
+      if ((flags & (Compound::kArgsAreXYValues | Compound::kAnyCompoundOffset    )) ==
+                   (Compound::kArgsAreXYValues | Compound::kScaledComponentOffset)) {
+        cm.m20 *= Geometry::length(BLPoint(cm.m00, cm.m01));
+        cm.m21 *= Geometry::length(BLPoint(cm.m10, cm.m11));
+      }
+    }
+
+    if (BL_UNLIKELY(componentId >= ctx.faceI->faceInfo.glyphCount))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+
+    TransformInternal::multiply(cm, cm, transform);
+    BL_PROPAGATE(decodeVarGlyph(ctx, componentId, cm, level + 1u));
+  }
+
+  return BL_SUCCESS;
+}
+
+static BLResult decodeVarGlyph(GlyfVarContext& ctx, BLGlyphId glyphId, const BLMatrix2D& transform, size_t level) noexcept {
+  size_t offset;
+  size_t endOff;
+
+  if (BL_UNLIKELY(!getGlyphDataRange(ctx.faceI, glyphId, offset, endOff)))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  // Empty glyph.
+  if (offset == endOff)
+    return BL_SUCCESS;
+
+  size_t remainingSize = endOff - offset;
+  if (BL_UNLIKELY(remainingSize < sizeof(GlyfTable::GlyphData)))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  const uint8_t* gPtr = ctx.faceI->glyf.glyfTable.data + offset;
+  int contourCountSigned = reinterpret_cast<const GlyfTable::GlyphData*>(gPtr)->numberOfContours();
+
+  gPtr += sizeof(GlyfTable::GlyphData);
+  remainingSize -= sizeof(GlyfTable::GlyphData);
+
+  if (contourCountSigned > 0)
+    return decodeVarSimpleGlyph(ctx, glyphId, gPtr, remainingSize, size_t(unsigned(contourCountSigned)), transform);
+
+  if (contourCountSigned == -1)
+    return decodeVarCompoundGlyph(ctx, glyphId, gPtr, remainingSize, transform, level);
+
+  if (BL_UNLIKELY(contourCountSigned < -1))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  return BL_SUCCESS;
+}
+
+BLResult getGlyphOutlinesVar(
+  const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
+  BLGlyphId glyphId,
+  const BLMatrix2D* transform,
+  BLPath* out,
+  size_t* contourCountOut,
+  ScopedBuffer* tmpBuffer) noexcept {
+
+  blUnused(tmpBuffer);
+
+  const OTFaceImpl* faceI = static_cast<const OTFaceImpl*>(faceI_);
+  if (BL_UNLIKELY(glyphId >= faceI->faceInfo.glyphCount))
+    return blTraceError(BL_ERROR_INVALID_GLYPH);
+
+  GlyfVarContext ctx;
+  ctx.faceI = faceI;
+  ctx.instance = static_cast<const VarInstance*>(varInstance);
+  ctx.out = out;
+  ctx.contourCount = 0;
+
+  BLResult result = decodeVarGlyph(ctx, glyphId, *transform, 0);
+  *contourCountOut = result == BL_SUCCESS ? ctx.contourCount : size_t(0);
+  return result;
+}
+
 // bl::OpenType::GlyfImpl - Init
 // =============================
 
@@ -14,12 +14,16 @@ namespace GlyfImpl {
 
 BLResult BL_CDECL getGlyphOutlines_ASIMD(
   const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   BLPath* out,
   size_t* contourCountOut,
   ScopedBuffer* tmpBuffer) noexcept {
 
+  if (varInstance)
+    return getGlyphOutlinesVar(faceI_, varInstance, glyphId, transform, out, contourCountOut, tmpBuffer);
+
   return getGlyphOutlinesSimdImpl(faceI_, glyphId, transform, out, contourCountOut, tmpBuffer);
 }
 
@@ -143,9 +143,21 @@ namespace GlyfImpl {
 
 BL_HIDDEN extern const LookupTable<uint32_t, ((GlyfTable::Simple::kImportantFlagsMask + 1) >> 1)> vertexSizeTable;
 
+//! Decodes glyph outlines of a variation instance - used by all `getGlyphOutlines()` implementations when the font
+//! has a non-default `varInstance`, which requires absolute coordinates to apply 'gvar' deltas.
+BL_HIDDEN BLResult getGlyphOutlinesVar(
+  const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
+  BLGlyphId glyphId,
+  const BLMatrix2D* transform,
+  BLPath* out,
+  size_t* contourCountOut,
+  ScopedBuffer* tmpBuffer) noexcept;
+
 #if defined(BL_BUILD_OPT_SSE4_2)
 BL_HIDDEN BLResult BL_CDECL getGlyphOutlines_SSE4_2(
   const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   BLPath* out,
@@ -156,6 +168,7 @@ BL_HIDDEN BLResult BL_CDECL getGlyphOutlines_SSE4_2(
 #if defined(BL_BUILD_OPT_AVX2)
 BL_HIDDEN BLResult BL_CDECL getGlyphOutlines_AVX2(
   const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   BLPath* out,
@@ -166,6 +179,7 @@ BL_HIDDEN BLResult BL_CDECL getGlyphOutlines_AVX2(
 #if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
 BL_HIDDEN BLResult BL_CDECL getGlyphOutlines_ASIMD(
   const BLFontFaceImpl* faceI_,
+  const FontVarInstance* varInstance,
   BLGlyphId glyphId,
   const BLMatrix2D* transform,
   BLPath* out,
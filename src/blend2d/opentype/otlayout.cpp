@@ -3236,10 +3236,73 @@ static BLResult applyGPosLookup(GPosContext& ctx, RawTable table, GPosLookupAndF
   return result;
 }
 
+// bl::OpenType::LayoutImpl - GSUB & GPOS - Coverage Digest
+// ========================================================
+
+static void addCoverageToDigest(CoverageDigest& digest, RawTable coverageTable) noexcept {
+  if (!coverageTable.fits(CoverageTable::kBaseSize)) {
+    digest.addAll();
+    return;
+  }
+
+  uint32_t format = coverageTable.dataAs<CoverageTable>()->format();
+  uint32_t count = coverageTable.dataAs<CoverageTable>()->array.count();
+
+  if ((format != 1 && format != 2) || !coverageTable.fits(CoverageTable::kBaseSize + count * CoverageTable::entrySizeByFormat(format))) {
+    digest.addAll();
+    return;
+  }
+
+  if (format == 1) {
+    const UInt16* glyphs = coverageTable.dataAs<CoverageTable::Format1>()->glyphs.array();
+    for (uint32_t i = 0; i < count; i++)
+      digest.addGlyph(glyphs[i].value());
+  }
+  else {
+    const CoverageTable::Range* ranges = coverageTable.dataAs<CoverageTable::Format2>()->ranges.array();
+    for (uint32_t i = 0; i < count; i++)
+      digest.addRange(ranges[i].firstGlyph(), ranges[i].lastGlyph());
+  }
+}
+
+// Adds glyphs, which a validated lookup subtable can be applied to, to the digest. This is the coverage of the first
+// (input) glyph, which is referenced by all lookup types except context lookups of format 3, which have an array of
+// coverages per glyph.
+static void addSubTableCoverageToDigest(CoverageDigest& digest, RawTable subTable, bool isGSub, uint32_t lookupTypeAndFormat) noexcept {
+  uint32_t coverageOffset = 0;
+
+  bool isContext3 = isGSub ? lookupTypeAndFormat == uint32_t(GSubLookupAndFormat::kType5Format3)
+                           : lookupTypeAndFormat == uint32_t(GPosLookupAndFormat::kType7Format3);
+
+  bool isChainedContext3 = isGSub ? lookupTypeAndFormat == uint32_t(GSubLookupAndFormat::kType6Format3)
+                                  : lookupTypeAndFormat == uint32_t(GPosLookupAndFormat::kType8Format3);
+
+  if (isContext3) {
+    if (subTable.fits(GSubGPosTable::SequenceContext3::kBaseSize + 2u) && subTable.dataAs<GSubGPosTable::SequenceContext3>()->glyphCount())
+      coverageOffset = subTable.dataAs<GSubGPosTable::SequenceContext3>()->coverageOffsetArray()[0].value();
+  }
+  else if (isChainedContext3) {
+    uint32_t inputOffset = 4u + uint32_t(subTable.dataAs<GSubGPosTable::ChainedSequenceContext3>()->backtrackGlyphCount()) * 2u;
+    if (subTable.fits(inputOffset + 4u) && subTable.readU16(inputOffset))
+      coverageOffset = subTable.readU16(inputOffset + 2u);
+  }
+  else if (subTable.fits(GSubGPosTable::LookupHeaderWithCoverage::kBaseSize)) {
+    coverageOffset = subTable.dataAs<GSubGPosTable::LookupHeaderWithCoverage>()->coverageOffset();
+  }
+
+  if (!coverageOffset || coverageOffset >= subTable.size) {
+    digest.addAll();
+    return;
+  }
+
+  addCoverageToDigest(digest, subTable.subTable(coverageOffset));
+}
+
 // bl::OpenType::LayoutImpl - GSUB & GPOS - Validate
 // =================================================
 
-static bool validateLookup(ValidationContext& validator, Table<GSubGPosTable> table, uint32_t lookupIndex) noexcept {
+// Validates a lookup and calculates its coverage digest, which is only valid if the lookup is valid.
+static bool validateLookup(ValidationContext& validator, Table<GSubGPosTable> table, uint32_t lookupIndex, CoverageDigest& digest) noexcept {
   const char* tableName = "LookupList";
   const OTFaceImpl* faceI = validator.faceImpl();
 
@@ -3332,6 +3395,8 @@ static bool validateLookup(ValidationContext& validator, Table<GSubGPosTable> ta
                         : validateGPosLookup(validator, subTable, GPosLookupAndFormat(lookupTypeAndFormat));
     if (!valid)
       return false;
+
+    addSubTableCoverageToDigest(digest, subTable, isGSub, lookupTypeAndFormat);
   }
 
   return true;
@@ -3356,8 +3421,13 @@ static BL_NOINLINE LayoutData::LookupStatusBits validateLookups(const OTFaceImpl
     if (lookupIndex >= lookupCount)
       break;
 
-    if (validateLookup(validator, table, lookupIndex))
+    CoverageDigest digest;
+    digest.reset();
+
+    if (validateLookup(validator, table, lookupIndex, digest)) {
+      faceI->layout.commitCoverageDigest(lookupKind, lookupIndex, digest);
       validBits |= BitSetOps::indexAsMask(bitIndex);
+    }
   }
 
   return faceI->layout.commitLookupStatusBits(lookupKind, wordIndex, LayoutData::LookupStatusBits::make(analyzedBits, validBits));
@@ -3443,6 +3513,12 @@ static BLResult BL_CDECL applyLookups(const BLFontFaceImpl* faceI_, BLGlyphBuffe
       uint32_t lookupTableIndex = it.next() + bitOffset;
       BL_ASSERT_VALIDATED(lookupTableIndex < layoutData.lookupCount);
 
+      // Skip the whole lookup if none of the glyphs can be covered by it, which is much cheaper than testing each
+      // glyph against coverage tables of all its subtables. Most glyphs are not covered by most lookups.
+      CoverageDigest digest = faceI->layout.getCoverageDigest(kLookupKind, lookupTableIndex);
+      if (!digest.mayContainAny(ctx.glyphData(), ctx.size()))
+        continue;
+
       uint32_t lookupTableOffset = lookupListTable->array()[lookupTableIndex].value();
       BL_ASSERT_VALIDATED(lookupTableOffset <= lookupListTable.size - 6u);
 
@@ -113,6 +113,77 @@ struct GSubGPosLookupInfo {
   TypeFormatInfo lookupInfo[kFormatAndIdCount];
 };
 
+//! Coverage digest - a compact superset of glyphs covered by all subtables of a GSUB/GPOS lookup.
+//!
+//! Each mask has a bit set for each `(glyphId >> shift) % kMaskBits` value of a covered glyph, using a different
+//! shift per mask. A glyph can only be covered if its bits are set in all masks, which makes it possible to skip
+//! lookups that cannot match any glyph of a glyph buffer without querying their coverage tables.
+struct CoverageDigest {
+  typedef uintptr_t MaskType;
+
+  enum : uint32_t {
+    kMaskCount = 3,
+    kMaskBits = uint32_t(sizeof(MaskType) * 8u)
+  };
+
+  MaskType masks[kMaskCount];
+
+  static BL_INLINE_NODEBUG constexpr uint32_t shiftOf(uint32_t maskIndex) noexcept {
+    return maskIndex == 0 ? 0u : maskIndex == 1 ? 4u : 9u;
+  }
+
+  static BL_INLINE_NODEBUG constexpr MaskType bitOf(uint32_t maskIndex, uint32_t glyphId) noexcept {
+    return MaskType(1) << ((glyphId >> shiftOf(maskIndex)) & (kMaskBits - 1u));
+  }
+
+  BL_INLINE void reset() noexcept {
+    for (uint32_t i = 0; i < kMaskCount; i++)
+      masks[i] = 0;
+  }
+
+  //! Makes the digest match all glyphs, used when a subtable coverage cannot be determined.
+  BL_INLINE void addAll() noexcept {
+    for (uint32_t i = 0; i < kMaskCount; i++)
+      masks[i] = ~MaskType(0);
+  }
+
+  BL_INLINE void addGlyph(uint32_t glyphId) noexcept {
+    for (uint32_t i = 0; i < kMaskCount; i++)
+      masks[i] |= bitOf(i, glyphId);
+  }
+
+  BL_INLINE void addRange(uint32_t firstGlyph, uint32_t lastGlyph) noexcept {
+    for (uint32_t i = 0; i < kMaskCount; i++) {
+      uint32_t a = firstGlyph >> shiftOf(i);
+      uint32_t b = lastGlyph >> shiftOf(i);
+
+      if (b - a >= kMaskBits - 1u) {
+        masks[i] = ~MaskType(0);
+        continue;
+      }
+
+      for (uint32_t j = a; j <= b; j++)
+        masks[i] |= MaskType(1) << (j & (kMaskBits - 1u));
+    }
+  }
+
+  BL_NODISCARD
+  BL_INLINE bool mayContain(uint32_t glyphId) const noexcept {
+    return ((masks[0] & bitOf(0, glyphId)) != 0) &
+           ((masks[1] & bitOf(1, glyphId)) != 0) &
+           ((masks[2] & bitOf(2, glyphId)) != 0);
+  }
+
+  //! Tests whether any of the given glyphs may be covered.
+  BL_NODISCARD
+  BL_INLINE bool mayContainAny(const BLGlyphId* glyphData, size_t size) const noexcept {
+    for (size_t i = 0; i < size; i++)
+      if (mayContain(glyphData[i]))
+        return true;
+    return false;
+  }
+};
+
 //! Data stored in `OTFaceImpl` related to OpenType advanced layout features.
 class LayoutData {
 public:
@@ -172,6 +243,7 @@ public:
     uint16_t lookupCount;
     uint16_t lookupStatusDataSize;
     uint16_t lookupStatusDataOffset;
+    uint16_t coverageDigestOffset;
   };
 
   //! \}
@@ -183,6 +255,10 @@ public:
   GDef gdef;
   GSubGPos kinds[2];
   LookupStatusBits* _lookupStatusBits;
+  //! Coverage digests of all GSUB and GPOS lookups (allocated together with lookup status bits), see \ref CoverageDigest.
+  //!
+  //! Digest masks are stored inverted, so a digest that was not computed yet (zero initialized) matches all glyphs.
+  CoverageDigest::MaskType* _coverageDigestData;
 
   //! \}
 
@@ -193,7 +269,8 @@ public:
     : tables{},
       gdef{},
       kinds{},
-      _lookupStatusBits(nullptr) {}
+      _lookupStatusBits(nullptr),
+      _coverageDigestData(nullptr) {}
 
   BL_INLINE ~LayoutData() noexcept {
     if (_lookupStatusBits)
@@ -219,7 +296,8 @@ public:
   //! \name Lookup Status Bits
   //! \{
 
-  //! Allocates 4 lookup bit arrays for both GSUB/GPOS lookups each having analyzed/valid bit per lookup.
+  //! Allocates 4 lookup bit arrays for both GSUB/GPOS lookups each having analyzed/valid bit per lookup, followed
+  //! by coverage digests of all GSUB/GPOS lookups.
   BL_INLINE BLResult allocateLookupStatusBits() noexcept {
     uint32_t gsubLookupCount = gsub().lookupCount;
     uint32_t gposLookupCount = gpos().lookupCount;
@@ -231,15 +309,22 @@ public:
     if (!totalLookupStatusDataSize)
       return BL_SUCCESS;
 
-    LookupStatusBits* lookupStatusBits = static_cast<LookupStatusBits*>(calloc(totalLookupStatusDataSize, sizeof(LookupStatusBits)));
-    if (BL_UNLIKELY(!lookupStatusBits))
+    size_t statusBitsSize = size_t(totalLookupStatusDataSize) * sizeof(LookupStatusBits);
+    size_t digestDataSize = size_t(gsubLookupCount + gposLookupCount) * sizeof(CoverageDigest);
+
+    void* data = calloc(1, statusBitsSize + digestDataSize);
+    if (BL_UNLIKELY(!data))
       return blTraceError(BL_ERROR_OUT_OF_MEMORY);
 
-    _lookupStatusBits = lookupStatusBits;
+    _lookupStatusBits = static_cast<LookupStatusBits*>(data);
+    _coverageDigestData = PtrOps::offset<CoverageDigest::MaskType>(data, statusBitsSize);
+
     gsub().lookupStatusDataSize = uint16_t(gsubLookupStatusDataSize);
     gsub().lookupStatusDataOffset = uint16_t(0);
+    gsub().coverageDigestOffset = uint16_t(0);
     gpos().lookupStatusDataSize = uint16_t(gposLookupStatusDataSize);
     gpos().lookupStatusDataOffset = uint16_t(gsubLookupStatusDataSize);
+    gpos().coverageDigestOffset = uint16_t(gsubLookupCount);
     return BL_SUCCESS;
   }
 
@@ -286,6 +371,36 @@ public:
   }
 
   //! \}
+
+  //! \name Coverage Digests
+  //! \{
+
+  BL_INLINE CoverageDigest::MaskType* _coverageDigestOf(LookupKind lookupKind, uint32_t lookupIndex) const noexcept {
+    return _coverageDigestData + (size_t(kinds[size_t(lookupKind)].coverageDigestOffset) + lookupIndex) * CoverageDigest::kMaskCount;
+  }
+
+  //! Returns a coverage digest of the given lookup - a digest that was not committed yet matches all glyphs.
+  BL_INLINE CoverageDigest getCoverageDigest(LookupKind lookupKind, uint32_t lookupIndex) const noexcept {
+    BL_ASSERT(lookupIndex < kinds[size_t(lookupKind)].lookupCount);
+    const CoverageDigest::MaskType* data = _coverageDigestOf(lookupKind, lookupIndex);
+
+    CoverageDigest digest;
+    for (uint32_t i = 0; i < CoverageDigest::kMaskCount; i++)
+      digest.masks[i] = ~blAtomicFetchRelaxed(&data[i]);
+    return digest;
+  }
+
+  //! Commits a coverage digest of a validated lookup. Each mask is stored separately, but since a mask that was not
+  //! committed yet matches all glyphs, another thread would never see a digest that doesn't match a covered glyph.
+  BL_INLINE void commitCoverageDigest(LookupKind lookupKind, uint32_t lookupIndex, const CoverageDigest& digest) const noexcept {
+    BL_ASSERT(lookupIndex < kinds[size_t(lookupKind)].lookupCount);
+    CoverageDigest::MaskType* data = _coverageDigestOf(lookupKind, lookupIndex);
+
+    for (uint32_t i = 0; i < CoverageDigest::kMaskCount; i++)
+      blAtomicStoreRelaxed(&data[i], ~digest.masks[i]);
+  }
+
+  //! \}
 };
 
 namespace LayoutImpl {
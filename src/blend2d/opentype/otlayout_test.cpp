@@ -0,0 +1,69 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "../api-build_test_p.h"
+#if defined(BL_TEST)
+
+#include "../random.h"
+#include "../opentype/otlayout_p.h"
+
+namespace bl {
+namespace OpenType {
+
+// bl::OpenType::LayoutImpl - Tests
+// ================================
+
+static void testCoverageDigest() noexcept {
+  BLRandom rnd(0x1234);
+
+  for (uint32_t iter = 0; iter < 100; iter++) {
+    CoverageDigest digest;
+    digest.reset();
+
+    uint32_t firstGlyph = rnd.nextUInt32() % 65000u;
+    uint32_t lastGlyph = firstGlyph + rnd.nextUInt32() % 200u;
+    uint32_t singleGlyph = rnd.nextUInt32() % 65536u;
+
+    EXPECT_FALSE(digest.mayContain(singleGlyph));
+
+    digest.addGlyph(singleGlyph);
+    digest.addRange(firstGlyph, lastGlyph);
+
+    // A digest must never reject a glyph that was added.
+    EXPECT_TRUE(digest.mayContain(singleGlyph));
+    for (uint32_t glyphId = firstGlyph; glyphId <= lastGlyph; glyphId++)
+      EXPECT_TRUE(digest.mayContain(glyphId));
+
+    BLGlyphId glyphs[3] = { 0xFFFFu, 0xFFFFu, BLGlyphId(singleGlyph) };
+    EXPECT_TRUE(digest.mayContainAny(glyphs, 3));
+  }
+
+  INFO("bl::OpenType::CoverageDigest - rejection of glyphs that were not added");
+  {
+    CoverageDigest digest;
+    digest.reset();
+    digest.addRange(36, 61);
+
+    uint32_t rejected = 0;
+    for (uint32_t glyphId = 0; glyphId < 4096; glyphId++)
+      rejected += uint32_t(!digest.mayContain(glyphId));
+
+    EXPECT_GE(rejected, 4000u);
+
+    digest.addAll();
+    for (uint32_t glyphId = 0; glyphId < 65536; glyphId += 7)
+      EXPECT_TRUE(digest.mayContain(glyphId));
+  }
+}
+
+UNIT(opentype_layout, BL_TEST_GROUP_TEXT_OPENTYPE) {
+  INFO("bl::OpenType::CoverageDigest");
+  testCoverageDigest();
+}
+
+} // {OpenType}
+} // {bl}
+
+#endif // BL_TEST
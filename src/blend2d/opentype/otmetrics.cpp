@@ -7,6 +7,7 @@
 #include "../trace_p.h"
 #include "../opentype/otface_p.h"
 #include "../opentype/otmetrics_p.h"
+#include "../support/math_p.h"
 #include "../support/ptrops_p.h"
 
 namespace bl {
@@ -37,8 +38,9 @@ static BL_INLINE const char* sizeCheckMessage(size_t size) noexcept {
 // bl::OpenType::MetricsImpl - GetGlyphAdvances
 // ============================================
 
-static BLResult BL_CDECL getGlyphAdvances(const BLFontFaceImpl* faceI_, const uint32_t* glyphData, intptr_t glyphAdvance, BLGlyphPlacement* placementData, size_t count) noexcept {
+static BLResult BL_CDECL getGlyphAdvances(const BLFontFaceImpl* faceI_, const FontVarInstance* varInstance_, const uint32_t* glyphData, intptr_t glyphAdvance, BLGlyphPlacement* placementData, size_t count) noexcept {
   const OTFaceImpl* faceI = static_cast<const OTFaceImpl*>(faceI_);
+  const VarInstance* varInstance = static_cast<const VarInstance*>(varInstance_);
   const XMtxTable* mtxTable = faceI->metrics.xmtxTable[BL_ORIENTATION_HORIZONTAL].dataAs<XMtxTable>();
 
   // Sanity check.
@@ -55,6 +57,9 @@ static BLResult BL_CDECL getGlyphAdvances(const BLFontFaceImpl* faceI_, const ui
     uint32_t metricIndex = blMin(glyphId, longMetricMax);
     int32_t advance = mtxTable->lmArray()[metricIndex].advance.value();
 
+    if (varInstance)
+      advance += VarImpl::getAdvanceDelta(faceI, varInstance, glyphId);
+
     placementData[i].placement.reset(0, 0);
     placementData[i].advance.reset(advance, 0);
   }
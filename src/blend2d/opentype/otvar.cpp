@@ -0,0 +1,899 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "../api-build_p.h"
+#include "../fontvariationsettings_p.h"
+#include "../trace_p.h"
+#include "../opentype/otface_p.h"
+#include "../opentype/otvar_p.h"
+#include "../support/memops_p.h"
+#include "../support/ptrops_p.h"
+#include "../support/scopedbuffer_p.h"
+
+namespace bl {
+namespace OpenType {
+namespace VarImpl {
+
+// bl::OpenType::VarImpl - Trace
+// =============================
+
+#if defined(BL_TRACE_OT_ALL) || defined(BL_TRACE_OT_VAR)
+#define Trace BLDebugTrace
+#else
+#define Trace BLDummyTrace
+#endif
+
+// bl::OpenType::VarImpl - Item Variation Store
+// ============================================
+
+// VariationRegionList:
+//   UInt16 axisCount;
+//   UInt16 regionCount;
+//   struct RegionAxisCoordinates { F2x14 start, peak, end; } regions[regionCount][axisCount];
+//
+// ItemVariationData:
+//   UInt16 itemCount;
+//   UInt16 wordDeltaCount;
+//   UInt16 regionIndexCount;
+//   UInt16 regionIndexes[regionIndexCount];
+//   DeltaSet deltaSets[itemCount];
+
+static BL_INLINE RawTable regionListOf(const RawTable& store) noexcept {
+  return store.subTableUnchecked(MemOps::readU32uBE(store.data + 2));
+}
+
+static BL_INLINE uint32_t regionCountOf(const RawTable& store) noexcept {
+  return store ? MemOps::readU16uBE(regionListOf(store).data + 2) : 0u;
+}
+
+static RawTable validateItemVariationStore(RawTable store, uint32_t axisCount) noexcept {
+  if (!blFontTableFitsT<ItemVariationStoreTable>(store))
+    return RawTable();
+
+  const ItemVariationStoreTable* header = store.dataAs<ItemVariationStoreTable>();
+  uint32_t regionListOffset = header->variationRegionListOffset();
+  uint32_t dataCount = header->itemVariationDataCount();
+
+  if (header->format() != 1 || size_t(dataCount) * 4u > store.size - ItemVariationStoreTable::kBaseSize)
+    return RawTable();
+
+  if (regionListOffset > store.size - 4u)
+    return RawTable();
+
+  RawTable regionList = store.subTableUnchecked(regionListOffset);
+  uint32_t regionAxisCount = regionList.readU16(0);
+  uint32_t regionCount = regionList.readU16(2);
+
+  if (regionAxisCount != axisCount || !regionList.fits(4u + size_t(regionCount) * axisCount * 6u))
+    return RawTable();
+
+  return store;
+}
+
+// Returns the ItemVariationData at `outerIndex` or an empty table if it's missing or invalid.
+static RawTable itemVariationDataOf(const RawTable& store, uint32_t outerIndex) noexcept {
+  if (!store || outerIndex >= store.readU16(6))
+    return RawTable();
+
+  uint32_t offset = MemOps::readU32uBE(store.data + ItemVariationStoreTable::kBaseSize + outerIndex * 4u);
+  if (offset > store.size || store.size - offset < 6u)
+    return RawTable();
+
+  RawTable data = store.subTableUnchecked(offset);
+  if (!data.fits(6u + size_t(data.readU16(4)) * 2u))
+    return RawTable();
+
+  return data;
+}
+
+double getItemDelta(const RawTable& store, const double* scalars, uint32_t regionCount, uint32_t outerIndex, uint32_t innerIndex) noexcept {
+  RawTable data = itemVariationDataOf(store, outerIndex);
+  if (!data)
+    return 0.0;
+
+  uint32_t itemCount = data.readU16(0);
+  uint32_t wordDeltaCount = data.readU16(2);
+  uint32_t regionIndexCount = data.readU16(4);
+
+  bool longWords = (wordDeltaCount & 0x8000u) != 0;
+  uint32_t wordCount = wordDeltaCount & 0x7FFFu;
+
+  if (innerIndex >= itemCount || wordCount > regionIndexCount)
+    return 0.0;
+
+  size_t wordSize = longWords ? 4u : 2u;
+  size_t rowSize = wordCount * wordSize + (regionIndexCount - wordCount) * (wordSize / 2u);
+  size_t headerSize = 6u + size_t(regionIndexCount) * 2u;
+
+  if (!rowSize || (data.size - headerSize) / rowSize < itemCount)
+    return 0.0;
+
+  const uint8_t* regionIndexes = data.data + 6u;
+  const uint8_t* row = data.data + headerSize + innerIndex * rowSize;
+  double delta = 0.0;
+
+  for (uint32_t i = 0; i < regionIndexCount; i++) {
+    int32_t value;
+    if (i < wordCount) {
+      value = longWords ? MemOps::readI32uBE(row) : int32_t(MemOps::readI16uBE(row));
+      row += wordSize;
+    }
+    else {
+      value = longWords ? int32_t(MemOps::readI16uBE(row)) : int32_t(MemOps::readI8(row));
+      row += wordSize / 2u;
+    }
+
+    uint32_t regionIndex = MemOps::readU16uBE(regionIndexes + i * 2u);
+    if (regionIndex < regionCount)
+      delta += scalars[regionIndex] * double(value);
+  }
+
+  return delta;
+}
+
+BLResult getRegionScalars(const RawTable& store, const double* scalars, uint32_t regionCount, uint32_t outerIndex, double* out, uint32_t capacity, uint32_t* countOut) noexcept {
+  *countOut = 0;
+
+  // No variation store means that there are no regions, which is okay.
+  if (!store)
+    return BL_SUCCESS;
+
+  RawTable data = itemVariationDataOf(store, outerIndex);
+  if (BL_UNLIKELY(!data))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  uint32_t regionIndexCount = data.readU16(4);
+  if (BL_UNLIKELY(regionIndexCount > capacity))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  for (uint32_t i = 0; i < regionIndexCount; i++) {
+    uint32_t regionIndex = data.readU16(6u + i * 2u);
+    out[i] = scalars && regionIndex < regionCount ? scalars[regionIndex] : 0.0;
+  }
+
+  *countOut = regionIndexCount;
+  return BL_SUCCESS;
+}
+
+static void calcRegionScalars(const RawTable& store, const int16_t* coords, uint32_t axisCount, double* out, uint32_t regionCount) noexcept {
+  if (!regionCount)
+    return;
+
+  const uint8_t* p = regionListOf(store).data + 4u;
+
+  for (uint32_t i = 0; i < regionCount; i++) {
+    double scalar = 1.0;
+    for (uint32_t axis = 0; axis < axisCount; axis++, p += 6u) {
+      int start = MemOps::readI16uBE(p + 0u);
+      int peak = MemOps::readI16uBE(p + 2u);
+      int end = MemOps::readI16uBE(p + 4u);
+      scalar *= calcAxisScalar(coords[axis], start, peak, end);
+    }
+    out[i] = scalar;
+  }
+}
+
+// bl::OpenType::VarImpl - DeltaSetIndexMap
+// ========================================
+
+// DeltaSetIndexMap:
+//   UInt8 format;
+//   UInt8 entryFormat;
+//   UInt16|UInt32 mapCount;
+//   UInt8 mapData[mapCount * entrySize];
+
+static BL_INLINE uint32_t deltaSetIndexMapHeaderSize(uint32_t format) noexcept { return format == 0 ? 4u : 6u; }
+static BL_INLINE uint32_t deltaSetIndexMapEntrySize(uint32_t entryFormat) noexcept { return ((entryFormat >> 4) & 0x3u) + 1u; }
+
+static RawTable validateDeltaSetIndexMap(RawTable map) noexcept {
+  if (!map.fits(4u))
+    return RawTable();
+
+  uint32_t format = map.data[0];
+  if (format > 1 || !map.fits(deltaSetIndexMapHeaderSize(format)))
+    return RawTable();
+
+  uint32_t count = format == 0 ? MemOps::readU16uBE(map.data + 2) : MemOps::readU32uBE(map.data + 2);
+  uint32_t entrySize = deltaSetIndexMapEntrySize(map.data[1]);
+
+  if (!count || (map.size - deltaSetIndexMapHeaderSize(format)) / entrySize < count)
+    return RawTable();
+
+  return map;
+}
+
+static BL_INLINE void mapDeltaSetIndex(const RawTable& map, uint32_t index, uint32_t& outerIndex, uint32_t& innerIndex) noexcept {
+  uint32_t format = map.data[0];
+  uint32_t entryFormat = map.data[1];
+
+  uint32_t count = format == 0 ? MemOps::readU16uBE(map.data + 2) : MemOps::readU32uBE(map.data + 2);
+  uint32_t entrySize = deltaSetIndexMapEntrySize(entryFormat);
+  uint32_t innerBits = (entryFormat & 0xFu) + 1u;
+
+  const uint8_t* p = map.data + deltaSetIndexMapHeaderSize(format) + size_t(blMin(index, count - 1u)) * entrySize;
+  uint32_t entry = 0;
+
+  for (uint32_t i = 0; i < entrySize; i++)
+    entry = (entry << 8) | p[i];
+
+  outerIndex = entry >> innerBits;
+  innerIndex = entry & ((1u << innerBits) - 1u);
+}
+
+int32_t getAdvanceDelta(const OTFaceImpl* faceI, const VarInstance* instance, BLGlyphId glyphId) noexcept {
+  const VarData& var = faceI->var;
+  if (!instance || !var.hvarStore)
+    return 0;
+
+  // Instances are shared between threads - a delta calculated by multiple threads at the same time is always the same.
+  int32_t* cachedDelta = glyphId < instance->advanceDeltaCount ? &instance->advanceDeltas[glyphId] : nullptr;
+  if (cachedDelta) {
+    int32_t delta = blAtomicFetchRelaxed(cachedDelta);
+    if (delta != VarInstance::kAdvanceDeltaNotCached)
+      return delta;
+  }
+
+  uint32_t outerIndex = 0;
+  uint32_t innerIndex = glyphId;
+
+  if (var.hvarAdvanceMap)
+    mapDeltaSetIndex(var.hvarAdvanceMap, glyphId, outerIndex, innerIndex);
+
+  double delta = getItemDelta(var.hvarStore, instance->hvarRegionScalars, instance->hvarRegionCount, outerIndex, innerIndex);
+  int32_t roundedDelta = int32_t(Math::roundToInt(blClamp(delta, -1073741824.0, 1073741824.0)));
+
+  if (cachedDelta)
+    blAtomicStoreRelaxed(cachedDelta, roundedDelta);
+
+  return roundedDelta;
+}
+
+// bl::OpenType::VarImpl - Glyph Variations
+// ========================================
+
+// Decodes packed point numbers. Zero count means that all points of the glyph are referenced.
+static bool decodePackedPoints(const uint8_t*& p, const uint8_t* end, uint16_t* out, size_t capacity, size_t& countOut) noexcept {
+  if (p == end)
+    return false;
+
+  size_t count = *p++;
+  if (count & 0x80u) {
+    if (p == end)
+      return false;
+    count = ((count & 0x7Fu) << 8) | *p++;
+  }
+
+  countOut = count;
+  if (count > capacity)
+    return false;
+
+  size_t i = 0;
+  uint32_t pointIndex = 0;
+
+  while (i < count) {
+    if (p == end)
+      return false;
+
+    uint32_t control = *p++;
+    size_t runCount = (control & 0x7Fu) + 1u;
+    size_t valueSize = (control & 0x80u) ? 2u : 1u;
+
+    if (runCount > count - i || size_t(end - p) < runCount * valueSize)
+      return false;
+
+    for (size_t j = 0; j < runCount; j++, p += valueSize) {
+      pointIndex += valueSize == 2u ? MemOps::readU16uBE(p) : uint32_t(p[0]);
+      out[i++] = uint16_t(pointIndex);
+    }
+  }
+
+  return true;
+}
+
+// Decodes `count` packed deltas.
+static bool decodePackedDeltas(const uint8_t*& p, const uint8_t* end, int32_t* out, size_t count) noexcept {
+  size_t i = 0;
+
+  while (i < count) {
+    if (p == end)
+      return false;
+
+    uint32_t control = *p++;
+    size_t runCount = (control & 0x3Fu) + 1u;
+
+    if (runCount > count - i)
+      return false;
+
+    switch (control & 0xC0u) {
+      case 0x80u: {
+        for (size_t j = 0; j < runCount; j++)
+          out[i++] = 0;
+        break;
+      }
+
+      case 0x00u: {
+        if (size_t(end - p) < runCount)
+          return false;
+        for (size_t j = 0; j < runCount; j++, p += 1)
+          out[i++] = MemOps::readI8(p);
+        break;
+      }
+
+      case 0x40u: {
+        if (size_t(end - p) < runCount * 2u)
+          return false;
+        for (size_t j = 0; j < runCount; j++, p += 2)
+          out[i++] = MemOps::readI16uBE(p);
+        break;
+      }
+
+      default: {
+        if (size_t(end - p) < runCount * 4u)
+          return false;
+        for (size_t j = 0; j < runCount; j++, p += 4)
+          out[i++] = MemOps::readI32uBE(p);
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+// Interpolates a delta of a single coordinate that was not referenced by a tuple (IUP).
+static BL_INLINE double interpolateDelta(double c, double c1, double c2, double d1, double d2) noexcept {
+  if (c1 == c2)
+    return d1 == d2 ? d1 : 0.0;
+
+  if (c1 > c2) {
+    BLInternal::swap(c1, c2);
+    BLInternal::swap(d1, d2);
+  }
+
+  if (c <= c1)
+    return d1;
+
+  if (c >= c2)
+    return d2;
+
+  double scale = (d2 - d1) / (c2 - c1);
+  return d1 + (c - c1) * scale;
+}
+
+// Interpolates untouched points of a contour [start, end] from the nearest touched points (in contour order).
+static void interpolateUntouchedPoints(BLPoint* deltas, const uint8_t* touched, const BLPoint* points, size_t start, size_t end) noexcept {
+  size_t first = start;
+  while (!touched[first])
+    if (++first > end)
+      return;
+
+  size_t ref1 = first;
+  for (;;) {
+    size_t ref2 = ref1;
+    do {
+      ref2 = ref2 == end ? start : ref2 + 1u;
+    } while (!touched[ref2]);
+
+    size_t i = ref1 == end ? start : ref1 + 1u;
+    while (i != ref2) {
+      deltas[i].reset(interpolateDelta(points[i].x, points[ref1].x, points[ref2].x, deltas[ref1].x, deltas[ref2].x),
+                      interpolateDelta(points[i].y, points[ref1].y, points[ref2].y, deltas[ref1].y, deltas[ref2].y));
+      i = i == end ? start : i + 1u;
+    }
+
+    if (ref2 == first)
+      break;
+    ref1 = ref2;
+  }
+}
+
+BLResult applyGlyphDeltas(
+  const OTFaceImpl* faceI,
+  const VarInstance* instance,
+  BLGlyphId glyphId,
+  BLPoint* points,
+  size_t pointCount,
+  const uint16_t* contourEnds,
+  size_t contourCount) noexcept {
+
+  Table<GVarTable> gvar(faceI->var.gvar);
+  if (!instance || !gvar || glyphId >= gvar->glyphCount())
+    return BL_SUCCESS;
+
+  uint32_t axisCount = instance->axisCount;
+  uint32_t dataArrayOffset = gvar->glyphVariationDataArrayOffset();
+
+  size_t dataOffset;
+  size_t dataEnd;
+
+  if (gvar->flags() & GVarTable::kFlagLongOffsets) {
+    const uint8_t* offsets = gvar.data + GVarTable::kBaseSize + glyphId * 4u;
+    dataOffset = MemOps::readU32uBE(offsets + 0u);
+    dataEnd = MemOps::readU32uBE(offsets + 4u);
+  }
+  else {
+    const uint8_t* offsets = gvar.data + GVarTable::kBaseSize + glyphId * 2u;
+    dataOffset = size_t(MemOps::readU16uBE(offsets + 0u)) * 2u;
+    dataEnd = size_t(MemOps::readU16uBE(offsets + 2u)) * 2u;
+  }
+
+  // No variation data for this glyph.
+  if (dataOffset >= dataEnd)
+    return BL_SUCCESS;
+
+  if (BL_UNLIKELY(dataEnd > gvar.size - dataArrayOffset || dataEnd - dataOffset < 4u))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  // GlyphVariationData:
+  //   UInt16 tupleVariationCount;
+  //   Offset16 dataOffset;
+  //   TupleVariationHeader tupleVariationHeaders[tupleVariationCount];
+  const uint8_t* glyphData = gvar.data + dataArrayOffset + dataOffset;
+  size_t glyphDataSize = dataEnd - dataOffset;
+
+  uint32_t tupleVariationCount = MemOps::readU16uBE(glyphData);
+  uint32_t serializedOffset = MemOps::readU16uBE(glyphData + 2u);
+
+  // Serialized data cannot overlap the header of GlyphVariationData if there are tuple variation headers to read.
+  if (BL_UNLIKELY(serializedOffset > glyphDataSize || (serializedOffset < 4u && (tupleVariationCount & GVarTable::kTupleCountMask) != 0)))
+    return blTraceError(BL_ERROR_INVALID_DATA);
+
+  const uint8_t* headerPtr = glyphData + 4u;
+  const uint8_t* headerEnd = glyphData + serializedOffset;
+  const uint8_t* serializedPtr = headerEnd;
+  const uint8_t* serializedEnd = glyphData + glyphDataSize;
+
+  // Allocate temporary buffers - accumulated deltas, deltas of a single tuple, touched flags, point indexes, and
+  // decoded X/Y deltas.
+  ScopedBufferTmp<8192> tmpBuffer;
+  size_t bufferSize = pointCount * (sizeof(BLPoint) * 2u + sizeof(int32_t) * 2u + sizeof(uint16_t) * 2u + 1u);
+
+  BLPoint* accumulated = static_cast<BLPoint*>(tmpBuffer.alloc(bufferSize));
+  if (BL_UNLIKELY(!accumulated))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  BLPoint* tupleDeltas = accumulated + pointCount;
+  int32_t* xDeltas = reinterpret_cast<int32_t*>(tupleDeltas + pointCount);
+  int32_t* yDeltas = xDeltas + pointCount;
+  uint16_t* sharedPoints = reinterpret_cast<uint16_t*>(yDeltas + pointCount);
+  uint16_t* privatePoints = sharedPoints + pointCount;
+  uint8_t* touched = reinterpret_cast<uint8_t*>(privatePoints + pointCount);
+
+  for (size_t i = 0; i < pointCount; i++)
+    accumulated[i].reset();
+
+  size_t sharedPointCount = 0;
+  if (tupleVariationCount & GVarTable::kTupleSharedPoints) {
+    if (BL_UNLIKELY(!decodePackedPoints(serializedPtr, serializedEnd, sharedPoints, pointCount, sharedPointCount)))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+  }
+
+  const uint8_t* sharedTuples = gvar.data + gvar->sharedTuplesOffset();
+  uint32_t sharedTupleCount = gvar->sharedTupleCount();
+  size_t tupleSize = size_t(axisCount) * 2u;
+
+  tupleVariationCount &= GVarTable::kTupleCountMask;
+  for (uint32_t tupleIndex = 0; tupleIndex < tupleVariationCount; tupleIndex++) {
+    // TupleVariationHeader:
+    //   UInt16 variationDataSize;
+    //   UInt16 tupleIndex;
+    //   F2x14 peakTuple[axisCount];               [optional]
+    //   F2x14 intermediateStartTuple[axisCount];  [optional]
+    //   F2x14 intermediateEndTuple[axisCount];    [optional]
+    if (BL_UNLIKELY(size_t(headerEnd - headerPtr) < 4u))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+
+    uint32_t variationDataSize = MemOps::readU16uBE(headerPtr + 0u);
+    uint32_t tupleFlags = MemOps::readU16uBE(headerPtr + 2u);
+    headerPtr += 4u;
+
+    const uint8_t* peakTuple = nullptr;
+    const uint8_t* intermediateTuple = nullptr;
+    double scalar = 1.0;
+
+    if (tupleFlags & GVarTable::kTupleEmbeddedPeak) {
+      peakTuple = headerPtr;
+      headerPtr += tupleSize;
+    }
+    else {
+      uint32_t sharedIndex = tupleFlags & GVarTable::kTupleIndexMask;
+      if (BL_UNLIKELY(sharedIndex >= sharedTupleCount))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+      peakTuple = sharedTuples + sharedIndex * tupleSize;
+      scalar = instance->sharedTupleScalars[sharedIndex];
+    }
+
+    if (tupleFlags & GVarTable::kTupleIntermediate) {
+      intermediateTuple = headerPtr;
+      headerPtr += tupleSize * 2u;
+    }
+
+    if (BL_UNLIKELY(headerPtr > headerEnd || size_t(serializedEnd - serializedPtr) < variationDataSize))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+
+    const uint8_t* tuplePtr = serializedPtr;
+    const uint8_t* tupleEnd = serializedPtr + variationDataSize;
+    serializedPtr = tupleEnd;
+
+    // Shared tuple scalars are precalculated by the instance, unless the tuple has an intermediate region.
+    if ((tupleFlags & GVarTable::kTupleEmbeddedPeak) || intermediateTuple) {
+      scalar = 1.0;
+      for (uint32_t axis = 0; axis < axisCount && scalar != 0.0; axis++) {
+        int peak = MemOps::readI16uBE(peakTuple + axis * 2u);
+        int start = intermediateTuple ? int(MemOps::readI16uBE(intermediateTuple + axis * 2u)) : blMin(peak, 0);
+        int end = intermediateTuple ? int(MemOps::readI16uBE(intermediateTuple + tupleSize + axis * 2u)) : blMax(peak, 0);
+        scalar *= calcAxisScalar(instance->coords[axis], start, peak, end);
+      }
+    }
+
+    if (scalar == 0.0)
+      continue;
+
+    const uint16_t* tuplePoints = sharedPoints;
+    size_t tuplePointCount = sharedPointCount;
+
+    if (tupleFlags & GVarTable::kTuplePrivatePoints) {
+      if (BL_UNLIKELY(!decodePackedPoints(tuplePtr, tupleEnd, privatePoints, pointCount, tuplePointCount)))
+        return blTraceError(BL_ERROR_INVALID_DATA);
+      tuplePoints = privatePoints;
+    }
+
+    bool allPoints = tuplePointCount == 0;
+    size_t deltaCount = allPoints ? pointCount : tuplePointCount;
+
+    if (BL_UNLIKELY(!decodePackedDeltas(tuplePtr, tupleEnd, xDeltas, deltaCount) ||
+                    !decodePackedDeltas(tuplePtr, tupleEnd, yDeltas, deltaCount)))
+      return blTraceError(BL_ERROR_INVALID_DATA);
+
+    if (allPoints) {
+      for (size_t i = 0; i < pointCount; i++)
+        accumulated[i] += BLPoint(double(xDeltas[i]), double(yDeltas[i])) * scalar;
+      continue;
+    }
+
+    if (!contourEnds) {
+      // Composite glyphs don't interpolate untouched points - they are just not changed.
+      for (size_t i = 0; i < deltaCount; i++) {
+        size_t pointIndex = tuplePoints[i];
+        if (pointIndex < pointCount)
+          accumulated[pointIndex] += BLPoint(double(xDeltas[i]), double(yDeltas[i])) * scalar;
+      }
+      continue;
+    }
+
+    memset(touched, 0, pointCount);
+    for (size_t i = 0; i < pointCount; i++)
+      tupleDeltas[i].reset();
+
+    for (size_t i = 0; i < deltaCount; i++) {
+      size_t pointIndex = tuplePoints[i];
+      if (pointIndex < pointCount) {
+        tupleDeltas[pointIndex].reset(double(xDeltas[i]), double(yDeltas[i]));
+        touched[pointIndex] = 1;
+      }
+    }
+
+    size_t contourStart = 0;
+    for (size_t contourIndex = 0; contourIndex < contourCount; contourIndex++) {
+      size_t contourEnd = contourEnds[contourIndex];
+      if (contourEnd >= contourStart && contourEnd < pointCount)
+        interpolateUntouchedPoints(tupleDeltas, touched, points, contourStart, contourEnd);
+      contourStart = contourEnd + 1u;
+    }
+
+    for (size_t i = 0; i < pointCount; i++)
+      accumulated[i] += tupleDeltas[i] * scalar;
+  }
+
+  for (size_t i = 0; i < pointCount; i++)
+    points[i] += accumulated[i];
+
+  return BL_SUCCESS;
+}
+
+// bl::OpenType::VarImpl - Instance
+// ================================
+
+static BL_INLINE double fixedToDouble(uint32_t value) noexcept { return double(int32_t(value)) * (1.0 / 65536.0); }
+
+// Maps a normalized coordinate by using 'avar' segment map (pairs of F2x14 values).
+static double mapAxisValue(const uint8_t* map, uint32_t count, double value) noexcept {
+  if (!count)
+    return value;
+
+  double from0 = f2x14ToDouble(MemOps::readI16uBE(map + 0u));
+  double to0 = f2x14ToDouble(MemOps::readI16uBE(map + 2u));
+
+  if (value <= from0)
+    return value + to0 - from0;
+
+  for (uint32_t i = 1; i < count; i++) {
+    double from1 = f2x14ToDouble(MemOps::readI16uBE(map + i * 4u + 0u));
+    double to1 = f2x14ToDouble(MemOps::readI16uBE(map + i * 4u + 2u));
+
+    if (value <= from1) {
+      if (from1 == from0)
+        return to1;
+      return to0 + (to1 - to0) * (value - from0) / (from1 - from0);
+    }
+
+    from0 = from1;
+    to0 = to1;
+  }
+
+  return value + to0 - from0;
+}
+
+static void normalizeCoords(const OTFaceImpl* faceI, const BLFontVariationSettingsView& view, int16_t* coords) noexcept {
+  const VarData& var = faceI->var;
+
+  const uint8_t* axisPtr = var.fvar.data + var.axesOffset;
+  const uint8_t* avarPtr = var.avar ? var.avar.data + AVarTable::kBaseSize : nullptr;
+
+  for (uint32_t axis = 0; axis < var.axisCount; axis++, axisPtr += var.axisSize) {
+    const FVarTable::AxisRecord* axisRecord = reinterpret_cast<const FVarTable::AxisRecord*>(axisPtr);
+
+    BLTag axisTag = axisRecord->axisTag();
+    double minValue = fixedToDouble(axisRecord->minValue());
+    double defValue = fixedToDouble(axisRecord->defaultValue());
+    double maxValue = fixedToDouble(axisRecord->maxValue());
+    double value = defValue;
+
+    for (const BLFontVariationItem& item : view)
+      if (item.tag == axisTag)
+        value = double(item.value);
+
+    double normalized = 0.0;
+    if (minValue <= defValue && defValue <= maxValue) {
+      value = blClamp(value, minValue, maxValue);
+      if (value < defValue)
+        normalized = (value - defValue) / (defValue - minValue);
+      else if (value > defValue)
+        normalized = (value - defValue) / (maxValue - defValue);
+    }
+
+    if (avarPtr) {
+      uint32_t mapCount = MemOps::readU16uBE(avarPtr);
+      normalized = mapAxisValue(avarPtr + 2u, mapCount, normalized);
+      avarPtr += 2u + mapCount * 4u;
+    }
+
+    coords[axis] = int16_t(Math::roundToInt(blClamp(normalized, -1.0, 1.0) * 16384.0));
+  }
+}
+
+static VarInstance* createInstance(const OTFaceImpl* faceI, const int16_t* coords) noexcept {
+  const VarData& var = faceI->var;
+
+  uint32_t axisCount = var.axisCount;
+  uint32_t sharedTupleCount = var.gvar ? uint32_t(var.gvar->sharedTupleCount()) : 0u;
+  uint32_t hvarRegionCount = regionCountOf(var.hvarStore);
+  uint32_t cff2RegionCount = regionCountOf(var.cff2Store);
+  uint32_t advanceDeltaCount = var.hvarStore ? faceI->faceInfo.glyphCount : 0u;
+
+  size_t scalarCount = size_t(sharedTupleCount) + hvarRegionCount + cff2RegionCount;
+  size_t implSize = sizeof(VarInstance) + scalarCount * sizeof(double) + advanceDeltaCount * sizeof(int32_t) + axisCount * sizeof(int16_t);
+
+  VarInstance* instance = static_cast<VarInstance*>(malloc(implSize));
+  if (BL_UNLIKELY(!instance))
+    return nullptr;
+
+  instance->refCount = 1;
+  instance->axisCount = axisCount;
+  instance->sharedTupleCount = sharedTupleCount;
+  instance->hvarRegionCount = hvarRegionCount;
+  instance->cff2RegionCount = cff2RegionCount;
+  instance->advanceDeltaCount = advanceDeltaCount;
+
+  instance->sharedTupleScalars = reinterpret_cast<double*>(instance + 1);
+  instance->hvarRegionScalars = instance->sharedTupleScalars + sharedTupleCount;
+  instance->cff2RegionScalars = instance->hvarRegionScalars + hvarRegionCount;
+  instance->advanceDeltas = reinterpret_cast<int32_t*>(instance->cff2RegionScalars + cff2RegionCount);
+  instance->coords = reinterpret_cast<int16_t*>(instance->advanceDeltas + advanceDeltaCount);
+  memcpy(instance->coords, coords, axisCount * sizeof(int16_t));
+
+  for (uint32_t i = 0; i < advanceDeltaCount; i++)
+    instance->advanceDeltas[i] = VarInstance::kAdvanceDeltaNotCached;
+
+  if (sharedTupleCount) {
+    const uint8_t* p = var.gvar.data + var.gvar->sharedTuplesOffset();
+    for (uint32_t i = 0; i < sharedTupleCount; i++) {
+      double scalar = 1.0;
+      for (uint32_t axis = 0; axis < axisCount; axis++, p += 2u) {
+        int peak = MemOps::readI16uBE(p);
+        scalar *= calcAxisScalar(coords[axis], blMin(peak, 0), peak, blMax(peak, 0));
+      }
+      instance->sharedTupleScalars[i] = scalar;
+    }
+  }
+
+  calcRegionScalars(var.hvarStore, coords, axisCount, instance->hvarRegionScalars, hvarRegionCount);
+  calcRegionScalars(var.cff2Store, coords, axisCount, instance->cff2RegionScalars, cff2RegionCount);
+
+  return instance;
+}
+
+static BL_INLINE VarInstance* findCachedInstance(const VarData& var, const int16_t* coords) noexcept {
+  for (uint32_t i = 0; i < VarData::kCacheSize; i++) {
+    VarInstance* instance = var.cache[i];
+    if (instance && memcmp(instance->coords, coords, var.axisCount * sizeof(int16_t)) == 0)
+      return instance;
+  }
+  return nullptr;
+}
+
+static BLResult BL_CDECL createVarInstance(const BLFontFaceImpl* faceI_, const BLFontVariationSettingsCore* variationSettings, FontVarInstance** out) noexcept {
+  const OTFaceImpl* faceI = static_cast<const OTFaceImpl*>(faceI_);
+  const VarData& var = faceI->var;
+
+  *out = nullptr;
+
+  BLFontVariationSettingsView view;
+  BL_PROPAGATE(blFontVariationSettingsGetView(variationSettings, &view));
+
+  ScopedBufferTmp<256> coordsBuffer;
+  int16_t* coords = static_cast<int16_t*>(coordsBuffer.alloc(var.axisCount * sizeof(int16_t)));
+  if (BL_UNLIKELY(!coords))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  normalizeCoords(faceI, view, coords);
+
+  // Default coordinates don't need an instance at all.
+  bool isDefault = true;
+  for (uint32_t axis = 0; axis < var.axisCount; axis++)
+    isDefault &= coords[axis] == 0;
+
+  if (isDefault)
+    return BL_SUCCESS;
+
+  // Instances are shared by all fonts that use the same normalized coordinates.
+  {
+    BLLockGuard<BLMutex> guard(var.cacheMutex);
+    VarInstance* cached = findCachedInstance(var, coords);
+    if (cached) {
+      *out = retainVarInstance(cached);
+      return BL_SUCCESS;
+    }
+  }
+
+  VarInstance* instance = createInstance(faceI, coords);
+  if (BL_UNLIKELY(!instance))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  {
+    BLLockGuard<BLMutex> guard(var.cacheMutex);
+    VarInstance* cached = findCachedInstance(var, coords);
+
+    if (cached) {
+      // Another thread created the same instance in the meantime.
+      free(instance);
+      instance = static_cast<VarInstance*>(retainVarInstance(cached));
+    }
+    else {
+      uint32_t slot = var.cacheNextSlot;
+      var.cacheNextSlot = (slot + 1u) % VarData::kCacheSize;
+
+      releaseVarInstance(var.cache[slot]);
+      var.cache[slot] = static_cast<VarInstance*>(retainVarInstance(instance));
+    }
+  }
+
+  *out = instance;
+  return BL_SUCCESS;
+}
+
+// bl::OpenType::VarImpl - Init
+// ============================
+
+static bool validateAVar(const Table<AVarTable>& avar, uint32_t axisCount) noexcept {
+  if (!avar.fits() || avar->majorVersion() != 1 || avar->axisCount() != axisCount)
+    return false;
+
+  size_t offset = AVarTable::kBaseSize;
+  for (uint32_t axis = 0; axis < axisCount; axis++) {
+    if (!avar.fits(offset + 2u))
+      return false;
+
+    offset += 2u + size_t(avar.readU16(offset)) * 4u;
+    if (!avar.fits(offset))
+      return false;
+  }
+
+  return true;
+}
+
+static bool validateGVar(const Table<GVarTable>& gvar, uint32_t axisCount) noexcept {
+  if (!gvar.fits() || gvar->majorVersion() != 1 || gvar->axisCount() != axisCount)
+    return false;
+
+  size_t offsetSize = (gvar->flags() & GVarTable::kFlagLongOffsets) ? 4u : 2u;
+  size_t offsetsEnd = GVarTable::kBaseSize + (size_t(gvar->glyphCount()) + 1u) * offsetSize;
+  size_t sharedTuplesOffset = gvar->sharedTuplesOffset();
+  size_t sharedTuplesSize = size_t(gvar->sharedTupleCount()) * axisCount * 2u;
+
+  return gvar.fits(offsetsEnd) &&
+         gvar->glyphVariationDataArrayOffset() <= gvar.size &&
+         sharedTuplesOffset <= gvar.size &&
+         sharedTuplesSize <= gvar.size - sharedTuplesOffset;
+}
+
+BLResult init(OTFaceImpl* faceI, OTFaceTables& tables) noexcept {
+  Table<FVarTable> fvar(tables.fvar);
+  if (!fvar)
+    return BL_SUCCESS;
+
+  Trace trace;
+  trace.info("bl::OpenType::OTFaceImpl::Init 'fvar' [Size=%u]\n", fvar.size);
+  trace.indent();
+
+  if (!fvar.fits() || fvar->majorVersion() != 1) {
+    trace.warn("Invalid or unsupported 'fvar' table\n");
+    return BL_SUCCESS;
+  }
+
+  uint32_t axisCount = fvar->axisCount();
+  uint32_t axisSize = fvar->axisSize();
+  uint32_t axesOffset = fvar->axesArrayOffset();
+
+  if (!axisCount || axisSize < sizeof(FVarTable::AxisRecord) || !fvar.fits(axesOffset + size_t(axisCount) * axisSize)) {
+    trace.warn("Invalid axes [Count=%u Size=%u]\n", axisCount, axisSize);
+    return BL_SUCCESS;
+  }
+
+  VarData& var = faceI->var;
+  var.fvar = fvar;
+  var.axisCount = uint16_t(axisCount);
+  var.axisSize = uint16_t(axisSize);
+  var.axesOffset = axesOffset;
+
+  for (uint32_t axis = 0; axis < axisCount; axis++) {
+    const FVarTable::AxisRecord* axisRecord = fvar.dataAs<FVarTable::AxisRecord>(axesOffset + axis * axisSize);
+    BL_PROPAGATE(faceI->variationTagSet.addTag(axisRecord->axisTag()));
+  }
+
+  Table<AVarTable> avar(tables.avar);
+  if (avar) {
+    if (validateAVar(avar, axisCount))
+      var.avar = avar;
+    else
+      trace.warn("Invalid 'avar' table, ignoring\n");
+  }
+
+  Table<GVarTable> gvar(tables.gvar);
+  if (gvar) {
+    if (validateGVar(gvar, axisCount))
+      var.gvar = gvar;
+    else
+      trace.warn("Invalid 'gvar' table, ignoring\n");
+  }
+
+  Table<XVarTable> hvar(tables.hvar);
+  if (hvar) {
+    if (hvar.fits() && hvar->majorVersion() == 1 && hvar->itemVariationStoreOffset() < hvar.size) {
+      var.hvarStore = validateItemVariationStore(hvar.subTableUnchecked(hvar->itemVariationStoreOffset()), axisCount);
+
+      uint32_t advanceMappingOffset = hvar->advanceMappingOffset();
+      if (advanceMappingOffset && advanceMappingOffset < hvar.size)
+        var.hvarAdvanceMap = validateDeltaSetIndexMap(hvar.subTableUnchecked(advanceMappingOffset));
+    }
+
+    if (!var.hvarStore)
+      trace.warn("Invalid 'HVAR' table, ignoring\n");
+  }
+
+  if (faceI->faceInfo.outlineType == BL_FONT_OUTLINE_TYPE_CFF2 && faceI->cff.varStore.size) {
+    RawTable cff2Store(faceI->cff.table.data + faceI->cff.varStore.offset, faceI->cff.varStore.size);
+    var.cff2Store = validateItemVariationStore(cff2Store, axisCount);
+  }
+
+  faceI->faceInfo.faceFlags |= BL_FONT_FACE_FLAG_OPENTYPE_VARIATIONS;
+  faceI->funcs.createVarInstance = createVarInstance;
+
+  return BL_SUCCESS;
+}
+
+} // {VarImpl}
+} // {OpenType}
+} // {bl}
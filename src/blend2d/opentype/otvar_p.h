@@ -0,0 +1,282 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_OPENTYPE_OTVAR_P_H_INCLUDED
+#define BLEND2D_OPENTYPE_OTVAR_P_H_INCLUDED
+
+#include "../fontface_p.h"
+#include "../opentype/otdefs_p.h"
+#include "../support/ptrops_p.h"
+#include "../threading/mutex_p.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_opentype_impl
+//! \{
+
+namespace bl {
+namespace OpenType {
+
+//! OpenType 'fvar' table.
+//!
+//! External Resources:
+//!   - https://docs.microsoft.com/en-us/typography/opentype/spec/fvar
+struct FVarTable {
+  enum : uint32_t { kBaseSize = 16 };
+
+  struct AxisRecord {
+    UInt32 axisTag;
+    F16x16 minValue;
+    F16x16 defaultValue;
+    F16x16 maxValue;
+    UInt16 flags;
+    UInt16 axisNameId;
+  };
+
+  UInt16 majorVersion;
+  UInt16 minorVersion;
+  Offset16 axesArrayOffset;
+  UInt16 reserved;
+  UInt16 axisCount;
+  UInt16 axisSize;
+  UInt16 instanceCount;
+  UInt16 instanceSize;
+};
+
+//! OpenType 'avar' table.
+//!
+//! External Resources:
+//!   - https://docs.microsoft.com/en-us/typography/opentype/spec/avar
+struct AVarTable {
+  enum : uint32_t { kBaseSize = 8 };
+
+  struct AxisValueMap {
+    F2x14 fromCoordinate;
+    F2x14 toCoordinate;
+  };
+
+  UInt16 majorVersion;
+  UInt16 minorVersion;
+  UInt16 reserved;
+  UInt16 axisCount;
+  /*
+  struct SegmentMaps {
+    UInt16 positionMapCount;
+    AxisValueMap axisValueMaps[positionMapCount];
+  } axisSegmentMaps[axisCount];
+  */
+};
+
+//! OpenType 'gvar' table.
+//!
+//! External Resources:
+//!   - https://docs.microsoft.com/en-us/typography/opentype/spec/gvar
+//!   - https://docs.microsoft.com/en-us/typography/opentype/spec/otvarcommonformats
+struct GVarTable {
+  enum : uint32_t { kBaseSize = 20 };
+
+  enum Flags : uint16_t {
+    kFlagLongOffsets = 0x0001u
+  };
+
+  enum TupleFlags : uint16_t {
+    kTupleEmbeddedPeak     = 0x8000u,
+    kTupleIntermediate     = 0x4000u,
+    kTuplePrivatePoints    = 0x2000u,
+    kTupleIndexMask        = 0x0FFFu,
+
+    // Flags of `tupleVariationCount`.
+    kTupleSharedPoints     = 0x8000u,
+    kTupleCountMask        = 0x0FFFu
+  };
+
+  UInt16 majorVersion;
+  UInt16 minorVersion;
+  UInt16 axisCount;
+  UInt16 sharedTupleCount;
+  Offset32 sharedTuplesOffset;
+  UInt16 glyphCount;
+  UInt16 flags;
+  Offset32 glyphVariationDataArrayOffset;
+  /*
+  union {
+    Offset16 glyphVariationDataOffsets16[glyphCount + 1];
+    Offset32 glyphVariationDataOffsets32[glyphCount + 1];
+  };
+  */
+};
+
+//! OpenType 'HVAR' and 'VVAR' tables.
+//!
+//! External Resources:
+//!   - https://docs.microsoft.com/en-us/typography/opentype/spec/hvar
+struct XVarTable {
+  enum : uint32_t { kBaseSize = 20 };
+
+  UInt16 majorVersion;
+  UInt16 minorVersion;
+  Offset32 itemVariationStoreOffset;
+  Offset32 advanceMappingOffset;
+  Offset32 lsbMappingOffset;
+  Offset32 rsbMappingOffset;
+};
+
+//! Item variation store (common table used by 'HVAR', 'VVAR', 'MVAR', 'GDEF', and 'CFF2').
+struct ItemVariationStoreTable {
+  enum : uint32_t { kBaseSize = 8 };
+
+  UInt16 format;
+  Offset32 variationRegionListOffset;
+  UInt16 itemVariationDataCount;
+  /*
+  Offset32 itemVariationDataOffsets[itemVariationDataCount];
+  */
+};
+
+//! Variation instance of an OpenType face.
+//!
+//! Contains normalized coordinates and scalars of all regions the face defines, which are calculated once per instance
+//! so they don't have to be recalculated each time a glyph outline or advance is requested. Advance deltas are cached
+//! per glyph when they are requested for the first time. Glyph outlines are not cached, they are interpolated each
+//! time they are requested.
+struct VarInstance : public FontVarInstance {
+  //! Marks an advance delta that was not calculated yet.
+  static constexpr int32_t kAdvanceDeltaNotCached = INT32_MIN;
+
+  //! Number of axes (matches the number of axes in 'fvar' table).
+  uint32_t axisCount;
+  //! Number of shared tuples in 'gvar' table.
+  uint32_t sharedTupleCount;
+  //! Number of regions in the 'HVAR' item variation store.
+  uint32_t hvarRegionCount;
+  //! Number of regions in the 'CFF2' item variation store.
+  uint32_t cff2RegionCount;
+  //! Number of cached advance deltas (either glyph count or zero if the face has no 'HVAR' table).
+  uint32_t advanceDeltaCount;
+
+  //! Normalized coordinates in F2x14 format (16384 represents 1.0).
+  int16_t* coords;
+  //! Scalars of 'gvar' shared tuples (only valid for tuples that don't use intermediate regions).
+  double* sharedTupleScalars;
+  //! Scalars of 'HVAR' regions.
+  double* hvarRegionScalars;
+  //! Scalars of 'CFF2' regions.
+  double* cff2RegionScalars;
+  //! Rounded advance deltas of all glyphs, \ref kAdvanceDeltaNotCached if not calculated yet (accessed atomically).
+  int32_t* advanceDeltas;
+};
+
+//! Variation data stored in \ref OTFaceImpl.
+struct VarData {
+  //! Maximum number of variation instances cached per face.
+  static constexpr uint32_t kCacheSize = 16;
+
+  //! Content of 'fvar' table (only valid if it has at least one axis).
+  Table<FVarTable> fvar;
+  //! Content of 'avar' table (only valid if it matches `fvar`).
+  Table<AVarTable> avar;
+  //! Content of 'gvar' table (only valid if it matches `fvar`).
+  Table<GVarTable> gvar;
+  //! Item variation store of 'HVAR' table.
+  RawTable hvarStore;
+  //! Advance mapping (DeltaSetIndexMap) of 'HVAR' table, may be empty.
+  RawTable hvarAdvanceMap;
+  //! Item variation store of 'CFF2' table.
+  RawTable cff2Store;
+
+  //! Number of axes.
+  uint16_t axisCount;
+  //! Size of a single axis record in 'fvar' table.
+  uint16_t axisSize;
+  //! Offset of axis records in 'fvar' table.
+  uint32_t axesOffset;
+
+  //! Protects the instance cache.
+  mutable BLMutex cacheMutex;
+  //! Index of the next cache slot to be replaced.
+  mutable uint32_t cacheNextSlot;
+  //! Cached variation instances.
+  mutable VarInstance* cache[kCacheSize];
+
+  BL_INLINE VarData() noexcept
+    : fvar(),
+      avar(),
+      gvar(),
+      hvarStore(),
+      hvarAdvanceMap(),
+      cff2Store(),
+      axisCount(0),
+      axisSize(0),
+      axesOffset(0),
+      cacheNextSlot(0),
+      cache {} {}
+
+  BL_INLINE ~VarData() noexcept {
+    for (uint32_t i = 0; i < kCacheSize; i++)
+      releaseVarInstance(cache[i]);
+  }
+
+  BL_INLINE bool isVariable() const noexcept { return axisCount != 0; }
+};
+
+namespace VarImpl {
+
+//! Converts a normalized coordinate in F2x14 format to double.
+static BL_INLINE double f2x14ToDouble(int value) noexcept { return double(value) * (1.0 / 16384.0); }
+
+//! Calculates a scalar of a single axis of a region or tuple as specified by OpenType.
+static BL_INLINE double calcAxisScalar(int coord, int start, int peak, int end) noexcept {
+  if (peak == 0 || coord == peak)
+    return 1.0;
+
+  // Invalid regions and regions that cross zero are ignored (they don't contribute).
+  if (start > peak || peak > end || (start < 0 && end > 0))
+    return 1.0;
+
+  if (coord <= start || coord >= end)
+    return 0.0;
+
+  if (coord < peak)
+    return double(coord - start) / double(peak - start);
+  else
+    return double(end - coord) / double(end - peak);
+}
+
+//! Calculates a delta of an item stored in item variation `store` by using region `scalars`.
+BL_HIDDEN double getItemDelta(const RawTable& store, const double* scalars, uint32_t regionCount, uint32_t outerIndex, uint32_t innerIndex) noexcept;
+
+//! Returns scalars of regions referenced by ItemVariationData at `outerIndex` in the given `store`.
+//!
+//! Used by CFF2 'blend' operator, which requires scalars in the order of region indexes of the data. The number of
+//! regions is returned via `countOut` (scalars are zero if `scalars` is null, which means the default instance).
+BL_HIDDEN BLResult getRegionScalars(const RawTable& store, const double* scalars, uint32_t regionCount, uint32_t outerIndex, double* out, uint32_t capacity, uint32_t* countOut) noexcept;
+
+//! Applies 'gvar' deltas of `glyphId` to `points`.
+//!
+//! The `points` array must contain all points of the glyph followed by 4 phantom points, which is `pointCount`. If
+//! `contourEnds` is non-null the glyph is simple and untouched points are interpolated (IUP), otherwise the points
+//! represent component offsets of a composite glyph.
+BL_HIDDEN BLResult applyGlyphDeltas(
+  const OTFaceImpl* faceI,
+  const VarInstance* instance,
+  BLGlyphId glyphId,
+  BLPoint* points,
+  size_t pointCount,
+  const uint16_t* contourEnds,
+  size_t contourCount) noexcept;
+
+//! Returns a rounded advance delta of `glyphId` as defined by 'HVAR' table, which is cached by `instance`.
+BL_HIDDEN int32_t getAdvanceDelta(const OTFaceImpl* faceI, const VarInstance* instance, BLGlyphId glyphId) noexcept;
+
+BL_HIDDEN BLResult init(OTFaceImpl* faceI, OTFaceTables& tables) noexcept;
+
+} // {VarImpl}
+
+} // {OpenType}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_OPENTYPE_OTVAR_P_H_INCLUDED
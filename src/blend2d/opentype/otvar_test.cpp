@@ -0,0 +1,223 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "../api-build_test_p.h"
+#if defined(BL_TEST)
+
+#include "../font_p.h"
+#include "../fontdata.h"
+#include "../fontface.h"
+#include "../fontvariationsettings.h"
+#include "../path.h"
+#include "../support/memops_p.h"
+#include "../opentype/otvar_p.h"
+
+#include "../test/resources/vartest_cff2_otf.h"
+#include "../test/resources/vartest_ttf.h"
+
+namespace bl {
+namespace OpenType {
+namespace VarImpl {
+
+// bl::OpenType::VarImpl - Tests
+// =============================
+
+// Both test fonts have a single 'wght' axis [100, 400, 900], 1000 units per em, and were verified by fontTools
+// instancer. The 'glyf' font also has 'avar' segment map that maps 0.5 to 0.25.
+struct GlyphExpectation {
+  float wght;
+  BLGlyphId glyphId;
+  double xMin;
+  double yMin;
+  double xMax;
+  double yMax;
+  int32_t advance;
+};
+
+static const GlyphExpectation glyfExpectations[] = {
+  { 100.0f, 1,  80.0,  0.0, 480.0, 700.0, 600 },
+  { 250.0f, 1,  90.0,  0.0, 490.0, 700.0, 600 },
+  { 400.0f, 1, 100.0,  0.0, 500.0, 700.0, 600 },
+  { 650.0f, 1, 100.0,  0.0, 550.0, 700.0, 650 },
+  { 900.0f, 1, 100.0,  0.0, 700.0, 700.0, 800 },
+
+  // Glyph 'B' is moved as a whole as it only has deltas of a single point (IUP).
+  { 400.0f, 2, 100.0,  0.0, 400.0, 400.0, 500 },
+  { 650.0f, 2, 112.5, 12.5, 412.5, 412.5, 500 },
+  { 900.0f, 2, 150.0, 50.0, 450.0, 450.0, 500 },
+
+  // Glyph 'C' is a composite of 'A' - both the component offset and the component are varied.
+  { 100.0f, 3, 180.0,  0.0, 580.0, 700.0, 700 },
+  { 400.0f, 3, 200.0,  0.0, 600.0, 700.0, 700 },
+  { 650.0f, 3, 225.0,  0.0, 675.0, 700.0, 700 },
+  { 900.0f, 3, 300.0,  0.0, 900.0, 700.0, 700 }
+};
+
+static const GlyphExpectation cff2Expectations[] = {
+  { 100.0f, 1, 100.0,  0.0, 500.0, 700.0, 600 },
+  { 400.0f, 1, 100.0,  0.0, 500.0, 700.0, 600 },
+  { 650.0f, 1, 100.0,  0.0, 600.0, 700.0, 700 },
+  { 900.0f, 1, 100.0,  0.0, 700.0, 700.0, 800 }
+};
+
+static void testGlyphs(const unsigned char* data, size_t size, const GlyphExpectation* expectations, size_t count) noexcept {
+  BLFontData fontData;
+  BLFontFace face;
+
+  EXPECT_SUCCESS(fontData.createFromData(data, size));
+  EXPECT_SUCCESS(face.createFromData(fontData, 0));
+  EXPECT_TRUE(face.hasFaceFlag(BL_FONT_FACE_FLAG_OPENTYPE_VARIATIONS));
+
+  for (size_t i = 0; i < count; i++) {
+    const GlyphExpectation& e = expectations[i];
+
+    BLFontVariationSettings variationSettings;
+    EXPECT_SUCCESS(variationSettings.setValue(BL_MAKE_TAG('w', 'g', 'h', 't'), e.wght));
+
+    BLFont font;
+    EXPECT_SUCCESS(font.createFromFace(face, float(face.unitsPerEm()), BLFontFeatureSettings(), variationSettings));
+
+    BLPath path;
+    BLBox box;
+    EXPECT_SUCCESS(font.getGlyphOutlines(e.glyphId, path));
+    EXPECT_SUCCESS(path.getBoundingBox(&box));
+
+    // Font outlines are flipped vertically (Y axis points down).
+    EXPECT_EQ(box.x0, e.xMin).message("Glyph #%u [wght=%g] xMin", e.glyphId, double(e.wght));
+    EXPECT_EQ(box.x1, e.xMax).message("Glyph #%u [wght=%g] xMax", e.glyphId, double(e.wght));
+    EXPECT_EQ(-box.y1, e.yMin).message("Glyph #%u [wght=%g] yMin", e.glyphId, double(e.wght));
+    EXPECT_EQ(-box.y0, e.yMax).message("Glyph #%u [wght=%g] yMax", e.glyphId, double(e.wght));
+
+    uint32_t glyphId = e.glyphId;
+    BLGlyphPlacement placement;
+    EXPECT_SUCCESS(font.getGlyphAdvances(&glyphId, sizeof(uint32_t), &placement, 1));
+    EXPECT_EQ(placement.advance.x, e.advance).message("Glyph #%u [wght=%g] advance", e.glyphId, double(e.wght));
+  }
+}
+
+static void testInstanceCache() noexcept {
+  BLFontData fontData;
+  BLFontFace face;
+
+  EXPECT_SUCCESS(fontData.createFromData(resource_vartest_ttf, sizeof(resource_vartest_ttf)));
+  EXPECT_SUCCESS(face.createFromData(fontData, 0));
+
+  BLFontVariationSettings defaultSettings;
+  EXPECT_SUCCESS(defaultSettings.setValue(BL_MAKE_TAG('w', 'g', 'h', 't'), 400.0f));
+
+  BLFontVariationSettings boldSettings;
+  EXPECT_SUCCESS(boldSettings.setValue(BL_MAKE_TAG('w', 'g', 'h', 't'), 900.0f));
+
+  BLFont a, b, c;
+  EXPECT_SUCCESS(a.createFromFace(face, 16.0f, BLFontFeatureSettings(), defaultSettings));
+  EXPECT_SUCCESS(b.createFromFace(face, 16.0f, BLFontFeatureSettings(), boldSettings));
+  EXPECT_SUCCESS(c.createFromFace(face, 32.0f, BLFontFeatureSettings(), boldSettings));
+
+  // Default coordinates don't need an instance, other coordinates share the same cached instance.
+  EXPECT_EQ(FontInternal::getImpl(&a)->varInstance, nullptr);
+  EXPECT_NE(FontInternal::getImpl(&b)->varInstance, nullptr);
+  EXPECT_EQ(FontInternal::getImpl(&b)->varInstance, FontInternal::getImpl(&c)->varInstance);
+
+  EXPECT_SUCCESS(c.resetVariationSettings());
+  EXPECT_EQ(FontInternal::getImpl(&c)->varInstance, nullptr);
+
+  EXPECT_SUCCESS(c.setVariationSettings(boldSettings));
+  EXPECT_EQ(FontInternal::getImpl(&b)->varInstance, FontInternal::getImpl(&c)->varInstance);
+
+  // Advance deltas are cached by the instance, thus shared by all fonts that use it.
+  const OpenType::VarInstance* instance = static_cast<const OpenType::VarInstance*>(FontInternal::getImpl(&b)->varInstance);
+  uint32_t glyphId = 1;
+  EXPECT_EQ(instance->advanceDeltaCount, face.glyphCount());
+  EXPECT_EQ(instance->advanceDeltas[glyphId], OpenType::VarInstance::kAdvanceDeltaNotCached);
+
+  BLGlyphPlacement placementB;
+  BLGlyphPlacement placementC;
+
+  EXPECT_SUCCESS(b.getGlyphAdvances(&glyphId, sizeof(uint32_t), &placementB, 1));
+  EXPECT_NE(instance->advanceDeltas[glyphId], OpenType::VarInstance::kAdvanceDeltaNotCached);
+
+  EXPECT_SUCCESS(c.getGlyphAdvances(&glyphId, sizeof(uint32_t), &placementC, 1));
+  EXPECT_EQ(placementB.advance.x, placementC.advance.x);
+}
+
+// Corrupts 'offsetToData' of the glyph variation data of `glyphId` and verifies that the data is rejected instead of
+// being read out of bounds.
+static void testMalformedGVar(BLGlyphId glyphId, uint16_t serializedOffset) noexcept {
+  uint8_t data[sizeof(resource_vartest_ttf)];
+  memcpy(data, resource_vartest_ttf, sizeof(resource_vartest_ttf));
+
+  // Find 'gvar' table in the table directory.
+  uint32_t gvarOffset = 0;
+  uint32_t tableCount = MemOps::readU16uBE(data + 4u);
+
+  for (uint32_t i = 0; i < tableCount; i++) {
+    const uint8_t* record = data + 12u + i * 16u;
+    if (MemOps::readU32uBE(record) == BL_MAKE_TAG('g', 'v', 'a', 'r'))
+      gvarOffset = MemOps::readU32uBE(record + 8u);
+  }
+  EXPECT_NE(gvarOffset, 0u);
+
+  uint8_t* gvar = data + gvarOffset;
+  uint32_t dataArrayOffset = MemOps::readU32uBE(gvar + 16u);
+  size_t dataOffset = (MemOps::readU16uBE(gvar + 14u) & GVarTable::kFlagLongOffsets)
+    ? size_t(MemOps::readU32uBE(gvar + GVarTable::kBaseSize + glyphId * 4u))
+    : size_t(MemOps::readU16uBE(gvar + GVarTable::kBaseSize + glyphId * 2u)) * 2u;
+
+  uint8_t* glyphData = gvar + dataArrayOffset + dataOffset;
+  EXPECT_NE(MemOps::readU16uBE(glyphData) & GVarTable::kTupleCountMask, 0u);
+  MemOps::writeU16uBE(glyphData + 2u, serializedOffset);
+
+  BLFontData fontData;
+  BLFontFace face;
+
+  EXPECT_SUCCESS(fontData.createFromData(data, sizeof(data)));
+  EXPECT_SUCCESS(face.createFromData(fontData, 0));
+
+  BLFontVariationSettings variationSettings;
+  EXPECT_SUCCESS(variationSettings.setValue(BL_MAKE_TAG('w', 'g', 'h', 't'), 900.0f));
+
+  BLFont font;
+  EXPECT_SUCCESS(font.createFromFace(face, float(face.unitsPerEm()), BLFontFeatureSettings(), variationSettings));
+
+  BLPath path;
+  EXPECT_EQ(font.getGlyphOutlines(glyphId, path), BL_ERROR_INVALID_DATA)
+    .message("Glyph #%u with offsetToData=%u must be rejected", glyphId, serializedOffset);
+}
+
+static void testAxisScalar() noexcept {
+  EXPECT_EQ(calcAxisScalar(0, 0, 16384, 16384), 0.0);
+  EXPECT_EQ(calcAxisScalar(8192, 0, 16384, 16384), 0.5);
+  EXPECT_EQ(calcAxisScalar(16384, 0, 16384, 16384), 1.0);
+  EXPECT_EQ(calcAxisScalar(-8192, -16384, -16384, 0), 0.5);
+  EXPECT_EQ(calcAxisScalar(-8192, 0, 16384, 16384), 0.0);
+  EXPECT_EQ(calcAxisScalar(12288, 0, 8192, 16384), 0.5);
+
+  // Peak of zero means that the axis doesn't participate.
+  EXPECT_EQ(calcAxisScalar(12288, 0, 0, 0), 1.0);
+}
+
+UNIT(opentype_var, BL_TEST_GROUP_TEXT_OPENTYPE) {
+  INFO("bl::OpenType::VarImpl::calcAxisScalar()");
+  testAxisScalar();
+
+  INFO("bl::OpenType::VarImpl - 'gvar' and 'HVAR' variations");
+  testGlyphs(resource_vartest_ttf, sizeof(resource_vartest_ttf), glyfExpectations, BL_ARRAY_SIZE(glyfExpectations));
+
+  INFO("bl::OpenType::VarImpl - 'CFF2' and 'HVAR' variations");
+  testGlyphs(resource_vartest_cff2_otf, sizeof(resource_vartest_cff2_otf), cff2Expectations, BL_ARRAY_SIZE(cff2Expectations));
+
+  INFO("bl::OpenType::VarImpl - variation instance cache");
+  testInstanceCache();
+
+  INFO("bl::OpenType::VarImpl - malformed 'gvar' data");
+  for (uint16_t serializedOffset = 0; serializedOffset < 4u; serializedOffset++)
+    testMalformedGVar(1, serializedOffset);
+}
+
+} // {VarImpl}
+} // {OpenType}
+} // {bl}
+
+#endif // BL_TEST
@@ -16,6 +16,8 @@
 #include "support/math_p.h"
 #include "support/ptrops_p.h"
 #include "support/traits_p.h"
+#include "support/wrap_p.h"
+#include "threading/mutex_p.h"
 
 const BLApproximationOptions blDefaultApproximationOptions = bl::PathInternal::makeDefaultApproximationOptions();
 
@@ -27,9 +29,39 @@ namespace PathInternal {
 
 static BLObjectEternalImpl<BLPathPrivateImpl> defaultPath;
 
+//! Guards edge caches of all paths - an edge cache is only replaced or retained while holding this lock.
+static Wrap<BLMutex> edgeCacheMutex;
+
 static BLResult appendTransformedPathWithType(BLPathCore* self, const BLPathCore* other, const BLRange* range, const BLMatrix2D* transform, uint32_t transformType) noexcept;
 static BLResult transformWithType(BLPathCore* self, const BLRange* range, const BLMatrix2D* transform, uint32_t transformType) noexcept;
 
+// bl::Path - Edge Cache
+// =====================
+
+BLPathEdgeCache* acquireEdgeCache(const BLPathPrivateImpl* impl) noexcept {
+  if (!blAtomicFetchRelaxed(&impl->edgeCache))
+    return nullptr;
+
+  BLLockGuard<BLMutex> guard(edgeCacheMutex);
+  BLPathEdgeCache* edgeCache = impl->edgeCache;
+
+  if (edgeCache)
+    retainEdgeCache(edgeCache);
+  return edgeCache;
+}
+
+void replaceEdgeCache(BLPathPrivateImpl* impl, BLPathEdgeCache* edgeCache) noexcept {
+  BLPathEdgeCache* old;
+  {
+    BLLockGuard<BLMutex> guard(edgeCacheMutex);
+    old = impl->edgeCache;
+    blAtomicStoreRelaxed(&impl->edgeCache, edgeCache);
+  }
+
+  if (old)
+    releaseEdgeCache(old);
+}
+
 // bl::Path - Utilities
 // ====================
 
@@ -94,6 +126,7 @@ static BL_INLINE BLResult allocImpl(BLPathCore* self, size_t size, BLObjectImplS
   impl->size = size;
   impl->capacity = capacity;
   impl->flags = BL_PATH_FLAG_DIRTY;
+  impl->edgeCache = nullptr;
   return BL_SUCCESS;
 }
 
@@ -156,6 +189,7 @@ static BL_INLINE BLResult prepareAdd(BLPathCore* self, size_t n, uint8_t** cmdOu
 
   // Likely case, appending to a path that is not shared and has the required capacity. We have to clear FLAGS
   // in addition to set the new size as flags can contain bits regarding BLPathInfo that will no longer hold.
+  invalidateEdgeCache(selfI);
   selfI->flags = BL_PATH_FLAG_DIRTY;
   selfI->size = sizeAfter;
 
@@ -173,6 +207,7 @@ static BL_INLINE BLResult makeMutable(BLPathCore* self) noexcept {
     selfI = getImpl(self);
   }
 
+  invalidateEdgeCache(selfI);
   selfI->flags = BL_PATH_FLAG_DIRTY;
   return BL_SUCCESS;
 }
@@ -351,6 +386,7 @@ BL_API_IMPL BLResult blPathClear(BLPathCore* self) noexcept {
   if (!isImplMutable(selfI))
     return replaceInstance(self, static_cast<BLPathCore*>(&blObjectDefaults[BL_OBJECT_TYPE_PATH]));
 
+  invalidateEdgeCache(selfI);
   selfI->size = 0;
   selfI->flags = 0;
   return BL_SUCCESS;
@@ -426,6 +462,7 @@ BL_API_IMPL BLResult blPathModifyOp(BLPathCore* self, BLModifyOp op, size_t n, u
     selfI = getImpl(self);
   }
 
+  invalidateEdgeCache(selfI);
   selfI->flags = BL_PATH_FLAG_DIRTY;
   *vtxDataOut = selfI->vertexData + index;
   *cmdDataOut = selfI->commandData + index;
@@ -480,6 +517,7 @@ BL_API_IMPL BLResult blPathAssignDeep(BLPathCore* self, const BLPathCore* other)
     return replaceInstance(self, &newO);
   }
 
+  invalidateEdgeCache(selfI);
   selfI->flags = BL_PATH_FLAG_DIRTY;
   selfI->size = size;
 
@@ -2080,6 +2118,7 @@ BL_API_IMPL BLResult blPathRemoveRange(BLPathCore* self, const BLRange* range) n
   }
   else {
     copyContent(cmdData + start, vtxData + start, cmdData + end, vtxData + end, size - end);
+    invalidateEdgeCache(selfI);
     selfI->size = sizeAfter;
     selfI->flags = BL_PATH_FLAG_DIRTY;
     return BL_SUCCESS;
@@ -2693,10 +2732,16 @@ OnLine:
 // bl::Path - Runtime Registration
 // ===============================
 
-void blPath2DRtInit(BLRuntimeContext* rt) noexcept {
+static void BL_CDECL blPath2DRtShutdown(BLRuntimeContext* rt) noexcept {
   blUnused(rt);
+  bl::PathInternal::edgeCacheMutex.destroy();
+}
 
+void blPath2DRtInit(BLRuntimeContext* rt) noexcept {
   bl::PathInternal::defaultPath.impl->flags = BL_PATH_FLAG_EMPTY;
   blObjectDefaults[BL_OBJECT_TYPE_PATH]._d.initDynamic(
     BLObjectInfo::fromTypeWithMarker(BL_OBJECT_TYPE_PATH), &bl::PathInternal::defaultPath.impl);
+
+  bl::PathInternal::edgeCacheMutex.init();
+  rt->shutdownHandlers.add(blPath2DRtShutdown);
 }
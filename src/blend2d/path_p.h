@@ -7,9 +7,11 @@
 #define BLEND2D_PATH_P_H_INCLUDED
 
 #include "api-internal_p.h"
+#include "matrix.h"
 #include "object_p.h"
 #include "path.h"
 #include "support/math_p.h"
+#include "threading/atomic_p.h"
 
 //! \cond INTERNAL
 //! \addtogroup blend2d_internal
@@ -18,10 +20,33 @@
 //! \name BLPath - Private Structs
 //! \{
 
+//! Edges of a path prepared by a rendering context (see `BLContext::preparePath()`).
+//!
+//! Edges are built for a particular transform, clip box, and flatten tolerance and stored in the same allocation
+//! right after this header. They are immutable once created and reference counted, so a rendering context can keep
+//! using them until its batch completes even when the path is modified or destroyed meanwhile.
+struct BLPathEdgeCache {
+  //! Reference count.
+  size_t refCount;
+  //! Fixed-point transform the edges were built with (including the origin).
+  BLMatrix2D transform;
+  //! Fixed-point clip box the edges were clipped to.
+  BLBox clipBox;
+  //! Fixed-point flatten tolerance.
+  double tolerance;
+  //! Fixed-point bounding box of all edges.
+  BLBoxI boundingBox;
+  //! The first edge (`bl::RasterEngine::EdgeVector<int>`), all edges are linked into a single list sorted by their
+  //! first row. Null if the path has no edges within the clip box.
+  void* edges;
+};
+
 //! Private implementation that extends \ref BLPathImpl.
 struct BLPathPrivateImpl : public BLPathImpl {
   BLBox controlBox;
   BLBox boundingBox;
+  //! Edge cache (created by `BLContext::preparePath()`, can be null).
+  BLPathEdgeCache* edgeCache;
 };
 
 //! \}
@@ -42,6 +67,35 @@ static BL_INLINE constexpr BLObjectImplSize implSizeFromCapacity(size_t capacity
 
 //! \}
 
+//! \name BLPath - Internals - Edge Cache
+//! \{
+
+static BL_INLINE void retainEdgeCache(BLPathEdgeCache* edgeCache) noexcept {
+  blAtomicFetchAddStrong(&edgeCache->refCount);
+}
+
+static BL_INLINE void releaseEdgeCache(BLPathEdgeCache* edgeCache) noexcept {
+  if (blAtomicFetchSubStrong(&edgeCache->refCount) == 1)
+    free(edgeCache);
+}
+
+//! Returns a retained edge cache of the path `impl` or null if the path has no edge cache.
+//!
+//! The edge cache of a path can be replaced by another thread preparing the same path, thus it's read and retained
+//! under a lock. The caller must release the returned edge cache by `releaseEdgeCache()`.
+BL_HIDDEN BLPathEdgeCache* acquireEdgeCache(const BLPathPrivateImpl* impl) noexcept;
+
+//! Installs `edgeCache` to the path `impl`, replacing (and releasing) an existing one.
+BL_HIDDEN void replaceEdgeCache(BLPathPrivateImpl* impl, BLPathEdgeCache* edgeCache) noexcept;
+
+//! Releases an edge cache of the path `impl`, must be called before the path is modified.
+static BL_INLINE void invalidateEdgeCache(BLPathPrivateImpl* impl) noexcept {
+  if (BL_UNLIKELY(blAtomicFetchRelaxed(&impl->edgeCache)))
+    replaceEdgeCache(impl, nullptr);
+}
+
+//! \}
+
 //! \name BLPath - Internals - Common Functionality (Impl)
 //! \{
 
@@ -50,6 +104,7 @@ static BL_INLINE bool isImplMutable(BLPathImpl* impl) noexcept {
 }
 
 static BL_INLINE BLResult freeImpl(BLPathPrivateImpl* impl) noexcept {
+  invalidateEdgeCache(impl);
   return ObjectInternal::freeImpl(impl);
 }
 
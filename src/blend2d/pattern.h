@@ -23,9 +23,19 @@ BL_DEFINE_ENUM(BLPatternQuality) {
   BL_PATTERN_QUALITY_NEAREST = 0,
   //! Bilinear interpolation.
   BL_PATTERN_QUALITY_BILINEAR = 1,
+  //! Bicubic interpolation (Catmull-Rom spline), which samples 4x4 pixels.
+  //!
+  //! \note Bicubic interpolation is only used when the pattern is scaled, rotated, or translated by a fractional
+  //! offset, otherwise it's the same as other quality modes.
+  //!
+  //! \note Bicubic interpolation is always provided by portable (non-JIT) pipelines, which is slower than other
+  //! quality modes and slower still with composition operators other than `BL_COMP_OP_SRC_OVER` and
+  //! `BL_COMP_OP_SRC_COPY`. There is no Lanczos quality - significantly downscaled patterns are sampled from
+  //! image mipmaps instead.
+  BL_PATTERN_QUALITY_BICUBIC = 2,
 
   //! Maximum value of `BLPatternQuality`.
-  BL_PATTERN_QUALITY_MAX_VALUE = 1
+  BL_PATTERN_QUALITY_MAX_VALUE = 2
 
   BL_FORCE_ENUM_UINT32(BL_PATTERN_QUALITY)
 };
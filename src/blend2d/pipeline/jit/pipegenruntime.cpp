@@ -13,6 +13,7 @@
 #include "../../pipeline/jit/pipecompiler_p.h"
 #include "../../pipeline/jit/pipecomposer_p.h"
 #include "../../pipeline/jit/pipegenruntime_p.h"
+#include "../../pipeline/reference/fixedpiperuntime_p.h"
 #include "../../support/wrap_p.h"
 
 namespace bl {
@@ -89,6 +90,14 @@ static BLResult BL_CDECL blPipeGenRuntimeTest(PipeRuntime* self_, uint32_t signa
 
 static BLResult BL_CDECL blPipeGenRuntimeGet(PipeRuntime* self_, uint32_t signature, DispatchData* out, PipeLookupCache* cache) noexcept {
   PipeDynamicRuntime* self = static_cast<PipeDynamicRuntime*>(self_);
+
+  // Bicubic pattern fetch is not implemented by the compiler, reference pipelines provide it for all operators.
+  Signature sig{signature};
+  if (sig.fetchType() == FetchType::kPatternAffineBCAny) {
+    PipeRuntime* staticRuntime = &PipeStaticRuntime::_global;
+    return staticRuntime->_funcs.get(staticRuntime, signature, out, cache);
+  }
+
   FillFunc fillFunc = self->_mutex.protectShared([&] { return (FillFunc)self->_functionCache.get(signature); });
 
   if (!fillFunc) {
@@ -377,6 +386,7 @@ static const char* stringifyFetchType(FetchType value) noexcept {
     case FetchType::kPatternAffineNNOpt     : return "PatternAffineNNOpt";
     case FetchType::kPatternAffineBIAny     : return "PatternAffineBIAny";
     case FetchType::kPatternAffineBIOpt     : return "PatternAffineBIOpt";
+    case FetchType::kPatternAffineBCAny     : return "PatternAffineBCAny";
     case FetchType::kGradientLinearNNPad    : return "GradientLinearNNPad";
     case FetchType::kGradientLinearNNRoR    : return "GradientLinearNNRoR";
     case FetchType::kGradientLinearDitherPad: return "GradientLinearDitherPad";
@@ -412,6 +422,10 @@ FillFunc PipeDynamicRuntime::_compileFillFunc(uint32_t signature) noexcept {
   if (sig.srcFormat() == FormatExt::kNone)
     return nullptr;
 
+  // Bicubic fetch is not implemented by the compiler (see `blPipeGenRuntimeGet()`).
+  if (sig.fetchType() == FetchType::kPatternAffineBCAny)
+    return nullptr;
+
   CompilerErrorHandler eh;
   asmjit::CodeHolder code;
 
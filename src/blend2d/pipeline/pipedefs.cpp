@@ -117,70 +117,16 @@ Signature initPatternAxAy(FetchData::Pattern& fetchData, BLExtendMode extendMode
   return initPatternTxTy(fetchData, FetchType::kPatternAlignedPad, extendMode, -x, -y, false);
 }
 
-Signature initPatternFxFy(FetchData::Pattern& fetchData, BLExtendMode extendMode, BLPatternQuality quality, uint32_t bytesPerPixel, int64_t tx64, int64_t ty64) noexcept {
-  blUnused(bytesPerPixel);
-
-  FetchType fetchBase = FetchType::kPatternAlignedPad;
-  uint32_t wx = uint32_t(tx64 & 0xFF);
-  uint32_t wy = uint32_t(ty64 & 0xFF);
-
-  int tx = -int(tx64 >> 8);
-  int ty = -int(ty64 >> 8);
-
-  // If one or both `wx` or `wy` are non-zero it means that the translation is fractional. In that case we must
-  // calculate weights of [x0 y0], [x1 y0], [x0 y1], and [x1 y1] pixels.
-  bool isFractional = (wx | wy) != 0;
-  if (isFractional) {
-    if (quality == BL_PATTERN_QUALITY_NEAREST) {
-      tx -= (wx >= 128);
-      ty -= (wy >= 128);
-      isFractional = false;
-    }
-    else {
-      fetchData.simple.wa = ((      wy) * (      wx)      ) >> 8; // [x0 y0]
-      fetchData.simple.wb = ((      wy) * (256 - wx) + 255) >> 8; // [x1 y0]
-      fetchData.simple.wc = ((256 - wy) * (      wx)      ) >> 8; // [x0 y1]
-      fetchData.simple.wd = ((256 - wy) * (256 - wx) + 255) >> 8; // [x1 y1]
-
-      // The FxFy fetcher must work even when one or both `wx` or `wy` are zero, so we always decrement `tx` and `ty`.
-      // In addition, Fx or Fy fetcher can be replaced by FxFy if there is no Fx or Fy implementation (typically this
-      // could happen if we are running portable pipeline without any optimizations).
-      tx--;
-      ty--;
-
-      if (wy == 0)
-        fetchBase = FetchType::kPatternFxPad;
-      else if (wx == 0)
-        fetchBase = FetchType::kPatternFyPad;
-      else
-        fetchBase = FetchType::kPatternFxFyPad;
-    }
-  }
-
-  return initPatternTxTy(fetchData, fetchBase, extendMode, tx, ty, isFractional);
-}
-
-Signature initPatternAffine(FetchData::Pattern& fetchData, BLExtendMode extendMode, BLPatternQuality quality, uint32_t bytesPerPixel, const BLMatrix2D& transform) noexcept {
-  // Inverted transformation matrix.
-  BLMatrix2D inv;
-  if (BLMatrix2D::invert(inv, transform) != BL_SUCCESS)
-    return Signature::fromPendingFlag(1);
-
+// Initializes affine fetch data from an already inverted transformation matrix.
+static Signature initPatternAffineInverted(FetchData::Pattern& fetchData, BLExtendMode extendMode, BLPatternQuality quality, uint32_t bytesPerPixel, const BLMatrix2D& inv) noexcept {
   double xx = inv.m00;
   double xy = inv.m01;
   double yx = inv.m10;
   double yy = inv.m11;
 
-  if (Math::isNearOne(xx) && Math::isNearZero(xy) && Math::isNearZero(yx) && Math::isNearOne(yy)) {
-    int64_t tx64 = Math::floorToInt64(-inv.m20 * 256.0);
-    int64_t ty64 = Math::floorToInt64(-inv.m21 * 256.0);
-    return initPatternFxFy(fetchData, extendMode, quality, bytesPerPixel, tx64, ty64);
-  }
-
   FetchType fetchType =
-    quality == BL_PATTERN_QUALITY_NEAREST
-      ? FetchType::kPatternAffineNNAny
-      : FetchType::kPatternAffineBIAny;
+    quality == BL_PATTERN_QUALITY_NEAREST  ? FetchType::kPatternAffineNNAny :
+    quality == BL_PATTERN_QUALITY_BILINEAR ? FetchType::kPatternAffineBIAny : FetchType::kPatternAffineBCAny;
 
   // Pattern bounds.
   int tw = int(fetchData.src.size.w);
@@ -191,8 +137,8 @@ Signature initPatternAffine(FetchData::Pattern& fetchData, BLExtendMode extendMo
                  fetchData.src.stride >= 0 &&
                  fetchData.src.stride <= intptr_t(Traits::maxValue<int16_t>());
 
-  // TODO: [JIT] OPTIMIZATION: Not implemented for bilinear yet.
-  if (quality == BL_PATTERN_QUALITY_BILINEAR)
+  // TODO: [JIT] OPTIMIZATION: Not implemented for bilinear yet. Bicubic fetch has no optimized variant.
+  if (quality != BL_PATTERN_QUALITY_NEAREST)
     opt = 0;
 #else
   constexpr uint32_t opt = 0;
@@ -372,6 +318,69 @@ Signature initPatternAffine(FetchData::Pattern& fetchData, BLExtendMode extendMo
   return Signature::fromFetchType(fetchType);
 }
 
+Signature initPatternFxFy(FetchData::Pattern& fetchData, BLExtendMode extendMode, BLPatternQuality quality, uint32_t bytesPerPixel, int64_t tx64, int64_t ty64) noexcept {
+  // Bicubic filter samples 4x4 pixels, which is not supported by FxFy fetchers, so use affine fetcher if the
+  // translation is fractional.
+  if (quality == BL_PATTERN_QUALITY_BICUBIC && ((tx64 | ty64) & 0xFF) != 0) {
+    BLMatrix2D inv(1.0, 0.0, 0.0, 1.0, double(-tx64) / 256.0, double(-ty64) / 256.0);
+    return initPatternAffineInverted(fetchData, extendMode, quality, bytesPerPixel, inv);
+  }
+
+  FetchType fetchBase = FetchType::kPatternAlignedPad;
+  uint32_t wx = uint32_t(tx64 & 0xFF);
+  uint32_t wy = uint32_t(ty64 & 0xFF);
+
+  int tx = -int(tx64 >> 8);
+  int ty = -int(ty64 >> 8);
+
+  // If one or both `wx` or `wy` are non-zero it means that the translation is fractional. In that case we must
+  // calculate weights of [x0 y0], [x1 y0], [x0 y1], and [x1 y1] pixels.
+  bool isFractional = (wx | wy) != 0;
+  if (isFractional) {
+    if (quality == BL_PATTERN_QUALITY_NEAREST) {
+      tx -= (wx >= 128);
+      ty -= (wy >= 128);
+      isFractional = false;
+    }
+    else {
+      fetchData.simple.wa = ((      wy) * (      wx)      ) >> 8; // [x0 y0]
+      fetchData.simple.wb = ((      wy) * (256 - wx) + 255) >> 8; // [x1 y0]
+      fetchData.simple.wc = ((256 - wy) * (      wx)      ) >> 8; // [x0 y1]
+      fetchData.simple.wd = ((256 - wy) * (256 - wx) + 255) >> 8; // [x1 y1]
+
+      // The FxFy fetcher must work even when one or both `wx` or `wy` are zero, so we always decrement `tx` and `ty`.
+      // In addition, Fx or Fy fetcher can be replaced by FxFy if there is no Fx or Fy implementation (typically this
+      // could happen if we are running portable pipeline without any optimizations).
+      tx--;
+      ty--;
+
+      if (wy == 0)
+        fetchBase = FetchType::kPatternFxPad;
+      else if (wx == 0)
+        fetchBase = FetchType::kPatternFyPad;
+      else
+        fetchBase = FetchType::kPatternFxFyPad;
+    }
+  }
+
+  return initPatternTxTy(fetchData, fetchBase, extendMode, tx, ty, isFractional);
+}
+
+Signature initPatternAffine(FetchData::Pattern& fetchData, BLExtendMode extendMode, BLPatternQuality quality, uint32_t bytesPerPixel, const BLMatrix2D& transform) noexcept {
+  // Inverted transformation matrix.
+  BLMatrix2D inv;
+  if (BLMatrix2D::invert(inv, transform) != BL_SUCCESS)
+    return Signature::fromPendingFlag(1);
+
+  if (Math::isNearOne(inv.m00) && Math::isNearZero(inv.m01) && Math::isNearZero(inv.m10) && Math::isNearOne(inv.m11)) {
+    int64_t tx64 = Math::floorToInt64(-inv.m20 * 256.0);
+    int64_t ty64 = Math::floorToInt64(-inv.m21 * 256.0);
+    return initPatternFxFy(fetchData, extendMode, quality, bytesPerPixel, tx64, ty64);
+  }
+
+  return initPatternAffineInverted(fetchData, extendMode, quality, bytesPerPixel, inv);
+}
+
 // FetchData - Init Gradient
 // =========================
 
@@ -155,6 +155,8 @@ enum class FetchType : uint8_t {
   kPatternAffineBIAny,
   //!< Pattern {affine-bilinear} (any) [Optimized].
   kPatternAffineBIOpt,
+  //!< Pattern {affine-bicubic}  (any) [Base].
+  kPatternAffineBCAny,
 
   //!< Linear gradient (pad) [Base].
   kGradientLinearNNPad,
@@ -191,7 +193,7 @@ enum class FetchType : uint8_t {
   kFailure = 0xFFu,
 
   kPatternAnyFirst = kPatternAlignedBlit,
-  kPatternAnyLast = kPatternAffineBIOpt,
+  kPatternAnyLast = kPatternAffineBCAny,
 
   kPatternAlignedFirst = kPatternAlignedBlit,
   kPatternAlignedLast = kPatternAlignedRoR,
@@ -212,7 +214,7 @@ enum class FetchType : uint8_t {
   kPatternSimpleLast = kPatternFxFyRoR,
 
   kPatternAffineFirst = kPatternAffineNNAny,
-  kPatternAffineLast = kPatternAffineBIOpt,
+  kPatternAffineLast = kPatternAffineBCAny,
 
   kGradientAnyFirst = kGradientLinearNNPad,
   kGradientAnyLast = kGradientConicDither,
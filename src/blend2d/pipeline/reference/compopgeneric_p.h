@@ -8,9 +8,11 @@
 
 #include "../../compop_p.h"
 #include "../../pipeline/pipedefs_p.h"
+#include "../../pipeline/reference/compopspan_p.h"
 #include "../../pipeline/reference/pixelgeneric_p.h"
 #include "../../pipeline/reference/fetchgeneric_p.h"
 #include "../../pixelops/scalar_p.h"
+#include "../../support/math_p.h"
 
 //! \cond INTERNAL
 //! \addtogroup blend2d_pipeline_reference
@@ -82,6 +84,152 @@ struct CompOp_Plus_Op {
   }
 };
 
+//! Generic implementation of all composition operators, which calculates each pixel in floating point.
+//!
+//! It's only used by fetchers that have no specialized pipeline for the operator (bicubic pattern fetch), so it
+//! favors simplicity over speed. Blend modes use W3C compositing formulas applied to unpremultiplied colors, thus
+//! results may differ from JIT compiled pipelines by a rounding error.
+struct CompOpGeneric {
+  static BL_INLINE float blendColor(CompOpExt compOp, float dc, float sc) noexcept {
+    switch (compOp) {
+      case CompOpExt::kMultiply   : return dc * sc;
+      case CompOpExt::kScreen     : return dc + sc - dc * sc;
+      case CompOpExt::kOverlay    : return dc <= 0.5f ? 2.0f * sc * dc : 1.0f - 2.0f * (1.0f - sc) * (1.0f - dc);
+      case CompOpExt::kDarken     : return blMin(dc, sc);
+      case CompOpExt::kLighten    : return blMax(dc, sc);
+      case CompOpExt::kColorDodge : return dc <= 0.0f ? 0.0f : sc >= 1.0f ? 1.0f : blMin(1.0f, dc / (1.0f - sc));
+      case CompOpExt::kColorBurn  : return dc >= 1.0f ? 1.0f : sc <= 0.0f ? 0.0f : 1.0f - blMin(1.0f, (1.0f - dc) / sc);
+      case CompOpExt::kLinearLight: return blClamp(dc + 2.0f * sc - 1.0f, 0.0f, 1.0f);
+      case CompOpExt::kPinLight   : return sc <= 0.5f ? blMin(dc, 2.0f * sc) : blMax(dc, 2.0f * sc - 1.0f);
+      case CompOpExt::kHardLight  : return sc <= 0.5f ? 2.0f * sc * dc : 1.0f - 2.0f * (1.0f - sc) * (1.0f - dc);
+      case CompOpExt::kDifference : return blAbs(dc - sc);
+      case CompOpExt::kExclusion  : return dc + sc - 2.0f * dc * sc;
+
+      case CompOpExt::kSoftLight: {
+        if (sc <= 0.5f)
+          return dc - (1.0f - 2.0f * sc) * dc * (1.0f - dc);
+
+        float d = dc <= 0.25f ? ((16.0f * dc - 12.0f) * dc + 4.0f) * dc : Math::sqrt(dc);
+        return dc + (2.0f * sc - 1.0f) * (d - dc);
+      }
+
+      default:
+        return dc;
+    }
+  }
+
+  //! Composites a single premultiplied channel `dc` with `sc`, the result is not clamped.
+  static BL_INLINE float compositeChannel(CompOpExt compOp, float dc, float sc, float da, float sa, bool isAlpha) noexcept {
+    switch (compOp) {
+      case CompOpExt::kSrcOver    : return sc + dc * (1.0f - sa);
+      case CompOpExt::kSrcCopy    : return sc;
+      case CompOpExt::kSrcIn      : return sc * da;
+      case CompOpExt::kSrcOut     : return sc * (1.0f - da);
+      case CompOpExt::kSrcAtop    : return sc * da + dc * (1.0f - sa);
+      case CompOpExt::kDstOver    : return dc + sc * (1.0f - da);
+      case CompOpExt::kDstCopy    : return dc;
+      case CompOpExt::kDstIn      : return dc * sa;
+      case CompOpExt::kDstOut     : return dc * (1.0f - sa);
+      case CompOpExt::kDstAtop    : return dc * sa + sc * (1.0f - da);
+      case CompOpExt::kXor        : return sc * (1.0f - da) + dc * (1.0f - sa);
+      case CompOpExt::kClear      : return 0.0f;
+      case CompOpExt::kPlus       : return dc + sc;
+      case CompOpExt::kModulate   : return dc * sc;
+      case CompOpExt::kAlphaInv   : return 1.0f - dc;
+
+      case CompOpExt::kMinus:
+        return isAlpha ? da + sa * (1.0f - da) : blMax(dc - sc, 0.0f) + sc * (1.0f - da);
+
+      case CompOpExt::kLinearBurn:
+        return isAlpha ? sa + da - sa * da : dc + sc - sa * da;
+
+      default: {
+        // Separable blend modes: Dca' = B(Dc, Sc).Sa.Da + Sca.(1 - Da) + Dca.(1 - Sa), Da' = Sa + Da - Sa.Da
+        if (isAlpha)
+          return sa + da - sa * da;
+
+        float dcu = da > 0.0f ? blMin(dc / da, 1.0f) : 0.0f;
+        float scu = sa > 0.0f ? blMin(sc / sa, 1.0f) : 0.0f;
+        return blendColor(compOp, dcu, scu) * sa * da + sc * (1.0f - da) + dc * (1.0f - sa);
+      }
+    }
+  }
+
+  static BL_INLINE uint32_t toU8(float x) noexcept {
+    return uint32_t(int(blClamp(x, 0.0f, 1.0f) * 255.0f + 0.5f));
+  }
+
+  static BL_NOINLINE uint32_t compositeA8(CompOpExt compOp, uint32_t d, uint32_t s) noexcept {
+    constexpr float k1Div255 = 1.0f / 255.0f;
+
+    float da = float(d) * k1Div255;
+    float sa = float(s) * k1Div255;
+    return toU8(compositeChannel(compOp, da, sa, da, sa, true));
+  }
+
+  static BL_NOINLINE uint32_t compositePRGB32(CompOpExt compOp, uint32_t d, uint32_t s) noexcept {
+    constexpr float k1Div255 = 1.0f / 255.0f;
+
+    float da = float(d >> 24) * k1Div255;
+    float sa = float(s >> 24) * k1Div255;
+
+    uint32_t a = toU8(compositeChannel(compOp, da, sa, da, sa, true));
+    uint32_t result = a << 24;
+
+    for (uint32_t shift = 0; shift < 24; shift += 8) {
+      float dc = float((d >> shift) & 0xFFu) * k1Div255;
+      float sc = float((s >> shift) & 0xFFu) * k1Div255;
+
+      // Keep the result premultiplied, color components must not exceed alpha.
+      result |= blMin(toU8(compositeChannel(compOp, dc, sc, da, sa, false)), a) << shift;
+    }
+
+    return result;
+  }
+};
+
+template<typename PixelT, uint32_t kCompOpValue>
+struct CompOp_Generic_Op {
+  typedef PixelT PixelType;
+
+  enum : uint32_t {
+    kCompOp = kCompOpValue,
+    kOptimizeOpaque = 1
+  };
+
+  static constexpr bool kIsA8 = std::is_same<PixelT, Pixel::P8_Alpha>::value;
+
+  static BL_INLINE PixelType op_prgb32_prgb32(PixelType d, PixelType s) noexcept {
+    return PixelType::fromValue(kIsA8 ? CompOpGeneric::compositeA8(CompOpExt(kCompOp), d.value(), s.value())
+                                      : CompOpGeneric::compositePRGB32(CompOpExt(kCompOp), d.value(), s.value()));
+  }
+
+  // D' = Op(D, S).m + D.(1 - m)
+  static BL_INLINE PixelType op_prgb32_prgb32(PixelType d, PixelType s, uint32_t m) noexcept {
+    PixelType x = op_prgb32_prgb32(d, s);
+    return (d.unpack() * Repeat{m ^ 0xFFu} + x.unpack() * Repeat{m}).div255().pack();
+  }
+};
+
+//! Fetches `n` PRGB32 pixels to be composited by span functions - either returns a pointer provided by the fetcher
+//! (no copy) or fetches pixels one by one into `buffer`, which is returned.
+template<typename FetchOp, bool kHasSpanPtr = FetchOp::kHasSpanPtr != 0>
+struct FetchSpanPRGB32 {
+  static BL_INLINE const uint32_t* fetch(FetchOp& fetchOp, uint32_t* buffer, size_t n) noexcept {
+    for (size_t i = 0; i < n; i++)
+      buffer[i] = uint32_t(fetchOp.fetch().p);
+    return buffer;
+  }
+};
+
+template<typename FetchOp>
+struct FetchSpanPRGB32<FetchOp, true> {
+  static BL_INLINE const uint32_t* fetch(FetchOp& fetchOp, uint32_t* buffer, size_t n) noexcept {
+    blUnused(buffer);
+    return fetchOp.fetchSpan(n);
+  }
+};
+
 template<typename OpT, typename PixelT, typename FetchOp, uint32_t kDstBPP_>
 struct CompOp_Base {
   typedef OpT Op;
@@ -97,6 +245,20 @@ struct CompOp_Base {
 
   static constexpr FormatExt kFormat = PixelTypeToFormat<PixelT>::kFormat;
 
+  //! Whether spans can be composited by SIMD functions provided by \ref CompOpSpanFuncs (PRGB32 SrcCopy & SrcOver).
+  static constexpr bool kSpanFuncsAvailable =
+    kDstBPP == 4 && std::is_same<PixelT, Pixel::P32_A8R8G8B8>::value &&
+    (uint32_t(kCompOp) == BL_COMP_OP_SRC_OVER || uint32_t(kCompOp) == BL_COMP_OP_SRC_COPY);
+
+  //! Index to \ref CompOpSpanFuncs tables (always in range, even when span functions are not available).
+  static constexpr uint32_t kSpanFuncIndex = kSpanFuncsAvailable ? uint32_t(kCompOp) : 0u;
+
+  //! Minimum width of a span that would be composited by SIMD functions, shorter spans use scalar code.
+  static constexpr size_t kSpanMinWidth = 4;
+
+  //! Number of pixels fetched into a temporary buffer before they are composited by SIMD functions.
+  static constexpr size_t kSpanBatchSize = 64;
+
   BL_INLINE void rectInitFetch(ContextData* ctxData, const void* fetchData, uint32_t xPos, uint32_t yPos, uint32_t rectWidth) noexcept {
     fetchOp.rectInitFetch(ctxData, fetchData, xPos, yPos, rectWidth);
   }
@@ -141,7 +303,88 @@ struct CompOp_Base {
     return dstPtr + kDstBPP;
   }
 
+  //! Composites a span of `w` pixels with a constant mask `m` by SIMD span functions and returns the advanced `dstPtr`
+  //! or null if the span cannot be composited this way.
+  BL_INLINE uint8_t* compositeCSpanSimd(uint8_t* dstPtr, size_t w, uint32_t m) noexcept {
+    if (!kSpanFuncsAvailable || w < kSpanMinWidth)
+      return nullptr;
+
+    if (FetchOp::kIsSolid) {
+      CompOpCSpanFunc func = compOpSpanFuncs.cspanSolid[kSpanFuncIndex];
+      if (!func)
+        return nullptr;
+
+      uint32_t src = uint32_t(fetchOp.fetch().p);
+      func(reinterpret_cast<uint32_t*>(dstPtr), &src, w, m);
+      dstPtr += w * kDstBPP;
+    }
+    else {
+      // Opaque SrcCopy of fetched pixels is just a copy, which scalar code does without a temporary buffer.
+      if (uint32_t(kCompOp) == BL_COMP_OP_SRC_COPY && m == 255)
+        return nullptr;
+
+      CompOpCSpanFunc func = compOpSpanFuncs.cspan[kSpanFuncIndex];
+      if (!func)
+        return nullptr;
+
+      uint32_t srcBuffer[kSpanBatchSize];
+      do {
+        size_t n = blMin(w, kSpanBatchSize);
+        const uint32_t* src = FetchSpanPRGB32<FetchOp>::fetch(fetchOp, srcBuffer, n);
+
+        func(reinterpret_cast<uint32_t*>(dstPtr), src, n, m);
+        dstPtr += n * kDstBPP;
+        w -= n;
+      } while (w);
+    }
+
+    return dstPtr;
+  }
+
+  //! Composites a span of `w` pixels with a variable mask by SIMD span functions and returns the advanced `dstPtr`
+  //! or null if the span cannot be composited this way. If `globalAlpha` is not 255 the mask is multiplied by it first.
+  BL_INLINE uint8_t* compositeVSpanSimd(uint8_t* dstPtr, const uint8_t* maskPtr, uint32_t globalAlpha, size_t w) noexcept {
+    if (!kSpanFuncsAvailable || w < kSpanMinWidth)
+      return nullptr;
+
+    CompOpVSpanFunc func = FetchOp::kIsSolid ? compOpSpanFuncs.vspanSolid[kSpanFuncIndex]
+                                             : compOpSpanFuncs.vspan[kSpanFuncIndex];
+    if (!func)
+      return nullptr;
+
+    uint32_t srcBuffer[kSpanBatchSize];
+    uint8_t maskBuffer[kSpanBatchSize];
+
+    if (FetchOp::kIsSolid)
+      srcBuffer[0] = uint32_t(fetchOp.fetch().p);
+
+    do {
+      size_t n = blMin(w, kSpanBatchSize);
+      const uint8_t* m = maskPtr;
+      const uint32_t* src = srcBuffer;
+
+      if (!FetchOp::kIsSolid)
+        src = FetchSpanPRGB32<FetchOp>::fetch(fetchOp, srcBuffer, n);
+
+      if (globalAlpha != 255) {
+        for (size_t i = 0; i < n; i++)
+          maskBuffer[i] = uint8_t(PixelOps::Scalar::udiv255(uint32_t(maskPtr[i]) * globalAlpha));
+        m = maskBuffer;
+      }
+
+      func(reinterpret_cast<uint32_t*>(dstPtr), src, m, n);
+      dstPtr += n * kDstBPP;
+      maskPtr += n;
+      w -= n;
+    } while (w);
+
+    return dstPtr;
+  }
+
   BL_INLINE uint8_t* compositeCSpanOpaque(uint8_t* dstPtr, size_t w) noexcept {
+    if (uint8_t* dstEnd = compositeCSpanSimd(dstPtr, w, 255))
+      return dstEnd;
+
     size_t i = w;
     do {
       dstPtr = compositePixelOpaque(dstPtr);
@@ -150,6 +393,9 @@ struct CompOp_Base {
   }
 
   BL_INLINE uint8_t* compositeCSpanMasked(uint8_t* dstPtr, size_t w, uint32_t m) noexcept {
+    if (uint8_t* dstEnd = compositeCSpanSimd(dstPtr, w, m))
+      return dstEnd;
+
     size_t i = w;
     do {
       dstPtr = compositePixelMasked(dstPtr, m);
@@ -165,6 +411,9 @@ struct CompOp_Base {
   }
 
   BL_INLINE uint8_t* compositeVSpanWithGA(uint8_t* BL_RESTRICT dstPtr, const uint8_t* BL_RESTRICT maskPtr, size_t w) noexcept {
+    if (uint8_t* dstEnd = compositeVSpanSimd(dstPtr, maskPtr, 255, w))
+      return dstEnd;
+
     size_t i = w;
     do {
       uint32_t msk = maskPtr[0];
@@ -175,6 +424,9 @@ struct CompOp_Base {
   }
 
   BL_INLINE uint8_t* compositeVSpanWithoutGA(uint8_t* BL_RESTRICT dstPtr, const uint8_t* BL_RESTRICT maskPtr, uint32_t globalAlpha, size_t w) noexcept {
+    if (uint8_t* dstEnd = compositeVSpanSimd(dstPtr, maskPtr, globalAlpha, w))
+      return dstEnd;
+
     size_t i = w;
     do {
       uint32_t msk = PixelOps::Scalar::udiv255(uint32_t(maskPtr[0]) * globalAlpha);
@@ -0,0 +1,23 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "../../api-build_p.h"
+#if defined(BL_BUILD_OPT_AVX2)
+
+#include "../../pipeline/reference/compopspansimdimpl_p.h"
+
+namespace bl {
+namespace Pipeline {
+namespace Reference {
+
+void initCompOpSpanFuncs_AVX2(CompOpSpanFuncs& funcs) noexcept {
+  initCompOpSpanFuncsSimd(funcs);
+}
+
+} // {Reference}
+} // {Pipeline}
+} // {bl}
+
+#endif // BL_BUILD_OPT_AVX2
@@ -0,0 +1,75 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_PIPELINE_REFERENCE_COMPOPSPAN_P_H_INCLUDED
+#define BLEND2D_PIPELINE_REFERENCE_COMPOPSPAN_P_H_INCLUDED
+
+#include "../../api-internal_p.h"
+#include "../../context.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_pipeline_reference
+//! \{
+
+namespace bl {
+namespace Pipeline {
+namespace Reference {
+
+//! Composites `n` PRGB32 pixels of `src` into `dst` with a constant mask `m` (255 means opaque).
+//!
+//! If `src` describes a solid span, it points to a single pixel, which is used by all destination pixels.
+typedef void (BL_CDECL* CompOpCSpanFunc)(uint32_t* dst, const uint32_t* src, size_t n, uint32_t m) BL_NOEXCEPT;
+
+//! Composites `n` PRGB32 pixels of `src` into `dst` with a variable mask `mask` (one byte per pixel).
+//!
+//! If `src` describes a solid span, it points to a single pixel, which is used by all destination pixels.
+typedef void (BL_CDECL* CompOpVSpanFunc)(uint32_t* dst, const uint32_t* src, const uint8_t* mask, size_t n) BL_NOEXCEPT;
+
+//! Composition span functions used by reference pipelines, which are selected at runtime based on CPU features.
+//!
+//! Only PRGB32 destinations and SrcCopy and SrcOver operators are accelerated. Each table is indexed by \ref
+//! BLCompOp (only `BL_COMP_OP_SRC_OVER` and `BL_COMP_OP_SRC_COPY`). Null functions mean that no SIMD acceleration
+//! is available and reference pipelines must use scalar code. Fetchers are not vectorized - pixels of non-solid
+//! sources are fetched by scalar code into a temporary buffer, which is then passed to span functions. The only
+//! exception are aligned blits of PRGB32 images, which pass source pixels to span functions directly.
+struct CompOpSpanFuncs {
+  //! Number of composition operators that are accelerated.
+  static constexpr uint32_t kCompOpCount = 2;
+
+  //! Solid source with a constant mask.
+  CompOpCSpanFunc cspanSolid[kCompOpCount];
+  //! Pixel array source with a constant mask.
+  CompOpCSpanFunc cspan[kCompOpCount];
+  //! Solid source with a variable mask.
+  CompOpVSpanFunc vspanSolid[kCompOpCount];
+  //! Pixel array source with a variable mask.
+  CompOpVSpanFunc vspan[kCompOpCount];
+};
+
+static_assert(BL_COMP_OP_SRC_OVER < CompOpSpanFuncs::kCompOpCount && BL_COMP_OP_SRC_COPY < CompOpSpanFuncs::kCompOpCount,
+              "SrcOver and SrcCopy operators must be usable as indexes to CompOpSpanFuncs tables");
+
+BL_HIDDEN extern CompOpSpanFuncs compOpSpanFuncs;
+
+#if defined(BL_BUILD_OPT_SSE2)
+BL_HIDDEN void initCompOpSpanFuncs_SSE2(CompOpSpanFuncs& funcs) noexcept;
+#endif // BL_BUILD_OPT_SSE2
+
+#if defined(BL_BUILD_OPT_AVX2)
+BL_HIDDEN void initCompOpSpanFuncs_AVX2(CompOpSpanFuncs& funcs) noexcept;
+#endif // BL_BUILD_OPT_AVX2
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+BL_HIDDEN void initCompOpSpanFuncs_ASIMD(CompOpSpanFuncs& funcs) noexcept;
+#endif // BL_BUILD_OPT_ASIMD
+
+} // {Reference}
+} // {Pipeline}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_PIPELINE_REFERENCE_COMPOPSPAN_P_H_INCLUDED
@@ -0,0 +1,183 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "../../api-build_test_p.h"
+#if defined(BL_TEST)
+
+#include "../../random.h"
+#include "../../runtime_p.h"
+#include "../../pipeline/reference/compopgeneric_p.h"
+#include "../../pipeline/reference/compopspan_p.h"
+
+// bl::Pipeline::Reference - CompOp Spans - Tests
+// ==============================================
+
+namespace bl {
+namespace Pipeline {
+namespace Reference {
+namespace Tests {
+
+// Spans up to 17 pixels exercise all code paths of span functions (8 pixels, 4 pixels, and a tail of 1-3 pixels).
+static constexpr uint32_t kMaxWidth = 17;
+// Destination, source, and mask pointers are offset by up to 3 pixels, thus also unaligned spans are tested.
+static constexpr uint32_t kMaxOffset = 3;
+// Pixels around a span, which must not be modified by span functions.
+static constexpr uint32_t kGuardSize = 4;
+static constexpr uint32_t kBufferSize = kGuardSize + kMaxOffset + kMaxWidth + kGuardSize;
+static constexpr uint32_t kGuardPixel = 0xDEADBEEFu;
+
+enum class SpanKind : uint32_t {
+  kCSpanSolid,
+  kCSpan,
+  kVSpanSolid,
+  kVSpan,
+
+  kMaxValue = kVSpan
+};
+
+static const char* spanKindName(SpanKind kind) noexcept {
+  switch (kind) {
+    case SpanKind::kCSpanSolid: return "cspanSolid";
+    case SpanKind::kCSpan: return "cspan";
+    case SpanKind::kVSpanSolid: return "vspanSolid";
+    default: return "vspan";
+  }
+}
+
+static BL_INLINE bool isSolidSpan(SpanKind kind) noexcept { return kind == SpanKind::kCSpanSolid || kind == SpanKind::kVSpanSolid; }
+static BL_INLINE bool isVSpan(SpanKind kind) noexcept { return kind == SpanKind::kVSpanSolid || kind == SpanKind::kVSpan; }
+
+// Returns a random premultiplied pixel - fully transparent and fully opaque pixels are generated more often.
+static uint32_t randomPRGB32(BLRandom& rnd) noexcept {
+  uint32_t x = rnd.nextUInt32();
+  uint32_t a = (x & 0x3u) == 0 ? 0u : (x & 0x3u) == 1 ? 255u : (x >> 24);
+
+  uint32_t r = rnd.nextUInt32() % (a + 1u);
+  uint32_t g = rnd.nextUInt32() % (a + 1u);
+  uint32_t b = rnd.nextUInt32() % (a + 1u);
+
+  return (a << 24) | (r << 16) | (g << 8) | b;
+}
+
+// Returns a random mask value - zero and full masks are generated more often.
+static uint32_t randomMask(BLRandom& rnd) noexcept {
+  uint32_t x = rnd.nextUInt32();
+  return (x & 0x3u) == 0 ? 0u : (x & 0x3u) == 1 ? 255u : (x >> 24);
+}
+
+// Composites a single pixel the same way as `CompOp_Base` does when it doesn't use span functions.
+template<typename OpT>
+static uint32_t compositePixelScalar(uint32_t d, uint32_t s, uint32_t m, bool isVSpan) noexcept {
+  typedef typename OpT::PixelType PixelType;
+
+  if (!isVSpan && OpT::kOptimizeOpaque && m == 255)
+    return s;
+  else
+    return OpT::op_prgb32_prgb32(PixelType{d}, PixelType{s}, m).p;
+}
+
+template<typename OpT>
+static void testSpanFunc(const CompOpSpanFuncs& funcs, SpanKind kind, const char* isaName, const char* compOpName, BLRandom& rnd) noexcept {
+  uint32_t compOp = OpT::kCompOp;
+
+  alignas(32) uint32_t dst[kBufferSize];
+  alignas(32) uint32_t src[kBufferSize];
+  alignas(32) uint8_t mask[kBufferSize];
+  uint32_t expected[kBufferSize];
+
+  // Constant masks to test - the last one is replaced by a random mask for each span.
+  static constexpr uint32_t constMasks[] = { 255, 0, 1, 128, 254, 0 };
+
+  for (uint32_t width = 0; width <= kMaxWidth; width++) {
+    for (uint32_t offset = 0; offset <= kMaxOffset; offset++) {
+      for (uint32_t maskIndex = 0; maskIndex < BL_ARRAY_SIZE(constMasks); maskIndex++) {
+        // Variable masks are random, thus it's not needed to test them with all constant masks.
+        if (isVSpan(kind) && maskIndex >= 2)
+          break;
+
+        // Use different alignment of source and mask to catch functions that would assume it's the same.
+        uint32_t dstIndex = kGuardSize + offset;
+        uint32_t srcIndex = kGuardSize + ((offset + 1u) & kMaxOffset);
+        uint32_t maskStart = kGuardSize + ((offset + 2u) & kMaxOffset);
+        uint32_t m = maskIndex == BL_ARRAY_SIZE(constMasks) - 1 ? randomMask(rnd) : constMasks[maskIndex];
+
+        for (uint32_t i = 0; i < kBufferSize; i++) {
+          dst[i] = kGuardPixel;
+          src[i] = randomPRGB32(rnd);
+          mask[i] = uint8_t(randomMask(rnd));
+        }
+
+        for (uint32_t i = 0; i < width; i++)
+          dst[dstIndex + i] = randomPRGB32(rnd);
+
+        memcpy(expected, dst, sizeof(dst));
+        for (uint32_t i = 0; i < width; i++) {
+          uint32_t s = isSolidSpan(kind) ? src[srcIndex] : src[srcIndex + i];
+          uint32_t pixelMask = isVSpan(kind) ? uint32_t(mask[maskStart + i]) : m;
+          expected[dstIndex + i] = compositePixelScalar<OpT>(dst[dstIndex + i], s, pixelMask, isVSpan(kind));
+        }
+
+        switch (kind) {
+          case SpanKind::kCSpanSolid: funcs.cspanSolid[compOp](dst + dstIndex, src + srcIndex, width, m); break;
+          case SpanKind::kCSpan: funcs.cspan[compOp](dst + dstIndex, src + srcIndex, width, m); break;
+          case SpanKind::kVSpanSolid: funcs.vspanSolid[compOp](dst + dstIndex, src + srcIndex, mask + maskStart, width); break;
+          case SpanKind::kVSpan: funcs.vspan[compOp](dst + dstIndex, src + srcIndex, mask + maskStart, width); break;
+        }
+
+        for (uint32_t i = 0; i < kBufferSize; i++) {
+          EXPECT_EQ(dst[i], expected[i])
+            .message("%s %s::%s(width=%u, offset=%u, mask=%u) - dst[%d]=%08X (Expected %08X)",
+                     isaName, compOpName, spanKindName(kind), width, offset, isVSpan(kind) ? 0u : m,
+                     int(i) - int(dstIndex), dst[i], expected[i]);
+        }
+      }
+    }
+  }
+}
+
+template<typename OpT>
+static void testSpanFuncs(const CompOpSpanFuncs& funcs, const char* isaName, const char* compOpName) noexcept {
+  INFO("Testing %s span functions of %s operator against scalar composition", isaName, compOpName);
+
+  BLRandom rnd(0x1234u);
+  for (uint32_t kind = 0; kind <= uint32_t(SpanKind::kMaxValue); kind++)
+    testSpanFunc<OpT>(funcs, SpanKind(kind), isaName, compOpName, rnd);
+}
+
+static void testCompOpSpans(const char* isaName, void (*initFunc)(CompOpSpanFuncs& funcs) noexcept) noexcept {
+  CompOpSpanFuncs funcs {};
+  initFunc(funcs);
+
+  testSpanFuncs<CompOp_SrcCopy_Op<Pixel::P32_A8R8G8B8>>(funcs, isaName, "SrcCopy");
+  testSpanFuncs<CompOp_SrcOver_Op<Pixel::P32_A8R8G8B8>>(funcs, isaName, "SrcOver");
+}
+
+UNIT(pipeline_reference_compop_span, BL_TEST_GROUP_RENDERING_PIXEL_OPS) {
+  BLRuntimeContext& rt = blRuntimeContext;
+
+#if defined(BL_BUILD_OPT_SSE2)
+  if (blRuntimeHasSSE2(&rt))
+    testCompOpSpans("SSE2", initCompOpSpanFuncs_SSE2);
+#endif // BL_BUILD_OPT_SSE2
+
+#if defined(BL_BUILD_OPT_AVX2)
+  if (blRuntimeHasAVX2(&rt))
+    testCompOpSpans("AVX2", initCompOpSpanFuncs_AVX2);
+#endif // BL_BUILD_OPT_AVX2
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+  if (blRuntimeHasASIMD(&rt))
+    testCompOpSpans("ASIMD", initCompOpSpanFuncs_ASIMD);
+#endif // BL_BUILD_OPT_ASIMD
+
+  blUnused(rt);
+}
+
+} // {Tests}
+} // {Reference}
+} // {Pipeline}
+} // {bl}
+
+#endif // BL_TEST
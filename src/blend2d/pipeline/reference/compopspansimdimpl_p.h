@@ -0,0 +1,263 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_PIPELINE_REFERENCE_COMPOPSPANSIMDIMPL_P_H_INCLUDED
+#define BLEND2D_PIPELINE_REFERENCE_COMPOPSPANSIMDIMPL_P_H_INCLUDED
+
+#include "../../pipeline/reference/compopspan_p.h"
+#include "../../simd/simd_p.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_pipeline_reference
+//! \{
+
+namespace bl {
+namespace Pipeline {
+namespace Reference {
+
+// bl::Pipeline::Reference - CompOp Spans - SIMD Implementation [SSE2 & AVX2 & ASIMD]
+// ==================================================================================
+//
+// The SIMD implementation must produce exactly the same output as the scalar implementation in `compopgeneric_p.h`,
+// thus all calculations use 16-bit lanes and the same `div255()` approximation. Spans with a variable mask always use
+// 128-bit vectors as expanding a mask into pixels would require crossing 128-bit lanes.
+
+namespace {
+
+using namespace SIMD;
+
+#if BL_SIMD_WIDTH_I >= 256
+typedef Vec32xU8 VecWide;
+#else
+typedef Vec16xU8 VecWide;
+#endif
+
+#if BL_TARGET_ARCH_X86
+template<typename V> static BL_INLINE V broadcastU16(uint32_t x) noexcept { return make_u16<V>(uint16_t(x)); }
+template<typename V> static BL_INLINE V broadcastU32(uint32_t x) noexcept { return make_u32<V>(x); }
+#else
+template<typename V> static BL_INLINE V broadcastU16(uint32_t x) noexcept { return make128_u16<V>(uint16_t(x)); }
+template<typename V> static BL_INLINE V broadcastU32(uint32_t x) noexcept { return make128_u32<V>(x); }
+#endif
+
+// Helpers
+// -------
+
+template<typename V> static BL_INLINE V unpackLo(const V& x) noexcept { return interleave_lo_u8(x, make_zero<V>()); }
+template<typename V> static BL_INLINE V unpackHi(const V& x) noexcept { return interleave_hi_u8(x, make_zero<V>()); }
+
+// Matches `PixelOps::Scalar::div255()` in all 16-bit lanes.
+template<typename V>
+static BL_INLINE V div255(const V& x) noexcept {
+  V u = add_u16(x, broadcastU16<V>(0x80u));
+  return srli_u16<8>(add_u16(u, srli_u16<8>(u)));
+}
+
+// Returns `255 - alpha` of unpacked pixels in all 16-bit lanes of each pixel.
+template<typename V>
+static BL_INLINE V negAlpha(const V& x) noexcept {
+  return swizzle_u16<3, 3, 3, 3>(x) ^ broadcastU16<V>(0xFFu);
+}
+
+// Loads `kN` pixels, or a single pixel broadcasted to all lanes if the source is solid.
+template<typename V, size_t kN, bool kSolid>
+static BL_INLINE V loadSrc(const uint32_t* src) noexcept {
+  if (kSolid)
+    return broadcastU32<V>(src[0]);
+  else if (kN == 1)
+    return loadu_32<V>(src);
+  else
+    return loadu<V>(src);
+}
+
+// Loads `kN` mask values and expands each one to 4 16-bit lanes (so it matches unpacked pixels).
+template<typename V, size_t kN>
+static BL_INLINE void loadMask(const uint8_t* mask, V& mLo, V& mHi) noexcept {
+  if (kN == 1) {
+    mLo = broadcastU16<V>(mask[0]);
+    mHi = mLo;
+  }
+  else {
+    V m = loadu_32<V>(mask);
+    m = interleave_lo_u8(m, m);
+    m = interleave_lo_u16(m, m);
+    mLo = unpackLo(m);
+    mHi = unpackHi(m);
+  }
+}
+
+// Composition Operators
+// ---------------------
+
+template<uint32_t kCompOp>
+struct CompOpSimd {};
+
+template<>
+struct CompOpSimd<BL_COMP_OP_SRC_COPY> {
+  template<typename V>
+  static BL_INLINE V opaque(const V& d, const V& s) noexcept {
+    blUnused(d);
+    return s;
+  }
+
+  template<typename V>
+  static BL_INLINE V masked(const V& d, const V& s, const V& mLo, const V& mHi) noexcept {
+    V mask255 = broadcastU16<V>(0xFFu);
+    V lo = add_u16(mul_u16(unpackLo(d), mLo ^ mask255), mul_u16(unpackLo(s), mLo));
+    V hi = add_u16(mul_u16(unpackHi(d), mHi ^ mask255), mul_u16(unpackHi(s), mHi));
+    return packs_128_i16_u8(div255(lo), div255(hi));
+  }
+};
+
+template<>
+struct CompOpSimd<BL_COMP_OP_SRC_OVER> {
+  template<typename V>
+  static BL_INLINE V opUnpacked(const V& d, const V& sLo, const V& sHi) noexcept {
+    V dLo = div255(mul_u16(unpackLo(d), negAlpha(sLo)));
+    V dHi = div255(mul_u16(unpackHi(d), negAlpha(sHi)));
+    return packs_128_i16_u8(add_u16(sLo, dLo), add_u16(sHi, dHi));
+  }
+
+  template<typename V>
+  static BL_INLINE V opaque(const V& d, const V& s) noexcept {
+    return opUnpacked(d, unpackLo(s), unpackHi(s));
+  }
+
+  template<typename V>
+  static BL_INLINE V masked(const V& d, const V& s, const V& mLo, const V& mHi) noexcept {
+    return opUnpacked(d, div255(mul_u16(unpackLo(s), mLo)), div255(mul_u16(unpackHi(s), mHi)));
+  }
+};
+
+// Span Processing
+// ---------------
+
+template<typename V, size_t kN>
+struct PixelIO32 {
+  static BL_INLINE V load(const uint32_t* p) noexcept { return loadu<V>(p); }
+  static BL_INLINE void store(uint32_t* p, const V& v) noexcept { storeu(p, v); }
+};
+
+template<typename V>
+struct PixelIO32<V, 1> {
+  static BL_INLINE V load(const uint32_t* p) noexcept { return loadu_32<V>(p); }
+  static BL_INLINE void store(uint32_t* p, const V& v) noexcept { storeu_32(p, v); }
+};
+
+// Calls `op.run<V, kN>()` for each block of destination pixels - uses `VecWide` if allowed by `Op::kWide`, then 4
+// pixels at a time, and finally a single pixel at a time.
+template<typename Op>
+static BL_INLINE void compositeSpan(uint32_t* dst, size_t n, Op& op) noexcept {
+#if BL_SIMD_WIDTH_I >= 256
+  if (Op::kWide) {
+    while (n >= 8) {
+      PixelIO32<Vec32xU8, 8>::store(dst, op.template run<Vec32xU8, 8>(PixelIO32<Vec32xU8, 8>::load(dst)));
+      dst += 8;
+      n -= 8;
+    }
+  }
+#endif
+
+  while (n >= 4) {
+    PixelIO32<Vec16xU8, 4>::store(dst, op.template run<Vec16xU8, 4>(PixelIO32<Vec16xU8, 4>::load(dst)));
+    dst += 4;
+    n -= 4;
+  }
+
+  while (n) {
+    PixelIO32<Vec16xU8, 1>::store(dst, op.template run<Vec16xU8, 1>(PixelIO32<Vec16xU8, 1>::load(dst)));
+    dst++;
+    n--;
+  }
+}
+
+template<uint32_t kCompOp, bool kSolid>
+struct CSpanOpaqueOp {
+  static constexpr bool kWide = true;
+  const uint32_t* src;
+
+  template<typename V, size_t kN>
+  BL_INLINE V run(const V& d) noexcept {
+    V s = loadSrc<V, kN, kSolid>(src);
+    if (!kSolid)
+      src += kN;
+    return CompOpSimd<kCompOp>::opaque(d, s);
+  }
+};
+
+template<uint32_t kCompOp, bool kSolid>
+struct CSpanMaskedOp {
+  static constexpr bool kWide = true;
+  const uint32_t* src;
+  uint32_t m;
+
+  template<typename V, size_t kN>
+  BL_INLINE V run(const V& d) noexcept {
+    V s = loadSrc<V, kN, kSolid>(src);
+    V mv = broadcastU16<V>(m);
+    if (!kSolid)
+      src += kN;
+    return CompOpSimd<kCompOp>::masked(d, s, mv, mv);
+  }
+};
+
+template<uint32_t kCompOp, bool kSolid>
+struct VSpanOp {
+  static constexpr bool kWide = false;
+  const uint32_t* src;
+  const uint8_t* mask;
+
+  template<typename V, size_t kN>
+  BL_INLINE V run(const V& d) noexcept {
+    V s = loadSrc<V, kN, kSolid>(src);
+    V mLo, mHi;
+    loadMask<V, kN>(mask, mLo, mHi);
+
+    if (!kSolid)
+      src += kN;
+    mask += kN;
+    return CompOpSimd<kCompOp>::masked(d, s, mLo, mHi);
+  }
+};
+
+template<uint32_t kCompOp, bool kSolid>
+static void BL_CDECL compositeCSpan(uint32_t* dst, const uint32_t* src, size_t n, uint32_t m) noexcept {
+  if (m == 255) {
+    CSpanOpaqueOp<kCompOp, kSolid> op{src};
+    compositeSpan(dst, n, op);
+  }
+  else {
+    CSpanMaskedOp<kCompOp, kSolid> op{src, m};
+    compositeSpan(dst, n, op);
+  }
+}
+
+template<uint32_t kCompOp, bool kSolid>
+static void BL_CDECL compositeVSpan(uint32_t* dst, const uint32_t* src, const uint8_t* mask, size_t n) noexcept {
+  VSpanOp<kCompOp, kSolid> op{src, mask};
+  compositeSpan(dst, n, op);
+}
+
+static BL_INLINE void initCompOpSpanFuncsSimd(CompOpSpanFuncs& funcs) noexcept {
+  funcs.cspanSolid[BL_COMP_OP_SRC_OVER] = compositeCSpan<BL_COMP_OP_SRC_OVER, true>;
+  funcs.cspanSolid[BL_COMP_OP_SRC_COPY] = compositeCSpan<BL_COMP_OP_SRC_COPY, true>;
+  funcs.cspan[BL_COMP_OP_SRC_OVER] = compositeCSpan<BL_COMP_OP_SRC_OVER, false>;
+  funcs.cspan[BL_COMP_OP_SRC_COPY] = compositeCSpan<BL_COMP_OP_SRC_COPY, false>;
+  funcs.vspanSolid[BL_COMP_OP_SRC_OVER] = compositeVSpan<BL_COMP_OP_SRC_OVER, true>;
+  funcs.vspanSolid[BL_COMP_OP_SRC_COPY] = compositeVSpan<BL_COMP_OP_SRC_COPY, true>;
+  funcs.vspan[BL_COMP_OP_SRC_OVER] = compositeVSpan<BL_COMP_OP_SRC_OVER, false>;
+  funcs.vspan[BL_COMP_OP_SRC_COPY] = compositeVSpan<BL_COMP_OP_SRC_COPY, false>;
+}
+
+} // {anonymous}
+
+} // {Reference}
+} // {Pipeline}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_PIPELINE_REFERENCE_COMPOPSPANSIMDIMPL_P_H_INCLUDED
@@ -27,7 +27,7 @@ namespace {
 template<typename PixelT>
 struct FetchSolid {
   typedef PixelT PixelType;
-  enum : uint32_t { kIsSolid = 1 };
+  enum : uint32_t { kIsSolid = 1, kHasSpanPtr = 0 };
 
   PixelType _src;
 
@@ -72,8 +72,10 @@ struct FetchSolid {
 // Fetch - Non Solid
 // =================
 
+//! Fetchers that provide `fetchSpan()`, which returns a pointer to `n` contiguous PRGB32 pixels, set `kHasSpanPtr`
+//! to 1. Other fetchers must be called `n` times to fetch `n` pixels.
 struct FetchNonSolid {
-  enum : uint32_t { kIsSolid = 0 };
+  enum : uint32_t { kIsSolid = 0, kHasSpanPtr = 0 };
 };
 
 // Fetch - Pattern - Utilities
@@ -451,6 +453,30 @@ struct FetchPatternAffineCtx {
     return Vec::u32x2{uint32_t(x), uint32_t(y)};
   }
 
+  //! Returns X/Y indexes of a pixel at [offX, offY] relative to the current position.
+  //!
+  //! Unlike `index()`, which only handles offsets that can overflow the pattern once (nearest and bilinear), this
+  //! function handles any offset as repeated and reflected coordinates are wrapped into `[ox - rx + 1, ox]` first.
+  BL_INLINE Vec::u32x2 tapIndex(int32_t offX, int32_t offY) const noexcept {
+    return Vec::u32x2{tapIndexOf(int32_t(px_py.x >> 32) + offX, minx_miny.x, maxx_maxy.x, ox_oy.x, rx_ry.x),
+                      tapIndexOf(int32_t(px_py.y >> 32) + offY, minx_miny.y, maxx_maxy.y, ox_oy.y, rx_ry.y)};
+  }
+
+  static BL_INLINE uint32_t tapIndexOf(int32_t v, int32_t minV, int32_t maxV, int32_t o, int32_t r) noexcept {
+    // PAD (no repeat/reflect correction).
+    if (r == 0)
+      return uint32_t(blClamp(v, minV, maxV));
+
+    int32_t lo = o - r + 1;
+    int32_t d = (v - lo) % r;
+
+    if (d < 0)
+      d += r;
+
+    v = lo + d;
+    return uint32_t(v ^ (v >> 31));
+  }
+
   BL_INLINE void advanceX() noexcept {
     px_py += xx_xy;
 
@@ -474,6 +500,9 @@ struct FetchPatternAlignedBlit : public FetchNonSolid {
 
   static constexpr uint32_t kSrcBPP = FormatMetadata<kFormat>::kBPP;
 
+  //! PRGB32 pixels can be used directly by span functions as they are the same as fetched pixels.
+  enum : uint32_t { kHasSpanPtr = kFormat == FormatExt::kPRGB32 };
+
   const uint8_t* pixelPtr;
   intptr_t stride;
 
@@ -533,6 +562,12 @@ struct FetchPatternAlignedBlit : public FetchNonSolid {
     pixelPtr += kSrcBPP;
     return pixel;
   }
+
+  BL_INLINE const uint32_t* fetchSpan(size_t n) noexcept {
+    const uint32_t* span = reinterpret_cast<const uint32_t*>(pixelPtr);
+    pixelPtr += n * kSrcBPP;
+    return span;
+  }
 };
 
 template<typename DstPixelT, FormatExt kFormat, typename CtxX>
@@ -795,6 +830,73 @@ struct FetchPatternAffineBIAny : public FetchPatternAffineNNBase<DstPixelT, kFor
   }
 };
 
+//! Calculates bicubic (Catmull-Rom) weights of pixels at [-1, 0, 1, 2] from 8-bit fraction `t`.
+//!
+//! The sum of all weights is always 256, however, outer weights can be negative, so the result must be clamped.
+static BL_INLINE void bicubicWeights(int32_t w[4], uint32_t t) noexcept {
+  int32_t t1 = int32_t(t);
+  int32_t t2 = t1 * t1;
+  int32_t t3 = t2 * t1;
+
+  w[0] = (-t3 + t2 * 512 - t1 * 65536 + 65536) >> 17;
+  w[2] = (-3 * t3 + t2 * 1024 + t1 * 65536 + 65536) >> 17;
+  w[3] = (t3 - t2 * 256 + 65536) >> 17;
+  w[1] = 256 - w[0] - w[2] - w[3];
+}
+
+template<typename DstPixelT, FormatExt kFormat>
+struct FetchPatternAffineBCAny : public FetchPatternAffineNNBase<DstPixelT, kFormat> {
+  typedef DstPixelT PixelType;
+
+  static constexpr uint32_t kSrcBPP = FormatMetadata<kFormat>::kBPP;
+  static constexpr uint32_t kChannels = uint32_t(sizeof(PixelType::p));
+
+  using FetchPatternAffineNNBase<DstPixelT, kFormat>::_pixelData;
+  using FetchPatternAffineNNBase<DstPixelT, kFormat>::_stride;
+  using FetchPatternAffineNNBase<DstPixelT, kFormat>::_ctx;
+
+  BL_INLINE PixelType fetch() noexcept {
+    int32_t wx[4];
+    int32_t wy[4];
+
+    bicubicWeights(wx, _ctx.fracX());
+    bicubicWeights(wy, _ctx.fracY());
+
+    Vec::u32x2 index[4];
+    for (uint32_t i = 0; i < 4; i++)
+      index[i] = _ctx.tapIndex(int32_t(i) - 1, int32_t(i) - 1);
+
+    _ctx.advanceX();
+
+    int32_t acc[kChannels];
+    for (uint32_t c = 0; c < kChannels; c++)
+      acc[c] = 0x8000;
+
+    for (uint32_t y = 0; y < 4; y++) {
+      const uint8_t* line = _pixelData + intptr_t(index[y].y) * _stride;
+
+      int32_t row[kChannels] {};
+      for (uint32_t x = 0; x < 4; x++) {
+        uint32_t p = uint32_t(PixelIO<PixelType, kFormat>::fetch(line + size_t(index[x].x) * kSrcBPP).p);
+        for (uint32_t c = 0; c < kChannels; c++)
+          row[c] += int32_t((p >> (c * 8u)) & 0xFFu) * wx[x];
+      }
+
+      for (uint32_t c = 0; c < kChannels; c++)
+        acc[c] += row[c] * wy[y];
+    }
+
+    // The last channel is alpha, color channels of premultiplied pixels cannot exceed it.
+    uint32_t a = IntOps::clampToByte(acc[kChannels - 1] >> 16);
+    uint32_t p = a << ((kChannels - 1u) * 8u);
+
+    for (uint32_t c = 0; c < kChannels - 1u; c++)
+      p |= blMin<uint32_t>(IntOps::clampToByte(acc[c] >> 16), a) << (c * 8u);
+
+    return PixelType::fromValue(p);
+  }
+};
+
 // Fetch - Pattern - Dispatch
 // ==========================
 
@@ -871,6 +973,11 @@ struct FetchPatternDispatch<FetchType::kPatternAffineBIOpt, DstPixelT, kSrcForma
   using Fetch = FetchPatternAffineBIAny<DstPixelT, kSrcFormat>;
 };
 
+template<typename DstPixelT, FormatExt kSrcFormat>
+struct FetchPatternDispatch<FetchType::kPatternAffineBCAny, DstPixelT, kSrcFormat> {
+  using Fetch = FetchPatternAffineBCAny<DstPixelT, kSrcFormat>;
+};
+
 // Fetch - Gradient - Base
 // =======================
 
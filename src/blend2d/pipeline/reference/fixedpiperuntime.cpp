@@ -6,8 +6,10 @@
 #include "../../api-build_p.h"
 #include "../../compopsimplifyimpl_p.h"
 #include "../../pipeline/reference/compopgeneric_p.h"
+#include "../../pipeline/reference/compopspan_p.h"
 #include "../../pipeline/reference/fillgeneric_p.h"
 #include "../../pipeline/reference/fixedpiperuntime_p.h"
+#include "../../support/lookuptable_p.h"
 #include "../../support/wrap_p.h"
 
 namespace bl {
@@ -17,6 +19,7 @@ namespace Pipeline {
 // ==============================
 
 Wrap<PipeStaticRuntime> PipeStaticRuntime::_global;
+Reference::CompOpSpanFuncs Reference::compOpSpanFuncs;
 
 // FixedPipelineRuntime - Get
 // ==========================
@@ -125,6 +128,7 @@ static constexpr FillPatternFuncTable get_fill_pattern_func_table() noexcept {
     get_fill_pattern_func<FillType::kBoxA, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineNNOpt  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kBoxA, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIAny  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kBoxA, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIOpt  , kSrcFormat>(),
+    get_fill_pattern_func<FillType::kBoxA, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBCAny  , kSrcFormat>(),
 
     get_fill_pattern_func<FillType::kMask, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAlignedBlit  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kMask, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAlignedPad   , kSrcFormat>(),
@@ -140,6 +144,7 @@ static constexpr FillPatternFuncTable get_fill_pattern_func_table() noexcept {
     get_fill_pattern_func<FillType::kMask, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineNNOpt  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kMask, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIAny  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kMask, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIOpt  , kSrcFormat>(),
+    get_fill_pattern_func<FillType::kMask, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBCAny  , kSrcFormat>(),
 
     get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAlignedBlit  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAlignedPad   , kSrcFormat>(),
@@ -154,10 +159,62 @@ static constexpr FillPatternFuncTable get_fill_pattern_func_table() noexcept {
     get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineNNAny  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineNNOpt  , kSrcFormat>(),
     get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIAny  , kSrcFormat>(),
-    get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIOpt  , kSrcFormat>()
+    get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBIOpt  , kSrcFormat>(),
+    get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBCAny  , kSrcFormat>()
   }};
 }
 
+// Bicubic pattern fetch is not implemented by the JIT compiler, so the reference pipeline provides it for all
+// operators. SrcOver and SrcCopy use the tables above, other operators use `CompOp_Generic_Op`.
+struct FillBicubicFuncTable {
+  static constexpr uint32_t kFillTypeCount = uint32_t(FillType::_kMaxValue);
+
+  FillFunc funcs[kFillTypeCount];
+};
+
+template<FormatExt kDstFormat, uint32_t kDstBPP, typename CompOp, FormatExt kSrcFormat, bool kGeneric>
+struct FillBicubicFuncTableGen {
+  static constexpr FillBicubicFuncTable get() noexcept {
+    return FillBicubicFuncTable{{
+      get_fill_pattern_func<FillType::kBoxA    , kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBCAny, kSrcFormat>(),
+      get_fill_pattern_func<FillType::kMask    , kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBCAny, kSrcFormat>(),
+      get_fill_pattern_func<FillType::kAnalytic, kDstFormat, kDstBPP, CompOp, FetchType::kPatternAffineBCAny, kSrcFormat>()
+    }};
+  }
+};
+
+// Operators that have their own tables or are always simplified to another operator are not instantiated.
+template<FormatExt kDstFormat, uint32_t kDstBPP, typename CompOp, FormatExt kSrcFormat>
+struct FillBicubicFuncTableGen<kDstFormat, kDstBPP, CompOp, kSrcFormat, false> {
+  static constexpr FillBicubicFuncTable get() noexcept { return FillBicubicFuncTable{{nullptr, nullptr, nullptr}}; }
+};
+
+static constexpr bool isGenericBicubicCompOp(CompOpExt compOp) noexcept {
+  return compOp != CompOpExt::kSrcOver &&
+         compOp != CompOpExt::kSrcCopy &&
+         compOp != CompOpExt::kDstCopy &&
+         compOp != CompOpExt::kClear &&
+         compOp != CompOpExt::kAlphaInv;
+}
+
+template<FormatExt kDstFormat, uint32_t kDstBPP, typename PixelT, FormatExt kSrcFormat, size_t... CompOps>
+static constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> get_fill_bicubic_func_tables(Internal::index_sequence<CompOps...>) noexcept {
+  return LookupTable<FillBicubicFuncTable, kCompOpExtCount>{{
+    FillBicubicFuncTableGen<
+      kDstFormat,
+      kDstBPP,
+      Reference::CompOp_Generic_Op<PixelT, uint32_t(CompOps)>,
+      kSrcFormat,
+      isGenericBicubicCompOp(CompOpExt(CompOps))
+    >::get()...
+  }};
+}
+
+template<FormatExt kDstFormat, uint32_t kDstBPP, typename PixelT, FormatExt kSrcFormat>
+static constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> get_fill_bicubic_func_tables() noexcept {
+  return get_fill_bicubic_func_tables<kDstFormat, kDstBPP, PixelT, kSrcFormat>(Internal::make_index_sequence<kCompOpExtCount>{});
+}
+
 template<FormatExt kDstFormat, uint32_t kDstBPP, typename CompOp>
 static constexpr FillGradientFuncTable get_fill_gradient_func_table() noexcept {
   return FillGradientFuncTable{{
@@ -241,6 +298,21 @@ static const constexpr FillGradientFuncTable a8_fill_gradient_funcs[2] = {
   get_fill_gradient_func_table<FormatExt::kA8, 1, Reference::CompOp_SrcCopy_Op<Reference::Pixel::P8_Alpha>>()
 };
 
+static const constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> prgb32_fill_bicubic_prgb32_funcs =
+  get_fill_bicubic_func_tables<FormatExt::kPRGB32, 4, Reference::Pixel::P32_A8R8G8B8, FormatExt::kPRGB32>();
+
+static const constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> prgb32_fill_bicubic_xrgb32_funcs =
+  get_fill_bicubic_func_tables<FormatExt::kPRGB32, 4, Reference::Pixel::P32_A8R8G8B8, FormatExt::kXRGB32>();
+
+static const constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> prgb32_fill_bicubic_a8_funcs =
+  get_fill_bicubic_func_tables<FormatExt::kPRGB32, 4, Reference::Pixel::P32_A8R8G8B8, FormatExt::kA8>();
+
+static const constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> a8_fill_bicubic_prgb32_funcs =
+  get_fill_bicubic_func_tables<FormatExt::kA8, 1, Reference::Pixel::P8_Alpha, FormatExt::kPRGB32>();
+
+static const constexpr LookupTable<FillBicubicFuncTable, kCompOpExtCount> a8_fill_bicubic_a8_funcs =
+  get_fill_bicubic_func_tables<FormatExt::kA8, 1, Reference::Pixel::P8_Alpha, FormatExt::kA8>();
+
 static BLResult BL_CDECL blPipeGenRuntimeGet(PipeRuntime* self_, uint32_t signature, DispatchData* dispatchData, PipeLookupCache* cache) noexcept {
   blUnused(self_);
 
@@ -311,6 +383,45 @@ static BLResult BL_CDECL blPipeGenRuntimeGet(PipeRuntime* self_, uint32_t signat
         break;
     }
   }
+  else if (fetchType == FetchType::kPatternAffineBCAny) {
+    uint32_t compOpIndex = uint32_t(compOp);
+    switch (s.dstFormat()) {
+      case FormatExt::kPRGB32:
+      case FormatExt::kXRGB32: {
+        switch (s.srcFormat()) {
+          case FormatExt::kPRGB32:
+            fillFunc = prgb32_fill_bicubic_prgb32_funcs[compOpIndex].funcs[fillTypeIdx];
+            break;
+          case FormatExt::kXRGB32:
+            fillFunc = prgb32_fill_bicubic_xrgb32_funcs[compOpIndex].funcs[fillTypeIdx];
+            break;
+          case FormatExt::kA8:
+            fillFunc = prgb32_fill_bicubic_a8_funcs[compOpIndex].funcs[fillTypeIdx];
+            break;
+          default:
+            break;
+        }
+        break;
+      }
+
+      case FormatExt::kA8: {
+        switch (s.srcFormat()) {
+          case FormatExt::kPRGB32:
+            fillFunc = a8_fill_bicubic_prgb32_funcs[compOpIndex].funcs[fillTypeIdx];
+            break;
+          case FormatExt::kA8:
+            fillFunc = a8_fill_bicubic_a8_funcs[compOpIndex].funcs[fillTypeIdx];
+            break;
+          default:
+            break;
+        }
+        break;
+      }
+
+      default:
+        break;
+    }
+  }
 
   if (!fillFunc)
     return blTraceError(BL_ERROR_NOT_IMPLEMENTED);
@@ -346,7 +457,26 @@ PipeStaticRuntime::~PipeStaticRuntime() noexcept {}
 // ===========================================
 
 void blStaticPipelineRtInit(BLRuntimeContext* rt) noexcept {
+  // Maybe unused, if no architecture dependent optimizations are available.
   blUnused(rt);
 
+  bl::Pipeline::Reference::CompOpSpanFuncs& spanFuncs = bl::Pipeline::Reference::compOpSpanFuncs;
+  memset(&spanFuncs, 0, sizeof(spanFuncs));
+
+#if defined(BL_BUILD_OPT_SSE2)
+  if (blRuntimeHasSSE2(rt))
+    bl::Pipeline::Reference::initCompOpSpanFuncs_SSE2(spanFuncs);
+#endif
+
+#if defined(BL_BUILD_OPT_AVX2)
+  if (blRuntimeHasAVX2(rt))
+    bl::Pipeline::Reference::initCompOpSpanFuncs_AVX2(spanFuncs);
+#endif
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+  if (blRuntimeHasASIMD(rt))
+    bl::Pipeline::Reference::initCompOpSpanFuncs_ASIMD(spanFuncs);
+#endif
+
   bl::Pipeline::PipeStaticRuntime::_global.init();
 }
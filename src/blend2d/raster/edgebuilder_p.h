@@ -1029,6 +1029,64 @@ public:
     return addFromSource(source, source.mustClose());
   }
 
+  //! Adds a part of a figure that has been split across several edge builders. The part starts at `start`, continues
+  //! by segments of `view` until the figure or `view` ends, and is closed by a line to `closeTo` if it's not null.
+  //! Both `start` and `closeTo` are in path coordinates. The number of consumed commands is stored to `consumedOut`.
+  BL_INLINE BLResult addFigurePart(const BLPathView& view, const BLPoint& start, const BLPoint* closeTo, const BLMatrix2D& transform, BLTransformType transformType, size_t* consumedOut) noexcept {
+    if (transformType <= BL_TRANSFORM_TYPE_SCALE)
+      return _addFigurePartScale(view, start, closeTo, transform, consumedOut);
+    else
+      return _addFigurePartAffine(view, start, closeTo, transform, consumedOut);
+  }
+
+  BL_NOINLINE BLResult _addFigurePartScale(BLPathView view, const BLPoint& start, const BLPoint* closeTo, const BLMatrix2D& transform, size_t* consumedOut) noexcept {
+    EdgeSourcePathScale source(EdgeTransformScale(transform), view);
+    return addFigurePartFromSource(source, start, closeTo, consumedOut);
+  }
+
+  BL_NOINLINE BLResult _addFigurePartAffine(BLPathView view, const BLPoint& start, const BLPoint* closeTo, const BLMatrix2D& transform, size_t* consumedOut) noexcept {
+    EdgeSourcePathAffine source(EdgeTransformAffine(transform), view);
+    return addFigurePartFromSource(source, start, closeTo, consumedOut);
+  }
+
+  template<class Source>
+  BL_INLINE BLResult addFigurePartFromSource(Source& source, const BLPoint& start, const BLPoint* closeTo, size_t* consumedOut) noexcept {
+    const uint8_t* cmdStart = source._cmdPtr;
+
+    State state;
+    source._transform.apply(state.a, start);
+    state.aFlags = blClipCalcXYFlags(state.a, _clipBoxD);
+
+    for (;;) {
+      if (source.isLineTo()) {
+        BLPoint b;
+        source.nextLineTo(b);
+        BL_PROPAGATE(lineTo(source, state, b));
+      }
+      else if (source.isQuadTo()) {
+        BL_PROPAGATE(quadTo(source, state));
+      }
+      else if (source.isCubicTo()) {
+        BL_PROPAGATE(cubicTo(source, state));
+      }
+      else if (source.isConicTo()) {
+        BL_PROPAGATE(conicTo(source, state));
+      }
+      else {
+        break;
+      }
+    }
+
+    if (closeTo) {
+      BLPoint b;
+      source._transform.apply(b, *closeTo);
+      BL_PROPAGATE(lineTo(source, state, b));
+    }
+
+    *consumedOut = size_t(source._cmdPtr - cmdStart);
+    return BL_SUCCESS;
+  }
+
   template<class Source>
   BL_INLINE BLResult addFromSource(Source& source, bool closed) noexcept {
     State state;
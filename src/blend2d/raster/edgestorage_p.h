@@ -67,6 +67,18 @@ struct EdgeList {
       _last = item;
     }
   }
+
+  //! Appends all items of `other` list to this list.
+  BL_INLINE void appendList(const EdgeList<CoordT>& other) noexcept {
+    if (other.empty())
+      return;
+
+    if (empty())
+      _first = other._first;
+    else
+      _last->next = other._first;
+    _last = other._last;
+  }
 };
 
 template<typename CoordT>
@@ -415,10 +415,7 @@ static BL_INLINE bool initNonSolidFetchData(
       BLImageImpl* imageI = ImageInternal::getImpl(image);
 
       fetchData->extra.format = uint8_t(imageI->format);
-      fetchData->initImageSource(imageI, area);
-
-      fetchData->signature = Pipeline::FetchUtils::initPatternAffine(
-        fetchData->pipelineData.pattern, extendMode, quality, uint32_t(imageI->depth) / 8u, *transform);
+      fetchData->setupPatternAffineMipmapped(imageI, area, extendMode, quality, *transform);
       break;
     }
 
@@ -1013,6 +1010,9 @@ static BL_INLINE void releaseBatchFetchData(BLRasterContextImpl* ctxI, RenderCom
 
         if (command.retainsMaskImageData())
           ImageInternal::releaseImpl<RCMode::kMaybe>(command._payload.boxMaskA.maskImageI.ptr);
+
+        if (command.retainsEdgeCache())
+          PathInternal::releaseEdgeCache(command._payload.analytic.edgeCache.ptr);
       }
       commandData += IntOps::bitSizeOf<BLBitWord>();
     }
@@ -1652,32 +1652,10 @@ static BLResult BL_CDECL saveImpl(BLContextImpl* baseImpl, BLContextCookie* cook
   return BL_SUCCESS;
 }
 
-static BLResult BL_CDECL restoreImpl(BLContextImpl* baseImpl, const BLContextCookie* cookie) noexcept {
-  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+// Restores `n` top-most states - the caller must verify that there is at least `n` states to restore.
+static void restoreStates(BLRasterContextImpl* ctxI, uint32_t n) noexcept {
   SavedState* savedState = ctxI->savedState;
 
-  if (BL_UNLIKELY(!savedState))
-    return blTraceError(BL_ERROR_NO_STATES_TO_RESTORE);
-
-  // By default there would be only one state to restore if `cookie` was not provided.
-  uint32_t n = 1;
-
-  if (cookie) {
-    // Verify context origin.
-    if (BL_UNLIKELY(cookie->data[0] != ctxI->contextOriginId))
-      return blTraceError(BL_ERROR_NO_MATCHING_COOKIE);
-
-    // Verify cookie payload and get the number of states we have to restore (if valid).
-    n = getNumStatesToRestore(savedState, cookie->data[1]);
-    if (BL_UNLIKELY(n == 0))
-      return blTraceError(BL_ERROR_NO_MATCHING_COOKIE);
-  }
-  else {
-    // A state that has a `stateId` assigned cannot be restored without a matching cookie.
-    if (savedState->stateId != Traits::maxValue<uint64_t>())
-      return blTraceError(BL_ERROR_NO_MATCHING_COOKIE);
-  }
-
   ContextFlags kPreservedFlags = ContextFlags::kPreservedFlags | ContextFlags::kSharedStateAllFlags;
   ContextFlags contextFlagsToKeep = ctxI->contextFlags & kPreservedFlags;
   ctxI->internalState.savedStateCount -= n;
@@ -1756,6 +1734,44 @@ static BLResult BL_CDECL restoreImpl(BLContextImpl* baseImpl, const BLContextCoo
   }
 
   ctxI->contextFlags = (ctxI->contextFlags & ~kPreservedFlags) | contextFlagsToKeep;
+}
+
+static BLResult BL_CDECL restoreImpl(BLContextImpl* baseImpl, const BLContextCookie* cookie) noexcept {
+  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+  SavedState* savedState = ctxI->savedState;
+
+  if (BL_UNLIKELY(!savedState))
+    return blTraceError(BL_ERROR_NO_STATES_TO_RESTORE);
+
+  // By default there would be only one state to restore if `cookie` was not provided.
+  uint32_t n = 1;
+
+  if (cookie) {
+    // Verify context origin.
+    if (BL_UNLIKELY(cookie->data[0] != ctxI->contextOriginId))
+      return blTraceError(BL_ERROR_NO_MATCHING_COOKIE);
+
+    // Verify cookie payload and get the number of states we have to restore (if valid).
+    n = getNumStatesToRestore(savedState, cookie->data[1]);
+    if (BL_UNLIKELY(n == 0))
+      return blTraceError(BL_ERROR_NO_MATCHING_COOKIE);
+  }
+  else {
+    // A state that has a `stateId` assigned cannot be restored without a matching cookie.
+    if (savedState->stateId != Traits::maxValue<uint64_t>())
+      return blTraceError(BL_ERROR_NO_MATCHING_COOKIE);
+  }
+
+  // States saved before the current group has started can only be restored by `endGroup()`.
+  if (LayerState* layer = ctxI->layerState) {
+    SavedState* state = savedState;
+    for (uint32_t i = 0; i < n; i++, state = state->prevState) {
+      if (BL_UNLIKELY(state == layer->savedState))
+        return blTraceError(BL_ERROR_NO_STATES_TO_RESTORE);
+    }
+  }
+
+  restoreStates(ctxI, n);
   return BL_SUCCESS;
 }
 
@@ -1829,6 +1845,13 @@ static BLResult BL_CDECL setHintImpl(BLContextImpl* baseImpl, BLContextHint hint
       ctxI->internalState.hints.patternQuality = uint8_t(value);
       return BL_SUCCESS;
 
+    case BL_CONTEXT_HINT_GLYPH_POSITIONING:
+      if (BL_UNLIKELY(value > BL_GLYPH_POSITIONING_MAX_VALUE))
+        return blTraceError(BL_ERROR_INVALID_VALUE);
+
+      ctxI->internalState.hints.glyphPositioning = uint8_t(value);
+      return BL_SUCCESS;
+
     default:
       return blTraceError(BL_ERROR_INVALID_VALUE);
   }
@@ -1840,15 +1863,18 @@ static BLResult BL_CDECL setHintsImpl(BLContextImpl* baseImpl, const BLContextHi
   uint8_t renderingQuality = hints->renderingQuality;
   uint8_t patternQuality = hints->patternQuality;
   uint8_t gradientQuality = hints->gradientQuality;
+  uint8_t glyphPositioning = hints->glyphPositioning;
 
   if (BL_UNLIKELY(renderingQuality > BL_RENDERING_QUALITY_MAX_VALUE ||
                   patternQuality   > BL_PATTERN_QUALITY_MAX_VALUE   ||
-                  gradientQuality  > BL_GRADIENT_QUALITY_MAX_VALUE  ))
+                  gradientQuality  > BL_GRADIENT_QUALITY_MAX_VALUE  ||
+                  glyphPositioning > BL_GLYPH_POSITIONING_MAX_VALUE ))
     return blTraceError(BL_ERROR_INVALID_VALUE);
 
   ctxI->internalState.hints.renderingQuality = renderingQuality;
   ctxI->internalState.hints.patternQuality = patternQuality;
   ctxI->internalState.hints.gradientQuality = gradientQuality;
+  ctxI->internalState.hints.glyphPositioning = glyphPositioning;
   return BL_SUCCESS;
 }
 
@@ -2289,6 +2315,12 @@ static BLResult BL_CDECL restoreClippingImpl(BLContextImpl* baseImpl) noexcept {
       ctxI->syncWorkData.clipMode = state->clipMode;
       ctxI->contextFlags &= ~(ContextFlags::kNoClipRect | ContextFlags::kWeakStateClip | ContextFlags::kSharedStateFill);
       ctxI->contextFlags |= (state->prevContextFlags & ContextFlags::kNoClipRect);
+
+      // The state saved by `beginGroup()` holds the clipping of the outer destination, which can be larger than
+      // the layer of the group.
+      LayerState* layer = ctxI->layerState;
+      if (layer && layer->savedState == state)
+        clipToFinalBox(ctxI, BLBox(layer->boxI.x0, layer->boxI.y0, layer->boxI.x1, layer->boxI.y1));
     }
     else {
       // If there is no state saved it means that we have to restore clipping to
@@ -2301,6 +2333,198 @@ static BLResult BL_CDECL restoreClippingImpl(BLContextImpl* baseImpl) noexcept {
   return BL_SUCCESS;
 }
 
+// bl::RasterEngine - ContextImpl - Frontend - Group Management
+// =============================================================
+
+static BL_INLINE BLBoxI calculateGroupBox(BLRasterContextImpl* ctxI, const BLRect* bounds) noexcept {
+  const BLBoxI& clipBoxI = ctxI->finalClipBoxI();
+
+  if (blTestFlag(ctxI->contextFlags, ContextFlags::kNoClipRect | ContextFlags::kNoMetaTransform | ContextFlags::kNoUserTransform))
+    return BLBoxI(0, 0, 0, 0);
+
+  if (!bounds)
+    return clipBoxI;
+
+  BLBox b = TransformInternal::mapBox(ctxI->finalTransform(), BLBox(bounds->x, bounds->y, bounds->x + bounds->w, bounds->y + bounds->h));
+
+  // Intersect in double precision first so the result always fits into integers (NaNs produce an empty box).
+  double x0 = blMax(Math::floor(b.x0), double(clipBoxI.x0));
+  double y0 = blMax(Math::floor(b.y0), double(clipBoxI.y0));
+  double x1 = blMin(Math::ceil(b.x1), double(clipBoxI.x1));
+  double y1 = blMin(Math::ceil(b.y1), double(clipBoxI.y1));
+
+  if (!(x0 < x1 && y0 < y1))
+    return BLBoxI(0, 0, 0, 0);
+
+  return BLBoxI(int(x0), int(y0), int(x1), int(y1));
+}
+
+// Makes the destination point to either the layer of the group or to the previous destination, which must be
+// called after all pending commands have been flushed (workers copy `dstData` when a batch starts).
+static BL_INLINE void retargetDestination(BLRasterContextImpl* ctxI, const BLImageData& dstData) noexcept {
+  uint32_t prevFormat = ctxI->dstData.format;
+
+  ctxI->dstData = dstData;
+  ctxI->syncWorkData.initContextData(dstData, ctxI->syncWorkData.ctxData.pixelOrigin);
+
+  if (prevFormat != dstData.format)
+    onAfterCompOpChanged(ctxI);
+}
+
+static BLResult createGroupLayer(BLRasterContextImpl* ctxI, LayerState* layer) noexcept {
+  const BLBoxI& boxI = layer->boxI;
+  BLFormat format = ctxI->dstData.format == BL_FORMAT_A8 ? BL_FORMAT_A8 : BL_FORMAT_PRGB32;
+
+  BL_PROPAGATE(blImageCreate(&layer->layerImage, boxI.x1 - boxI.x0, boxI.y1 - boxI.y0, format));
+
+  BLImageData layerData;
+  BL_PROPAGATE(blImageMakeMutable(&layer->layerImage, &layerData));
+
+  // The layer must be transparent initially.
+  uint32_t bytesPerPixel = blFormatInfo[format].depth / 8u;
+  size_t rowSize = size_t(layerData.size.w) * bytesPerPixel;
+  uint8_t* layerPixels = static_cast<uint8_t*>(layerData.pixelData);
+
+  for (int y = 0; y < layerData.size.h; y++, layerPixels += layerData.stride)
+    memset(layerPixels, 0, rowSize);
+
+  // Offset the pixel pointer so `boxI.x0` and `boxI.y0` map to the first pixel of the layer.
+  BLImageData dstData = ctxI->dstData;
+  dstData.pixelData = static_cast<uint8_t*>(layerData.pixelData) - intptr_t(boxI.y0) * layerData.stride
+                                                                 - intptr_t(boxI.x0) * intptr_t(bytesPerPixel);
+  dstData.stride = layerData.stride;
+  dstData.format = format;
+
+  retargetDestination(ctxI, dstData);
+  return BL_SUCCESS;
+}
+
+// Resets both meta and user transformations to identity so the layer can be blitted in device coordinates.
+static void resetTransformsToIdentity(BLRasterContextImpl* ctxI) noexcept {
+  constexpr ContextFlags kUserAndMetaFlags = ContextFlags::kWeakStateMetaTransform | ContextFlags::kWeakStateUserTransform;
+
+  // See `userToMetaImpl()` - the state must hold the current `metaTransform` and `userTransform`.
+  if (blTestFlag(ctxI->contextFlags, kUserAndMetaFlags)) {
+    SavedState* state = ctxI->savedState;
+    state->altTransform = ctxI->metaTransform();
+
+    if (blTestFlag(ctxI->contextFlags, ContextFlags::kWeakStateUserTransform))
+      state->userTransform = ctxI->userTransform();
+  }
+
+  ctxI->internalState.metaTransform.reset();
+  ctxI->internalState.userTransform.reset();
+  ctxI->internalState.finalTransform.reset();
+  updateMetaTransformFixed(ctxI);
+  updateFinalTransformFixed(ctxI);
+
+  ctxI->internalState.finalTransformFixedType = BL_TRANSFORM_TYPE_SCALE;
+  ctxI->internalState.metaTransformFixedType = BL_TRANSFORM_TYPE_SCALE;
+  ctxI->internalState.metaTransformType = BL_TRANSFORM_TYPE_TRANSLATE;
+  ctxI->internalState.finalTransformType = BL_TRANSFORM_TYPE_TRANSLATE;
+  ctxI->setTranslationI(BLPointI(0, 0));
+
+  ctxI->contextFlags &= ~(kUserAndMetaFlags | ContextFlags::kNoMetaTransform | ContextFlags::kNoUserTransform | ContextFlags::kSharedStateAllFlags);
+  ctxI->contextFlags |= ContextFlags::kInfoIntegralTranslation;
+}
+
+static BLResult compositeGroupLayer(BLRasterContextImpl* ctxI, LayerState* layer) noexcept {
+  BL_PROPAGATE(saveImpl(ctxI, nullptr));
+
+  setCompOpImpl(ctxI, layer->compOp);
+  setGlobalAlphaImpl(ctxI, ctxI->globalAlphaD() * layer->opacity);
+  resetTransformsToIdentity(ctxI);
+
+  BLPointI origin(layer->boxI.x0, layer->boxI.y0);
+  BLResult result = ctxI->virt->blitImageI(ctxI, &origin, &layer->layerImage, nullptr);
+
+  restoreStates(ctxI, 1);
+  return result;
+}
+
+static void destroyLayerState(BLRasterContextImpl* ctxI, LayerState* layer) noexcept {
+  blImageDestroy(&layer->layerImage);
+  ctxI->freeLayerState(layer);
+}
+
+static BLResult BL_CDECL beginGroupImpl(BLContextImpl* baseImpl, double opacity, BLCompOp compOp, const BLRect* bounds) noexcept {
+  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+
+  if (BL_UNLIKELY(Math::isNaN(opacity) || uint32_t(compOp) > BL_COMP_OP_MAX_VALUE))
+    return blTraceError(BL_ERROR_INVALID_VALUE);
+
+  BLBoxI boxI = calculateGroupBox(ctxI, bounds);
+  bool hasLayer = boxI.x0 < boxI.x1 && boxI.y0 < boxI.y1;
+
+  // Everything rendered so far must go to the current destination.
+  if (hasLayer)
+    BL_PROPAGATE(flushImpl(ctxI, BL_CONTEXT_FLUSH_SYNC));
+
+  LayerState* layer = ctxI->allocLayerState();
+  if (BL_UNLIKELY(!layer))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  BLResult result = saveImpl(ctxI, nullptr);
+  if (BL_UNLIKELY(result != BL_SUCCESS)) {
+    ctxI->freeLayerState(layer);
+    return result;
+  }
+
+  layer->prevLayer = ctxI->layerState;
+  layer->savedState = ctxI->savedState;
+  layer->prevDstData = ctxI->dstData;
+  layer->boxI = hasLayer ? boxI : BLBoxI(0, 0, 0, 0);
+  layer->opacity = blClamp(opacity, 0.0, 1.0);
+  layer->compOp = compOp;
+  blImageInit(&layer->layerImage);
+
+  if (hasLayer) {
+    result = createGroupLayer(ctxI, layer);
+    if (BL_UNLIKELY(result != BL_SUCCESS)) {
+      restoreStates(ctxI, 1);
+      destroyLayerState(ctxI, layer);
+      return result;
+    }
+  }
+
+  // The group starts with the default global alpha and composition operator - the outer ones are only applied once
+  // when the layer is composited by `endGroup()`.
+  setGlobalAlphaImpl(ctxI, 1.0);
+  setCompOpImpl(ctxI, BL_COMP_OP_SRC_OVER);
+
+  ctxI->layerState = layer;
+  return clipToFinalBox(ctxI, BLBox(layer->boxI.x0, layer->boxI.y0, layer->boxI.x1, layer->boxI.y1));
+}
+
+static BLResult BL_CDECL endGroupImpl(BLContextImpl* baseImpl) noexcept {
+  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+  LayerState* layer = ctxI->layerState;
+
+  if (BL_UNLIKELY(!layer))
+    return blTraceError(BL_ERROR_INVALID_STATE);
+
+  bool hasLayer = layer->boxI.x0 < layer->boxI.x1;
+  if (hasLayer) {
+    BL_PROPAGATE(flushImpl(ctxI, BL_CONTEXT_FLUSH_SYNC));
+    retargetDestination(ctxI, layer->prevDstData);
+  }
+
+  // Restore all states saved within the group including the state saved by `beginGroup()`.
+  uint32_t n = 1;
+  for (SavedState* state = ctxI->savedState; state != layer->savedState; state = state->prevState)
+    n++;
+
+  restoreStates(ctxI, n);
+  ctxI->layerState = layer->prevLayer;
+
+  BLResult result = BL_SUCCESS;
+  if (hasLayer)
+    result = compositeGroupLayer(ctxI, layer);
+
+  destroyLayerState(ctxI, layer);
+  return result;
+}
+
 // bl::RasterEngine - ContextImpl - Mask & Blit Utilities
 // ======================================================
 
@@ -2484,6 +2708,100 @@ static BL_INLINE BLResult enqueueCommandWithFillJob(
   });
 }
 
+// Enqueues a fill of a large path split into shards, which are built by several workers concurrently. Shards are
+// split at on-curve points, thus their sizes are only approximately equal.
+static BL_NOINLINE BLResult enqueueCommandWithFillPathShards(
+    BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds,
+    const BLPoint& originFixed, const BLPath* path, uint32_t shardCount) noexcept {
+
+  constexpr uint8_t kNoCoord = kInvalidQuantizedCoordinate;
+
+  WorkerManager& mgr = ctxI->workerMgr();
+  RenderCommand* command = mgr.currentCommand();
+
+  BL_PROPAGATE(ensureFetchAndDispatchData(ctxI, di.signature, ds.fetchData, command->pipeDispatchData()));
+
+  size_t groupSize = IntOps::alignUp(PathShardGroup::sizeOf(shardCount), WorkerManager::kAllocatorAlignment);
+  size_t jobsSize = IntOps::alignUp(sizeof(RenderJob_PathShardOp) * shardCount, WorkerManager::kAllocatorAlignment);
+
+  PathShardGroup* group = mgr._allocator.template allocNoAlignT<PathShardGroup>(groupSize);
+  RenderJob_PathShardOp* jobs = mgr._allocator.template allocNoAlignT<RenderJob_PathShardOp>(jobsSize);
+
+  if (BL_UNLIKELY(!group || !jobs))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  BLPathView view = path->view();
+  size_t shardStart = 0;
+  uint32_t jobCount = 0;
+
+  for (uint32_t i = 0; i < shardCount; i++) {
+    size_t shardEnd = view.size;
+    if (i + 1u < shardCount)
+      shardEnd = findPathShardBoundary(view, view.size / shardCount * (i + 1u));
+
+    if (shardEnd <= shardStart)
+      continue;
+
+    jobs[jobCount].initStates(getSharedFillState(ctxI));
+    jobs[jobCount].initShard(group, jobCount, shardStart, shardEnd);
+
+    jobCount++;
+    shardStart = shardEnd;
+  }
+
+  group->init(path, jobCount);
+
+  // All jobs must be added once the command is enqueued as the command waits for all of them. Jobs that don't fit
+  // into the current job queue go to a queue allocated in advance - shard count is limited by the thread count, thus
+  // a single queue is always enough.
+  static_assert(uint32_t(BL_RUNTIME_MAX_THREAD_COUNT) + 1u <= kRenderQueueCapacity,
+                "Job queue capacity must be sufficient to hold all shards of a single path");
+
+  RenderJobQueue* reservedJobQueue = nullptr;
+  if (jobCount > mgr._jobAppender.remaining()) {
+    reservedJobQueue = mgr.newJobQueue();
+    if (BL_UNLIKELY(!reservedJobQueue))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+  }
+
+  return enqueueCommand(ctxI, command, kNoCoord, ds.fetchData, [&](RenderCommand* command) noexcept {
+    command->_payload.analytic.stateSlotIndex = mgr.nextStateSlotIndex();
+
+    for (uint32_t i = 0; i < jobCount; i++) {
+      if (mgr.isJobQueueFull()) {
+        BL_ASSERT(reservedJobQueue != nullptr);
+        mgr._appendJobQueue(reservedJobQueue);
+        reservedJobQueue = nullptr;
+      }
+
+      RenderJob_PathShardOp* job = &jobs[i];
+      job->initFillJob(mgr._commandAppender.queue(), mgr._commandAppender.index());
+      job->setOriginFixed(originFixed);
+      job->setMetaTransformFixedType(ctxI->metaTransformFixedType());
+      job->setFinalTransformFixedType(ctxI->finalTransformFixedType());
+      mgr.addJob(job);
+    }
+
+    markQueueFullOrExhausted(ctxI, mgr._jobAppender.full());
+  });
+}
+
+// Enqueues a fill of `path` that is built by a job. Paths that are large enough to be split into at least two shards
+// are built by multiple jobs when the context uses worker threads.
+static BL_INLINE BLResult enqueueCommandWithFillPathJob(
+    BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds,
+    const BLPoint& originFixed, const BLPath* path) noexcept {
+
+  size_t maxShardCount = path->size() / BL_RASTER_CONTEXT_MINIMUM_PATH_SHARD_SIZE;
+  uint32_t shardCount = uint32_t(blMin<size_t>(maxShardCount, ctxI->workerMgr().threadCount() + 1u));
+
+  if (shardCount >= 2u)
+    return enqueueCommandWithFillPathShards(ctxI, di, ds, originFixed, path, shardCount);
+
+  size_t jobSize = sizeof(RenderJob_GeometryOp) + sizeof(BLPathCore);
+  return enqueueCommandWithFillJob<RenderJob_GeometryOp>(ctxI, di, ds, jobSize, originFixed, [&](RenderJob_GeometryOp* job) noexcept { job->setGeometryWithPath(path); });
+}
+
 template<typename JobType, typename JobFinalizer>
 static BL_INLINE BLResult enqueueCommandWithStrokeJob(
     BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds,
@@ -2562,6 +2880,9 @@ static BL_INLINE BLResult enqueueFillOrStrokeGlyphRun(
   BLPoint originFixed = ctxI->finalTransformFixed().mapPoint(*origin);
   di.addFillType(Pipeline::FillType::kAnalytic);
 
+  GlyphOriginQuantizer quantizer;
+  quantizer.init(BLGlyphPositioning(ctxI->hints().glyphPositioning), ctxI->fpScaleD());
+
   RenderCommand* command = ctxI->workerMgr->currentCommand();
   command->initCommand(di.alpha);
   command->initFillAnalytic(nullptr, 0, BL_FILL_RULE_NON_ZERO);
@@ -2571,6 +2892,7 @@ static BL_INLINE BLResult enqueueFillOrStrokeGlyphRun(
     IntOps::alignUp(sizeof(RenderJob_TextOp), WorkerManager::kAllocatorAlignment), originFixed,
     [&](RenderJob_TextOp* job) {
       job->initFont(*font);
+      job->initGlyphOriginQuantizer(quantizer);
       job->initGlyphRun(glyphData, placementData, size, glyphRun->placementType, glyphRun->flags);
     });
 }
@@ -2608,6 +2930,9 @@ static BL_INLINE BLResult enqueueFillOrStrokeText(
     BLPoint originFixed = ctxI->finalTransformFixed().mapPoint(*origin);
     di.addFillType(Pipeline::FillType::kAnalytic);
 
+    GlyphOriginQuantizer quantizer;
+    quantizer.init(BLGlyphPositioning(ctxI->hints().glyphPositioning), ctxI->fpScaleD());
+
     RenderCommand* command = ctxI->workerMgr->currentCommand();
     command->initCommand(di.alpha);
     command->initFillAnalytic(nullptr, 0, BL_FILL_RULE_NON_ZERO);
@@ -2617,6 +2942,7 @@ static BL_INLINE BLResult enqueueFillOrStrokeText(
       IntOps::alignUp(sizeof(RenderJob_TextOp), WorkerManager::kAllocatorAlignment), originFixed,
       [&](RenderJob_TextOp* job) {
         job->initFont(*font);
+        job->initGlyphOriginQuantizer(quantizer);
         if (serializedTextSize > BL_RASTER_CONTEXT_MAXIMUM_EMBEDDED_TEXT_SIZE)
           job->initGlyphBuffer(gb->impl);
         else
@@ -2630,6 +2956,84 @@ static BL_INLINE BLResult enqueueFillOrStrokeText(
   return result;
 }
 
+// bl::RasterEngine - ContextImpl - Internals - Asynchronous Rendering - Coalesce
+// ==============================================================================
+
+static BL_INLINE bool areBoxesAdjacent(const BLBoxI& a, const BLBoxI& b) noexcept {
+  if (a.x0 == b.x0 && a.x1 == b.x1)
+    return a.y1 == b.y0 || b.y1 == a.y0;
+
+  if (a.y0 == b.y0 && a.y1 == b.y1)
+    return a.x1 == b.x0 || b.x1 == a.x0;
+
+  return false;
+}
+
+// Merges a FillBoxA `command`, which was not enqueued yet, into the previous command if both have the same solid
+// source, global alpha, and dispatch data. Boxes that share an edge are merged into a single box, other boxes are
+// appended to a FillBoxListA command, which is processed by workers as a single command. Only commands within the
+// same queue are coalesced, which means that the previous command always belongs to the current batch.
+static BL_INLINE bool coalesceFillBoxA(BLRasterContextImpl* ctxI, const RenderCommand* command, RenderFetchDataHeader* fetchData) noexcept {
+  BL_ASSERT(command->isFillBoxA());
+
+  WorkerManager& mgr = ctxI->workerMgr();
+  RenderCommandAppender& appender = mgr.commandAppender();
+
+  // Box lists are filled without fetching, see `CommandProcAsync::fillBoxListA()`.
+  if (appender.empty() || !fetchData->isSolid() || command->pipeDispatchData()->fetchFunc != nullptr)
+    return false;
+
+  size_t prevIndex = appender.index() - 1u;
+  RenderCommand* prev = appender.command(prevIndex);
+
+  if (!(prev->isFillBoxA() || prev->isFillBoxListA()) || prev->hasStyleFetchData() || prev->alpha() != command->alpha() ||
+      prev->isOccluder() != command->isOccluder())
+    return false;
+
+  if (prev->_source.solid.prgb64 != static_cast<RenderFetchDataSolid*>(fetchData)->pipelineData.prgb64 ||
+      prev->pipeDispatchData()->fillFunc != command->pipeDispatchData()->fillFunc ||
+      prev->pipeDispatchData()->fetchFunc != nullptr)
+    return false;
+
+  const BLBoxI& boxA = command->boxI();
+
+  if (prev->isFillBoxA()) {
+    BLBoxI& prevBoxA = prev->_payload.box.boxI;
+
+    if (areBoxesAdjacent(prevBoxA, boxA)) {
+      prevBoxA.reset(blMin(prevBoxA.x0, boxA.x0), blMin(prevBoxA.y0, boxA.y0),
+                     blMax(prevBoxA.x1, boxA.x1), blMax(prevBoxA.y1, boxA.y1));
+      appender.queue()->initQuantizedY0(prevIndex, uint8_t(prevBoxA.y0 >> ctxI->commandQuantizationShiftAA()));
+      return true;
+    }
+
+    BLBoxI* boxes = mgr._allocator.template allocNoAlignT<BLBoxI>(RenderCommand::kBoxListCapacity * sizeof(BLBoxI));
+    if (BL_UNLIKELY(!boxes))
+      return false;
+
+    prev->convertFillBoxAToList(boxes);
+  }
+  else if (prev->boxListSize() >= RenderCommand::kBoxListCapacity) {
+    return false;
+  }
+
+  prev->appendFillBoxListA(boxA);
+  appender.queue()->initQuantizedY0(prevIndex, uint8_t(prev->boxI().y0 >> ctxI->commandQuantizationShiftAA()));
+  return true;
+}
+
+// Marks a FillBoxA `command`, which was not enqueued yet, as an occluder if it replaces all pixels it covers. Workers
+// use occluders to skip box commands in a band that would be completely overdrawn by a later occluder.
+static BL_INLINE void markOccluder(BLRasterContextImpl* ctxI, RenderCommand* command, const DispatchInfo& di) noexcept {
+  BL_ASSERT(command->isFillBoxA());
+
+  if (ctxI->workerMgr().occlusionCulling() &&
+      di.signature.compOp() == CompOpExt::kSrcCopy &&
+      di.alpha == uint32_t(ctxI->renderTargetInfo.fullAlphaI)) {
+    command->addFlags(RenderCommandFlags::kOccluder);
+  }
+}
+
 // bl::RasterEngine - ContextImpl - Internals - Fill Clipped Box
 // =============================================================
 
@@ -2654,9 +3058,16 @@ BL_INLINE BLResult fillClippedBoxA<kAsync>(BLRasterContextImpl* ctxI, DispatchIn
 
   command->initCommand(di.alpha);
   command->initFillBoxA(boxA);
+  markOccluder(ctxI, command, di);
+
+  if (coalesceFillBoxA(ctxI, command, ds.fetchData))
+    return BL_SUCCESS;
 
   uint8_t qy0 = uint8_t((boxA.y0) >> ctxI->commandQuantizationShiftAA());
-  return enqueueCommand(ctxI, command, qy0, ds.fetchData, [&](RenderCommand*) noexcept {});
+  return enqueueCommand(ctxI, command, qy0, ds.fetchData, [&](RenderCommand* command) noexcept {
+    if (command->isOccluder())
+      ctxI->workerMgr().addOccluder();
+  });
 }
 
 template<RenderingMode kRM>
@@ -2713,7 +3124,18 @@ BL_INLINE BLResult fillClippedBoxF<kAsync>(BLRasterContextImpl* ctxI, DispatchIn
   }
 
   BL_PROPAGATE(ensureFetchAndDispatchData(ctxI, di.signature, ds.fetchData, command->pipeDispatchData()));
-  return enqueueCommand(ctxI, command, qy0, ds.fetchData, [&](RenderCommand*) noexcept {});
+
+  if (command->isFillBoxA()) {
+    markOccluder(ctxI, command, di);
+
+    if (coalesceFillBoxA(ctxI, command, ds.fetchData))
+      return BL_SUCCESS;
+  }
+
+  return enqueueCommand(ctxI, command, qy0, ds.fetchData, [&](RenderCommand* command) noexcept {
+    if (command->isOccluder())
+      ctxI->workerMgr().addOccluder();
+  });
 }
 
 // bl::RasterEngine - ContextImpl - Internals - Fill All
@@ -2783,6 +3205,81 @@ BL_NOINLINE BLResult fillClippedEdges<kAsync>(BLRasterContextImpl* ctxI, Dispatc
   });
 }
 
+// bl::RasterEngine - ContextImpl - Internals - Fill Prepared Edges
+// =================================================================
+//
+// A path prepared by `preparePath()` holds an edge cache, which is only used when the path is filled with the same
+// fixed-point transform (including the origin), clip box, and flatten tolerance as the cache was built with. Edges of
+// the cache are never modified - the synchronous rasterizer reads them by bands and asynchronous commands point to
+// them directly and retain the cache until the batch is finalized. The cache is acquired (retained) when it's looked
+// up as another thread can prepare the same path meanwhile and replace it.
+
+//! Returns a retained edge cache of `path` that matches the current state and the given `transform`, or null.
+static BL_INLINE BLPathEdgeCache* acquireMatchingEdgeCache(const BLRasterContextImpl* ctxI, const BLPath& path, const BLMatrix2D& transform) noexcept {
+  BLPathEdgeCache* edgeCache = PathInternal::acquireEdgeCache(PathInternal::getImpl(&path));
+  if (!edgeCache)
+    return nullptr;
+
+  if (edgeCache->transform != transform || edgeCache->clipBox != ctxI->finalClipBoxFixedD() || edgeCache->tolerance != ctxI->internalState.toleranceFixedD) {
+    PathInternal::releaseEdgeCache(edgeCache);
+    return nullptr;
+  }
+
+  return edgeCache;
+}
+
+//! Fills edges of a retained `edgeCache`, the reference is consumed (released or passed to the command).
+template<RenderingMode kRM>
+static BLResult fillPreparedEdges(BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds, BLPathEdgeCache* edgeCache, BLFillRule fillRule) noexcept;
+
+template<>
+BL_NOINLINE BLResult fillPreparedEdges<kSync>(BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds, BLPathEdgeCache* edgeCache, BLFillRule fillRule) noexcept {
+  const EdgeVector<int>* edges = static_cast<const EdgeVector<int>*>(edgeCache->edges);
+  BLResult result = BL_SUCCESS;
+
+  if (edges) {
+    Pipeline::DispatchData dispatchData;
+    di.addFillType(Pipeline::FillType::kAnalytic);
+    result = ensureFetchAndDispatchData(ctxI, di.signature, ds.fetchData, &dispatchData);
+
+    if (result == BL_SUCCESS)
+      result = CommandProcSync::fillAnalytic(ctxI->syncWorkData, dispatchData, di.alpha, edges, edgeCache->boundingBox, fillRule, ds.fetchData->getPipelineData());
+  }
+
+  PathInternal::releaseEdgeCache(edgeCache);
+  return result;
+}
+
+template<>
+BL_NOINLINE BLResult fillPreparedEdges<kAsync>(BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds, BLPathEdgeCache* edgeCache, BLFillRule fillRule) noexcept {
+  EdgeVector<int>* edges = static_cast<EdgeVector<int>*>(edgeCache->edges);
+  if (!edges) {
+    PathInternal::releaseEdgeCache(edgeCache);
+    return BL_SUCCESS;
+  }
+
+  RenderCommand* command = ctxI->workerMgr->currentCommand();
+  uint8_t qy0 = uint8_t(edgeCache->boundingBox.y0 >> ctxI->commandQuantizationShiftFp());
+
+  di.addFillType(Pipeline::FillType::kAnalytic);
+  command->initCommand(di.alpha);
+  command->initFillAnalytic(edges, edgeCache->boundingBox.y0, fillRule);
+
+  BLResult result = ensureFetchAndDispatchData(ctxI, di.signature, ds.fetchData, command->pipeDispatchData());
+  if (BL_UNLIKELY(result != BL_SUCCESS)) {
+    PathInternal::releaseEdgeCache(edgeCache);
+    return result;
+  }
+
+  // The reference is passed to the command and released when the batch is finalized.
+  command->initFillAnalyticEdgeCache(edgeCache);
+
+  return enqueueCommand(ctxI, command, qy0, ds.fetchData, [&](RenderCommand* command) noexcept {
+    command->_payload.analytic.stateSlotIndex = ctxI->workerMgr().nextStateSlotIndex();
+    ctxI->workerMgr()._commandAppender.markFetchData();
+  });
+}
+
 // bl::RasterEngine - ContextImpl - Internals - Fill Unclipped Path
 // ================================================================
 
@@ -2791,6 +3288,10 @@ static BL_INLINE BLResult fillUnclippedPath(
     BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds,
     const BLPath& path, BLFillRule fillRule, const BLMatrix2D& transform, BLTransformType transformType) noexcept {
 
+  BLPathEdgeCache* edgeCache = acquireMatchingEdgeCache(ctxI, path, transform);
+  if (edgeCache)
+    return fillPreparedEdges<kRM>(ctxI, di, ds, edgeCache, fillRule);
+
   if BL_CONSTEXPR (kRM == kAsync)
     ctxI->syncWorkData.saveState();
 
@@ -2827,21 +3328,24 @@ BL_INLINE BLResult fillUnclippedPathWithOrigin<kAsync>(
     BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds,
     const BLPoint& originFixed, const BLPath& path, BLFillRule fillRule) noexcept {
 
-  if (path.size() <= BL_RASTER_CONTEXT_MINIMUM_ASYNC_PATH_SIZE) {
-    const BLMatrix2D& ft = ctxI->finalTransformFixed();
-    BLMatrix2D transform(ft.m00, ft.m01, ft.m10, ft.m11, originFixed.x, originFixed.y);
+  const BLMatrix2D& ft = ctxI->finalTransformFixed();
+  BLMatrix2D transform(ft.m00, ft.m01, ft.m10, ft.m11, originFixed.x, originFixed.y);
 
+  if (path.size() <= BL_RASTER_CONTEXT_MINIMUM_ASYNC_PATH_SIZE) {
     BLTransformType transformType = blMax<BLTransformType>(ctxI->finalTransformFixedType(), BL_TRANSFORM_TYPE_TRANSLATE);
     return fillUnclippedPath<kAsync>(ctxI, di, ds, path, fillRule, transform, transformType);
   }
 
-  size_t jobSize = sizeof(RenderJob_GeometryOp) + sizeof(BLPathCore);
+  BLPathEdgeCache* edgeCache = acquireMatchingEdgeCache(ctxI, path, transform);
+  if (edgeCache)
+    return fillPreparedEdges<kAsync>(ctxI, di, ds, edgeCache, fillRule);
+
   di.addFillType(Pipeline::FillType::kAnalytic);
 
   RenderCommand* command = ctxI->workerMgr->currentCommand();
   command->initCommand(di.alpha);
   command->initFillAnalytic(nullptr, 0, fillRule);
-  return enqueueCommandWithFillJob<RenderJob_GeometryOp>(ctxI, di, ds, jobSize, originFixed, [&](RenderJob_GeometryOp* job) noexcept { job->setGeometryWithPath(&path); });
+  return enqueueCommandWithFillPathJob(ctxI, di, ds, originFixed, &path);
 }
 
 // bl::RasterEngine - ContextImpl - Internals - Fill Unclipped Polygon
@@ -3044,7 +3548,10 @@ BLResult BL_NOINLINE fillUnclippedGeometry<kAsync>(BLRasterContextImpl* ctxI, Di
       if (path->size() <= BL_RASTER_CONTEXT_MINIMUM_ASYNC_PATH_SIZE)
         return fillUnclippedPath<kAsync>(ctxI, di, ds, *path, fillRule);
 
-      size_t jobSize = sizeof(RenderJob_GeometryOp) + sizeof(BLPathCore);
+      BLPathEdgeCache* edgeCache = acquireMatchingEdgeCache(ctxI, *path, ctxI->finalTransformFixed());
+      if (edgeCache)
+        return fillPreparedEdges<kAsync>(ctxI, di, ds, edgeCache, fillRule);
+
       BLPoint originFixed(ctxI->finalTransformFixed().m20, ctxI->finalTransformFixed().m21);
 
       di.addFillType(Pipeline::FillType::kAnalytic);
@@ -3052,7 +3559,7 @@ BLResult BL_NOINLINE fillUnclippedGeometry<kAsync>(BLRasterContextImpl* ctxI, Di
       RenderCommand* command = ctxI->workerMgr->currentCommand();
       command->initCommand(di.alpha);
       command->initFillAnalytic(nullptr, 0, fillRule);
-      return enqueueCommandWithFillJob<RenderJob_GeometryOp>(ctxI, di, ds, jobSize, originFixed, [&](RenderJob_GeometryOp* job) noexcept { job->setGeometryWithPath(path); });
+      return enqueueCommandWithFillPathJob(ctxI, di, ds, originFixed, path);
     }
 
     default: {
@@ -3106,7 +3613,10 @@ BL_NOINLINE BLResult fillUnclippedText<kSync>(BLRasterContextImpl* ctxI, Dispatc
   BLPoint originFixed = ctxI->finalTransformFixed().mapPoint(*origin);
   WorkData* workData = &ctxI->syncWorkData;
 
-  BL_PROPAGATE(addFilledGlyphRunEdges(workData, DirectStateAccessor(ctxI), originFixed, font, glyphRun));
+  GlyphOriginQuantizer quantizer;
+  quantizer.init(BLGlyphPositioning(ctxI->hints().glyphPositioning), ctxI->fpScaleD());
+
+  BL_PROPAGATE(addFilledGlyphRunEdges(workData, DirectStateAccessor(ctxI), originFixed, font, glyphRun, quantizer));
   return fillClippedEdges<kSync>(ctxI, di, ds, BL_FILL_RULE_NON_ZERO);
 }
 
@@ -3521,6 +4031,298 @@ static BLResult BL_CDECL fillGeometryExtImpl(BLContextImpl* baseImpl, BLGeometry
   return finalizeExplicitOp<kRM>(ctxI, fetchData.ptr(), result);
 }
 
+// bl::RasterEngine - ContextImpl - Frontend - Prepare Path
+// ========================================================
+
+static BLResult BL_CDECL preparePathDImpl(BLContextImpl* baseImpl, const BLPoint* origin, const BLPathCore* path) noexcept {
+  BL_ASSERT(path->_d.isPath());
+
+  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+  if (path->dcast().empty())
+    return BL_SUCCESS;
+
+  BLPoint originFixed = ctxI->finalTransformFixed().mapPoint(*origin);
+  const BLMatrix2D& ft = ctxI->finalTransformFixed();
+  BLMatrix2D transform(ft.m00, ft.m01, ft.m10, ft.m11, originFixed.x, originFixed.y);
+
+  // Nothing to do if the path has been already prepared for the same state.
+  BLPathEdgeCache* matchingEdgeCache = acquireMatchingEdgeCache(ctxI, path->dcast(), transform);
+  if (matchingEdgeCache) {
+    PathInternal::releaseEdgeCache(matchingEdgeCache);
+    return BL_SUCCESS;
+  }
+
+  BLPathEdgeCache* edgeCache;
+  BLTransformType transformType = blMax<BLTransformType>(ctxI->finalTransformFixedType(), BL_TRANSFORM_TYPE_TRANSLATE);
+  BL_PROPAGATE(createPathEdgeCache(&ctxI->syncWorkData, path->dcast().view(), transform, transformType, ctxI->internalState.toleranceFixedD, &edgeCache));
+
+  PathInternal::replaceEdgeCache(PathInternal::getImpl(path), edgeCache);
+  return BL_SUCCESS;
+}
+
+// bl::RasterEngine - ContextImpl - Frontend - Fill Path Instances
+// ===============================================================
+//
+// Edges of the path are built only once (as an edge cache placed within the clip box) and each instance that is not
+// clipped only translates them, instances crossing the clip box are built by the edge builder and instances outside
+// of the clip box are skipped. Origins of instances are rounded to the fixed-point precision, thus the translation
+// is always integral. Each instance is still a separate render command so overlapping instances are composited the
+// same way as if `fillPath()` was called per origin. In async mode edges of all instances that were enqueued to the
+// same batch are built by a single job.
+
+enum class PathInstanceType : uint32_t {
+  kCulled,
+  kUnclipped,
+  kClipped
+};
+
+//! State of a `fillPathInstances()` call shared by all instances.
+struct PathInstancer {
+  const BLPath* path;
+  //! Fixed-point bounding box of the path transformed by the final transform without translation.
+  BLBox boxFixed;
+  //! Range of fixed-point origins (inclusive) of instances that are not clipped, empty if there are none.
+  BLBox unclippedOrigins;
+  //! Edge cache, built when the first unclipped instance is filled.
+  BLPathEdgeCache* edgeCache;
+  //! Fixed-point origin the edge cache was built with.
+  BLPointI edgeCacheOrigin;
+  //! Job that builds edges of instances enqueued to the current batch (async mode only).
+  RenderJob_PathInstancesOp* job;
+  //! Batch the job was enqueued to.
+  uint32_t jobBatchId;
+  //! Number of instances that were not filled yet.
+  size_t remaining;
+
+  BL_INLINE ~PathInstancer() noexcept {
+    if (edgeCache)
+      PathInternal::releaseEdgeCache(edgeCache);
+  }
+};
+
+static BL_INLINE void initPathInstancer(BLRasterContextImpl* ctxI, PathInstancer& instancer, const BLPath& path, size_t n) noexcept {
+  instancer.path = &path;
+  instancer.edgeCache = nullptr;
+  instancer.edgeCacheOrigin.reset();
+  instancer.job = nullptr;
+  instancer.jobBatchId = 0;
+  instancer.remaining = n;
+
+  BLBox box;
+  if (BL_UNLIKELY(path.getBoundingBox(&box) != BL_SUCCESS)) {
+    // Nothing is culled and all instances are clipped.
+    double inf = Math::inf<double>();
+    instancer.boxFixed.reset(-inf, -inf, inf, inf);
+    instancer.unclippedOrigins.reset(inf, inf, -inf, -inf);
+    return;
+  }
+
+  const BLMatrix2D& ft = ctxI->finalTransformFixed();
+  BLMatrix2D transform(ft.m00, ft.m01, ft.m10, ft.m11, 0.0, 0.0);
+
+  BLPoint p0 = transform.mapPoint(box.x0, box.y0);
+  BLPoint p1 = transform.mapPoint(box.x1, box.y0);
+  BLPoint p2 = transform.mapPoint(box.x0, box.y1);
+  BLPoint p3 = transform.mapPoint(box.x1, box.y1);
+
+  BLPoint boxMin = blMin(blMin(p0, p1), blMin(p2, p3));
+  BLPoint boxMax = blMax(blMax(p0, p1), blMax(p2, p3));
+  instancer.boxFixed.reset(boxMin.x, boxMin.y, boxMax.x, boxMax.y);
+
+  // Vertices of flattened curves lie on the curves, thus the edges only exceed the bounding box by rounding.
+  const BLBox& clipBox = ctxI->finalClipBoxFixedD();
+  instancer.unclippedOrigins.reset(Math::ceil(clipBox.x0 - boxMin.x + 1.0), Math::ceil(clipBox.y0 - boxMin.y + 1.0),
+                                   Math::floor(clipBox.x1 - boxMax.x - 1.0), Math::floor(clipBox.y1 - boxMax.y - 1.0));
+}
+
+static BL_INLINE PathInstanceType classifyPathInstance(const BLRasterContextImpl* ctxI, const PathInstancer& instancer, const BLPoint& originFixed) noexcept {
+  const BLBox& clipBox = ctxI->finalClipBoxFixedD();
+  const BLBox& box = instancer.boxFixed;
+
+  // Also culls instances having non-finite origins.
+  if (!(originFixed.x + box.x1 > clipBox.x0 && originFixed.x + box.x0 < clipBox.x1 &&
+        originFixed.y + box.y1 > clipBox.y0 && originFixed.y + box.y0 < clipBox.y1))
+    return PathInstanceType::kCulled;
+
+  const BLBox& unclipped = instancer.unclippedOrigins;
+  if (originFixed.x >= unclipped.x0 && originFixed.x <= unclipped.x1 && originFixed.y >= unclipped.y0 && originFixed.y <= unclipped.y1)
+    return PathInstanceType::kUnclipped;
+  else
+    return PathInstanceType::kClipped;
+}
+
+// Builds the edge cache of the instanced path, which is translated to the first unclipped origin.
+static BL_NOINLINE BLResult buildPathInstanceEdgeCache(BLRasterContextImpl* ctxI, PathInstancer& instancer) noexcept {
+  const BLMatrix2D& ft = ctxI->finalTransformFixed();
+  BLPointI origin(int(instancer.unclippedOrigins.x0), int(instancer.unclippedOrigins.y0));
+  BLMatrix2D transform(ft.m00, ft.m01, ft.m10, ft.m11, double(origin.x), double(origin.y));
+
+  BLTransformType transformType = blMax<BLTransformType>(ctxI->finalTransformFixedType(), BL_TRANSFORM_TYPE_TRANSLATE);
+  BL_PROPAGATE(createPathEdgeCache(&ctxI->syncWorkData, instancer.path->view(), transform, transformType, ctxI->internalState.toleranceFixedD, &instancer.edgeCache));
+
+  instancer.edgeCacheOrigin = origin;
+  return BL_SUCCESS;
+}
+
+static BL_INLINE BLResult ensurePathInstanceEdgeCache(BLRasterContextImpl* ctxI, PathInstancer& instancer) noexcept {
+  if (instancer.edgeCache)
+    return BL_SUCCESS;
+  return buildPathInstanceEdgeCache(ctxI, instancer);
+}
+
+static BL_INLINE BLPointI pathInstanceOffset(const PathInstancer& instancer, const BLPoint& originFixed) noexcept {
+  return BLPointI(int(originFixed.x) - instancer.edgeCacheOrigin.x, int(originFixed.y) - instancer.edgeCacheOrigin.y);
+}
+
+// Creates a job that builds edges of instances enqueued to the current batch, which is sized to hold either all
+// remaining instances or as many instances as the batch can hold.
+static BL_NOINLINE BLResult newPathInstancesJob(BLRasterContextImpl* ctxI, PathInstancer& instancer) noexcept {
+  WorkerManager& mgr = ctxI->workerMgr();
+
+  size_t instanceCapacity = blMin(instancer.remaining, mgr.remainingBatchCommandCount());
+  size_t instancesSize = IntOps::alignUp(sizeof(PathInstance) * instanceCapacity, WorkerManager::kAllocatorAlignment);
+
+  PathInstance* instances = mgr._allocator.template allocNoAlignT<PathInstance>(instancesSize);
+  if (BL_UNLIKELY(!instances))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  RenderJob_PathInstancesOp* job;
+  BL_PROPAGATE(newFillJob(ctxI, sizeof(RenderJob_PathInstancesOp), &job));
+
+  job->initFillJob(instancer.path, instances, instanceCapacity);
+  job->setOriginFixed(BLPoint(0.0, 0.0));
+  job->setMetaTransformFixedType(ctxI->metaTransformFixedType());
+  job->setFinalTransformFixedType(ctxI->finalTransformFixedType());
+
+  // The job is only processed when the batch is flushed, thus it's fine to add instances after it was enqueued.
+  mgr.addJob(job);
+  markQueueFullOrExhausted(ctxI, mgr._jobAppender.full());
+
+  instancer.job = job;
+  instancer.jobBatchId = mgr.currentBatchId();
+  return BL_SUCCESS;
+}
+
+template<RenderingMode kRM>
+static BLResult fillPathInstanceWithStyle(BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds, PathInstancer& instancer, const BLPoint& origin) noexcept;
+
+template<>
+BL_INLINE BLResult fillPathInstanceWithStyle<kSync>(BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds, PathInstancer& instancer, const BLPoint& origin) noexcept {
+  const BLMatrix2D& ft = ctxI->finalTransformFixed();
+  BLPoint originFixed = ft.mapPoint(origin);
+  originFixed.reset(Math::nearby(originFixed.x), Math::nearby(originFixed.y));
+
+  PathInstanceType instanceType = classifyPathInstance(ctxI, instancer, originFixed);
+  if (instanceType == PathInstanceType::kCulled)
+    return BL_SUCCESS;
+
+  if (instanceType == PathInstanceType::kClipped) {
+    BLMatrix2D transform(ft.m00, ft.m01, ft.m10, ft.m11, originFixed.x, originFixed.y);
+    BLTransformType transformType = blMax<BLTransformType>(ctxI->finalTransformFixedType(), BL_TRANSFORM_TYPE_TRANSLATE);
+    return fillUnclippedPath<kSync>(ctxI, di, ds, *instancer.path, ctxI->fillRule(), transform, transformType);
+  }
+
+  BL_PROPAGATE(ensurePathInstanceEdgeCache(ctxI, instancer));
+  if (!instancer.edgeCache->edges)
+    return BL_SUCCESS;
+
+  BL_PROPAGATE(addTranslatedEdges(&ctxI->syncWorkData, instancer.edgeCache, pathInstanceOffset(instancer, originFixed)));
+  return fillClippedEdges<kSync>(ctxI, di, ds, ctxI->fillRule());
+}
+
+template<>
+BL_INLINE BLResult fillPathInstanceWithStyle<kAsync>(BLRasterContextImpl* ctxI, DispatchInfo di, DispatchStyle ds, PathInstancer& instancer, const BLPoint& origin) noexcept {
+  constexpr uint8_t kNoCoord = kInvalidQuantizedCoordinate;
+
+  BLPoint originFixed = ctxI->finalTransformFixed().mapPoint(origin);
+  originFixed.reset(Math::nearby(originFixed.x), Math::nearby(originFixed.y));
+
+  PathInstanceType instanceType = classifyPathInstance(ctxI, instancer, originFixed);
+  if (instanceType == PathInstanceType::kCulled)
+    return BL_SUCCESS;
+
+  if (instanceType == PathInstanceType::kUnclipped) {
+    BL_PROPAGATE(ensurePathInstanceEdgeCache(ctxI, instancer));
+    if (!instancer.edgeCache->edges)
+      return BL_SUCCESS;
+  }
+
+  WorkerManager& mgr = ctxI->workerMgr();
+  RenderCommand* command = mgr.currentCommand();
+
+  di.addFillType(Pipeline::FillType::kAnalytic);
+  command->initCommand(di.alpha);
+  command->initFillAnalytic(nullptr, 0, ctxI->fillRule());
+  BL_PROPAGATE(ensureFetchAndDispatchData(ctxI, di.signature, ds.fetchData, command->pipeDispatchData()));
+
+  // A new job is required when the batch was flushed or the job cannot hold more instances.
+  RenderJob_PathInstancesOp* job = instancer.job;
+  if (!job || instancer.jobBatchId != mgr.currentBatchId() || job->full()) {
+    BL_PROPAGATE(newPathInstancesJob(ctxI, instancer));
+    job = instancer.job;
+  }
+
+  if (instanceType == PathInstanceType::kUnclipped && !job->hasEdgeCache()) {
+    PathInternal::retainEdgeCache(instancer.edgeCache);
+    job->setEdgeCache(instancer.edgeCache, instancer.edgeCacheOrigin);
+  }
+
+  return enqueueCommand(ctxI, command, kNoCoord, ds.fetchData, [&](RenderCommand* command) noexcept {
+    command->_payload.analytic.stateSlotIndex = mgr.nextStateSlotIndex();
+    job->addInstance(mgr._commandAppender.queue(), mgr._commandAppender.index(), instanceType == PathInstanceType::kClipped, originFixed);
+  });
+}
+
+template<RenderingMode kRM>
+static BL_NOINLINE BLResult fillPathInstance(BLRasterContextImpl* ctxI, PathInstancer& instancer, const BLPoint& origin) noexcept {
+  BLResult bailResult = BL_SUCCESS;
+
+  BL_CONTEXT_RESOLVE_IMPLICIT_STYLE_OP(ContextFlags::kNoFillOpImplicit, BL_CONTEXT_STYLE_SLOT_FILL, kNoBail);
+  return fillPathInstanceWithStyle<kRM>(ctxI, di, ds, instancer, origin);
+}
+
+template<RenderingMode kRM>
+static BL_NOINLINE BLResult fillPathInstanceRgba32(BLRasterContextImpl* ctxI, PathInstancer& instancer, const BLPoint& origin, uint32_t rgba32) noexcept {
+  BLResult bailResult = BL_SUCCESS;
+
+  BL_CONTEXT_RESOLVE_EXPLICIT_SOLID_OP(ContextFlags::kNoFillOpExplicit, BL_CONTEXT_STYLE_SLOT_FILL, rgba32, kNoBail);
+  return fillPathInstanceWithStyle<kRM>(ctxI, di, ds, instancer, origin);
+}
+
+template<RenderingMode kRM>
+static BLResult BL_CDECL fillPathInstancesDImpl(BLContextImpl* baseImpl, const BLPathCore* path, const BLPoint* origins, size_t n) noexcept {
+  BL_ASSERT(path->_d.isPath());
+
+  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+  if (path->dcast().empty() || !n)
+    return BL_SUCCESS;
+
+  PathInstancer instancer;
+  initPathInstancer(ctxI, instancer, path->dcast(), n);
+
+  for (size_t i = 0; i < n; i++, instancer.remaining--)
+    BL_PROPAGATE(fillPathInstance<kRM>(ctxI, instancer, origins[i]));
+
+  return BL_SUCCESS;
+}
+
+template<RenderingMode kRM>
+static BLResult BL_CDECL fillPathInstancesDRgba32Impl(BLContextImpl* baseImpl, const BLPathCore* path, const BLPoint* origins, const BLRgba32* colors, size_t n) noexcept {
+  BL_ASSERT(path->_d.isPath());
+
+  BLRasterContextImpl* ctxI = static_cast<BLRasterContextImpl*>(baseImpl);
+  if (path->dcast().empty() || !n)
+    return BL_SUCCESS;
+
+  PathInstancer instancer;
+  initPathInstancer(ctxI, instancer, path->dcast(), n);
+
+  for (size_t i = 0; i < n; i++, instancer.remaining--)
+    BL_PROPAGATE(fillPathInstanceRgba32<kRM>(ctxI, instancer, origins[i], colors[i].value));
+
+  return BL_SUCCESS;
+}
+
 // bl::RasterEngine - ContextImpl - Frontend - Fill Unclipped Text
 // ===============================================================
 
@@ -4017,8 +4819,7 @@ static BLResult BL_CDECL blitImageDImpl(BLContextImpl* baseImpl, const BLPoint*
     BLMatrix2D ft(ctxI->finalTransform());
     ft.translate(dst.x, dst.y);
 
-    fetchData->initImageSource(imgI, srcRect);
-    if (!fetchData->setupPatternAffine(BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND, BLPatternQuality(ctxI->hints().patternQuality), imgBytesPerPixel, ft))
+    if (!fetchData->setupPatternAffineMipmapped(imgI, srcRect, BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND, BLPatternQuality(ctxI->hints().patternQuality), ft))
       return BL_SUCCESS;
 
     prepareNonSolidFetch(ctxI, di, ds, fetchData.ptr());
@@ -4096,10 +4897,7 @@ static BLResult BL_CDECL blitScaledImageDImpl(BLContextImpl* baseImpl, const BLR
     BLMatrix2D ft(rect->w / double(srcRect.w), 0.0, 0.0, rect->h / double(srcRect.h), rect->x, rect->y);
     TransformInternal::multiply(ft, ft, ctxI->finalTransform());
 
-    uint32_t imgBytesPerPixel = imgI->depth / 8u;
-    fetchData->initImageSource(imgI, srcRect);
-
-    if (!fetchData->setupPatternAffine(BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND, BLPatternQuality(ctxI->hints().patternQuality), imgBytesPerPixel, ft))
+    if (!fetchData->setupPatternAffineMipmapped(imgI, srcRect, BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND, BLPatternQuality(ctxI->hints().patternQuality), ft))
       return BL_SUCCESS;
 
     prepareNonSolidFetch(ctxI, di, ds, fetchData.ptr());
@@ -4136,9 +4934,7 @@ static BLResult BL_CDECL blitScaledImageIImpl(BLContextImpl* baseImpl, const BLR
     BLMatrix2D transform(double(rect->w) / double(srcRect.w), 0.0, 0.0, double(rect->h) / double(srcRect.h), double(rect->x), double(rect->y));
     TransformInternal::multiply(transform, transform, ctxI->finalTransform());
 
-    uint32_t imgBytesPerPixel = imgI->depth / 8u;
-    fetchData->initImageSource(imgI, srcRect);
-    if (!fetchData->setupPatternAffine(BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND, BLPatternQuality(ctxI->hints().patternQuality), imgBytesPerPixel, transform))
+    if (!fetchData->setupPatternAffineMipmapped(imgI, srcRect, BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND, BLPatternQuality(ctxI->hints().patternQuality), transform))
       return BL_SUCCESS;
 
     prepareNonSolidFetch(ctxI, di, ds, fetchData.ptr());
@@ -4380,6 +5176,7 @@ static BLResult attach(BLRasterContextImpl* ctxI, BLImageCore* image, const BLCo
   // Initialize the rendering state to defaults.
   ctxI->stateIdCounter = 0;
   ctxI->savedState = nullptr;
+  ctxI->layerState = nullptr;
   ctxI->sharedFillState = nullptr;
   ctxI->sharedStrokeState = nullptr;
 
@@ -4451,6 +5248,13 @@ static BLResult detach(BLRasterContextImpl* ctxI) noexcept {
     ctxI->pipeProvider.runtime()->destroy();
   ctxI->pipeProvider.reset();
 
+  // Release all groups - their content is discarded as they were not ended.
+  while (ctxI->layerState) {
+    LayerState* layer = ctxI->layerState;
+    ctxI->layerState = layer->prevLayer;
+    destroyLayerState(ctxI, layer);
+  }
+
   // Release all states.
   //
   // Important as the user doesn't have to restore all states, in that case we basically need to iterate
@@ -4472,6 +5276,7 @@ static BLResult detach(BLRasterContextImpl* ctxI) noexcept {
   ctxI->baseZone.clear();
   ctxI->fetchDataPool.reset();
   ctxI->savedStatePool.reset();
+  ctxI->layerStatePool.reset();
   ctxI->syncWorkData.ctxData.reset();
   ctxI->syncWorkData.workZone.clear();
 
@@ -4513,6 +5318,8 @@ static void initVirt(BLContextVirt* virt) noexcept {
 
   virt->save                     = saveImpl;
   virt->restore                  = restoreImpl;
+  virt->beginGroup               = beginGroupImpl;
+  virt->endGroup                 = endGroupImpl;
 
   virt->applyTransformOp         = applyTransformOpImpl;
   virt->userToMeta               = userToMetaImpl;
@@ -4575,6 +5382,11 @@ static void initVirt(BLContextVirt* virt) noexcept {
   virt->fillGeometryRgba32       = fillGeometryRgba32Impl<kRM>;
   virt->fillGeometryExt          = fillGeometryExtImpl<kRM>;
 
+  virt->fillPathInstancesD       = fillPathInstancesDImpl<kRM>;
+  virt->fillPathInstancesDRgba32 = fillPathInstancesDRgba32Impl<kRM>;
+
+  virt->preparePathD             = preparePathDImpl;
+
   virt->fillTextOpI              = fillTextOpIImpl<kRM>;
   virt->fillTextOpIRgba32        = fillTextOpIRgba32Impl<kRM>;
   virt->fillTextOpIExt           = fillTextOpIExtImpl<kRM>;
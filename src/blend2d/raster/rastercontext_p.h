@@ -55,6 +55,10 @@ static constexpr const BLExtendMode BL_RASTER_CONTEXT_PREFERRED_BLIT_EXTEND = BL
 //! is higher than the cost of processing that path in a user thread).
 static constexpr const uint32_t BL_RASTER_CONTEXT_MINIMUM_ASYNC_PATH_SIZE = 10;
 
+//! Minimum size of a path shard (in vertices). A path that is at least twice as large is split into shards when the
+//! rendering context uses worker threads, so edges of the path are built by several workers concurrently.
+static constexpr const uint32_t BL_RASTER_CONTEXT_MINIMUM_PATH_SHARD_SIZE = 16384;
+
 //! Maximum size of a text to be copied as is when dispatching asynchronous jobs. When the limit is reached the job
 //! serialized would create a BLGlyphBuffer instead of making raw copy of the text, as the glyph-buffer has to copy
 //! it anyway.
@@ -102,6 +106,8 @@ public:
   bl::RasterEngine::RasterContextState internalState;
   //! Link to the previous saved state that will be restored by `BLContext::restore()`.
   bl::RasterEngine::SavedState* savedState;
+  //! Link to the current group that will be ended by `BLContext::endGroup()`.
+  bl::RasterEngine::LayerState* layerState;
   //! An actual shared fill-state (asynchronous rendering).
   bl::RasterEngine::SharedFillState* sharedFillState;
   //! An actual shared stroke-state (asynchronous rendering).
@@ -113,6 +119,8 @@ public:
   bl::ArenaPool<bl::RasterEngine::RenderFetchData> fetchDataPool;
   //! Object pool used to allocate `SavedState`.
   bl::ArenaPool<bl::RasterEngine::SavedState> savedStatePool;
+  //! Object pool used to allocate `LayerState`.
+  bl::ArenaPool<bl::RasterEngine::LayerState> layerStatePool;
 
   //! Pipeline runtime (either global or isolated, depending on create-options).
   bl::Pipeline::PipeProvider pipeProvider;
@@ -157,11 +165,13 @@ public:
       solidOverrideFillTable{},
       solidFetchDataOverrideTable{},
       savedState{},
+      layerState{},
       sharedFillState{},
       sharedStrokeState{},
       baseZone(8192 - bl::ArenaAllocator::kBlockOverhead, 16, staticData, staticSize),
       fetchDataPool(),
       savedStatePool(),
+      layerStatePool(),
       pipeProvider(),
       contextOriginId(BLUniqueIdGenerator::generateId(BLUniqueIdGenerator::Domain::kContext)),
       stateIdCounter(0),
@@ -198,6 +208,9 @@ public:
   BL_INLINE bl::RasterEngine::SavedState* allocSavedState() noexcept { return savedStatePool.alloc(savedStateZone()); }
   BL_INLINE void freeSavedState(bl::RasterEngine::SavedState* state) noexcept { savedStatePool.free(state); }
 
+  BL_INLINE bl::RasterEngine::LayerState* allocLayerState() noexcept { return layerStatePool.alloc(baseZone); }
+  BL_INLINE void freeLayerState(bl::RasterEngine::LayerState* layer) noexcept { layerStatePool.free(layer); }
+
   BL_INLINE void ensureWorkerMgr() noexcept {
     if (!workerMgrInitialized) {
       workerMgr.init();
@@ -4,11 +4,17 @@
 // SPDX-License-Identifier: Zlib
 
 #include "../api-build_p.h"
+#include "../font_p.h"
+#include "../fontface_p.h"
+#include "../geometry_p.h"
 #include "../path_p.h"
 #include "../pathstroke_p.h"
 #include "../raster/edgebuilder_p.h"
+#include "../raster/rastercontext_p.h"
 #include "../raster/rastercontextops_p.h"
 #include "../raster/workdata_p.h"
+#include "../support/algorithm_p.h"
+#include "../support/math_p.h"
 
 namespace bl {
 namespace RasterEngine {
@@ -46,6 +52,610 @@ BLResult addFilledPathEdges(WorkData* workData, const BLPathView& pathView, cons
   return workData->accumulateError(result);
 }
 
+// bl::RasterEngine - Path Sharding
+// ================================
+//
+// A large path can be split into shards, which are processed by several workers concurrently. Figures that are split
+// across shards are added as open parts, which start at the last vertex of the previous shard. The shard containing
+// the end of such figure closes it by a line to the start of the figure, which is the only edge the serial edge
+// building would add and that is not a segment of any part. Since both the parts and the closing line are clipped
+// and flattened exactly as they would be in a single edge builder, the shards produce the same coverage.
+
+static BL_INLINE bool isPathShardBoundary(const uint8_t* cmdData, size_t index) noexcept {
+  uint32_t cmd = cmdData[index];
+  if (cmd == BL_PATH_CMD_MOVE)
+    return true;
+
+  return cmdData[index - 1] == BL_PATH_CMD_ON && (cmd == BL_PATH_CMD_ON || cmd == BL_PATH_CMD_QUAD || cmd == BL_PATH_CMD_CUBIC || cmd == BL_PATH_CMD_CONIC);
+}
+
+size_t findPathShardBoundary(const BLPathView& pathView, size_t index) noexcept {
+  const uint8_t* cmdData = pathView.commandData;
+  size_t size = pathView.size;
+
+  index = blMax<size_t>(index, 1u);
+  while (index < size && !isPathShardBoundary(cmdData, index))
+    index++;
+  return blMin(index, size);
+}
+
+static BL_INLINE BLResult addFilledPathShardEdgesInternal(WorkData* workData, const BLPathView& pathView, size_t shardStart, size_t shardEnd, const BLMatrix2D& transform, BLTransformType transformType) noexcept {
+  EdgeBuilder<int>& edgeBuilder = workData->edgeBuilder;
+
+  const uint8_t* cmdData = pathView.commandData;
+  const BLPoint* vtxData = pathView.vertexData;
+
+  size_t index = shardStart;
+  bool continuesAfterEnd = shardEnd < pathView.size && cmdData[shardEnd] != BL_PATH_CMD_MOVE;
+
+  // A part of a figure that started in a previous shard.
+  if (cmdData[index] != BL_PATH_CMD_MOVE) {
+    size_t consumed;
+    BLPathView partView { cmdData + index, vtxData + index, shardEnd - index };
+
+    const BLPoint* figureStart = nullptr;
+    bool figureEnds = !continuesAfterEnd;
+
+    if (!figureEnds) {
+      // The figure ends in this shard if the part is terminated by something else than the end of the shard.
+      size_t i = index;
+      while (i < shardEnd && cmdData[i] != BL_PATH_CMD_MOVE && cmdData[i] != BL_PATH_CMD_CLOSE)
+        i++;
+      figureEnds = i != shardEnd;
+    }
+
+    if (figureEnds) {
+      size_t i = index - 1u;
+      while (i > 0 && cmdData[i] != BL_PATH_CMD_MOVE)
+        i--;
+
+      if (cmdData[i] == BL_PATH_CMD_MOVE)
+        figureStart = &vtxData[i];
+    }
+
+    BL_PROPAGATE(edgeBuilder.addFigurePart(partView, vtxData[index - 1u], figureStart, transform, transformType, &consumed));
+    index += consumed;
+  }
+
+  if (index >= shardEnd)
+    return BL_SUCCESS;
+
+  // A figure that continues in the next shard must be left open, all figures before it are complete.
+  size_t closedEnd = shardEnd;
+  if (continuesAfterEnd) {
+    size_t i = shardEnd;
+    while (i > index && cmdData[i - 1u] != BL_PATH_CMD_MOVE)
+      i--;
+
+    if (i > index)
+      closedEnd = i - 1u;
+  }
+
+  BLPathView closedView { cmdData + index, vtxData + index, closedEnd - index };
+  BL_PROPAGATE(edgeBuilder.addPath(closedView, true, transform, transformType));
+
+  if (closedEnd != shardEnd) {
+    BLPathView openView { cmdData + closedEnd, vtxData + closedEnd, shardEnd - closedEnd };
+    BL_PROPAGATE(edgeBuilder.addPath(openView, false, transform, transformType));
+  }
+
+  return BL_SUCCESS;
+}
+
+BLResult addFilledPathShardEdges(WorkData* workData, const BLPathView& pathView, size_t shardStart, size_t shardEnd, const BLMatrix2D& transform, BLTransformType transformType) noexcept {
+  workData->edgeBuilder.begin();
+
+  BLResult result = addFilledPathShardEdgesInternal(workData, pathView, shardStart, shardEnd, transform, transformType);
+  if (result == BL_SUCCESS)
+    result = workData->edgeBuilder.done();
+
+  if (BL_LIKELY(result == BL_SUCCESS))
+    return result;
+
+  workData->revertEdgeBuilder();
+  return workData->accumulateError(result);
+}
+
+// bl::RasterEngine - Path Edge Cache
+// ==================================
+//
+// Edges of a prepared path are built by the regular edge builder and then copied from the band lists into a single
+// allocation, where they are linked into one list sorted by their first row. Such list doesn't depend on the band
+// height, thus it can be rasterized by any rendering context that uses the same transform, clip box, and tolerance.
+
+static BL_INLINE size_t edgeVectorSize(const EdgeVector<int>* edge) noexcept {
+  return sizeof(EdgeVector<int>) - sizeof(EdgePoint<int>) + edge->count * sizeof(EdgePoint<int>);
+}
+
+static BL_INLINE BLResult createPathEdgeCacheInternal(WorkData* workData, BLPathEdgeCache** out) noexcept {
+  EdgeStorage<int>& edgeStorage = workData->edgeStorage;
+
+  EdgeVector<int>** edges = nullptr;
+  size_t edgeCount = 0;
+  size_t edgeDataSize = 0;
+
+  // Nothing to cache if everything was clipped out or all lines were horizontal, but the cache is still valid.
+  bool hasEdges = !edgeStorage.empty() && edgeStorage.boundingBox().y0 < edgeStorage.boundingBox().y1;
+
+  if (hasEdges) {
+    EdgeList<int>* bandEdges = edgeStorage.bandEdges();
+    uint32_t bandStart = edgeStorage.bandStartFromBBox();
+    uint32_t bandEnd = edgeStorage.bandEndFromBBox();
+
+    for (uint32_t bandId = bandStart; bandId < bandEnd; bandId++) {
+      for (EdgeVector<int>* edge = bandEdges[bandId].first(); edge; edge = edge->next) {
+        edgeCount++;
+        edgeDataSize += edgeVectorSize(edge);
+      }
+    }
+
+    edges = workData->workZone.allocT<EdgeVector<int>*>(edgeCount * sizeof(EdgeVector<int>*));
+    if (BL_UNLIKELY(!edges))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+    size_t i = 0;
+    for (uint32_t bandId = bandStart; bandId < bandEnd; bandId++) {
+      for (EdgeVector<int>* edge = bandEdges[bandId].first(); edge; edge = edge->next) {
+        edges[i++] = edge;
+      }
+    }
+
+    quickSort(edges, edgeCount, [](const EdgeVector<int>* a, const EdgeVector<int>* b) noexcept {
+      return a->pts[0].y < b->pts[0].y ? -1 : int(a->pts[0].y > b->pts[0].y);
+    });
+  }
+
+  size_t headerSize = IntOps::alignUp(sizeof(BLPathEdgeCache), 16u);
+  BLPathEdgeCache* edgeCache = static_cast<BLPathEdgeCache*>(malloc(headerSize + edgeDataSize));
+
+  if (BL_UNLIKELY(!edgeCache))
+    return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+  uint8_t* edgeData = reinterpret_cast<uint8_t*>(edgeCache) + headerSize;
+  EdgeVector<int>* first = nullptr;
+  EdgeVector<int>* last = nullptr;
+
+  for (size_t i = 0; i < edgeCount; i++) {
+    size_t size = edgeVectorSize(edges[i]);
+    EdgeVector<int>* edge = reinterpret_cast<EdgeVector<int>*>(edgeData);
+
+    memcpy(edge, edges[i], size);
+    if (last)
+      last->next = edge;
+    else
+      first = edge;
+
+    last = edge;
+    edgeData += size;
+  }
+
+  if (last)
+    last->next = nullptr;
+
+  edgeCache->refCount = 1;
+  edgeCache->clipBox = workData->edgeBuilder._clipBoxD;
+  edgeCache->boundingBox = hasEdges ? edgeStorage.boundingBox() : BLBoxI(0, 0, 0, 0);
+  edgeCache->edges = first;
+
+  *out = edgeCache;
+  return BL_SUCCESS;
+}
+
+BLResult createPathEdgeCache(WorkData* workData, const BLPathView& pathView, const BLMatrix2D& transform, BLTransformType transformType, double toleranceFixed, BLPathEdgeCache** out) noexcept {
+  workData->saveState();
+  BL_PROPAGATE(addFilledPathEdges(workData, pathView, transform, transformType));
+
+  BLResult result = createPathEdgeCacheInternal(workData, out);
+
+  // The edges were only built to be copied, thus release them regardless of the result.
+  workData->edgeStorage.clear();
+  workData->restoreState();
+
+  if (BL_UNLIKELY(result != BL_SUCCESS))
+    return workData->accumulateError(result);
+
+  (*out)->transform = transform;
+  (*out)->tolerance = toleranceFixed;
+  return BL_SUCCESS;
+}
+
+// bl::RasterEngine - Translated Edges
+// ===================================
+//
+// Instanced rendering fills the same path at many origins. Edges of the path are built only once (as an edge cache)
+// and then translated to each instance that is not clipped. The translation is an integer (fixed-point) offset, thus
+// translated edges only differ from edges the edge builder would build from the translated path in rounding.
+
+BLResult addTranslatedEdges(WorkData* workData, const BLPathEdgeCache* edgeCache, const BLPointI& offset) noexcept {
+  const EdgeVector<int>* src = static_cast<const EdgeVector<int>*>(edgeCache->edges);
+  if (!src)
+    return BL_SUCCESS;
+
+  EdgeStorage<int>& edgeStorage = workData->edgeStorage;
+  EdgeList<int>* bandEdges = edgeStorage.bandEdges();
+  uint32_t fixedBandHeightShift = edgeStorage.fixedBandHeightShift();
+
+  // Bounding box is merged first so `revertEdgeBuilder()` would clear all bands the edges were added to.
+  const BLBoxI& box = edgeCache->boundingBox;
+  Geometry::bound(edgeStorage._boundingBox, BLBoxI(box.x0 + offset.x, box.y0 + offset.y, box.x1 + offset.x, box.y1 + offset.y));
+
+  do {
+    size_t count = src->count;
+    EdgeVector<int>* dst = workData->workZone.allocT<EdgeVector<int>>(edgeVectorSize(src));
+
+    if (BL_UNLIKELY(!dst)) {
+      workData->revertEdgeBuilder();
+      return workData->accumulateError(blTraceError(BL_ERROR_OUT_OF_MEMORY));
+    }
+
+    dst->signBit = src->signBit;
+    dst->count = count;
+
+    for (size_t i = 0; i < count; i++)
+      dst->pts[i].reset(src->pts[i].x + offset.x, src->pts[i].y + offset.y);
+
+    bandEdges[unsigned(dst->pts[0].y) >> fixedBandHeightShift].append(dst);
+    src = src->next;
+  } while (src);
+
+  return BL_SUCCESS;
+}
+
+// bl::RasterEngine - Hairline Strokes
+// ===================================
+//
+// Thin strokes are very common (outlines, grids, charts) and for them the general stroker does more work than
+// necessary - it handles curves, emits offset paths in user space that are passed to a sink, and the sink then
+// passes three paths (including a separate path for the start cap) to the edge builder, which transforms them.
+// Hairline strokes only consist of line segments, thus their outline is built directly in device space in a single
+// pass, and it's passed to the edge builder at once. The geometry mirrors the general stroker so the output of both
+// is the same, except for tiny differences caused by offsetting in device space instead of user space. The outline
+// is filled by the non-zero fill rule as a whole like the outline of the general stroker, thus parts of a stroke that
+// overlap are rendered the same way. The only visible difference is in round joins, which are approximated by at most
+// 4 line segments instead of curves, so the tips of sharp round joins are a few percent lighter.
+
+// Maximum transformed stroke width (in pixels) that is considered a hairline.
+static constexpr double kHairlineMaxWidth = 1.5;
+
+// The same length epsilon as used by the general stroker so both produce the same figures.
+static constexpr double kHairlineLengthEpsilonSq = 1e-20;
+
+// Maximum angle of a single round join segment (45 degrees) - a hairline join is at most 1.5 pixels wide, so it
+// doesn't need more than 4 segments to cover a half circle.
+static constexpr double kHairlineRoundStep = Math::kPI_DIV_4;
+
+// Maximum number of vertices emitted by a single join (round join with 4 segments) at one side.
+static constexpr size_t kHairlineMaxJoinVertices = 5;
+
+bool isHairlineStroke(const WorkData* workData, const BLPathView& pathView, const BLStrokeOptions& strokeOptions, const BLMatrix2D& transform) noexcept {
+  if (strokeOptions.startCap > BL_STROKE_CAP_SQUARE || strokeOptions.endCap > BL_STROKE_CAP_SQUARE || strokeOptions.join > BL_STROKE_JOIN_ROUND)
+    return false;
+
+  // Only similarity transforms (uniform scale, rotation, reflection, and translation) keep the stroke width the same
+  // in all directions, which is required to offset segments in device space.
+  double sx = Math::hypot(transform.m00, transform.m01);
+  double sy = Math::hypot(transform.m10, transform.m11);
+  double sxy = transform.m00 * transform.m10 + transform.m01 * transform.m11;
+
+  if (!(blAbs(sx - sy) <= sx * 1e-6 && blAbs(sxy) <= sx * sy * 1e-6))
+    return false;
+
+  double width = strokeOptions.width * sx;
+  if (!(width > 0.0 && width <= kHairlineMaxWidth * workData->ctxI->fpScaleD()))
+    return false;
+
+  // Only line segments are handled, curves and invalid paths go through the general stroker.
+  const uint8_t* cmdData = pathView.commandData;
+  bool inFigure = false;
+
+  for (size_t i = 0; i < pathView.size; i++) {
+    uint32_t cmd = cmdData[i];
+    if (cmd == BL_PATH_CMD_MOVE)
+      inFigure = true;
+    else if (cmd == BL_PATH_CMD_ON && inFigure)
+      continue;
+    else if (cmd == BL_PATH_CMD_CLOSE)
+      inFigure = false;
+    else
+      return false;
+  }
+
+  return true;
+}
+
+static BL_INLINE bool testHairlineInnerJoin(const BLPoint& a0, const BLPoint& a1, const BLPoint& b0, const BLPoint& b1, const BLPoint& join) noexcept {
+  BLPoint min = blMax(blMin(a0, a1), blMin(b0, b1));
+  BLPoint max = blMin(blMax(a0, a1), blMax(b0, b1));
+
+  return (join.x >= min.x) & (join.y >= min.y) &
+         (join.x <= max.x) & (join.y <= max.y) ;
+}
+
+namespace {
+
+struct HairlineStroker {
+  uint32_t joinType;
+  double d;
+  double miterLimit;
+  double miterLimitSq;
+
+  // Outer join at `p` offset by `sd` (signed distance) - `k` is the offset of the miter point.
+  BL_INLINE void outerJoin(PathAppender& out, const BLPoint& p, const BLPoint& n0, const BLPoint& n1, double sd, const BLPoint& k, double cross) noexcept {
+    // The miter point (and clipped miter points) lie on the offset lines, thus there is no need to emit `pa` and `pb`.
+    if (Geometry::lengthSq(k) <= miterLimitSq) {
+      out.lineTo(p + k);
+      return;
+    }
+
+    if (joinType == BL_STROKE_JOIN_MITER_CLIP) {
+      double b2 = blAbs(Geometry::cross(k, n0));
+
+      // Avoid degenerate cases and NaN.
+      if (b2 > 0)
+        b2 = b2 * miterLimit / Geometry::length(k);
+      else
+        b2 = miterLimit;
+
+      out.lineTo(p + sd * n0 - b2 * Geometry::normal(n0));
+      out.lineTo(p + sd * n1 + b2 * Geometry::normal(n1));
+      return;
+    }
+
+    BLPoint w0 = n0 * sd;
+    out.lineTo(p + w0);
+
+    if (joinType == BL_STROKE_JOIN_ROUND) {
+      // The outer arc rotates from `w0` towards `w1`, clockwise on the left side (Y pointing up) and counter-clockwise
+      // on the right side, which also disambiguates joins of segments having opposite directions.
+      double angle = Math::atan2(blAbs(cross), Geometry::dot(n0, n1));
+      uint32_t count = blClamp(uint32_t(Math::ceil(angle / kHairlineRoundStep)), 1u, 4u);
+      double step = (sd > 0.0 ? -angle : angle) / double(count);
+
+      for (uint32_t i = 1; i < count; i++) {
+        double s = Math::sin(step * double(i));
+        double c = Math::cos(step * double(i));
+        out.lineTo(p + BLPoint(w0.x * c - w0.y * s, w0.x * s + w0.y * c));
+      }
+    }
+
+    out.lineTo(p + n1 * sd);
+  }
+
+  // Inner join at `p` offset by `sd` (signed distance) - either the intersection of both offset segments (if it lies
+  // on both of them) or a path through the vertex itself, which is always correct considering the non-zero fill rule.
+  BL_INLINE void innerJoin(PathAppender& out, const BLPoint& p, const BLPoint& p1, const BLPoint& n0, const BLPoint& n1, double sd, const BLPoint& k) noexcept {
+    BLPoint pa = p + n0 * sd;
+    BLPoint pb = p + n1 * sd;
+
+    if (testHairlineInnerJoin(out.vtx[-1], pa, pb, p1 + n1 * sd, p + k)) {
+      out.lineTo(p + k);
+    }
+    else {
+      out.lineTo(pa);
+      out.lineTo(p);
+      out.lineTo(pb);
+    }
+  }
+
+  // Joins a segment ending at `p` (normal `n0`) with a segment from `p` to `p1` (normal `n1`). The left side of the
+  // stroke is emitted to `aOut` and the right side to `bOut`, which must be reversed later.
+  BL_INLINE void join(PathAppender& aOut, PathAppender& bOut, const BLPoint& p, const BLPoint& p1, const BLPoint& n0, const BLPoint& n1) noexcept {
+    if (n0 == n1) {
+      BLPoint w = n0 * d;
+      aOut.lineTo(p + w);
+      bOut.lineTo(p - w);
+      return;
+    }
+
+    double cross = Geometry::cross(n0, n1);
+    BLPoint m = n0 + n1;
+    BLPoint k = m * (d * 2.0) / Geometry::lengthSq(m);
+
+    if (cross >= 0.0) {
+      outerJoin(bOut, p, n0, n1, -d, -k, cross);
+      innerJoin(aOut, p, p1, n0, n1, d, k);
+    }
+    else {
+      outerJoin(aOut, p, n0, n1, d, k, cross);
+      innerJoin(bOut, p, p1, n0, n1, -d, -k);
+    }
+  }
+};
+
+} // {anonymous}
+
+BLResult addHairlineStrokeEdges(WorkData* workData, const BLPathView& pathView, const BLStrokeOptions& strokeOptions, const BLMatrix2D& transform, BLPath& outlinePath, BLPath& sidePath) noexcept {
+  double scale = Math::hypot(transform.m00, transform.m01);
+
+  HairlineStroker stroker;
+  stroker.joinType = strokeOptions.join;
+  stroker.d = strokeOptions.width * 0.5 * scale;
+
+  if (stroker.joinType <= BL_STROKE_JOIN_MITER_ROUND) {
+    stroker.joinType = stroker.joinType == BL_STROKE_JOIN_MITER_BEVEL ? uint32_t(BL_STROKE_JOIN_BEVEL) :
+                       stroker.joinType == BL_STROKE_JOIN_MITER_ROUND ? uint32_t(BL_STROKE_JOIN_ROUND) : stroker.joinType;
+    stroker.miterLimit = stroker.d * strokeOptions.miterLimit;
+  }
+  else {
+    stroker.miterLimit = 1e-10 * scale;
+  }
+  stroker.miterLimitSq = Math::square(stroker.miterLimit);
+
+  double startExt = strokeOptions.startCap == BL_STROKE_CAP_SQUARE ? stroker.d : 0.0;
+  double endExt = strokeOptions.endCap == BL_STROKE_CAP_SQUARE ? stroker.d : 0.0;
+
+  const uint8_t* cmdData = pathView.commandData;
+  const BLPoint* vtxData = pathView.vertexData;
+
+  size_t i = 0;
+  size_t size = pathView.size;
+
+  outlinePath.clear();
+  while (i < size) {
+    if (cmdData[i] != BL_PATH_CMD_MOVE) {
+      i++;
+      continue;
+    }
+
+    size_t figureStart = i;
+    size_t figureEnd = i + 1;
+
+    while (figureEnd < size && cmdData[figureEnd] == BL_PATH_CMD_ON)
+      figureEnd++;
+
+    bool closed = figureEnd < size && cmdData[figureEnd] == BL_PATH_CMD_CLOSE;
+    i = figureEnd + size_t(closed);
+
+    size_t maxVertices = (figureEnd - figureStart + 1u) * kHairlineMaxJoinVertices;
+
+    PathAppender aOut;
+    PathAppender bOut;
+
+    BL_PROPAGATE(aOut.beginAppend(&outlinePath, maxVertices * 2u));
+    BL_PROPAGATE(bOut.beginAssign(&sidePath, maxVertices));
+
+    BLPoint* aFirst = aOut.vtx;
+    BLPoint* bFirst = bOut.vtx;
+
+    BLPoint uPrev = vtxData[figureStart];
+    BLPoint p0 = transform.mapPoint(uPrev);
+    BLPoint n0 {};
+    BLPoint pSecond {};
+    BLPoint nInitial {};
+    bool isOpen = false;
+
+    // A closed figure has an additional closing segment, which ends at its initial vertex.
+    size_t vtxEnd = figureEnd + size_t(closed);
+
+    for (size_t j = figureStart + 1; j < vtxEnd; j++) {
+      BLPoint u1 = j < figureEnd ? vtxData[j] : vtxData[figureStart];
+      if (Geometry::lengthSq(u1 - uPrev) < kHairlineLengthEpsilonSq)
+        continue;
+
+      uPrev = u1;
+      BLPoint p1 = transform.mapPoint(u1);
+      BLPoint n1 = Geometry::normal(Geometry::unitVector(p1 - p0));
+
+      if (!isOpen) {
+        BLPoint w = n1 * stroker.d;
+        BLPoint e = BLPoint(n1.y, -n1.x) * (closed ? 0.0 : startExt);
+
+        aOut.moveTo(p0 + w - e);
+        bOut.moveTo(p0 - w - e);
+
+        pSecond = p1;
+        nInitial = n1;
+        isOpen = true;
+      }
+      else {
+        stroker.join(aOut, bOut, p0, p1, n0, n1);
+      }
+
+      p0 = p1;
+      n0 = n1;
+    }
+
+    // Don't emit anything if the figure has no points (and thus no direction).
+    if (!isOpen) {
+      aOut.done(&outlinePath);
+      bOut.done(&sidePath);
+      continue;
+    }
+
+    if (closed) {
+      // The figure is closed => the result is two closed figures without caps. The last join ends at the initial
+      // vertex, which must be patched as the join could have replaced it by an intersection of offset segments.
+      stroker.join(aOut, bOut, p0, pSecond, n0, nInitial);
+      *aFirst = aOut.vtx[-1];
+      *bFirst = bOut.vtx[-1];
+    }
+    else {
+      // The figure is open => the result is a single figure having caps at both ends.
+      BLPoint w = n0 * stroker.d;
+      BLPoint e = BLPoint(n0.y, -n0.x) * endExt;
+
+      aOut.lineTo(p0 + w + e);
+      aOut.lineTo(p0 - w + e);
+    }
+
+    // Append the right side reversed - as a separate figure if the figure is closed.
+    const BLPoint* bPtr = bOut.vtx;
+
+    if (closed)
+      aOut.moveTo(*--bPtr);
+
+    while (bPtr != bFirst)
+      aOut.lineTo(*--bPtr);
+
+    aOut.done(&outlinePath);
+    bOut.done(&sidePath);
+  }
+
+  return workData->edgeBuilder.addPath(outlinePath.view(), true, TransformInternal::identityTransform, BL_TRANSFORM_TYPE_IDENTITY);
+}
+
+// bl::RasterEngine - Quantized Glyph Run Edges
+// =============================================
+
+BLResult addQuantizedGlyphRunEdges(WorkData* workData, const BLMatrix2D& transform, const BLFontCore* font, const BLGlyphRun* glyphRun, const GlyphOriginQuantizer& quantizer) noexcept {
+  // Outlines are cached in a small direct-mapped cache indexed by glyph id. Each outline is decoded at zero origin
+  // and stored in `path`, which is cleared when it grows too much so long runs of unique glyphs don't accumulate.
+  static constexpr uint32_t kCacheSize = 64;
+  static constexpr size_t kMaxCachedPathSize = 16384;
+  static constexpr uint32_t kInvalidGlyphId = 0xFFFFFFFFu;
+
+  struct CachedOutline {
+    uint32_t glyphId;
+    size_t start;
+    size_t end;
+  };
+
+  BLFontPrivateImpl* fontI = FontInternal::getImpl(font);
+  BLFontFacePrivateImpl* faceI = FontFaceInternal::getImpl(&fontI->face);
+
+  auto getGlyphOutlinesFunc = faceI->funcs.getGlyphOutlines;
+  const FontVarInstance* varInstance = fontI->varInstance;
+
+  EdgeBuilder<int>& edgeBuilder = workData->edgeBuilder;
+  BLPath& path = workData->tmpPath[3];
+  path.clear();
+
+  CachedOutline cache[kCacheSize];
+  for (uint32_t i = 0; i < kCacheSize; i++)
+    cache[i].glyphId = kInvalidGlyphId;
+
+  ScopedBufferTmp<BL_FONT_GET_GLYPH_OUTLINE_BUFFER_SIZE> tmpBuffer;
+  size_t contourCount;
+
+  return FontInternal::forEachGlyphRunTransform(fontI, glyphRun, &transform, [&](size_t glyphIndex, BLGlyphId glyphId, BLMatrix2D& glyphTransform) noexcept -> BLResult {
+    blUnused(glyphIndex);
+
+    BLPoint origin = quantizer.quantize(glyphTransform.m20, glyphTransform.m21);
+    CachedOutline& outline = cache[glyphId % kCacheSize];
+
+    if (outline.glyphId != glyphId) {
+      if (path.size() > kMaxCachedPathSize) {
+        path.clear();
+        for (uint32_t i = 0; i < kCacheSize; i++)
+          cache[i].glyphId = kInvalidGlyphId;
+      }
+
+      size_t start = path.size();
+      glyphTransform.m20 = 0.0;
+      glyphTransform.m21 = 0.0;
+      BL_PROPAGATE(getGlyphOutlinesFunc(faceI, varInstance, glyphId, &glyphTransform, &path, &contourCount, &tmpBuffer));
+
+      outline.glyphId = glyphId;
+      outline.start = start;
+      outline.end = path.size();
+    }
+
+    BLPathView view;
+    view.reset(path.commandData() + outline.start, path.vertexData() + outline.start, outline.end - outline.start);
+    return edgeBuilder.addPath(view, true, BLMatrix2D::makeTranslation(origin.x, origin.y), BL_TRANSFORM_TYPE_TRANSLATE);
+  });
+}
+
 // bl::RasterEngine - Sinks & Sink Utilities
 // =========================================
 
@@ -42,6 +42,31 @@ BL_HIDDEN BLResult addFilledPolygonEdges(WorkData* workData, const BLPointI* pts
 BL_HIDDEN BLResult addFilledPolygonEdges(WorkData* workData, const BLPoint* pts, size_t size, const BLMatrix2D& transform, BLTransformType transformType) noexcept;
 BL_HIDDEN BLResult addFilledPathEdges(WorkData* workData, const BLPathView& pathView, const BLMatrix2D& transform, BLTransformType transformType) noexcept;
 
+//! Returns the first index, starting from `index`, at which `pathView` can be split into shards - either a start of a
+//! figure, or a start of a segment that follows an on-curve point. Returns `pathView.size` if there is no such index.
+BL_HIDDEN size_t findPathShardBoundary(const BLPathView& pathView, size_t index) noexcept;
+
+//! Adds edges of a shard of a filled `pathView`, which consists of commands in `[shardStart, shardEnd)` range, where
+//! both indexes are boundaries returned by `findPathShardBoundary()`. Edges of all shards combined are equal to the
+//! edges built by `addFilledPathEdges()` - each figure split across shards is closed by the shard containing its end.
+BL_HIDDEN BLResult addFilledPathShardEdges(WorkData* workData, const BLPathView& pathView, size_t shardStart, size_t shardEnd, const BLMatrix2D& transform, BLTransformType transformType) noexcept;
+
+//! Creates an edge cache of a filled `pathView` transformed by `transform`, which is clipped to the clip box of the
+//! edge builder and flattened with `toleranceFixed`. The edge builder must be already configured with both of them.
+BL_HIDDEN BLResult createPathEdgeCache(WorkData* workData, const BLPathView& pathView, const BLMatrix2D& transform, BLTransformType transformType, double toleranceFixed, BLPathEdgeCache** out) noexcept;
+
+//! Adds edges of `edgeCache` translated by `offset` (in fixed point) to the edge storage of `workData`. The caller
+//! must verify that the translated edges are within the clip box of the edge builder as they are not clipped.
+BL_HIDDEN BLResult addTranslatedEdges(WorkData* workData, const BLPathEdgeCache* edgeCache, const BLPointI& offset) noexcept;
+
+//! Tests whether a stroke of `pathView` can be rendered by `addHairlineStrokeEdges()`, which requires a similarity
+//! `transform`, a transformed stroke width of at most 1.5 pixels, butt or square caps, and a path without curves.
+BL_HIDDEN bool isHairlineStroke(const WorkData* workData, const BLPathView& pathView, const BLStrokeOptions& strokeOptions, const BLMatrix2D& transform) noexcept;
+
+//! Adds edges of a hairline stroke to the edge builder, bypassing the general stroker. The edge builder must be
+//! already initialized by `EdgeBuilder::begin()`. Both `outlinePath` and `sidePath` are used as temporaries.
+BL_HIDDEN BLResult addHairlineStrokeEdges(WorkData* workData, const BLPathView& pathView, const BLStrokeOptions& strokeOptions, const BLMatrix2D& transform, BLPath& outlinePath, BLPath& sidePath) noexcept;
+
 //! Edge builder sink - acts as a base class for other sinks, but can also be used as is, for example
 //! by `addFilledGlyphRunEdges()` implementation.
 struct EdgeBuilderSink {
@@ -62,6 +87,11 @@ struct StrokeGlyphRunSink : public StrokeSink {
   const BLApproximationOptions* approximationOptions;
 };
 
+//! Adds edges of a filled `glyphRun` with glyph origins quantized by `quantizer` to the edge builder, which must be
+//! already initialized by `EdgeBuilder::begin()`. Glyphs that repeat in the run have their outlines decoded only once,
+//! as all their instances differ only by translation. Uses `WorkData::tmpPath[3]` to store the decoded outlines.
+BL_HIDDEN BLResult addQuantizedGlyphRunEdges(WorkData* workData, const BLMatrix2D& transform, const BLFontCore* font, const BLGlyphRun* glyphRun, const GlyphOriginQuantizer& quantizer) noexcept;
+
 BL_HIDDEN BLResult BL_CDECL fillGlyphRunSink(BLPathCore* path, const void* info, void* userData) noexcept;
 BL_HIDDEN BLResult BL_CDECL strokeGeometrySink(BLPathCore* a, BLPathCore* b, BLPathCore* c, size_t figureStart, size_t figureEnd, void* userData) noexcept;
 BL_HIDDEN BLResult BL_CDECL strokeGlyphRunSink(BLPathCore* path, const void* info, void* userData) noexcept;
@@ -70,7 +100,7 @@ template<typename StateAccessor>
 static BL_INLINE BLResult addFilledGlyphRunEdges(
   WorkData* workData,
   const StateAccessor& accessor,
-  const BLPoint& originFixed, const BLFontCore* font, const BLGlyphRun* glyphRun) noexcept {
+  const BLPoint& originFixed, const BLFontCore* font, const BLGlyphRun* glyphRun, const GlyphOriginQuantizer& quantizer) noexcept {
 
   BLMatrix2D transform(accessor.finalTransformFixed(originFixed));
   BLPath* path = &workData->tmpPath[3];
@@ -80,7 +110,11 @@ static BL_INLINE BLResult addFilledGlyphRunEdges(
   sink.edgeBuilder = &workData->edgeBuilder;
   sink.edgeBuilder->begin();
 
-  BLResult result = blFontGetGlyphRunOutlines(font, glyphRun, &transform, path, fillGlyphRunSink, &sink);
+  BLResult result;
+  if (quantizer.enabled())
+    result = addQuantizedGlyphRunEdges(workData, transform, font, glyphRun, quantizer);
+  else
+    result = blFontGetGlyphRunOutlines(font, glyphRun, &transform, path, fillGlyphRunSink, &sink);
 
   // EdgeBuilder::done() can only fail on out of memory condition.
   if (BL_LIKELY(result == BL_SUCCESS)) {
@@ -121,15 +155,21 @@ static BL_INLINE BLResult addStrokedPathEdges(
     sink.transformType = accessor.metaTransformFixedType();
   }
 
-  a->clear();
+  BLResult result;
   workData->edgeBuilder.begin();
 
-  BLResult result = PathInternal::strokePath(
-    path->view(),
-    accessor.strokeOptions(),
-    accessor.approximationOptions(),
-    *a, *b, *c,
-    strokeGeometrySink, &sink);
+  if (isHairlineStroke(workData, path->view(), accessor.strokeOptions(), transform)) {
+    result = addHairlineStrokeEdges(workData, path->view(), accessor.strokeOptions(), transform, *a, *b);
+  }
+  else {
+    a->clear();
+    result = PathInternal::strokePath(
+      path->view(),
+      accessor.strokeOptions(),
+      accessor.approximationOptions(),
+      *a, *b, *c,
+      strokeGeometrySink, &sink);
+  }
 
   // EdgeBuilder::done() can only fail on out of memory condition.
   if (BL_LIKELY(result == BL_SUCCESS)) {
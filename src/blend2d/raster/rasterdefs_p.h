@@ -16,6 +16,7 @@
 #include "../pattern_p.h"
 #include "../path_p.h"
 #include "../pipeline/pipedefs_p.h"
+#include "../support/math_p.h"
 
 //! \cond INTERNAL
 //! \addtogroup blend2d_raster_engine_impl
@@ -203,6 +204,36 @@ static BL_INLINE_NODEBUG constexpr ContextFlags operator>>(ContextFlags a, const
   return ContextFlags((std::underlying_type<ContextFlags>::type)(a) >> n);
 }
 
+//! Quantizes glyph origins in fixed point coordinates as specified by \ref BLGlyphPositioning hint.
+struct GlyphOriginQuantizer {
+  //! Horizontal quantization step in fixed point coordinates (zero if not quantized).
+  double stepX;
+  //! Vertical quantization step in fixed point coordinates (zero if not quantized).
+  double stepY;
+
+  BL_INLINE void init(BLGlyphPositioning positioning, double fpScale) noexcept {
+    // Number of horizontal and vertical subpixel positions, zero means no quantization.
+    static constexpr uint8_t positionCountTable[BL_GLYPH_POSITIONING_MAX_VALUE + 1][2] = {
+      { 0, 0 }, // BL_GLYPH_POSITIONING_EXACT
+      { 4, 4 }, // BL_GLYPH_POSITIONING_SUBPIXEL_4X4
+      { 4, 1 }, // BL_GLYPH_POSITIONING_SUBPIXEL_4X1
+      { 1, 1 }  // BL_GLYPH_POSITIONING_PIXEL
+    };
+
+    uint32_t nx = positionCountTable[positioning][0];
+    uint32_t ny = positionCountTable[positioning][1];
+
+    stepX = nx ? fpScale / double(nx) : 0.0;
+    stepY = ny ? fpScale / double(ny) : 0.0;
+  }
+
+  BL_INLINE_NODEBUG bool enabled() const noexcept { return stepX != 0.0; }
+
+  BL_INLINE BLPoint quantize(double x, double y) const noexcept {
+    return BLPoint(Math::round(x / stepX) * stepX, Math::round(y / stepY) * stepY);
+  }
+};
+
 } // {RasterEngine}
 } // {bl}
 
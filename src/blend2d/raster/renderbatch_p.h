@@ -51,6 +51,10 @@ public:
   uint32_t _commandCount;
   uint32_t _bandCount;
   uint32_t _stateSlotCount;
+  //! Number of commands marked as occluders, zero if occlusion culling is disabled.
+  uint32_t _occluderCount;
+  //! Index of the last occluder command, commands after it cannot be culled.
+  uint32_t _lastOccluderIndex;
 
   //! \}
 
@@ -69,6 +73,8 @@ public:
 
   BL_INLINE_NODEBUG uint32_t bandCount() const noexcept { return _bandCount; }
   BL_INLINE_NODEBUG uint32_t stateSlotCount() const noexcept { return _stateSlotCount; }
+  BL_INLINE_NODEBUG uint32_t occluderCount() const noexcept { return _occluderCount; }
+  BL_INLINE_NODEBUG uint32_t lastOccluderIndex() const noexcept { return _lastOccluderIndex; }
 
   BL_INLINE void accumulateErrorFlags(uint32_t errorFlags) noexcept {
     blAtomicFetchOrRelaxed(&_accumulatedErrorFlags, errorFlags);
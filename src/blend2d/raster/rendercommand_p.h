@@ -7,6 +7,7 @@
 #define BLEND2D_RASTER_RENDERCOMMAND_P_H_INCLUDED
 
 #include "../geometry_p.h"
+#include "../path_p.h"
 #include "../pipeline/pipedefs_p.h"
 #include "../raster/edgebuilder_p.h"
 #include "../raster/rasterdefs_p.h"
@@ -42,7 +43,8 @@ enum class RenderCommandType : uint8_t {
   kFillBoxA = 1,
   kFillBoxU = 2,
   kFillAnalytic = 3,
-  kFillBoxMaskA = 4
+  kFillBoxMaskA = 4,
+  kFillBoxListA = 5
 };
 
 //! Raster command flags.
@@ -50,6 +52,13 @@ enum class RenderCommandFlags : uint8_t {
   //! No flags specified.
   kNoFlags = 0x00u,
 
+  //! The command is FillBoxA or FillBoxListA that replaces all pixels it covers, used by occlusion culling.
+  kOccluder = 0x01u,
+
+  //! The command is FillAnalytic that retains `_payload.analytic.edgeCache`, which owns its edges and which must be
+  //! released during batch finalization.
+  kRetainsEdgeCache = 0x02u,
+
   //! The command holds `_source.fetchData` (the operation is non-solid, fetch-data is valid and used).
   kHasStyleFetchData = 0x10u,
 
@@ -90,6 +99,9 @@ struct RenderCommand {
   //! Maximum size of the payload embedded in the \ref RenderCommand itself.
   enum PayloadDataSize : uint32_t { kPayloadDataSize = 32 };
 
+  //! Maximum number of boxes of a FillBoxListA command (also the capacity of its box array).
+  enum BoxListCapacity : uint32_t { kBoxListCapacity = 32 };
+
   //! \}
 
   //! \name Payload
@@ -111,10 +123,24 @@ struct RenderCommand {
     BLBoxI boxI;
   };
 
+  //! FillBoxListA payload - aligned boxes of consecutive fills that were coalesced into a single command.
+  //!
+  //! The bounding box is stored at the same offset as `FillBox::boxI`, so `boxI()` works for both payloads.
+  struct FillBoxListA {
+    Ptr64<BLBoxI> boxes;
+    uint32_t boxCount;
+    uint32_t reserved;
+    BLBoxI boxI;
+  };
+
   //! FillAnalytic and FillMaskAnalytic payload, used by the asynchronous rendering context implementation.
   struct FillAnalytic {
-    //! Fetch data used by mask `kTypeFillMaskAnalytic` command types.
-    Ptr64<RenderFetchData> maskFetchData;
+    union {
+      //! Fetch data used by mask `kTypeFillMaskAnalytic` command types.
+      Ptr64<RenderFetchData> maskFetchData;
+      //! Edge cache of a prepared path that owns `edges`, only valid if the command has \ref RenderCommandFlags::kRetainsEdgeCache.
+      Ptr64<BLPathEdgeCache> edgeCache;
+    };
     //! Points to the start of the first edge. Edges that start in next bands are linked next after edges of the previous
     //! band, which makes it possible to only store the start of the list.
     Ptr64<const EdgeVector<int>> edges;
@@ -133,6 +159,8 @@ struct RenderCommand {
     FillBox box;
     //! Payload used by FillBoxAMaskA.
     FillBoxMaskA boxMaskA;
+    //! Payload used by FillBoxListA.
+    FillBoxListA boxList;
     //! Payload used by FillAnalytic in case of asynchronous rendering.
     FillAnalytic analytic;
 
@@ -146,6 +174,7 @@ struct RenderCommand {
   BL_STATIC_ASSERT(sizeof(Payload) == kPayloadDataSize);
   BL_STATIC_ASSERT(sizeof(FillBox) == kPayloadDataSize);
   BL_STATIC_ASSERT(sizeof(FillBoxMaskA) <= kPayloadDataSize);
+  BL_STATIC_ASSERT(sizeof(FillBoxListA) == kPayloadDataSize);
   BL_STATIC_ASSERT(sizeof(FillAnalytic) <= kPayloadDataSize);
 
   //! \}
@@ -216,6 +245,37 @@ struct RenderCommand {
     _type = RenderCommandType::kFillBoxMaskA;
   }
 
+  //! Converts FillBoxA command to FillBoxListA command that uses `boxes` array, which must have at least
+  //! `kBoxListCapacity` items. The original box becomes the first box of the list.
+  BL_INLINE void convertFillBoxAToList(BLBoxI* boxes) noexcept {
+    BL_ASSERT(isFillBoxA());
+
+    boxes[0] = _payload.box.boxI;
+    _payload.boxList.boxes.ptr = boxes;
+    _payload.boxList.boxCount = 1;
+    _payload.boxList.reserved = 0;
+    _type = RenderCommandType::kFillBoxListA;
+  }
+
+  //! Appends `boxA` to FillBoxListA command and updates its bounding box.
+  BL_INLINE void appendFillBoxListA(const BLBoxI& boxA) noexcept {
+    BL_ASSERT(isFillBoxListA());
+    BL_ASSERT(_payload.boxList.boxCount < kBoxListCapacity);
+
+    FillBoxListA& boxList = _payload.boxList;
+    boxList.boxes.ptr[boxList.boxCount++] = boxA;
+    boxList.boxI.reset(blMin(boxList.boxI.x0, boxA.x0), blMin(boxList.boxI.y0, boxA.y0),
+                       blMax(boxList.boxI.x1, boxA.x1), blMax(boxList.boxI.y1, boxA.y1));
+  }
+
+  //! Makes FillAnalytic command use edges of a prepared path owned by `edgeCache`, which must be already retained.
+  BL_INLINE void initFillAnalyticEdgeCache(BLPathEdgeCache* edgeCache) noexcept {
+    BL_ASSERT(isFillAnalytic());
+
+    _payload.analytic.edgeCache.ptr = edgeCache;
+    addFlags(RenderCommandFlags::kRetainsEdgeCache);
+  }
+
   //! Sets edges of FillAnalytic or FillMaskAnalytic command.
   BL_INLINE void setAnalyticEdges(EdgeStorage<int>* edgeStorage) noexcept {
     _payload.analytic.edges.ptr = edgeStorage->flattenEdgeLinks();
@@ -244,12 +304,15 @@ struct RenderCommand {
   BL_INLINE_NODEBUG bool isFillBoxU() const noexcept { return _type == RenderCommandType::kFillBoxU; }
   BL_INLINE_NODEBUG bool isFillAnalytic() const noexcept { return _type == RenderCommandType::kFillAnalytic; }
   BL_INLINE_NODEBUG bool isFillBoxMaskA() const noexcept { return _type == RenderCommandType::kFillBoxMaskA; }
+  BL_INLINE_NODEBUG bool isFillBoxListA() const noexcept { return _type == RenderCommandType::kFillBoxListA; }
 
   BL_INLINE_NODEBUG RenderCommandFlags flags() const noexcept { return RenderCommandFlags(_flags); }
   BL_INLINE_NODEBUG bool hasFlag(RenderCommandFlags flag) const noexcept { return uint32_t(_flags & flag) != 0; }
   BL_INLINE_NODEBUG void addFlags(RenderCommandFlags flags) noexcept { _flags |= flags; }
 
+  BL_INLINE_NODEBUG bool isOccluder() const noexcept { return hasFlag(RenderCommandFlags::kOccluder); }
   BL_INLINE_NODEBUG bool hasStyleFetchData() const noexcept { return hasFlag(RenderCommandFlags::kHasStyleFetchData); }
+  BL_INLINE_NODEBUG bool retainsEdgeCache() const noexcept { return hasFlag(RenderCommandFlags::kRetainsEdgeCache); }
   BL_INLINE_NODEBUG bool retainsStyleFetchData() const noexcept { return hasFlag(RenderCommandFlags::kRetainsStyleFetchData); }
   BL_INLINE_NODEBUG bool retainsMask() const noexcept { return hasFlag(RenderCommandFlags::kRetainsMaskImageData | RenderCommandFlags::kRetainsMaskFetchData); }
   BL_INLINE_NODEBUG bool retainsMaskImageData() const noexcept { return hasFlag(RenderCommandFlags::kRetainsMaskImageData); }
@@ -258,6 +321,16 @@ struct RenderCommand {
   BL_INLINE_NODEBUG uint32_t alpha() const noexcept { return _alpha; }
   BL_INLINE_NODEBUG const BLBoxI& boxI() const noexcept { return _payload.box.boxI; }
 
+  BL_INLINE const BLBoxI* boxListData() const noexcept {
+    BL_ASSERT(isFillBoxListA());
+    return _payload.boxList.boxes.ptr;
+  }
+
+  BL_INLINE uint32_t boxListSize() const noexcept {
+    BL_ASSERT(isFillBoxListA());
+    return _payload.boxList.boxCount;
+  }
+
   BL_INLINE uint32_t analyticFillRule() const noexcept {
     BL_ASSERT(isFillAnalytic());
     return _payload.analytic.fillRule;
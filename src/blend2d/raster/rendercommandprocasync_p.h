@@ -59,6 +59,9 @@ public:
   size_t _pendingCommandBitSetSize;
   BLBitWord _pendingCommandBitSetMask;
 
+  //! Commands culled in the current band, only allocated when the batch contains occluders.
+  BLBitWord* _culledCommandBitSetData;
+
   AnalyticActiveEdge<int>* _pooledEdges;
 
   //! \}
@@ -78,6 +81,7 @@ public:
       _pendingCommandBitSetData(nullptr),
       _pendingCommandBitSetSize(0),
       _pendingCommandBitSetMask(0),
+      _culledCommandBitSetData(nullptr),
       _pooledEdges(nullptr) {}
 
   //! \}
@@ -98,6 +102,12 @@ public:
     if (!_stateSlotData || !_pendingCommandBitSetData)
       return blTraceError(BL_ERROR_OUT_OF_MEMORY);
 
+    if (_batch->occluderCount()) {
+      _culledCommandBitSetData = _workData->workZone.allocT<BLBitWord>(bitWordCount * sizeof(BLBitWord), sizeof(BLBitWord));
+      if (!_culledCommandBitSetData)
+        return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+    }
+
     _stateSlotCount = stateSlotCount;
     _pendingCommandBitSetSize = bitWordCount;
 
@@ -143,6 +153,9 @@ public:
   BL_INLINE BLBitWord pendingCommandBitSetMask() const noexcept { return _pendingCommandBitSetMask; }
   BL_INLINE void clearPendingCommandBitSetMask() noexcept { _pendingCommandBitSetMask = 0; }
 
+  BL_INLINE bool hasCulledCommandBitSet() const noexcept { return _culledCommandBitSetData != nullptr; }
+  BL_INLINE BLBitWord* culledCommandBitSetData() const noexcept { return _culledCommandBitSetData; }
+
   BL_INLINE SlotData& stateDataAt(size_t index) noexcept {
     BL_ASSERT(index < _stateSlotCount);
     return _stateSlotData[index];
@@ -174,6 +187,37 @@ static BL_INLINE CommandStatus fillBoxA(ProcData& procData, const RenderCommand&
   return CommandStatus(command.boxI().y1 <= int(procData.bandY1()));
 }
 
+static CommandStatus fillBoxListA(ProcData& procData, const RenderCommand& command) noexcept {
+  int bandY0 = int(procData.bandY0());
+  int bandY1 = int(procData.bandY1());
+
+  Pipeline::FillFunc fillFunc = command.pipeDispatchData()->fillFunc;
+  const void* fetchData = command.getPipeFetchData();
+
+  // Only solid fills are merged into box lists, thus there is nothing to fetch.
+  BL_ASSERT(command.pipeDispatchData()->fetchFunc == nullptr);
+
+  // Boxes must be filled in the order they were added as they can overlap.
+  const BLBoxI* boxes = command.boxListData();
+  uint32_t boxCount = command.boxListSize();
+
+  for (uint32_t i = 0; i < boxCount; i++) {
+    const BLBoxI& boxI = boxes[i];
+
+    int y0 = blMax(boxI.y0, bandY0);
+    int y1 = blMin(boxI.y1, bandY1);
+
+    if (y0 < y1) {
+      Pipeline::FillData fillData;
+      fillData.initBoxA8bpc(command.alpha(), boxI.x0, y0, boxI.x1, y1);
+
+      fillFunc(&procData.workData()->ctxData, &fillData, fetchData);
+    }
+  }
+
+  return CommandStatus(command.boxI().y1 <= bandY1);
+}
+
 static BL_INLINE CommandStatus fillBoxU(ProcData& procData, const RenderCommand& command) noexcept {
   int y0 = blMax(command.boxI().y0, int(procData.bandFixedY0()));
   int y1 = blMin(command.boxI().y1, int(procData.bandFixedY1()));
@@ -470,6 +514,21 @@ SaveState:
   return CommandStatus(!edges && !active);
 }
 
+//! Returns the status of a box `command` that was culled in the current band, because a later occluder covers it.
+static BL_INLINE CommandStatus skipCulledCommand(ProcData& procData, const RenderCommand& command) noexcept {
+  switch (command.type()) {
+    case RenderCommandType::kFillBoxU:
+      return CommandStatus(command.boxI().y1 <= int(procData.bandFixedY1()));
+
+    case RenderCommandType::kFillBoxMaskA:
+      return CommandStatus(command._payload.boxMaskA.boxI.y1 <= int(procData.bandY1()));
+
+    default:
+      BL_ASSERT(command.isFillBoxA() || command.isFillBoxListA());
+      return CommandStatus(command.boxI().y1 <= int(procData.bandY1()));
+  }
+}
+
 static CommandStatus processCommand(ProcData& procData, const RenderCommand& command, int32_t prevBandFy1, int32_t nextBandFy0) noexcept {
   switch (command.type()) {
     case RenderCommandType::kFillBoxA:
@@ -484,6 +543,9 @@ static CommandStatus processCommand(ProcData& procData, const RenderCommand& com
     case RenderCommandType::kFillBoxMaskA:
       return fillBoxMaskA(procData, command);
 
+    case RenderCommandType::kFillBoxListA:
+      return fillBoxListA(procData, command);
+
     default:
       return CommandStatus::kDone;
   }
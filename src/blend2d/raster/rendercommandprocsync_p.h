@@ -85,20 +85,22 @@ static BL_INLINE BLResult fillBoxMaskedA(WorkData& workData, const Pipeline::Dis
   return BL_SUCCESS;
 }
 
-static BL_NOINLINE BLResult fillAnalytic(WorkData& workData, const Pipeline::DispatchData& dispatchData, uint32_t alpha, const EdgeStorage<int>* edgeStorage, BLFillRule fillRule, const void* fetchData) noexcept {
+// Rasterizes either edges stored in band lists of `workData.edgeStorage` (`bandEdges` is non-null), which are consumed,
+// or a read-only list of `sortedEdges` sorted by their first row, which is shared with other render calls.
+static BL_NOINLINE BLResult fillAnalyticEdges(WorkData& workData, const Pipeline::DispatchData& dispatchData, uint32_t alpha, EdgeList<int>* bandEdges, const EdgeVector<int>* sortedEdges, const BLBoxI& boundingBox, BLFillRule fillRule, const void* fetchData) noexcept {
   // Rasterizer options to use - do not change unless you are improving the existing rasterizers.
   constexpr uint32_t kRasterizerOptions = AnalyticRasterizer::kOptionBandOffset | AnalyticRasterizer::kOptionRecordMinXMaxX;
 
-  // Can only be called if there is something to fill.
-  BL_ASSERT(edgeStorage != nullptr);
   // Should have been verified by the caller.
-  BL_ASSERT(edgeStorage->boundingBox().y0 < edgeStorage->boundingBox().y1);
+  BL_ASSERT(boundingBox.y0 < boundingBox.y1);
 
+  const EdgeStorage<int>* edgeStorage = &workData.edgeStorage;
   uint32_t bandHeight = edgeStorage->bandHeight();
   uint32_t bandHeightMask = bandHeight - 1;
+  uint32_t fixedBandHeightShift = edgeStorage->fixedBandHeightShift();
 
-  const uint32_t yStart = (uint32_t(edgeStorage->boundingBox().y0)                          ) >> Pipeline::A8Info::kShift;
-  const uint32_t yEnd   = (uint32_t(edgeStorage->boundingBox().y1) + Pipeline::A8Info::kMask) >> Pipeline::A8Info::kShift;
+  const uint32_t yStart = (uint32_t(boundingBox.y0)                          ) >> Pipeline::A8Info::kShift;
+  const uint32_t yEnd   = (uint32_t(boundingBox.y1) + Pipeline::A8Info::kMask) >> Pipeline::A8Info::kShift;
 
   size_t requiredWidth = IntOps::alignUp(uint32_t(workData.dstSize().w) + 1u + BL_PIPE_PIXELS_PER_ONE_BIT, BL_PIPE_PIXELS_PER_ONE_BIT);
   size_t requiredHeight = bandHeight;
@@ -121,9 +123,8 @@ static BL_NOINLINE BLResult fillAnalytic(WorkData& workData, const Pipeline::Dis
   AnalyticActiveEdge<int>* active = nullptr;
   AnalyticActiveEdge<int>* pooled = nullptr;
 
-  EdgeList<int>* bandEdges = edgeStorage->bandEdges();
-  uint32_t bandId = edgeStorage->bandStartFromBBox();
-  uint32_t bandEnd = edgeStorage->bandEndFromBBox();
+  uint32_t bandId = unsigned(boundingBox.y0) >> fixedBandHeightShift;
+  uint32_t bandEnd = blMin((unsigned(boundingBox.y1) >> fixedBandHeightShift) + 1, edgeStorage->bandCount());
 
   uint32_t dstWidth = uint32_t(workData.dstSize().w);
 
@@ -142,9 +143,12 @@ static BL_NOINLINE BLResult fillAnalytic(WorkData& workData, const Pipeline::Dis
   ras._bandOffset = yStart;
 
   ArenaAllocator* workZone = &workData.workZone;
+  const EdgeVector<int>* edges = sortedEdges;
   do {
-    EdgeVector<int>* edges = bandEdges[bandId].first();
-    bandEdges[bandId].reset();
+    if (bandEdges) {
+      edges = bandEdges[bandId].first();
+      bandEdges[bandId].reset();
+    }
 
     AnalyticActiveEdge<int>** pPrev = &active;
     AnalyticActiveEdge<int>* current = *pPrev;
@@ -192,7 +196,7 @@ SaveState:
       }
     }
 
-    if (edges) {
+    if (edges && (uint32_t(edges->pts[0].y) >> fixedBandHeightShift) <= bandId) {
       if (!pooled) {
         pooled = static_cast<AnalyticActiveEdge<int>*>(workZone->alloc(sizeof(AnalyticActiveEdge<int>)));
         if (BL_UNLIKELY(!pooled))
@@ -231,7 +235,7 @@ SaveState:
               goto SaveState;
           }
         } while (pts != end);
-      } while (edges);
+      } while (edges && (uint32_t(edges->pts[0].y) >> fixedBandHeightShift) <= bandId);
     }
 
     // Makes `active` or the last `AnalyticActiveEdge->next` null. It's important, because we don't unlink during
@@ -254,6 +258,16 @@ SaveState:
   return BL_SUCCESS;
 }
 
+static BL_INLINE BLResult fillAnalytic(WorkData& workData, const Pipeline::DispatchData& dispatchData, uint32_t alpha, EdgeStorage<int>* edgeStorage, BLFillRule fillRule, const void* fetchData) noexcept {
+  // Can only be called if there is something to fill.
+  BL_ASSERT(edgeStorage == &workData.edgeStorage);
+  return fillAnalyticEdges(workData, dispatchData, alpha, edgeStorage->bandEdges(), nullptr, edgeStorage->boundingBox(), fillRule, fetchData);
+}
+
+static BL_INLINE BLResult fillAnalytic(WorkData& workData, const Pipeline::DispatchData& dispatchData, uint32_t alpha, const EdgeVector<int>* sortedEdges, const BLBoxI& boundingBox, BLFillRule fillRule, const void* fetchData) noexcept {
+  return fillAnalyticEdges(workData, dispatchData, alpha, nullptr, sortedEdges, boundingBox, fillRule, fetchData);
+}
+
 } // {CommandProcSync}
 } // {RasterEngine}
 } // {bl}
@@ -35,5 +35,55 @@ BLResult computePendingFetchData(RenderFetchData* fetchData) noexcept {
   return BL_SUCCESS;
 }
 
+// Returns a mipmap level to use to render `area` of `imageI` transformed by `transform`, zero means the image itself.
+//
+// Mipmaps are only used when the whole image is used as a source (pattern or blit without an area) and when the image
+// is not attached to a rendering context (it could be modified during rendering). Repeat and reflect extend modes
+// require the image size to be divisible by `2^level` as otherwise the period of the pattern would not be preserved.
+static uint32_t selectMipLevel(BLImagePrivateImpl* imageI, const BLRectI& area, BLExtendMode extendMode, BLPatternQuality quality, const BLMatrix2D& transform) noexcept {
+  if (quality == BL_PATTERN_QUALITY_NEAREST || imageI->writerCount != 0 || ObjectInternal::isImplExternal(imageI))
+    return 0;
+
+  if (area != BLRectI(0, 0, imageI->size.w, imageI->size.h))
+    return 0;
+
+  double scale = blMax(Math::hypot(transform.m00, transform.m01), Math::hypot(transform.m10, transform.m11));
+  uint32_t maxLevel = BLImageMipChain::kMaxLevels;
+
+  if (extendMode != BL_EXTEND_MODE_PAD)
+    maxLevel = IntOps::ctz(uint32_t(imageI->size.w | imageI->size.h));
+
+  uint32_t level = 0;
+  while (scale <= 0.5 && level < maxLevel) {
+    scale *= 2.0;
+    level++;
+  }
+  return level;
+}
+
+bool RenderFetchData::setupPatternAffineMipmapped(BLImageImpl* imageI_, const BLRectI& area, BLExtendMode extendMode, BLPatternQuality quality, const BLMatrix2D& transform) noexcept {
+  BLImagePrivateImpl* imageI = static_cast<BLImagePrivateImpl*>(imageI_);
+  uint32_t bytesPerPixel = imageI->depth / 8u;
+  uint32_t level = selectMipLevel(imageI, area, extendMode, quality, transform);
+
+  if (level) {
+    const BLImageMipChain* mipChain = ImageInternal::ensureMipChain(imageI);
+    if (mipChain) {
+      level = blMin(level, mipChain->levelCount);
+      const BLImageMipChain::Level& mipLevel = mipChain->levels[level - 1u];
+
+      // Pixels of the mipmap level are `2^level` times larger than the image pixels, so scale them up to compensate.
+      double f = double(1u << level);
+      BLMatrix2D levelTransform(transform.m00 * f, transform.m01 * f, transform.m10 * f, transform.m11 * f, transform.m20, transform.m21);
+
+      Pipeline::FetchUtils::initImageSource(pipelineData.pattern, mipLevel.pixelData, mipLevel.stride, mipLevel.size.w, mipLevel.size.h);
+      return setupPatternAffine(extendMode, quality, bytesPerPixel, levelTransform);
+    }
+  }
+
+  initImageSource(imageI, area);
+  return setupPatternAffine(extendMode, quality, bytesPerPixel, transform);
+}
+
 } // {RasterEngine}
 } // {bl}
@@ -173,6 +173,11 @@ struct alignas(16) RenderFetchData : public RenderFetchDataHeader {
     return !signature.hasPendingFlag();
   }
 
+  //! Initializes the image source and affine fetch of `area` of `imageI`. If the transformation scales the image
+  //! down to 50% or less, a mipmap level of the image is used as a source instead (the transformation is adjusted
+  //! accordingly), which improves quality and reduces memory bandwidth of heavily downscaled images.
+  BL_HIDDEN bool setupPatternAffineMipmapped(BLImageImpl* imageI, const BLRectI& area, BLExtendMode extendMode, BLPatternQuality quality, const BLMatrix2D& transform) noexcept;
+
   //! \}
 
   //! \name Reference Counting
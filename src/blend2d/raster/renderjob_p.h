@@ -7,6 +7,7 @@
 #define BLEND2D_RASTER_RENDERJOB_P_H_INCLUDED
 
 #include "../geometry_p.h"
+#include "../path_p.h"
 #include "../pipeline/pipedefs_p.h"
 #include "../raster/edgebuilder_p.h"
 #include "../raster/renderbatch_p.h"
@@ -32,7 +33,10 @@ enum class RenderJobType : uint8_t {
   kStrokeGeometry = 3,
   kStrokeText = 4,
 
-  kMaxValue = 4
+  kFillPathShard = 5,
+  kFillPathInstances = 6,
+
+  kMaxValue = 6
 };
 
 enum class RenderJobFlags : uint8_t {
@@ -165,8 +169,135 @@ struct RenderJob_GeometryOp : public RenderJob_BaseOp {
   BL_INLINE_NODEBUG const T* geometryData() const noexcept { return reinterpret_cast<const T*>(this + 1); }
 };
 
+//! Edges built by a single shard of a sharded fill path operation, stored per band.
+struct PathShardEdges {
+  //! Edge lists of bands in `[bandStart, bandEnd)` range, the first list belongs to `bandStart`.
+  EdgeList<int>* bandEdges;
+  uint32_t bandStart;
+  uint32_t bandEnd;
+  //! Bounding box of the edges (in fixed point).
+  BLBoxI boundingBox;
+};
+
+//! Data shared by all shards of a fill path operation. A large path is split into shards so several workers can build
+//! its edges concurrently, the last shard that finishes merges edges of all shards and assigns them to the command.
+struct PathShardGroup {
+  BLPathCore _path;
+  size_t _pendingCount;
+  uint32_t _shardCount;
+  uint32_t _reserved;
+  PathShardEdges _shards[1];
+
+  static BL_INLINE_NODEBUG size_t sizeOf(uint32_t shardCount) noexcept {
+    return sizeof(PathShardGroup) + (shardCount - 1u) * sizeof(PathShardEdges);
+  }
+
+  BL_INLINE void init(const BLPathCore* path, uint32_t shardCount) noexcept {
+    blObjectPrivateInitWeakTagged(&_path, path);
+    _pendingCount = shardCount;
+    _shardCount = shardCount;
+    _reserved = 0;
+
+    for (uint32_t i = 0; i < shardCount; i++)
+      _shards[i] = PathShardEdges{nullptr, 0, 0, BLBoxI(Traits::maxValue<int>(), Traits::maxValue<int>(), Traits::minValue<int>(), Traits::minValue<int>())};
+  }
+
+  BL_INLINE_NODEBUG const BLPath& path() const noexcept { return _path.dcast(); }
+  BL_INLINE_NODEBUG uint32_t shardCount() const noexcept { return _shardCount; }
+  BL_INLINE_NODEBUG PathShardEdges& shardAt(size_t index) noexcept { return _shards[index]; }
+
+  //! Marks a shard as finished and returns true if it was the last one.
+  BL_INLINE bool finishShard() noexcept { return blAtomicFetchSubStrong(&_pendingCount) == 1u; }
+
+  BL_INLINE void destroy() noexcept { _path.dcast().~BLPath(); }
+};
+
+//! Builds edges of a single shard, which is a range of path commands, of a sharded fill path operation.
+struct RenderJob_PathShardOp : public RenderJob_BaseOp {
+  PathShardGroup* _group;
+  size_t _shardStart;
+  size_t _shardEnd;
+  uint32_t _shardIndex;
+
+  BL_INLINE void initFillJob(RenderCommandQueue* commandQueue, size_t commandIndex) noexcept {
+    _initInternal(RenderJobType::kFillPathShard, commandQueue, commandIndex);
+  }
+
+  BL_INLINE void initShard(PathShardGroup* group, uint32_t shardIndex, size_t shardStart, size_t shardEnd) noexcept {
+    _group = group;
+    _shardStart = shardStart;
+    _shardEnd = shardEnd;
+    _shardIndex = shardIndex;
+  }
+
+  BL_INLINE_NODEBUG PathShardGroup* group() const noexcept { return _group; }
+  BL_INLINE_NODEBUG uint32_t shardIndex() const noexcept { return _shardIndex; }
+  BL_INLINE_NODEBUG size_t shardStart() const noexcept { return _shardStart; }
+  BL_INLINE_NODEBUG size_t shardEnd() const noexcept { return _shardEnd; }
+};
+
+//! A single instance of a path filled by `RenderJob_PathInstancesOp`, which assigns edges to the instance's command.
+struct PathInstance {
+  RenderCommandQueue* commandQueue;
+  uint32_t commandIndex;
+  //! Whether the instance is clipped, in that case its edges are built from the path instead of being translated.
+  uint32_t clipped;
+  //! Fixed-point origin of the instance (always integral).
+  BLPoint originFixed;
+};
+
+//! Builds edges of all instances of a path filled by `fillPathInstances()` that were enqueued to the same batch.
+//!
+//! Edges of instances that are not clipped are translated edges of the edge cache, which was built with the origin
+//! `edgeCacheOrigin`, other instances are built from the path by the edge builder.
+struct RenderJob_PathInstancesOp : public RenderJob_BaseOp {
+  BLPathCore _path;
+  BLPathEdgeCache* _edgeCache;
+  BLPointI _edgeCacheOrigin;
+  PathInstance* _instances;
+  size_t _instanceCount;
+  size_t _instanceCapacity;
+
+  BL_INLINE void initFillJob(const BLPathCore* path, PathInstance* instances, size_t instanceCapacity) noexcept {
+    // Instances reference their commands, the job itself doesn't have any.
+    _initInternal(RenderJobType::kFillPathInstances, nullptr, 0);
+    blObjectPrivateInitWeakTagged(&_path, path);
+    _edgeCache = nullptr;
+    _edgeCacheOrigin.reset();
+    _instances = instances;
+    _instanceCount = 0;
+    _instanceCapacity = instanceCapacity;
+  }
+
+  //! Assigns a retained `edgeCache` built with `edgeCacheOrigin` to the job.
+  BL_INLINE void setEdgeCache(BLPathEdgeCache* edgeCache, const BLPointI& edgeCacheOrigin) noexcept {
+    _edgeCache = edgeCache;
+    _edgeCacheOrigin = edgeCacheOrigin;
+  }
+
+  BL_INLINE void addInstance(RenderCommandQueue* commandQueue, size_t commandIndex, bool clipped, const BLPoint& originFixed) noexcept {
+    BL_ASSERT(_instanceCount < _instanceCapacity);
+    _instances[_instanceCount++] = PathInstance{commandQueue, uint32_t(commandIndex), uint32_t(clipped), originFixed};
+  }
+
+  BL_INLINE void destroy() noexcept {
+    _path.dcast().~BLPath();
+    if (_edgeCache)
+      PathInternal::releaseEdgeCache(_edgeCache);
+  }
+
+  BL_INLINE_NODEBUG const BLPath& path() const noexcept { return _path.dcast(); }
+  BL_INLINE_NODEBUG const BLPathEdgeCache* edgeCache() const noexcept { return _edgeCache; }
+  BL_INLINE_NODEBUG const BLPointI& edgeCacheOrigin() const noexcept { return _edgeCacheOrigin; }
+  BL_INLINE_NODEBUG bool hasEdgeCache() const noexcept { return _edgeCache != nullptr; }
+  BL_INLINE_NODEBUG size_t instanceCount() const noexcept { return _instanceCount; }
+  BL_INLINE_NODEBUG bool full() const noexcept { return _instanceCount == _instanceCapacity; }
+  BL_INLINE_NODEBUG const PathInstance& instanceAt(size_t index) const noexcept { return _instances[index]; }
+};
+
 struct RenderJob_TextOp : public RenderJob_BaseOp {
   BLFontCore _font;
+  GlyphOriginQuantizer _glyphOriginQuantizer;
 
   union {
     BLArrayView<uint8_t> _textData;
@@ -192,6 +323,10 @@ struct RenderJob_TextOp : public RenderJob_BaseOp {
     blObjectPrivateInitWeakTagged(&_font, &font);
   }
 
+  BL_INLINE void initGlyphOriginQuantizer(const GlyphOriginQuantizer& quantizer) noexcept {
+    _glyphOriginQuantizer = quantizer;
+  }
+
   BL_INLINE void initTextData(const void* text, size_t size, BLTextEncoding encoding) noexcept {
     _payloadType = uint8_t(encoding);
     _textData.reset(static_cast<const uint8_t*>(text), size);
@@ -218,6 +353,7 @@ struct RenderJob_TextOp : public RenderJob_BaseOp {
   BL_INLINE_NODEBUG const void* textData() const noexcept { return _textData.data; }
   BL_INLINE_NODEBUG size_t textSize() const noexcept { return _textData.size; }
   BL_INLINE_NODEBUG const BLGlyphBuffer& glyphBuffer() const noexcept { return _glyphBuffer.dcast(); }
+  BL_INLINE_NODEBUG const GlyphOriginQuantizer& glyphOriginQuantizer() const noexcept { return _glyphOriginQuantizer; }
 };
 
 } // {RasterEngine}
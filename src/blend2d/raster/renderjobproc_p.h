@@ -111,11 +111,8 @@ static BL_INLINE void finalizeGeometryData(WorkData* workData, RenderJob_Geometr
     job->geometryData<BLPath>()->~BLPath();
 }
 
-template<typename Job>
-static BL_INLINE void assignEdges(WorkData* workData, Job* job, EdgeStorage<int>* edgeStorage) noexcept {
+static BL_INLINE void assignEdges(WorkData* workData, RenderCommandQueue* commandQueue, size_t commandIndex, EdgeStorage<int>* edgeStorage) noexcept {
   if (!edgeStorage->empty()) {
-    RenderCommandQueue* commandQueue = job->commandQueue();
-    size_t commandIndex = job->commandIndex();
     uint8_t qy0 = uint8_t((edgeStorage->boundingBox().y0) >> workData->commandQuantizationShiftFp());
 
     commandQueue->initQuantizedY0(commandIndex, qy0);
@@ -124,6 +121,11 @@ static BL_INLINE void assignEdges(WorkData* workData, Job* job, EdgeStorage<int>
   }
 }
 
+template<typename Job>
+static BL_INLINE void assignEdges(WorkData* workData, Job* job, EdgeStorage<int>* edgeStorage) noexcept {
+  assignEdges(workData, job->commandQueue(), job->commandIndex(), edgeStorage);
+}
+
 // bl::RasterEngine - Job Processor - Fill Geometry Job
 // ====================================================
 
@@ -143,6 +145,102 @@ static void processFillGeometryJob(WorkData* workData, RenderJob_GeometryOp* job
   finalizeGeometryData(workData, job);
 }
 
+// bl::RasterEngine - Job Processor - Fill Path Shard Job
+// ======================================================
+
+// Moves band lists of `edgeStorage` to `shard`, so the edge storage can be used by other jobs of the worker.
+static BL_INLINE void storeShardEdges(WorkData* workData, PathShardEdges& shard, EdgeStorage<int>* edgeStorage) noexcept {
+  if (edgeStorage->empty())
+    return;
+
+  uint32_t bandStart = edgeStorage->bandStartFromBBox();
+  uint32_t bandEnd = edgeStorage->bandEndFromBBox();
+  EdgeList<int>* bandEdges = workData->workZone.allocT<EdgeList<int>>((bandEnd - bandStart) * sizeof(EdgeList<int>));
+
+  if (BL_UNLIKELY(!bandEdges)) {
+    workData->accumulateError(blTraceError(BL_ERROR_OUT_OF_MEMORY));
+    edgeStorage->clear();
+    return;
+  }
+
+  for (uint32_t bandId = bandStart; bandId < bandEnd; bandId++) {
+    bandEdges[bandId - bandStart] = edgeStorage->bandEdges()[bandId];
+    edgeStorage->bandEdges()[bandId].reset();
+  }
+
+  shard.bandEdges = bandEdges;
+  shard.bandStart = bandStart;
+  shard.bandEnd = bandEnd;
+  shard.boundingBox = edgeStorage->boundingBox();
+  edgeStorage->resetBoundingBox();
+}
+
+// Merges band lists of all shards into `edgeStorage`, which must be empty. Shards are merged in their order, thus
+// each band contains edges in the same order as if the path was not sharded.
+static BL_INLINE void mergeShardEdges(PathShardGroup* group, EdgeStorage<int>* edgeStorage) noexcept {
+  for (uint32_t i = 0; i < group->shardCount(); i++) {
+    const PathShardEdges& shard = group->shardAt(i);
+
+    for (uint32_t bandId = shard.bandStart; bandId < shard.bandEnd; bandId++)
+      edgeStorage->bandEdges()[bandId].appendList(shard.bandEdges[bandId - shard.bandStart]);
+
+    Geometry::bound(edgeStorage->_boundingBox, shard.boundingBox);
+  }
+}
+
+static void processFillPathShardJob(WorkData* workData, RenderJob_PathShardOp* job) noexcept {
+  PathShardGroup* group = job->group();
+
+  JobStateAccessor accessor(job);
+  prepareEdgeBuilder(workData, accessor.fillState());
+  BLResult result = addFilledPathShardEdges(workData, group->path().view(), job->shardStart(), job->shardEnd(), accessor.finalTransformFixed(job->originFixed()), accessor.finalTransformFixedType());
+
+  if (result == BL_SUCCESS) {
+    storeShardEdges(workData, group->shardAt(job->shardIndex()), &workData->edgeStorage);
+  }
+
+  if (group->finishShard()) {
+    mergeShardEdges(group, &workData->edgeStorage);
+    assignEdges(workData, job, &workData->edgeStorage);
+    group->destroy();
+  }
+}
+
+// bl::RasterEngine - Job Processor - Fill Path Instances Job
+// ===========================================================
+
+static void processFillPathInstancesJob(WorkData* workData, RenderJob_PathInstancesOp* job) noexcept {
+  JobStateAccessor accessor(job);
+  prepareEdgeBuilder(workData, accessor.fillState());
+
+  const BLPathView pathView = job->path().view();
+  const BLPointI& edgeCacheOrigin = job->edgeCacheOrigin();
+  BLTransformType transformType = blMax<BLTransformType>(accessor.finalTransformFixedType(), BL_TRANSFORM_TYPE_TRANSLATE);
+
+  for (size_t i = 0; i < job->instanceCount(); i++) {
+    const PathInstance& instance = job->instanceAt(i);
+    BLResult result;
+
+    // Edges of previous instances were already assigned to their commands, thus only edges of this instance can
+    // be reverted in case of failure.
+    workData->saveState();
+
+    if (instance.clipped) {
+      result = addFilledPathEdges(workData, pathView, accessor.finalTransformFixed(instance.originFixed), transformType);
+    }
+    else {
+      BLPointI offset(int(instance.originFixed.x) - edgeCacheOrigin.x, int(instance.originFixed.y) - edgeCacheOrigin.y);
+      result = addTranslatedEdges(workData, job->edgeCache(), offset);
+    }
+
+    if (result == BL_SUCCESS) {
+      assignEdges(workData, instance.commandQueue, instance.commandIndex, &workData->edgeStorage);
+    }
+  }
+
+  job->destroy();
+}
+
 // bl::RasterEngine - Job Processor - Fill Text Job
 // ================================================
 
@@ -176,7 +274,7 @@ static void processFillTextJob(WorkData* workData, RenderJob_TextOp* job) noexce
     JobStateAccessor accessor(job);
     prepareEdgeBuilder(workData, accessor.fillState());
 
-    result = addFilledGlyphRunEdges(workData, accessor, originFixed, &font, glyphRun);
+    result = addFilledGlyphRunEdges(workData, accessor, originFixed, &font, glyphRun, job->glyphOriginQuantizer());
     if (result == BL_SUCCESS) {
       assignEdges(workData, job, &workData->edgeStorage);
     }
@@ -271,6 +369,14 @@ static void processJob(WorkData* workData, RenderJob* job) noexcept {
       processStrokeTextJob(workData, static_cast<RenderJob_TextOp*>(job));
       break;
 
+    case RenderJobType::kFillPathShard:
+      processFillPathShardJob(workData, static_cast<RenderJob_PathShardOp*>(job));
+      break;
+
+    case RenderJobType::kFillPathInstances:
+      processFillPathInstancesJob(workData, static_cast<RenderJob_PathInstancesOp*>(job));
+      break;
+
     default:
       BL_NOT_REACHED();
   }
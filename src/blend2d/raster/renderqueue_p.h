@@ -182,6 +182,7 @@ public:
   }
 
   BL_INLINE_NODEBUG bool full() const noexcept { return _ptr == _end; }
+  BL_INLINE_NODEBUG size_t remaining() const noexcept { return (size_t)(_end - _ptr); }
   BL_INLINE_NODEBUG void done(RenderGenericQueue<T>& queue) noexcept { queue._size = index(queue); }
 
   BL_INLINE void append(const T& item) noexcept {
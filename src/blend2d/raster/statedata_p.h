@@ -7,6 +7,7 @@
 #define BLEND2D_RASTER_STATEDATA_P_H_INCLUDED
 
 #include "../geometry.h"
+#include "../image.h"
 #include "../matrix_p.h"
 #include "../path_p.h"
 #include "../raster/styledata_p.h"
@@ -138,6 +139,28 @@ struct alignas(16) SavedState {
   BLMatrix2D userTransform;
 };
 
+//! Structure that holds a group started by `beginGroup()` (see `endGroup()`).
+//!
+//! The group renders into a layer image that only covers `boxI`. The destination is retargeted to the layer by
+//! offsetting its pixel pointer so all coordinates (transformations, clip boxes, and bands) stay the same and only
+//! pixels within `boxI` can be accessed, which is guaranteed by clipping to `boxI` when the group begins.
+struct LayerState {
+  //! Link to the previous (outer) group.
+  LayerState* prevLayer;
+  //! State saved by `beginGroup()` - cannot be restored by `restore()`, only by `endGroup()`.
+  SavedState* savedState;
+  //! Destination data that was used before the group has started.
+  BLImageData prevDstData;
+  //! Bounding box of the group in device coordinates (empty if the group doesn't render anything).
+  BLBoxI boxI;
+  //! Layer image (only valid if `boxI` is not empty).
+  BLImageCore layerImage;
+  //! Group opacity [0, 1].
+  double opacity;
+  //! Group composition operator.
+  BLCompOp compOp;
+};
+
 struct Matrix2x2 {
   double m[4];
 };
@@ -122,6 +122,7 @@ BLResult WorkerManager::init(BLRasterContextImpl* ctxI, const BLContextCreateInf
   }
 
   _isActive = true;
+  _occlusionCulling = (initFlags & BL_CONTEXT_CREATE_FLAG_OCCLUSION_CULLING) != 0;
   _bandCount = ctxI->bandCount();
   _commandQueueLimit = commandQueueLimit;
 
@@ -145,6 +146,7 @@ void WorkerManager::reset() noexcept {
     return;
 
   _isActive = false;
+  _occlusionCulling = false;
 
   if (_threadPool) {
     for (uint32_t i = 0; i < _threadCount; i++)
@@ -162,6 +164,7 @@ void WorkerManager::reset() noexcept {
   _commandQueueCount = 0;
   _commandQueueLimit = 0;
   _stateSlotCount = 0;
+  _occluderCount = 0;
 }
 
 } // {RasterEngine}
@@ -180,6 +180,8 @@ public:
 
   //! Indicates that a worker manager is active.
   uint32_t _isActive;
+  //! Indicates that occlusion culling is enabled (see \ref BL_CONTEXT_CREATE_FLAG_OCCLUSION_CULLING).
+  uint32_t _occlusionCulling;
   //! Number of worker threads.
   uint32_t _threadCount;
   //! Number of bands,
@@ -192,6 +194,10 @@ public:
   uint32_t _commandQueueLimit;
   //! Count of data slots.
   uint32_t _stateSlotCount;
+  //! Count of commands marked as occluders.
+  uint32_t _occluderCount;
+  //! Index of the last command marked as occluder, only valid if `_occluderCount` is non-zero.
+  uint32_t _lastOccluderIndex;
 
   //! \}
 
@@ -210,12 +216,15 @@ public:
       _workDataStorage{},
       _synchronization(),
       _isActive{},
+      _occlusionCulling{},
       _threadCount{},
       _bandCount{},
       _batchId{1},
       _commandQueueCount{},
       _commandQueueLimit{},
-      _stateSlotCount{} {}
+      _stateSlotCount{},
+      _occluderCount{},
+      _lastOccluderIndex{} {}
 
   BL_INLINE ~WorkerManager() noexcept {
     // Cannot be active upon destruction!
@@ -258,6 +267,7 @@ public:
 
     _commandQueueCount = 0;
     _stateSlotCount = 0;
+    _occluderCount = 0;
   }
 
   //! Releases all acquired threads and destroys all work contexts.
@@ -277,6 +287,9 @@ public:
 
   BL_INLINE_NODEBUG uint32_t threadCount() const noexcept { return _threadCount; }
 
+  //! Returns `true` when occlusion culling is enabled.
+  BL_INLINE_NODEBUG bool occlusionCulling() const noexcept { return _occlusionCulling != 0; }
+
   //! \}
 
   //! \name Command Data
@@ -287,6 +300,12 @@ public:
   BL_INLINE_NODEBUG RenderCommand* currentCommand() noexcept { return _commandAppender.currentCommand(); }
   BL_INLINE_NODEBUG uint32_t nextStateSlotIndex() noexcept { return _stateSlotCount++; }
 
+  //! Adds the current command, which is being enqueued, to occluders.
+  BL_INLINE void addOccluder() noexcept {
+    _occluderCount++;
+    _lastOccluderIndex = _commandQueueCount + uint32_t(_commandAppender.index());
+  }
+
   BL_INLINE_NODEBUG bool isCommandQueueFull() const noexcept { return _commandAppender.full(); }
 
   BL_INLINE bool hasPendingCommands() const noexcept {
@@ -341,21 +360,25 @@ public:
   }
 
   BL_INLINE BLResult _growJobQueue() noexcept {
+    RenderJobQueue* jobQueue = newJobQueue();
+    if (BL_UNLIKELY(!jobQueue))
+      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+
+    _appendJobQueue(jobQueue);
+    return BL_SUCCESS;
+  }
+
+  //! Appends a `jobQueue` allocated by `newJobQueue()` and makes it the current one.
+  BL_INLINE void _appendJobQueue(RenderJobQueue* jobQueue) noexcept {
     // Can only be called when the current job queue is full.
     BL_ASSERT(_jobAppender.full());
 
-    RenderJobQueue* jobQueue = currentBatch()->_jobList.last();
-    _jobAppender.done(*jobQueue);
-    currentBatch()->_jobCount += uint32_t(jobQueue->size());
-
-    jobQueue = newJobQueue();
-    if (BL_UNLIKELY(!jobQueue))
-      return blTraceError(BL_ERROR_OUT_OF_MEMORY);
+    RenderJobQueue* lastQueue = currentBatch()->_jobList.last();
+    _jobAppender.done(*lastQueue);
+    currentBatch()->_jobCount += uint32_t(lastQueue->size());
 
     currentBatch()->_jobList.append(jobQueue);
     _jobAppender.reset(*jobQueue);
-
-    return BL_SUCCESS;
   }
 
   BL_INLINE void addJob(RenderJob* job) noexcept {
@@ -410,6 +433,13 @@ public:
 
   BL_INLINE_NODEBUG bool isBatchFull() const noexcept { return _commandQueueCount >= _commandQueueLimit; }
 
+  //! Returns the maximum number of commands that can be enqueued before the current batch is flushed (at least 1).
+  BL_INLINE size_t remainingBatchCommandCount() const noexcept {
+    // Commands of the current command queue are only added to `_commandQueueCount` once the queue is full.
+    size_t commandCount = size_t(_commandQueueCount) + _commandAppender.index();
+    return commandCount < _commandQueueLimit ? size_t(_commandQueueLimit) - commandCount : size_t(1);
+  }
+
   BL_INLINE void finalizeBatch() noexcept {
     RenderJobQueue* lastJobQueue = _currentBatch->_jobList.last();
     RenderCommandQueue* lastCommandQueue = _currentBatch->_commandList.last();
@@ -421,6 +451,8 @@ public:
     _currentBatch->_jobCount += uint32_t(lastJobQueue->size());
     _currentBatch->_commandCount += uint32_t(lastCommandQueue->size());
     _currentBatch->_stateSlotCount = _stateSlotCount;
+    _currentBatch->_occluderCount = _occluderCount;
+    _currentBatch->_lastOccluderIndex = _lastOccluderIndex;
     _currentBatch->_bandCount = _bandCount;
     // TODO: [Rendering Context] Not used. the idea is that after the batch is processed we can reuse the blocks of the allocator (basically move it after the current block).
     // _currentBatch->_pastBlock = _allocator.pastBlock();
@@ -430,6 +462,7 @@ public:
 
     _commandQueueCount = 0;
     _stateSlotCount = 0;
+    _occluderCount = 0;
   }
 
   //! \}
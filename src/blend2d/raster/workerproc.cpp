@@ -64,6 +64,151 @@ static BL_NOINLINE void processJobs(WorkData* workData, RenderBatch* batch) noex
   workData->synchronization->waitForJobsToFinish();
 }
 
+// bl::RasterEngine::WorkerProc - OcclusionCulling
+// ===============================================
+
+// Calculates bounds of a box `command` clipped to the current band (in pixel units), which are used by occlusion
+// culling. Returns false if the command is not a box command (analytic commands keep a per-band state and must be
+// always processed) or if it doesn't intersect the band.
+static BL_INLINE bool getBandClippedBox(const CommandProcAsync::ProcData& procData, const RenderCommand& command, BLBoxI& out) noexcept {
+  BLBoxI box;
+
+  switch (command.type()) {
+    case RenderCommandType::kFillBoxA:
+    case RenderCommandType::kFillBoxListA:
+      box = command.boxI();
+      break;
+
+    case RenderCommandType::kFillBoxU: {
+      // Unaligned boxes are in 24.8 fixed point - the pixels they touch are what could be occluded.
+      const BLBoxI& boxU = command.boxI();
+      int fpMask = int(fpScale) - 1;
+      box.reset(boxU.x0 / int(fpScale), boxU.y0 / int(fpScale), (boxU.x1 + fpMask) / int(fpScale), (boxU.y1 + fpMask) / int(fpScale));
+      break;
+    }
+
+    case RenderCommandType::kFillBoxMaskA:
+      box = command._payload.boxMaskA.boxI;
+      break;
+
+    default:
+      return false;
+  }
+
+  out.reset(box.x0, blMax(box.y0, int(procData.bandY0())), box.x1, blMin(box.y1, int(procData.bandY1())));
+  return out.x0 < out.x1 && out.y0 < out.y1;
+}
+
+static BL_INLINE bool boxContainsBox(const BLBoxI& a, const BLBoxI& b) noexcept {
+  return a.x0 <= b.x0 && a.y0 <= b.y0 && a.x1 >= b.x1 && a.y1 >= b.y1;
+}
+
+static BL_INLINE uint64_t boxArea(const BLBoxI& box) noexcept {
+  return uint64_t(uint32_t(box.x1 - box.x0)) * uint32_t(box.y1 - box.y0);
+}
+
+// Walks pending commands of the current band from the last occluder to the first command and marks box commands,
+// which are fully covered by a later occluder, as culled. Only the largest occluder seen so far is tracked, which is
+// enough to catch the most common overdraw - backgrounds and panels that are repainted by opaque fills.
+//
+// Commands after the last occluder of the batch cannot be culled, and commands that are either not pending or have
+// not started yet in the current band are skipped without looking at them, so the cost of each band is proportional
+// to the number of commands the band actually processes.
+static void cullOccludedCommands(CommandProcAsync::ProcData& procData) noexcept {
+  typedef PrivateBitWordOps BitOps;
+  constexpr size_t kBitWordSize = IntOps::bitSizeOf<BLBitWord>();
+
+  RenderBatch* batch = procData.batch();
+
+  const BLBitWord* pendingBitSet = procData.pendingCommandBitSetData();
+  BLBitWord* culledBitSet = procData.culledCommandBitSetData();
+
+  size_t bitWordCount = procData.pendingCommandBitSetSize();
+  BLBitWord pendingGlobalMask = procData.pendingCommandBitSetMask();
+
+  memset(culledBitSet, 0, bitWordCount * sizeof(BLBitWord));
+
+  uint32_t bandQy0 = uint8_t(procData.bandY0() >> procData.workData()->commandQuantizationShiftAA());
+
+  BLBoxI occluder(0, 0, 0, 0);
+  uint64_t occluderArea = 0;
+
+  size_t lastIndex = batch->lastOccluderIndex();
+  size_t wordIndex = lastIndex / kBitWordSize;
+  BLBitWord wordMask = BitOps::nonZeroStartMask(lastIndex % kBitWordSize + 1u);
+
+  // Command queues have a capacity that is a multiple of `kBitWordSize`, so each BitWord maps to a single queue.
+  const RenderCommandQueue* commandQueue = batch->commandList().last();
+  size_t queueStart = batch->commandCount() - commandQueue->size();
+
+  for (;;) {
+    size_t wordStart = wordIndex * kBitWordSize;
+    while (wordStart < queueStart) {
+      commandQueue = commandQueue->prev();
+      queueStart -= commandQueue->size();
+    }
+
+    // The pending bit-set is not initialized in the first band, except the last BitWord (see `initProcData()`).
+    BLBitWord pendingMask = (pendingGlobalMask && wordIndex != bitWordCount - 1u) ? pendingGlobalMask : pendingBitSet[wordIndex];
+    pendingMask &= wordMask;
+
+    const RenderCommand* commandData = commandQueue->data() + (wordStart - queueStart);
+    const uint8_t* commandQuantizedY0 = commandQueue->_quantizedY0 + (wordStart - queueStart);
+
+    while (pendingMask) {
+      size_t bitIndex = kBitWordSize - 1u - BitOps::countZerosFromEnd(pendingMask);
+      pendingMask ^= BitOps::indexAsMask(bitIndex);
+
+      if (bandQy0 < commandQuantizedY0[bitIndex])
+        continue;
+
+      const RenderCommand& command = commandData[bitIndex];
+      BLBoxI box;
+
+      if (!getBandClippedBox(procData, command, box))
+        continue;
+
+      if (occluderArea && boxContainsBox(occluder, box)) {
+        culledBitSet[wordIndex] |= BitOps::indexAsMask(bitIndex);
+        continue;
+      }
+
+      if (command.isOccluder()) {
+        if (command.isFillBoxA()) {
+          uint64_t area = boxArea(box);
+          if (area > occluderArea) {
+            occluder = box;
+            occluderArea = area;
+          }
+        }
+        else {
+          const BLBoxI* boxes = command.boxListData();
+          uint32_t boxCount = command.boxListSize();
+
+          for (uint32_t boxIndex = 0; boxIndex < boxCount; boxIndex++) {
+            BLBoxI clipped(boxes[boxIndex].x0, blMax(boxes[boxIndex].y0, box.y0),
+                           boxes[boxIndex].x1, blMin(boxes[boxIndex].y1, box.y1));
+
+            if (clipped.y0 < clipped.y1) {
+              uint64_t area = boxArea(clipped);
+              if (area > occluderArea) {
+                occluder = clipped;
+                occluderArea = area;
+              }
+            }
+          }
+        }
+      }
+    }
+
+    if (!wordIndex)
+      break;
+
+    wordIndex--;
+    wordMask = IntOps::allOnes<BLBitWord>();
+  }
+}
+
 // bl::RasterEngine::WorkerProc - ProcessBand
 // ==========================================
 
@@ -177,6 +322,13 @@ static void processBand(CommandProcAsync::ProcData& procData, uint32_t currentBa
   // Initialize the `procData` with the current band.
   procData.initBand(currentBandId, workData->bandHeight(), fpScale);
 
+  // Commands culled in this band are skipped, but their status is still updated so they don't remain pending.
+  BLBitWord* culledBitSetPtr = nullptr;
+  if (procData.hasCulledCommandBitSet()) {
+    cullOccludedCommands(procData);
+    culledBitSetPtr = procData.culledCommandBitSetData();
+  }
+
   BLBitWord* bitSetPtr = procData.pendingCommandBitSetData();
   BLBitWord* bitSetEndMinus1 = procData.pendingCommandBitSetEnd() - 1;
   BLBitWord pendingGlobalMask = procData.pendingCommandBitSetMask();
@@ -208,6 +360,19 @@ static void processBand(CommandProcAsync::ProcData& procData, uint32_t currentBa
     if (pendingMask) {
 #if (BL_TARGET_ARCH_X86 || BL_TARGET_ARCH_ARM) && BL_SIMD_WIDTH_I
       BLBitWord processMask = pendingMask & matcher.match(commandQuantizedY0);
+
+      if (culledBitSetPtr) {
+        BLBitWord culledMask = processMask & *culledBitSetPtr;
+        processMask ^= culledMask;
+
+        BitOps::BitIterator culledIt(culledMask);
+        while (culledIt.hasNext()) {
+          uint32_t bitIndex = culledIt.next();
+          CommandProcAsync::CommandStatus status = CommandProcAsync::skipCulledCommand(procData, commandData[bitIndex]);
+          pendingMask ^= BitOps::indexAsMask(bitIndex, status);
+        }
+      }
+
       BitOps::BitIterator it(processMask);
 
       while (it.hasNext()) {
@@ -218,13 +383,16 @@ static void processBand(CommandProcAsync::ProcData& procData, uint32_t currentBa
         pendingMask ^= BitOps::indexAsMask(bitIndex, status);
       }
 #else
+      BLBitWord culledMask = culledBitSetPtr ? *culledBitSetPtr : BLBitWord(0);
       BitOps::BitIterator it(pendingMask);
 
       while (it.hasNext()) {
         uint32_t bitIndex = it.next();
         if (bandQy0 >= commandQuantizedY0[bitIndex]) {
           const RenderCommand& command = commandData[bitIndex];
-          CommandProcAsync::CommandStatus status = CommandProcAsync::processCommand(procData, command, prevBandFy1, nextBandFy0);
+          CommandProcAsync::CommandStatus status = BitOps::hasBit(culledMask, bitIndex)
+            ? CommandProcAsync::skipCulledCommand(procData, command)
+            : CommandProcAsync::processCommand(procData, command, prevBandFy1, nextBandFy0);
           pendingMask ^= BitOps::indexAsMask(bitIndex, status);
         }
       }
@@ -232,6 +400,9 @@ static void processBand(CommandProcAsync::ProcData& procData, uint32_t currentBa
       *bitSetPtr = pendingMask;
     }
 
+    if (culledBitSetPtr)
+      culledBitSetPtr++;
+
     if (++bitSetPtr >= bitSetEndMinus1) {
       pendingGlobalMask = 0;
       if (bitSetPtr > bitSetEndMinus1)
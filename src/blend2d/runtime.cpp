@@ -260,6 +260,7 @@ BL_API_IMPL BLResult blRuntimeInit() noexcept {
   blThreadPoolRtInit(rt);
   blZeroAllocatorRtInit(rt);
   blPixelOpsRtInit(rt);
+  blUnicodeRtInit(rt);
   blBitArrayRtInit(rt);
   blBitSetRtInit(rt);
   blArrayRtInit(rt);
@@ -271,6 +272,7 @@ BL_API_IMPL BLResult blRuntimeInit() noexcept {
   blImageDecoderRtInit(rt);
   blImageEncoderRtInit(rt);
   blImageScaleRtInit(rt);
+  blImageBlurRtInit(rt);
   blPatternRtInit(rt);
   blGradientRtInit(rt);
   blFontFeatureSettingsRtInit(rt);
@@ -279,6 +281,7 @@ BL_API_IMPL BLResult blRuntimeInit() noexcept {
   blFontFaceRtInit(rt);
   blOpenTypeRtInit(rt);
   blFontRtInit(rt);
+  blFontShapingCacheRtInit(rt);
   blFontManagerRtInit(rt);
   blStaticPipelineRtInit(rt);
 
@@ -88,6 +88,10 @@ BL_DEFINE_ENUM(BLRuntimeCleanupFlags) {
   BL_RUNTIME_CLEANUP_ZEROED_POOL = 0x00000002u,
   //! Cleanup thread pool (would join unused threads).
   BL_RUNTIME_CLEANUP_THREAD_POOL = 0x00000010u,
+  //! Cleanup font shaping cache (drops cached text runs, but keeps the cache enabled).
+  BL_RUNTIME_CLEANUP_FONT_SHAPING_CACHE = 0x00000020u,
+  //! Cleanup gradient LUT cache (drops LUTs shared between gradients, LUTs held by gradients are kept).
+  BL_RUNTIME_CLEANUP_GRADIENT_LUT_CACHE = 0x00000040u,
 
   //! Cleanup everything.
   BL_RUNTIME_CLEANUP_EVERYTHING = 0xFFFFFFFFu
@@ -190,6 +190,7 @@ BL_HIDDEN void blThreadRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blThreadPoolRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blZeroAllocatorRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blPixelOpsRtInit(BLRuntimeContext* rt) noexcept;
+BL_HIDDEN void blUnicodeRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blBitArrayRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blBitSetRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blArrayRtInit(BLRuntimeContext* rt) noexcept;
@@ -201,6 +202,7 @@ BL_HIDDEN void blImageCodecRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blImageDecoderRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blImageEncoderRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blImageScaleRtInit(BLRuntimeContext* rt) noexcept;
+BL_HIDDEN void blImageBlurRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blPatternRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blGradientRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blFontFeatureSettingsRtInit(BLRuntimeContext* rt) noexcept;
@@ -209,6 +211,7 @@ BL_HIDDEN void blFontDataRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blFontFaceRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blOpenTypeRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blFontRtInit(BLRuntimeContext* rt) noexcept;
+BL_HIDDEN void blFontShapingCacheRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blFontManagerRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blContextRtInit(BLRuntimeContext* rt) noexcept;
 BL_HIDDEN void blStaticPipelineRtInit(BLRuntimeContext* rt) noexcept;
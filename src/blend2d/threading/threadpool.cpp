@@ -348,6 +348,88 @@ static void BL_CDECL blThreadPoolReleaseThreads(BLThreadPool* self_, BLThread**
   return blThreadPoolReleaseThreadsInternal(self, threads, n);
 }
 
+// ThreadPool - Run Parallel
+// =========================
+
+namespace {
+
+struct ParallelRunData {
+  BLThreadPoolWorkFunc func;
+  void* data;
+  uint32_t remaining;
+
+  BLMutex mutex;
+  BLConditionVariable doneCondition;
+};
+
+struct ParallelRunWorker {
+  ParallelRunData* shared;
+  uint32_t workerId;
+};
+
+} // {anonymous}
+
+static void BL_CDECL blThreadPoolParallelEntry(BLThread* thread, void* data) noexcept {
+  blUnused(thread);
+
+  ParallelRunWorker* worker = static_cast<ParallelRunWorker*>(data);
+  ParallelRunData* shared = worker->shared;
+
+  shared->func(shared->data, worker->workerId);
+
+  // The counter must be decremented while holding the lock, otherwise the waiting thread could destroy `shared`
+  // before the signal is sent.
+  BLLockGuard<BLMutex> guard(shared->mutex);
+  if (--shared->remaining == 0)
+    shared->doneCondition.signal();
+}
+
+uint32_t blThreadPoolRunParallel(BLThreadPool* self, uint32_t n, BLThreadPoolWorkFunc func, void* data) noexcept {
+  BLThread* threads[BLInternalThreadPool::kMaxThreadCount];
+  ParallelRunWorker workers[BLInternalThreadPool::kMaxThreadCount];
+
+  uint32_t threadCount = 0;
+  if (n > 1) {
+    BLResult reason;
+    threadCount = self->acquireThreads(threads, blMin<uint32_t>(n - 1u, BLInternalThreadPool::kMaxThreadCount), 0, &reason);
+  }
+
+  if (threadCount == 0) {
+    func(data, 0);
+    return 1;
+  }
+
+  ParallelRunData shared;
+  shared.func = func;
+  shared.data = data;
+  shared.remaining = threadCount;
+
+  uint32_t runCount = 0;
+  for (uint32_t i = 0; i < threadCount; i++) {
+    workers[i].shared = &shared;
+    workers[i].workerId = runCount + 1;
+
+    if (threads[i]->run(blThreadPoolParallelEntry, &workers[i]) == BL_SUCCESS) {
+      runCount++;
+    }
+    else {
+      BLLockGuard<BLMutex> guard(shared.mutex);
+      shared.remaining--;
+    }
+  }
+
+  func(data, 0);
+
+  {
+    BLLockGuard<BLMutex> guard(shared.mutex);
+    while (shared.remaining != 0)
+      shared.doneCondition.wait(shared.mutex);
+  }
+
+  self->releaseThreads(threads, threadCount);
+  return runCount + 1;
+}
+
 // ThreadPool - Global
 // ===================
 
@@ -90,9 +90,19 @@ struct BLThreadPool {
 #endif
 };
 
+//! Work function used by `blThreadPoolRunParallel()`.
+typedef void (BL_CDECL* BLThreadPoolWorkFunc)(void* data, uint32_t workerId) BL_NOEXCEPT;
+
 BL_HIDDEN BLThreadPool* blThreadPoolGlobal() noexcept;
 BL_HIDDEN BLThreadPool* blThreadPoolCreate() noexcept;
 
+//! Runs `func` on the calling thread and on up to `n - 1` threads acquired from `self` and waits until all of them
+//! finish. Each invocation receives a unique `workerId` in `[0, n)`, where zero is always the calling thread.
+//!
+//! Returns the number of invocations, which is always at least one. The work itself should be distributed dynamically
+//! (for example by using an atomic counter) as it's not guaranteed that all `n` threads could be acquired.
+BL_HIDDEN uint32_t blThreadPoolRunParallel(BLThreadPool* self, uint32_t n, BLThreadPoolWorkFunc func, void* data) noexcept;
+
 //! \}
 //! \endcond
 
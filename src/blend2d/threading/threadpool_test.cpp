@@ -45,6 +45,25 @@ static void BL_CDECL test_thread_entry(BLThread* thread, void* data_) noexcept {
   }
 }
 
+struct ParallelTestData {
+  uint32_t itemIndex;
+  uint32_t itemCount;
+  uint32_t* items;
+};
+
+static void BL_CDECL test_parallel_entry(void* data_, uint32_t workerId) noexcept {
+  ParallelTestData* data = static_cast<ParallelTestData*>(data_);
+
+  for (;;) {
+    uint32_t i = blAtomicFetchAddRelaxed(&data->itemIndex);
+    if (i >= data->itemCount)
+      break;
+    data->items[i] = i + 1;
+  }
+
+  blUnused(workerId);
+}
+
 UNIT(thread_pool, BL_TEST_GROUP_THREADING) {
   BLThreadPool* tp = blThreadPoolGlobal();
   ThreadTestData data;
@@ -91,6 +110,20 @@ UNIT(thread_pool, BL_TEST_GROUP_THREADING) {
     tp->releaseThreads(threads, n);
   }
 
+  INFO("Running a parallel work on the caller and pooled threads");
+  {
+    constexpr uint32_t kItemCount = 10000;
+    uint32_t items[kItemCount] {};
+
+    ParallelTestData parallelData { 0, kItemCount, items };
+    uint32_t n = blThreadPoolRunParallel(tp, kThreadCount, test_parallel_entry, &parallelData);
+
+    EXPECT_GE(n, 1u);
+    EXPECT_LE(n, kThreadCount);
+
+    for (uint32_t i = 0; i < kItemCount; i++)
+      EXPECT_EQ(items[i], i + 1);
+  }
 
   INFO("Cleaning up");
   tp->cleanup();
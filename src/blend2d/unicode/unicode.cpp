@@ -4,6 +4,7 @@
 // SPDX-License-Identifier: Zlib
 
 #include "../api-build_p.h"
+#include "../runtime_p.h"
 #include "../unicode/unicode_p.h"
 #include "../support/intops_p.h"
 #include "../support/memops_p.h"
@@ -36,6 +37,36 @@ const uint8_t utf8SizeData[256] = {
   4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0  // 240 - 255
 };
 
+// bl::Unicode - Runs
+// ==================
+
+RunFuncs runFuncs;
+
+static size_t BL_CDECL utf8AsciiSize_Portable(const uint8_t* src, size_t size) noexcept {
+  size_t i = 0;
+  while (i < size && src[i] < 0x80u)
+    i++;
+  return i;
+}
+
+static size_t BL_CDECL utf8AsciiToUtf32_Portable(uint32_t* dst, const uint8_t* src, size_t size) noexcept {
+  size_t i = 0;
+  while (i < size && src[i] < 0x80u) {
+    dst[i] = src[i];
+    i++;
+  }
+  return i;
+}
+
+static size_t BL_CDECL utf16BmpToUtf32_Portable(uint32_t* dst, const uint16_t* src, size_t size) noexcept {
+  size_t i = 0;
+  while (i < size && !isSurrogate(src[i])) {
+    dst[i] = src[i];
+    i++;
+  }
+  return i;
+}
+
 // bl::Unicode - Validation
 // ========================
 
@@ -113,6 +144,27 @@ static BL_INLINE size_t offsetOfPtr(const void* base, const void* advanced) noex
   return (size_t)(static_cast<const char*>(advanced) - static_cast<const char*>(base));
 }
 
+// Decodes runs of characters, which don't need any validation, in bulk. Only supported when writing native UTF-32.
+template<typename Writer, typename Iterator, IOFlags kFlags>
+struct RunDecoder {
+  static BL_INLINE size_t decode(Writer& writer, Iterator& iter) noexcept {
+    blUnused(writer, iter);
+    return 0;
+  }
+};
+
+template<uint32_t kAlignment, typename Iterator, IOFlags kFlags>
+struct RunDecoder<Utf32Writer<BL_BYTE_ORDER_NATIVE, kAlignment>, Iterator, kFlags> {
+  static BL_INLINE size_t decode(Utf32Writer<BL_BYTE_ORDER_NATIVE, kAlignment>& writer, Iterator& iter) noexcept {
+    if (kAlignment < 4 && !IntOps::isAligned(writer._ptr, 4))
+      return 0;
+
+    size_t n = iter.template decodeSimpleRun<kFlags>(writer._ptr, writer.remainingSize());
+    writer._ptr += n;
+    return n;
+  }
+};
+
 // A simple implementation. It iterates `src` char-by-char and writes it to the destination. The advantage of this
 // implementation is that switching `Writer` and `Iterator` can customize strictness, endianness, etc, so we don't
 // have to repeat the code for different variations of UTF16 and UTF32.
@@ -125,6 +177,9 @@ static BL_INLINE BLResult convertUnicodeImpl(void* dst, size_t dstSizeInBytes, c
 
   BLResult result = BL_SUCCESS;
   while (iter.hasNext()) {
+    if (RunDecoder<Writer, Iterator, kFlags>::decode(writer, iter))
+      continue;
+
     uint32_t uc;
     size_t ucSizeInBytes;
 
@@ -398,3 +453,39 @@ BLResult convertUnicode(
 
 } // {Unicode}
 } // {bl}
+
+// bl::Unicode - Runtime Registration
+// ==================================
+
+void blUnicodeRtInit(BLRuntimeContext* rt) noexcept {
+  // Maybe unused, if no architecture dependent optimizations are available.
+  blUnused(rt);
+
+  bl::Unicode::runFuncs.utf8AsciiSize = bl::Unicode::utf8AsciiSize_Portable;
+  bl::Unicode::runFuncs.utf8AsciiToUtf32 = bl::Unicode::utf8AsciiToUtf32_Portable;
+  bl::Unicode::runFuncs.utf16BmpToUtf32 = bl::Unicode::utf16BmpToUtf32_Portable;
+
+#if defined(BL_BUILD_OPT_SSE4_1)
+  if (blRuntimeHasSSE4_1(rt)) {
+    bl::Unicode::runFuncs.utf8AsciiSize = bl::Unicode::utf8AsciiSize_SSE4_1;
+    bl::Unicode::runFuncs.utf8AsciiToUtf32 = bl::Unicode::utf8AsciiToUtf32_SSE4_1;
+    bl::Unicode::runFuncs.utf16BmpToUtf32 = bl::Unicode::utf16BmpToUtf32_SSE4_1;
+  }
+#endif
+
+#if defined(BL_BUILD_OPT_AVX2)
+  if (blRuntimeHasAVX2(rt)) {
+    bl::Unicode::runFuncs.utf8AsciiSize = bl::Unicode::utf8AsciiSize_AVX2;
+    bl::Unicode::runFuncs.utf8AsciiToUtf32 = bl::Unicode::utf8AsciiToUtf32_AVX2;
+    bl::Unicode::runFuncs.utf16BmpToUtf32 = bl::Unicode::utf16BmpToUtf32_AVX2;
+  }
+#endif
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+  if (blRuntimeHasASIMD(rt)) {
+    bl::Unicode::runFuncs.utf8AsciiSize = bl::Unicode::utf8AsciiSize_ASIMD;
+    bl::Unicode::runFuncs.utf8AsciiToUtf32 = bl::Unicode::utf8AsciiToUtf32_ASIMD;
+    bl::Unicode::runFuncs.utf16BmpToUtf32 = bl::Unicode::utf16BmpToUtf32_ASIMD;
+  }
+#endif
+}
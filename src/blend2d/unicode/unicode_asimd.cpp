@@ -0,0 +1,29 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include "../api-build_p.h"
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+
+#include "../unicode/unicodesimdimpl_p.h"
+
+namespace bl {
+namespace Unicode {
+
+size_t BL_CDECL utf8AsciiSize_ASIMD(const uint8_t* src, size_t size) noexcept {
+  return utf8AsciiSizeImpl(src, size);
+}
+
+size_t BL_CDECL utf8AsciiToUtf32_ASIMD(uint32_t* dst, const uint8_t* src, size_t size) noexcept {
+  return utf8AsciiToUtf32Impl(dst, src, size);
+}
+
+size_t BL_CDECL utf16BmpToUtf32_ASIMD(uint32_t* dst, const uint16_t* src, size_t size) noexcept {
+  return utf16BmpToUtf32Impl(dst, src, size);
+}
+
+} // {Unicode}
+} // {bl}
+
+#endif // BL_BUILD_OPT_ASIMD
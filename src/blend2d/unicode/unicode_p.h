@@ -180,6 +180,42 @@ BL_HIDDEN BLResult convertUnicode(
   void* dst, size_t dstSizeInBytes, uint32_t dstEncoding,
   const void* src, size_t srcSizeInBytes, uint32_t srcEncoding, ConversionState& state) noexcept;
 
+// bl::Unicode - Runs
+// ==================
+
+//! Functions that process runs of characters, which don't need any validation, in bulk.
+//!
+//! Each function processes as many leading characters of `src` as possible and returns their count, which is zero
+//! if the first character has to be decoded by a unicode reader. The best implementation is selected at runtime.
+struct RunFuncs {
+  //! Returns the number of leading ASCII characters of a UTF-8 string `src` having `size` bytes.
+  size_t (BL_CDECL* utf8AsciiSize)(const uint8_t* src, size_t size) BL_NOEXCEPT;
+  //! Decodes leading ASCII characters of a UTF-8 string `src` having `size` bytes into `dst`.
+  size_t (BL_CDECL* utf8AsciiToUtf32)(uint32_t* dst, const uint8_t* src, size_t size) BL_NOEXCEPT;
+  //! Decodes leading code units of a UTF-16 string `src` having `size` units, which are not surrogates, into `dst`.
+  size_t (BL_CDECL* utf16BmpToUtf32)(uint32_t* dst, const uint16_t* src, size_t size) BL_NOEXCEPT;
+};
+
+BL_HIDDEN extern RunFuncs runFuncs;
+
+#if defined(BL_BUILD_OPT_SSE4_1)
+BL_HIDDEN size_t BL_CDECL utf8AsciiSize_SSE4_1(const uint8_t* src, size_t size) noexcept;
+BL_HIDDEN size_t BL_CDECL utf8AsciiToUtf32_SSE4_1(uint32_t* dst, const uint8_t* src, size_t size) noexcept;
+BL_HIDDEN size_t BL_CDECL utf16BmpToUtf32_SSE4_1(uint32_t* dst, const uint16_t* src, size_t size) noexcept;
+#endif // BL_BUILD_OPT_SSE4_1
+
+#if defined(BL_BUILD_OPT_AVX2)
+BL_HIDDEN size_t BL_CDECL utf8AsciiSize_AVX2(const uint8_t* src, size_t size) noexcept;
+BL_HIDDEN size_t BL_CDECL utf8AsciiToUtf32_AVX2(uint32_t* dst, const uint8_t* src, size_t size) noexcept;
+BL_HIDDEN size_t BL_CDECL utf16BmpToUtf32_AVX2(uint32_t* dst, const uint16_t* src, size_t size) noexcept;
+#endif // BL_BUILD_OPT_AVX2
+
+#if BL_TARGET_ARCH_ARM >= 64 && defined(BL_BUILD_OPT_ASIMD)
+BL_HIDDEN size_t BL_CDECL utf8AsciiSize_ASIMD(const uint8_t* src, size_t size) noexcept;
+BL_HIDDEN size_t BL_CDECL utf8AsciiToUtf32_ASIMD(uint32_t* dst, const uint8_t* src, size_t size) noexcept;
+BL_HIDDEN size_t BL_CDECL utf16BmpToUtf32_ASIMD(uint32_t* dst, const uint16_t* src, size_t size) noexcept;
+#endif // BL_BUILD_OPT_ASIMD
+
 // bl::Unicode - UTF8 Reader
 // =========================
 
@@ -343,11 +379,33 @@ TruncatedString:
     _ptr++;
   }
 
+  //! Skips a run of ASCII characters, which never change the calculated indexes.
+  BL_INLINE void skipSimpleRun() noexcept {
+    if (_ptr != _end && uint8_t(_ptr[0]) < 0x80u)
+      _ptr += runFuncs.utf8AsciiSize(reinterpret_cast<const uint8_t*>(_ptr), remainingByteSize());
+  }
+
+  //! Decodes a run of ASCII characters (at most `maxCount`) into `dst` and returns the number of decoded characters.
+  template<IOFlags kFlags = IOFlags::kNoFlags>
+  BL_INLINE size_t decodeSimpleRun(uint32_t* dst, size_t maxCount) noexcept {
+    size_t size = blMin(remainingByteSize(), maxCount);
+    if (!size || uint8_t(_ptr[0]) >= 0x80u)
+      return 0;
+
+    size_t n = runFuncs.utf8AsciiToUtf32(dst, reinterpret_cast<const uint8_t*>(_ptr), size);
+    _ptr += n;
+    return n;
+  }
+
   template<IOFlags kFlags = IOFlags::kNoFlags>
   BL_NODISCARD
   BL_INLINE BLResult validate() noexcept {
     BLResult result = BL_SUCCESS;
-    while (hasNext()) {
+    for (;;) {
+      skipSimpleRun();
+      if (!hasNext())
+        break;
+
       uint32_t uc;
       result = next<kFlags>(uc);
       if (result)
@@ -484,6 +542,25 @@ TruncatedString:
     _ptr += 2;
   }
 
+  //! Decodes a run of code units that are not surrogates (at most `maxCount`) into `dst` and returns the number of
+  //! decoded characters. Only native byte-order without index calculation is handled, otherwise zero is returned.
+  template<IOFlags kFlags = IOFlags::kNoFlags>
+  BL_INLINE size_t decodeSimpleRun(uint32_t* dst, size_t maxCount) noexcept {
+    if (blTestFlag(kFlags, IOFlags::kByteSwap | IOFlags::kCalcIndex))
+      return 0;
+
+    if (blTestFlag(kFlags, IOFlags::kUnaligned) && !IntOps::isAligned(_ptr, 2))
+      return 0;
+
+    size_t size = blMin(remainingByteSize() / 2u, maxCount);
+    if (!size || isSurrogate(readU16<kFlags>(_ptr)))
+      return 0;
+
+    size_t n = runFuncs.utf16BmpToUtf32(dst, reinterpret_cast<const uint16_t*>(_ptr), size);
+    _ptr += n * 2u;
+    return n;
+  }
+
   //! \}
 
   //! \name Validator
@@ -598,6 +675,27 @@ public:
     _ptr += 4;
   }
 
+  //! Copies a run of valid characters that are not surrogates (at most `maxCount`) into `dst` and returns the number
+  //! of copied characters. Index calculation is not handled, zero is returned in that case.
+  template<IOFlags kFlags = IOFlags::kNoFlags>
+  BL_INLINE size_t decodeSimpleRun(uint32_t* dst, size_t maxCount) noexcept {
+    if (blTestFlag(kFlags, IOFlags::kCalcIndex))
+      return 0;
+
+    size_t size = blMin(remainingByteSize() / 4u, maxCount);
+    size_t n = 0;
+
+    while (n < size) {
+      uint32_t uc = readU32<kFlags>(_ptr + n * 4u);
+      if (uc > kCharMax || isSurrogate(uc))
+        break;
+      dst[n++] = uc;
+    }
+
+    _ptr += n * 4u;
+    return n;
+  }
+
   template<IOFlags kFlags = IOFlags::kNoFlags>
   BL_NODISCARD
   BL_INLINE BLResult validate() noexcept {
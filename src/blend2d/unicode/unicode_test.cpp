@@ -6,6 +6,8 @@
 #include "../api-build_test_p.h"
 #if defined(BL_TEST)
 
+#include "../glyphbuffer.h"
+#include "../random.h"
 #include "../unicode/unicode_p.h"
 #include "../support/intops_p.h"
 #include "../support/memops_p.h"
@@ -343,6 +345,205 @@ UNIT(unicode_io, BL_TEST_GROUP_CORE_UTILITIES) {
   }
 }
 
+// Generates a random mix of ASCII, BMP, and SMP characters - long ASCII and BMP runs are generated on purpose as
+// they are decoded in bulk.
+static void generateRandomText(BLRandom& rnd, uint32_t* dst, size_t size) noexcept {
+  size_t i = 0;
+  while (i < size) {
+    uint32_t kind = rnd.nextUInt32() % 8u;
+    size_t runSize = blMin<size_t>(size - i, 1u + rnd.nextUInt32() % 40u);
+
+    for (size_t j = 0; j < runSize; j++) {
+      uint32_t uc;
+      switch (kind) {
+        case 0: uc = 0x80u + rnd.nextUInt32() % (0x800u - 0x80u); break;
+        case 1: uc = 0x800u + rnd.nextUInt32() % (0xD800u - 0x800u); break;
+        case 2: uc = 0xE000u + rnd.nextUInt32() % (0x10000u - 0xE000u); break;
+        case 3: uc = 0x10000u + rnd.nextUInt32() % (Unicode::kCharMax + 1u - 0x10000u); break;
+        default: uc = rnd.nextUInt32() % 0x80u; break;
+      }
+      dst[i++] = uc;
+    }
+  }
+}
+
+// Scalar conversion to UTF-32, which only uses `Reader::next()` - used to verify the results of `convertUnicode()`.
+template<typename Reader>
+static BLResult convertToUtf32Scalar(uint32_t* dst, size_t dstSize, const void* src, size_t srcSizeInBytes, Unicode::ConversionState& state) noexcept {
+  Reader reader(src, srcSizeInBytes);
+  size_t i = 0;
+
+  state.reset();
+  while (reader.hasNext()) {
+    uint32_t uc;
+    size_t ucSize;
+
+    BLResult result = reader.template next<Unicode::IOFlags::kStrict>(uc, ucSize);
+    if (result != BL_SUCCESS) {
+      state.dstIndex = i * 4u;
+      state.srcIndex = reader.byteIndex(src);
+      return result;
+    }
+
+    if (i == dstSize) {
+      state.dstIndex = i * 4u;
+      state.srcIndex = reader.byteIndex(src) - ucSize;
+      return BL_ERROR_NO_SPACE_LEFT;
+    }
+
+    dst[i++] = uc;
+  }
+
+  state.dstIndex = i * 4u;
+  state.srcIndex = reader.byteIndex(src);
+  return BL_SUCCESS;
+}
+
+template<typename Reader>
+static void testConvertToUtf32(const void* src, size_t srcSizeInBytes, uint32_t srcEncoding, size_t dstSize) noexcept {
+  uint32_t dstA[600];
+  uint32_t dstB[600];
+
+  Unicode::ConversionState stateA;
+  Unicode::ConversionState stateB;
+
+  memset(dstA, 0, sizeof(dstA));
+  memset(dstB, 0, sizeof(dstB));
+
+  BLResult resultA = Unicode::convertUnicode(dstA, dstSize * 4u, BL_TEXT_ENCODING_UTF32, src, srcSizeInBytes, srcEncoding, stateA);
+  BLResult resultB = convertToUtf32Scalar<Reader>(dstB, dstSize, src, srcSizeInBytes, stateB);
+
+  EXPECT_EQ(resultA, resultB);
+  EXPECT_EQ(stateA.dstIndex, stateB.dstIndex);
+  EXPECT_EQ(stateA.srcIndex, stateB.srcIndex);
+  EXPECT_EQ(memcmp(dstA, dstB, stateB.dstIndex), 0);
+}
+
+UNIT(unicode_runs, BL_TEST_GROUP_CORE_UTILITIES) {
+  BLRandom rnd(0x5A17);
+
+  uint32_t text[512];
+  char utf8Buffer[512 * 4 + 1];
+  uint16_t utf16Buffer[512 * 2 + 1];
+
+  INFO("bl::Unicode::runFuncs");
+  {
+    uint8_t src[300];
+    uint32_t dst[300];
+
+    for (uint32_t i = 0; i < 300; i++)
+      src[i] = uint8_t(i & 0x7Fu);
+
+    // Place a non-ASCII byte at each position to verify that the runs stop exactly there.
+    for (size_t pos = 0; pos < 300; pos++) {
+      src[pos] = 0x80u;
+
+      EXPECT_EQ(Unicode::runFuncs.utf8AsciiSize(src, 300), pos);
+      EXPECT_EQ(Unicode::runFuncs.utf8AsciiToUtf32(dst, src, 300), pos);
+      for (size_t i = 0; i < pos; i++)
+        EXPECT_EQ(dst[i], uint32_t(src[i]));
+
+      src[pos] = uint8_t(pos & 0x7Fu);
+    }
+
+    uint16_t src16[300];
+    for (uint32_t i = 0; i < 300; i++)
+      src16[i] = uint16_t(0xD000u + i * 64u);
+
+    size_t firstSurrogate = (0xD800u - 0xD000u) / 64u;
+    EXPECT_EQ(Unicode::runFuncs.utf16BmpToUtf32(dst, src16, 300), firstSurrogate);
+    for (size_t i = 0; i < firstSurrogate; i++)
+      EXPECT_EQ(dst[i], uint32_t(src16[i]));
+  }
+
+  INFO("bl::Unicode::convertUnicode() - UTF-8 and UTF-16 to UTF-32 (random text)");
+  for (uint32_t iter = 0; iter < 500; iter++) {
+    size_t textSize = rnd.nextUInt32() % 512u;
+    generateRandomText(rnd, text, textSize);
+
+    Unicode::Utf8Writer utf8Writer(utf8Buffer + 1, sizeof(utf8Buffer) - 1);
+    Unicode::Utf16Writer<> utf16Writer(utf16Buffer, BL_ARRAY_SIZE(utf16Buffer));
+
+    for (size_t i = 0; i < textSize; i++) {
+      EXPECT_SUCCESS(utf8Writer.write(text[i]));
+      EXPECT_SUCCESS(utf16Writer.write(text[i]));
+    }
+
+    size_t utf8Size = utf8Writer.index(utf8Buffer + 1);
+    size_t utf16Size = utf16Writer.index(utf16Buffer);
+
+    // Corrupt the input from time to time to verify that errors are reported at the same position.
+    if (utf8Size && (iter & 3u) == 3u) {
+      utf8Buffer[1 + rnd.nextUInt32() % utf8Size] = char(0xFF);
+      utf16Buffer[rnd.nextUInt32() % utf16Size] = uint16_t(0xDC00u);
+    }
+
+    // Both full and insufficient destination sizes and also an unaligned source.
+    size_t dstSize = (iter & 1u) ? 600u : rnd.nextUInt32() % 600u;
+
+    testConvertToUtf32<Unicode::Utf8Reader>(utf8Buffer + 1, utf8Size, BL_TEXT_ENCODING_UTF8, dstSize);
+    testConvertToUtf32<Unicode::Utf16Reader>(utf16Buffer, utf16Size * 2u, BL_TEXT_ENCODING_UTF16, dstSize);
+
+    Unicode::ValidationState validationState;
+    BLResult validationResult = Unicode::blValidateUtf8(utf8Buffer + 1, utf8Size, validationState);
+
+    Unicode::Utf8Reader reader(utf8Buffer + 1, utf8Size);
+    BLResult expectedResult = BL_SUCCESS;
+    while (reader.hasNext()) {
+      uint32_t uc;
+      expectedResult = reader.next<Unicode::IOFlags::kStrict | Unicode::IOFlags::kCalcIndex>(uc);
+      if (expectedResult != BL_SUCCESS)
+        break;
+    }
+
+    EXPECT_EQ(validationResult, expectedResult);
+    EXPECT_EQ(validationState.utf8Index, reader.utf8Index(utf8Buffer + 1));
+    EXPECT_EQ(validationState.utf16Index, reader.utf16Index(utf8Buffer + 1));
+    EXPECT_EQ(validationState.utf32Index, reader.utf32Index(utf8Buffer + 1));
+  }
+
+  INFO("BLGlyphBuffer::setUtf8Text() & setUtf16Text() - clusters of decoded runs");
+  for (uint32_t iter = 0; iter < 100; iter++) {
+    size_t textSize = rnd.nextUInt32() % 512u;
+    generateRandomText(rnd, text, textSize);
+
+    Unicode::Utf8Writer utf8Writer(utf8Buffer, sizeof(utf8Buffer));
+    Unicode::Utf16Writer<> utf16Writer(utf16Buffer, BL_ARRAY_SIZE(utf16Buffer));
+
+    for (size_t i = 0; i < textSize; i++) {
+      EXPECT_SUCCESS(utf8Writer.write(text[i]));
+      EXPECT_SUCCESS(utf16Writer.write(text[i]));
+    }
+
+    size_t utf8Size = utf8Writer.index(utf8Buffer);
+    size_t utf16Size = utf16Writer.index(utf16Buffer);
+
+    BLGlyphBuffer gb8;
+    BLGlyphBuffer gb16;
+
+    EXPECT_SUCCESS(gb8.setUtf8Text(utf8Buffer, utf8Size));
+    EXPECT_SUCCESS(gb16.setUtf16Text(utf16Buffer, utf16Size));
+
+    EXPECT_EQ(gb8.size(), textSize);
+    EXPECT_EQ(gb16.size(), textSize);
+
+    Unicode::Utf8Reader reader8(utf8Buffer, utf8Size);
+    Unicode::Utf16Reader reader16(utf16Buffer, utf16Size * 2u);
+
+    for (size_t i = 0; i < textSize; i++) {
+      uint32_t uc;
+
+      EXPECT_EQ(gb8.content()[i], text[i]);
+      EXPECT_EQ(gb8.infoData()[i].cluster, uint32_t(reader8.nativeIndex(utf8Buffer)));
+      EXPECT_SUCCESS(reader8.next(uc));
+
+      EXPECT_EQ(gb16.content()[i], text[i]);
+      EXPECT_EQ(gb16.infoData()[i].cluster, uint32_t(reader16.nativeIndex(utf16Buffer)));
+      EXPECT_SUCCESS(reader16.next(uc));
+    }
+  }
+}
+
 } // {Tests}
 } // {bl}
 
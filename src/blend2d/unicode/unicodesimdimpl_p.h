@@ -0,0 +1,155 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#ifndef BLEND2D_UNICODE_UNICODESIMDIMPL_P_H_INCLUDED
+#define BLEND2D_UNICODE_UNICODESIMDIMPL_P_H_INCLUDED
+
+#include "../unicode/unicode_p.h"
+#include "../simd/simd_p.h"
+
+//! \cond INTERNAL
+//! \addtogroup blend2d_internal
+//! \{
+
+namespace bl {
+namespace Unicode {
+
+// bl::Unicode - SIMD Implementation [SSE4.1 & AVX2 & ASIMD]
+// =========================================================
+//
+// Run functions must produce exactly the same output as the portable implementation in `unicode.cpp` - they only
+// process characters that don't need any validation. Each block of 16 bytes (or 32 bytes when 256-bit vectors are
+// available) is tested first and the remaining characters are handled by a scalar loop, which stops at the first
+// character that must be decoded by a unicode reader.
+
+namespace {
+
+using namespace SIMD;
+
+// Tests whether any byte of `v` has its most significant bit set (is not ASCII).
+template<typename V>
+static BL_INLINE bool hasNonAscii(const V& v) noexcept {
+#if BL_TARGET_ARCH_X86
+  return extract_sign_bits_i8(v) != 0u;
+#else
+  return vmaxvq_u8(simd_u8(v.v)) >= 0x80u;
+#endif
+}
+
+// Tests whether any 16-bit element of `v` is a high or low surrogate.
+static BL_INLINE bool hasSurrogate(const Vec8xU16& v) noexcept {
+  Vec8xU16 m = cmp_eq_u16(v & make128_u16<Vec8xU16>(0xF800u), make128_u16<Vec8xU16>(0xD800u));
+#if BL_TARGET_ARCH_X86
+  return extract_sign_bits_i8(m) != 0u;
+#else
+  return vmaxvq_u16(simd_u16(m.v)) != 0u;
+#endif
+}
+
+// Widens 16 ASCII characters to 16 UTF-32 code-points.
+static BL_INLINE void widen16xU8(uint32_t* dst, const Vec16xU8& v) noexcept {
+  Vec16xU8 zero = make_zero<Vec16xU8>();
+  Vec8xU16 lo = vec_u16(interleave_lo_u8(v, zero));
+  Vec8xU16 hi = vec_u16(interleave_hi_u8(v, zero));
+  Vec8xU16 zero16 = vec_u16(zero);
+
+  storeu(dst +  0, interleave_lo_u16(lo, zero16));
+  storeu(dst +  4, interleave_hi_u16(lo, zero16));
+  storeu(dst +  8, interleave_lo_u16(hi, zero16));
+  storeu(dst + 12, interleave_hi_u16(hi, zero16));
+}
+
+// Widens 8 UTF-16 code units (none of them is a surrogate) to 8 UTF-32 code-points.
+static BL_INLINE void widen8xU16(uint32_t* dst, const Vec8xU16& v) noexcept {
+  Vec8xU16 zero = make_zero<Vec8xU16>();
+  storeu(dst + 0, interleave_lo_u16(v, zero));
+  storeu(dst + 4, interleave_hi_u16(v, zero));
+}
+
+static BL_INLINE size_t utf8AsciiSizeImpl(const uint8_t* src, size_t size) noexcept {
+  size_t i = 0;
+
+#if BL_SIMD_WIDTH_I >= 256
+  while (size - i >= 32u && !hasNonAscii(loadu<Vec32xU8>(src + i)))
+    i += 32u;
+#endif
+
+  while (size - i >= 16u && !hasNonAscii(loadu<Vec16xU8>(src + i)))
+    i += 16u;
+
+  while (i < size && src[i] < 0x80u)
+    i++;
+
+  return i;
+}
+
+static BL_INLINE size_t utf8AsciiToUtf32Impl(uint32_t* dst, const uint8_t* src, size_t size) noexcept {
+  size_t i = 0;
+
+#if BL_SIMD_WIDTH_I >= 256
+  while (size - i >= 32u && !hasNonAscii(loadu<Vec32xU8>(src + i))) {
+    widen16xU8(dst + i +  0, loadu<Vec16xU8>(src + i +  0));
+    widen16xU8(dst + i + 16, loadu<Vec16xU8>(src + i + 16));
+    i += 32u;
+  }
+#endif
+
+  while (size - i >= 16u) {
+    Vec16xU8 v = loadu<Vec16xU8>(src + i);
+    if (hasNonAscii(v))
+      break;
+
+    widen16xU8(dst + i, v);
+    i += 16u;
+  }
+
+  while (i < size && src[i] < 0x80u) {
+    dst[i] = src[i];
+    i++;
+  }
+
+  return i;
+}
+
+static BL_INLINE size_t utf16BmpToUtf32Impl(uint32_t* dst, const uint16_t* src, size_t size) noexcept {
+  size_t i = 0;
+
+  while (size - i >= 16u) {
+    Vec8xU16 v0 = loadu<Vec8xU16>(src + i + 0);
+    Vec8xU16 v1 = loadu<Vec8xU16>(src + i + 8);
+    if (hasSurrogate(v0) || hasSurrogate(v1))
+      break;
+
+    widen8xU16(dst + i + 0, v0);
+    widen8xU16(dst + i + 8, v1);
+    i += 16u;
+  }
+
+  while (size - i >= 8u) {
+    Vec8xU16 v = loadu<Vec8xU16>(src + i);
+    if (hasSurrogate(v))
+      break;
+
+    widen8xU16(dst + i, v);
+    i += 8u;
+  }
+
+  while (i < size && !isSurrogate(src[i])) {
+    dst[i] = src[i];
+    i++;
+  }
+
+  return i;
+}
+
+} // {anonymous}
+
+} // {Unicode}
+} // {bl}
+
+//! \}
+//! \endcond
+
+#endif // BLEND2D_UNICODE_UNICODESIMDIMPL_P_H_INCLUDED
@@ -0,0 +1,140 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include <blend2d.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "bl_test_cmdline.h"
+#include "bl_test_performance_timer.h"
+
+namespace ImageScaleBench {
+
+struct FilterNameEntry {
+  BLImageScaleFilter filter;
+  char name[12];
+};
+
+static constexpr FilterNameEntry filterNameTable[] = {
+  { BL_IMAGE_SCALE_FILTER_NEAREST , "nearest"  },
+  { BL_IMAGE_SCALE_FILTER_BILINEAR, "bilinear" },
+  { BL_IMAGE_SCALE_FILTER_BICUBIC , "bicubic"  },
+  { BL_IMAGE_SCALE_FILTER_LANCZOS , "lanczos"  }
+};
+
+struct FormatNameEntry {
+  BLFormat format;
+  char name[8];
+};
+
+static constexpr FormatNameEntry formatNameTable[] = {
+  { BL_FORMAT_PRGB32, "prgb32" },
+  { BL_FORMAT_XRGB32, "xrgb32" },
+  { BL_FORMAT_A8    , "a8"     }
+};
+
+struct BenchOptions {
+  uint32_t srcWidth;
+  uint32_t srcHeight;
+  uint32_t quantity;
+};
+
+static int help() {
+  printf("Usage:\n");
+  printf("  bl_bench_image_scale [options] [--help for help]\n");
+  printf("\n");
+
+  printf("Purpose:\n");
+  printf("  Benchmark BLImage::scale() with all scaling filters, downscaling and upscaling the source image.\n");
+  printf("\n");
+
+  printf("Options:\n");
+  printf("  --width      - Width of the source image               [default=1920]\n");
+  printf("  --height     - Height of the source image              [default=1080]\n");
+  printf("  --quantity   - Number of scale calls per test          [default=10]\n");
+  printf("\n");
+
+  return 0;
+}
+
+static void fillSource(BLImage& img) {
+  BLContext ctx(img);
+  BLGradient gradient(BLLinearGradientValues(0, 0, img.width(), img.height()));
+
+  gradient.addStop(0.0, BLRgba32(0xFF000000u));
+  gradient.addStop(0.5, BLRgba32(0x80FF8000u));
+  gradient.addStop(1.0, BLRgba32(0xFF0080FFu));
+
+  ctx.fillAll(gradient);
+
+  BLRandom rnd(0x1234);
+  for (uint32_t i = 0; i < 2000; i++) {
+    double x = rnd.nextDouble() * img.width();
+    double y = rnd.nextDouble() * img.height();
+    double r = rnd.nextDouble() * 40.0 + 2.0;
+    ctx.fillCircle(x, y, r, BLRgba32(rnd.nextUInt32()));
+  }
+
+  ctx.end();
+}
+
+static void runBench(const BenchOptions& options) {
+  static const double scaleFactors[] = { 0.25, 0.5, 0.75, 1.5, 2.0 };
+
+  for (const FormatNameEntry& formatEntry : formatNameTable) {
+    BLImage src(int(options.srcWidth), int(options.srcHeight), BL_FORMAT_PRGB32);
+    fillSource(src);
+
+    if (formatEntry.format != BL_FORMAT_PRGB32)
+      src.convert(formatEntry.format);
+
+    for (double scale : scaleFactors) {
+      BLSizeI dstSize(int(options.srcWidth * scale), int(options.srcHeight * scale));
+
+      printf("[%-6s] %ux%u -> %dx%d:", formatEntry.name, options.srcWidth, options.srcHeight, dstSize.w, dstSize.h);
+
+      for (const FilterNameEntry& filterEntry : filterNameTable) {
+        BLImage dst;
+        PerformanceTimer timer;
+
+        timer.start();
+        for (uint32_t i = 0; i < options.quantity; i++)
+          BLImage::scale(dst, src, dstSize, filterEntry.filter);
+        timer.stop();
+
+        printf(" %s=%0.3f [ms]", filterEntry.name, timer.duration() / double(options.quantity));
+      }
+
+      printf("\n");
+      fflush(stdout);
+    }
+  }
+}
+
+} // {ImageScaleBench}
+
+int main(int argc, char* argv[]) {
+  BLRuntimeScope rtScope;
+  CmdLine cmdLine(argc, argv);
+
+  printf("Blend2D Image Scale Benchmark [use --help for command line options]\n\n");
+
+  if (cmdLine.hasArg("--help"))
+    return ImageScaleBench::help();
+
+  ImageScaleBench::BenchOptions options {};
+  options.srcWidth = cmdLine.valueAsUInt("--width", 1920);
+  options.srcHeight = cmdLine.valueAsUInt("--height", 1080);
+  options.quantity = cmdLine.valueAsUInt("--quantity", 10);
+
+  if (!options.srcWidth || !options.srcHeight || !options.quantity) {
+    printf("Failed to process command line arguments:\n");
+    printf("  Width, height, and quantity must be greater than zero\n");
+    return 1;
+  }
+
+  ImageScaleBench::runBench(options);
+  return 0;
+}
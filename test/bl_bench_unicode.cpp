@@ -0,0 +1,148 @@
+// This file is part of Blend2D project <https://blend2d.com>
+//
+// See blend2d.h or LICENSE.md for license and copyright information
+// SPDX-License-Identifier: Zlib
+
+#include <blend2d.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#include "bl_test_cmdline.h"
+#include "bl_test_performance_timer.h"
+
+namespace UnicodeBench {
+
+struct TextKindEntry {
+  char name[8];
+  uint32_t first;
+  uint32_t last;
+  uint32_t asciiPercentage;
+};
+
+// Each text kind is a mix of ASCII characters (spaces, punctuation, etc...) and characters of the given range.
+static constexpr TextKindEntry textKindTable[] = {
+  { "ascii" , 0x00020u, 0x0007Eu, 100 },
+  { "latin" , 0x000C0u, 0x0017Fu, 85  },
+  { "cjk"   , 0x04E00u, 0x09FFFu, 10  },
+  { "emoji" , 0x1F600u, 0x1F64Fu, 50  }
+};
+
+struct BenchOptions {
+  uint32_t textSize;
+  uint32_t quantity;
+};
+
+static int help() {
+  printf("Usage:\n");
+  printf("  bl_bench_unicode [options] [--help for help]\n");
+  printf("\n");
+
+  printf("Purpose:\n");
+  printf("  Benchmark BLGlyphBuffer::setUtf8Text() and setUtf16Text(), which decode the text to UTF-32.\n");
+  printf("\n");
+
+  printf("Options:\n");
+  printf("  --size       - Number of characters of each text       [default=4096]\n");
+  printf("  --quantity   - Number of decode calls per test         [default=10000]\n");
+  printf("\n");
+
+  return 0;
+}
+
+static void generateText(const TextKindEntry& kind, uint32_t size, std::vector<char>& utf8, std::vector<uint16_t>& utf16) {
+  BLRandom rnd(0x1234);
+
+  for (uint32_t i = 0; i < size; i++) {
+    uint32_t uc = rnd.nextUInt32() % 100u < kind.asciiPercentage
+      ? 0x20u + rnd.nextUInt32() % (0x7Fu - 0x20u)
+      : kind.first + rnd.nextUInt32() % (kind.last - kind.first + 1u);
+
+    if (uc < 0x80u) {
+      utf8.push_back(char(uc));
+    }
+    else if (uc < 0x800u) {
+      utf8.push_back(char(0xC0u | (uc >> 6)));
+      utf8.push_back(char(0x80u | (uc & 0x3Fu)));
+    }
+    else if (uc < 0x10000u) {
+      utf8.push_back(char(0xE0u | (uc >> 12)));
+      utf8.push_back(char(0x80u | ((uc >> 6) & 0x3Fu)));
+      utf8.push_back(char(0x80u | (uc & 0x3Fu)));
+    }
+    else {
+      utf8.push_back(char(0xF0u | (uc >> 18)));
+      utf8.push_back(char(0x80u | ((uc >> 12) & 0x3Fu)));
+      utf8.push_back(char(0x80u | ((uc >> 6) & 0x3Fu)));
+      utf8.push_back(char(0x80u | (uc & 0x3Fu)));
+    }
+
+    if (uc < 0x10000u) {
+      utf16.push_back(uint16_t(uc));
+    }
+    else {
+      utf16.push_back(uint16_t(0xD800u + ((uc - 0x10000u) >> 10)));
+      utf16.push_back(uint16_t(0xDC00u + ((uc - 0x10000u) & 0x3FFu)));
+    }
+  }
+}
+
+static double megabytesPerSecond(size_t byteSize, uint32_t quantity, double durationInMs) {
+  return durationInMs > 0.0 ? (double(byteSize) * double(quantity)) / (durationInMs * 1000.0) : 0.0;
+}
+
+static void runBench(const BenchOptions& options) {
+  for (const TextKindEntry& kind : textKindTable) {
+    std::vector<char> utf8;
+    std::vector<uint16_t> utf16;
+    generateText(kind, options.textSize, utf8, utf16);
+
+    BLGlyphBuffer gb;
+    PerformanceTimer timer;
+
+    timer.start();
+    for (uint32_t i = 0; i < options.quantity; i++)
+      gb.setUtf8Text(utf8.data(), utf8.size());
+    timer.stop();
+
+    double utf8Duration = timer.duration();
+
+    timer.start();
+    for (uint32_t i = 0; i < options.quantity; i++)
+      gb.setUtf16Text(utf16.data(), utf16.size());
+    timer.stop();
+
+    double utf16Duration = timer.duration();
+
+    printf("[%-5s] utf8=%0.1f [MB/s] utf16=%0.1f [MB/s]\n",
+      kind.name,
+      megabytesPerSecond(utf8.size(), options.quantity, utf8Duration),
+      megabytesPerSecond(utf16.size() * 2u, options.quantity, utf16Duration));
+    fflush(stdout);
+  }
+}
+
+} // {UnicodeBench}
+
+int main(int argc, char* argv[]) {
+  BLRuntimeScope rtScope;
+  CmdLine cmdLine(argc, argv);
+
+  printf("Blend2D Unicode Benchmark [use --help for command line options]\n\n");
+
+  if (cmdLine.hasArg("--help"))
+    return UnicodeBench::help();
+
+  UnicodeBench::BenchOptions options {};
+  options.textSize = cmdLine.valueAsUInt("--size", 4096);
+  options.quantity = cmdLine.valueAsUInt("--quantity", 10000);
+
+  if (!options.textSize || !options.quantity) {
+    printf("Failed to process command line arguments:\n");
+    printf("  Size and quantity must be greater than zero\n");
+    return 1;
+  }
+
+  UnicodeBench::runBench(options);
+  return 0;
+}
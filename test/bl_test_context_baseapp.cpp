@@ -144,6 +144,7 @@ bool BaseTestApp::parseCommonOptions(const CmdLine& cmdLine) {
       testCases.styleIds.push_back(StyleId::kPatternFxFy);
       testCases.styleIds.push_back(StyleId::kPatternAffineNearest);
       testCases.styleIds.push_back(StyleId::kPatternAffineBilinear);
+      testCases.styleIds.push_back(StyleId::kPatternAffineBicubic);
     }
     else if (options.styleId == StyleId::kRandomUnstable || options.styleId == StyleId::kAllUnstable) {
       testCases.styleIds.push_back(StyleId::kGradientRadial);
@@ -279,6 +280,7 @@ void BaseTestApp::printStyleIds() const {
   printf("  %-23s - Pattern with fractional x and y translation\n", styleIdToString(StyleId::kPatternFxFy));
   printf("  %-23s - Pattern with affine transformation (nearest)\n", styleIdToString(StyleId::kPatternAffineNearest));
   printf("  %-23s - Pattern with affine transformation (bilinear)\n", styleIdToString(StyleId::kPatternAffineBilinear));
+  printf("  %-23s - Pattern with affine transformation (bicubic)\n", styleIdToString(StyleId::kPatternAffineBicubic));
   printf("  %-23s - Random style for every render call\n", styleIdToString(StyleId::kRandom));
   printf("  %-23s - Like 'random', but only styles that never require --max-diff\n", styleIdToString(StyleId::kRandomStable));
   printf("  %-23s - Like 'random', but only styles that could require --max-diff\n", styleIdToString(StyleId::kRandomUnstable));
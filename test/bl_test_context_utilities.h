@@ -82,6 +82,7 @@ enum class StyleId : uint32_t {
   kPatternFxFy,
   kPatternAffineNearest,
   kPatternAffineBilinear,
+  kPatternAffineBicubic,
 
   kRandom,
   kRandomStable,
@@ -197,6 +198,7 @@ static const char* styleIdToString(StyleId styleId) {
     case StyleId::kPatternFxFy          : return "pattern-fx-fy";
     case StyleId::kPatternAffineNearest : return "pattern-affine-nearest";
     case StyleId::kPatternAffineBilinear: return "pattern-affine-bilinear";
+    case StyleId::kPatternAffineBicubic : return "pattern-affine-bicubic";
     case StyleId::kRandom               : return "random";
     case StyleId::kRandomStable         : return "random-stable";
     case StyleId::kRandomUnstable       : return "random-unstable";
@@ -689,6 +691,10 @@ public:
         ctx.setPatternQuality(BL_PATTERN_QUALITY_BILINEAR);
         break;
 
+      case StyleId::kPatternAffineBicubic:
+        ctx.setPatternQuality(BL_PATTERN_QUALITY_BICUBIC);
+        break;
+
       default:
         break;
     }
@@ -783,7 +789,8 @@ public:
       }
 
       case StyleId::kPatternAffineNearest:
-      case StyleId::kPatternAffineBilinear: {
+      case StyleId::kPatternAffineBilinear:
+      case StyleId::kPatternAffineBicubic: {
         uint32_t textureId = _rnd.nextUInt32() % kTextureCount;
         BLExtendMode extendMode = BLExtendMode(_rnd.nextUInt32() % (BL_EXTEND_MODE_MAX_VALUE + 1));
 
@@ -0,0 +1,60 @@
+#ifndef RESOURCE_VARTEST_TTF_H_INCLUDED
+#define RESOURCE_VARTEST_TTF_H_INCLUDED
+
+static const unsigned char resource_vartest_ttf[] = {
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x80, 0x00, 0x03, 0x00, 0x60, 0x48, 0x56, 0x41, 0x52, 0x40, 0xD8, 0x40, 0x31,
+  0x00, 0x00, 0x03, 0x34, 0x00, 0x00, 0x00, 0x3A, 0x4F, 0x53, 0x2F, 0x32, 0x41, 0x38, 0x41, 0xC6, 0x00, 0x00, 0x01, 0x68,
+  0x00, 0x00, 0x00, 0x60, 0x61, 0x76, 0x61, 0x72, 0x10, 0x06, 0x20, 0x01, 0x00, 0x00, 0x03, 0x70, 0x00, 0x00, 0x00, 0x1A,
+  0x63, 0x6D, 0x61, 0x70, 0x00, 0x0C, 0x00, 0x96, 0x00, 0x00, 0x01, 0xD8, 0x00, 0x00, 0x00, 0x34, 0x66, 0x76, 0x61, 0x72,
+  0x7C, 0xF1, 0x69, 0x92, 0x00, 0x00, 0x03, 0x8C, 0x00, 0x00, 0x00, 0x24, 0x67, 0x6C, 0x79, 0x66, 0x74, 0x07, 0x48, 0x98,
+  0x00, 0x00, 0x02, 0x18, 0x00, 0x00, 0x00, 0x5E, 0x67, 0x76, 0x61, 0x72, 0xD2, 0xDA, 0x57, 0xE4, 0x00, 0x00, 0x03, 0xB0,
+  0x00, 0x00, 0x00, 0x64, 0x68, 0x65, 0x61, 0x64, 0x2F, 0x95, 0xCE, 0xE8, 0x00, 0x00, 0x00, 0xEC, 0x00, 0x00, 0x00, 0x36,
+  0x68, 0x68, 0x65, 0x61, 0x05, 0xAC, 0x02, 0x2B, 0x00, 0x00, 0x01, 0x24, 0x00, 0x00, 0x00, 0x24, 0x68, 0x6D, 0x74, 0x78,
+  0x08, 0xFC, 0x01, 0xC2, 0x00, 0x00, 0x01, 0xC8, 0x00, 0x00, 0x00, 0x10, 0x6C, 0x6F, 0x63, 0x61, 0x00, 0x49, 0x00, 0x34,
+  0x00, 0x00, 0x02, 0x0C, 0x00, 0x00, 0x00, 0x0A, 0x6D, 0x61, 0x78, 0x70, 0x00, 0x08, 0x00, 0x0B, 0x00, 0x00, 0x01, 0x48,
+  0x00, 0x00, 0x00, 0x20, 0x6E, 0x61, 0x6D, 0x65, 0xF3, 0x40, 0x6E, 0xF1, 0x00, 0x00, 0x02, 0x78, 0x00, 0x00, 0x00, 0x90,
+  0x70, 0x6F, 0x73, 0x74, 0x00, 0x50, 0x00, 0x25, 0x00, 0x00, 0x03, 0x08, 0x00, 0x00, 0x00, 0x2A, 0x00, 0x01, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x1D, 0xB1, 0x46, 0xB7, 0x5F, 0x0F, 0x3C, 0xF5, 0x00, 0x03, 0x03, 0xE8, 0x00, 0x00, 0x00, 0x00,
+  0xE6, 0xFA, 0xC5, 0xA6, 0x00, 0x00, 0x00, 0x00, 0xE6, 0xFA, 0xC5, 0xA6, 0x00, 0x32, 0x00, 0x00, 0x02, 0x58, 0x02, 0xBC,
+  0x00, 0x00, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x03, 0x20, 0xFF, 0x38,
+  0x00, 0x00, 0x02, 0xBC, 0x00, 0x32, 0x00, 0x32, 0x02, 0x58, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x00, 0x01, 0x00, 0x04,
+  0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01,
+  0x00, 0x03, 0x02, 0x3F, 0x01, 0x90, 0x00, 0x05, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0x3F,
+  0x3F, 0x3F, 0x00, 0x00, 0x00, 0x41, 0x00, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x01, 0xF4, 0x00, 0x32,
+  0x02, 0x58, 0x00, 0x64, 0x01, 0xF4, 0x00, 0x64, 0x02, 0xBC, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03,
+  0x00, 0x00, 0x00, 0x14, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0x14, 0x00, 0x04, 0x00, 0x20, 0x00, 0x00, 0x00, 0x04,
+  0x00, 0x04, 0x00, 0x01, 0x00, 0x00, 0x00, 0x43, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x41, 0xFF, 0xFF, 0xFF, 0xC0, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0D, 0x00, 0x1A, 0x00, 0x27, 0x00, 0x2F, 0x00, 0x00, 0x00, 0x01, 0x00, 0x32,
+  0x00, 0x00, 0x01, 0xC2, 0x02, 0xBC, 0x00, 0x03, 0x00, 0x00, 0x33, 0x11, 0x21, 0x11, 0x32, 0x01, 0x90, 0x02, 0xBC, 0xFD,
+  0x44, 0x00, 0x00, 0x01, 0x00, 0x64, 0x00, 0x00, 0x01, 0xF4, 0x02, 0xBC, 0x00, 0x03, 0x00, 0x00, 0x33, 0x11, 0x21, 0x11,
+  0x64, 0x01, 0x90, 0x02, 0xBC, 0xFD, 0x44, 0x00, 0x00, 0x01, 0x00, 0x64, 0x00, 0x00, 0x01, 0x90, 0x01, 0x90, 0x00, 0x03,
+  0x00, 0x00, 0x33, 0x10, 0x21, 0x11, 0x64, 0x01, 0x2C, 0x01, 0x90, 0xFE, 0x70, 0x00, 0xFF, 0xFF, 0x00, 0xC8, 0x00, 0x00,
+  0x02, 0x58, 0x02, 0xBC, 0x00, 0x06, 0x00, 0x01, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x4E, 0x00, 0x01,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x09, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x07,
+  0x00, 0x09, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x06, 0x00, 0x10, 0x00, 0x03, 0x00, 0x01, 0x04, 0x09,
+  0x00, 0x01, 0x00, 0x12, 0x00, 0x16, 0x00, 0x03, 0x00, 0x01, 0x04, 0x09, 0x00, 0x02, 0x00, 0x0E, 0x00, 0x28, 0x00, 0x03,
+  0x00, 0x01, 0x04, 0x09, 0x01, 0x00, 0x00, 0x0C, 0x00, 0x36, 0x42, 0x4C, 0x56, 0x61, 0x72, 0x54, 0x65, 0x73, 0x74, 0x52,
+  0x65, 0x67, 0x75, 0x6C, 0x61, 0x72, 0x57, 0x65, 0x69, 0x67, 0x68, 0x74, 0x00, 0x42, 0x00, 0x4C, 0x00, 0x56, 0x00, 0x61,
+  0x00, 0x72, 0x00, 0x54, 0x00, 0x65, 0x00, 0x73, 0x00, 0x74, 0x00, 0x52, 0x00, 0x65, 0x00, 0x67, 0x00, 0x75, 0x00, 0x6C,
+  0x00, 0x61, 0x00, 0x72, 0x00, 0x57, 0x00, 0x65, 0x00, 0x69, 0x00, 0x67, 0x00, 0x68, 0x00, 0x74, 0x00, 0x02, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x24, 0x00, 0x25, 0x00, 0x26, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x0C, 0x00, 0x01, 0x00, 0x00, 0x00, 0x16, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x40, 0x00,
+  0x40, 0x00, 0x00, 0x04, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x04, 0xC0, 0x00, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00,
+  0x10, 0x00, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x10, 0x00, 0x02, 0x00, 0x01, 0x00, 0x14,
+  0x00, 0x00, 0x00, 0x08, 0x77, 0x67, 0x68, 0x74, 0x00, 0x64, 0x00, 0x00, 0x01, 0x90, 0x00, 0x00, 0x03, 0x84, 0x00, 0x00,
+  0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x1E, 0x00, 0x04, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x1B, 0x00, 0x22, 0x40, 0x00, 0x80, 0x02, 0x00, 0x0E,
+  0x00, 0x07, 0x00, 0x00, 0x00, 0x0C, 0xA0, 0x00, 0xC0, 0x00, 0x03, 0x02, 0x01, 0x01, 0x03, 0x80, 0x41, 0x00, 0xC8, 0x00,
+  0xC8, 0x82, 0x04, 0x03, 0x00, 0x01, 0x01, 0x01, 0x03, 0xEC, 0xEC, 0xEC, 0xEC, 0x83, 0x80, 0x01, 0x00, 0x08, 0x00, 0x04,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x32, 0x00, 0x32, 0x00, 0x80, 0x01, 0x00, 0x08, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00,
+  0x64, 0x83, 0x84, 0x00,
+};
+
+#endif // RESOURCE_VARTEST_TTF_H_INCLUDED